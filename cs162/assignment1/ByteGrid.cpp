@@ -0,0 +1,752 @@
+/*************************************************************************
+ * Author:          David Rigert
+ * Date Created:    10/17/2026
+ * Last Modified:   10/17/2026
+ * Assignment:      Assignment 1
+ * Filename:        ByteGrid.cpp
+ *
+ * Description:     Implementation of the ByteGrid class.
+ *                  Each cell is stored as 0 or 1, so the eight neighbor
+ *                  bytes can be added lane by lane without overflow.
+ *                  The rule is a 32-byte lookup table indexed by the
+ *                  neighbor count, plus 16 for live cells, so every rule
+ *                  runs through the same branch-free kernels.
+ *                  The SIMD kernels are compiled with target attributes
+ *                  so the program still runs on CPUs without them.
+ ************************************************************************/
+#include <algorithm>
+#include <cstring>
+#include "ByteGrid.hpp"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define BYTEGRID_X86
+#include <immintrin.h>
+#endif
+
+// Rows ahead of the kernel fetched into cache in tiles narrower than a row
+static const int PREFETCH_ROWS = 8;
+
+/********************************************************************
+ *  Function:       void compareRowScalar(const unsigned char *row,
+ *                      const unsigned char *out, int width,
+ *                      Grid::RowStats &stats)
+ *  Description:    Counts the births and deaths between cells 1 to
+ *                  width - 2 of a row and its next state, and finds
+ *                  the live extent of the next state. Eight cells are
+ *                  compared at a time: since each byte is 0 or 1,
+ *                  multiplying a word by 0x0101010101010101 adds its
+ *                  bytes into the top byte.
+ *  Parameters:     row     Current state of the row
+ *                  out     Next state of the row
+ *                  width   Number of cells in each row
+ *                  stats   Receives the statistics of the row
+ *  Preconditions:  width >= 3
+ *  Postconditions: stats.right < stats.left if out has no live cells
+ *******************************************************************/
+static void compareRowScalar(const unsigned char *row, const unsigned char *out,
+                             int width, Grid::RowStats &stats)
+{
+    const uint64_t ONES = 0x0101010101010101ULL;
+    Grid::RowStats sum = { 0, 0, width, -1 };
+    int x = 1;
+    for (; x + 8 <= width - 1; x += 8)
+    {
+        uint64_t before, after;
+        std::memcpy(&before, row + x, 8);
+        std::memcpy(&after, out + x, 8);
+        if ((before | after) == 0)
+        {
+            continue;
+        }
+        sum.births += ((after & ~before) * ONES) >> 56;
+        sum.deaths += ((before & ~after) * ONES) >> 56;
+        if (after != 0)
+        {
+            sum.left = std::min(sum.left, x);
+            sum.right = x + 7;
+        }
+    }
+    for (; x < width - 1; x++)
+    {
+        sum.births += out[x] & !row[x];
+        sum.deaths += row[x] & !out[x];
+        if (out[x])
+        {
+            sum.left = std::min(sum.left, x);
+            sum.right = x;
+        }
+    }
+    
+    // Narrow the extent from whole words to cells
+    if (sum.left <= sum.right)
+    {
+        while (!out[sum.left])
+        {
+            sum.left++;
+        }
+        while (!out[sum.right])
+        {
+            sum.right--;
+        }
+    }
+    stats = sum;
+}
+
+/********************************************************************
+ *  Function:       uint64_t hashRowChanges(const unsigned char *row,
+ *                      const unsigned char *out, int first, int last,
+ *                      int y)
+ *  Description:    Gets the XOR of the keys of the cells among first
+ *                  to last - 1 that differ between a row and its next
+ *                  state. It runs right after the kernel, while both
+ *                  rows are still in cache, and compares eight cells
+ *                  at a time, so unchanged runs cost one comparison.
+ *  Parameters:     row     Current state of the row
+ *                  out     Next state of the row
+ *                  first   First cell to compare
+ *                  last    Cell after the last cell to compare
+ *                  y       Y coordinate of the row
+ *  Preconditions:  0 <= first <= last <= width
+ *  Postconditions: Returns 0 if no cells changed
+ *******************************************************************/
+static uint64_t hashRowChanges(const unsigned char *row, const unsigned char *out,
+                               int first, int last, int y)
+{
+    uint64_t hash = 0;
+    int x = first;
+    for (; x + 8 <= last; x += 8)
+    {
+        uint64_t before, after;
+        std::memcpy(&before, row + x, 8);
+        std::memcpy(&after, out + x, 8);
+        if (before == after)
+        {
+            continue;
+        }
+        for (int i = 0; i < 8; i++)
+        {
+            if (row[x + i] != out[x + i])
+            {
+                hash ^= Grid::getCellKey(x + i, y);
+            }
+        }
+    }
+    for (; x < last; x++)
+    {
+        if (row[x] != out[x])
+        {
+            hash ^= Grid::getCellKey(x, y);
+        }
+    }
+    return hash;
+}
+
+/********************************************************************
+ *  Function:       void computeRowScalar(const unsigned char *above,
+ *                      const unsigned char *row, const unsigned char *below,
+ *                      unsigned char *out, int width,
+ *                      const unsigned char *table, Grid::RowStats *stats)
+ *  Description:    Calculates the next state of cells 1 to width - 2
+ *                  one cell at a time.
+ *  Parameters:     above   Row above the row to calculate
+ *                  row     Row to calculate
+ *                  below   Row below the row to calculate
+ *                  out     Receives the next state of row
+ *                  width   Number of cells in each row
+ *                  table   Rule lookup table
+ *                  stats   Receives the statistics of the row, or NULL
+ *  Preconditions:  width >= 3
+ *  Postconditions: out[1] to out[width - 2] contain the next generation
+ *******************************************************************/
+static void computeRowScalar(const unsigned char *above, const unsigned char *row,
+                             const unsigned char *below, unsigned char *out,
+                             int width, const unsigned char *table,
+                             Grid::RowStats *stats)
+{
+    for (int x = 1; x < width - 1; x++)
+    {
+        int count = above[x - 1] + above[x] + above[x + 1]
+                  + row[x - 1] + row[x + 1]
+                  + below[x - 1] + below[x] + below[x + 1];
+        out[x] = table[(row[x] << 4) | count];
+    }
+    if (stats)
+    {
+        compareRowScalar(row, out, width, *stats);
+    }
+}
+
+#if defined(BYTEGRID_X86)
+/********************************************************************
+ *  Function:       void computeRowSse2(const unsigned char *above,
+ *                      const unsigned char *row, const unsigned char *below,
+ *                      unsigned char *out, int width,
+ *                      const unsigned char *table, Grid::RowStats *stats)
+ *  Description:    Calculates the next state of cells 1 to width - 2
+ *                  16 cells at a time with SSE2, finishing the
+ *                  remainder with the scalar loop. SSE2 has no byte
+ *                  shuffle, so the counts in the rule are compared
+ *                  with the neighbor counts one at a time.
+ *  Parameters:     See computeRowScalar
+ *  Preconditions:  width >= 3
+ *  Postconditions: out[1] to out[width - 2] contain the next generation
+ *******************************************************************/
+__attribute__((target("sse2")))
+static void computeRowSse2(const unsigned char *above, const unsigned char *row,
+                           const unsigned char *below, unsigned char *out,
+                           int width, const unsigned char *table,
+                           Grid::RowStats *stats)
+{
+    const __m128i one = _mm_set1_epi8(1);
+    int x = 1;
+    
+    // Neighbor counts in the rule, broadcast to every lane
+    __m128i birthCounts[9];
+    __m128i survivalCounts[9];
+    int births = 0;
+    int survivals = 0;
+    for (int n = 0; n <= 8; n++)
+    {
+        if (table[n])
+        {
+            birthCounts[births++] = _mm_set1_epi8(n);
+        }
+        if (table[16 + n])
+        {
+            survivalCounts[survivals++] = _mm_set1_epi8(n);
+        }
+    }
+    
+    for (; x + 16 <= width - 1; x += 16)
+    {
+        __m128i count = _mm_loadu_si128((const __m128i *)(above + x - 1));
+        count = _mm_add_epi8(count, _mm_loadu_si128((const __m128i *)(above + x)));
+        count = _mm_add_epi8(count, _mm_loadu_si128((const __m128i *)(above + x + 1)));
+        count = _mm_add_epi8(count, _mm_loadu_si128((const __m128i *)(row + x - 1)));
+        count = _mm_add_epi8(count, _mm_loadu_si128((const __m128i *)(row + x + 1)));
+        count = _mm_add_epi8(count, _mm_loadu_si128((const __m128i *)(below + x - 1)));
+        count = _mm_add_epi8(count, _mm_loadu_si128((const __m128i *)(below + x)));
+        count = _mm_add_epi8(count, _mm_loadu_si128((const __m128i *)(below + x + 1)));
+    
+        __m128i born = _mm_setzero_si128();
+        for (int i = 0; i < births; i++)
+        {
+            born = _mm_or_si128(born, _mm_cmpeq_epi8(count, birthCounts[i]));
+        }
+        __m128i stays = _mm_setzero_si128();
+        for (int i = 0; i < survivals; i++)
+        {
+            stays = _mm_or_si128(stays, _mm_cmpeq_epi8(count, survivalCounts[i]));
+        }
+    
+        __m128i alive = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(row + x)), one);
+        __m128i result = _mm_or_si128(_mm_andnot_si128(alive, born),
+                                      _mm_and_si128(alive, stays));
+        result = _mm_and_si128(result, one);
+        _mm_storeu_si128((__m128i *)(out + x), result);
+    }
+    
+    // Finish the cells that do not fill a whole register
+    if (x < width - 1)
+    {
+        computeRowScalar(above + x - 1, row + x - 1, below + x - 1,
+                         out + x - 1, width - x + 1, table, NULL);
+    }
+    if (stats)
+    {
+        compareRowScalar(row, out, width, *stats);
+    }
+}
+
+// 32 cleared bytes then 32 set ones; loading at offset n sets the
+// last n lanes of a register
+static const unsigned char LAST_LANES[64] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255
+};
+
+/********************************************************************
+ *  Function:       __m256i computeCellsAvx2(const unsigned char *above,
+ *                      const unsigned char *row, const unsigned char *below,
+ *                      unsigned char *out, int x, __m256i deadTable,
+ *                      __m256i liveTable)
+ *  Description:    Calculates the next state of cells x to x + 31 with
+ *                  AVX2. Both halves of the rule table fit in a
+ *                  register, so the next state is looked up with byte
+ *                  shuffles.
+ *  Parameters:     See computeRowScalar
+ *                  x           First cell to calculate
+ *                  deadTable   Rule table of dead cells
+ *                  liveTable   Rule table of live cells
+ *  Preconditions:  CPU supports AVX2, cells x - 1 to x + 32 exist
+ *  Postconditions: Returns the next state stored in out[x] to out[x + 31]
+ *******************************************************************/
+__attribute__((target("avx2"), always_inline))
+static inline __m256i computeCellsAvx2(const unsigned char *above,
+                                       const unsigned char *row,
+                                       const unsigned char *below,
+                                       unsigned char *out, int x,
+                                       __m256i deadTable, __m256i liveTable)
+{
+    __m256i count = _mm256_loadu_si256((const __m256i *)(above + x - 1));
+    count = _mm256_add_epi8(count, _mm256_loadu_si256((const __m256i *)(above + x)));
+    count = _mm256_add_epi8(count, _mm256_loadu_si256((const __m256i *)(above + x + 1)));
+    count = _mm256_add_epi8(count, _mm256_loadu_si256((const __m256i *)(row + x - 1)));
+    count = _mm256_add_epi8(count, _mm256_loadu_si256((const __m256i *)(row + x + 1)));
+    count = _mm256_add_epi8(count, _mm256_loadu_si256((const __m256i *)(below + x - 1)));
+    count = _mm256_add_epi8(count, _mm256_loadu_si256((const __m256i *)(below + x)));
+    count = _mm256_add_epi8(count, _mm256_loadu_si256((const __m256i *)(below + x + 1)));
+    
+    // Counts are 0 to 8, so each one indexes its lane of the table
+    __m256i cells = _mm256_loadu_si256((const __m256i *)(row + x));
+    __m256i alive = _mm256_cmpeq_epi8(cells, _mm256_set1_epi8(1));
+    __m256i born = _mm256_shuffle_epi8(deadTable, count);
+    __m256i stays = _mm256_shuffle_epi8(liveTable, count);
+    __m256i result = _mm256_blendv_epi8(born, stays, alive);
+    _mm256_storeu_si256((__m256i *)(out + x), result);
+    return result;
+}
+
+/********************************************************************
+ *  Function:       void computeRowAvx2<STATS>(const unsigned char *above,
+ *                      const unsigned char *row, const unsigned char *below,
+ *                      unsigned char *out, int width,
+ *                      const unsigned char *table, Grid::RowStats *stats)
+ *  Description:    Calculates the next state of cells 1 to width - 2
+ *                  32 cells at a time with AVX2, ending with a register
+ *                  that overlaps the one before it instead of a scalar
+ *                  remainder. With STATS, the births and deaths of
+ *                  each register are added into byte counters that
+ *                  are summed once every 255 registers, and the cells
+ *                  are OR'ed together, so the loop gains only a few
+ *                  unbranched logic operations. Rows that are empty
+ *                  before and after skip adding up the counters; the
+ *                  extent of the others is searched from both ends.
+ *  Parameters:     See computeRowScalar
+ *  Preconditions:  width >= 3, CPU supports AVX2, stats is not NULL
+ *                  if STATS
+ *  Postconditions: out[1] to out[width - 2] contain the next generation
+ *******************************************************************/
+template <bool STATS>
+__attribute__((target("avx2")))
+static void computeRowAvx2(const unsigned char *above, const unsigned char *row,
+                           const unsigned char *below, unsigned char *out,
+                           int width, const unsigned char *table,
+                           Grid::RowStats *stats)
+{
+    // Rows narrower than a register are left to the scalar loop
+    int last = width - 33;
+    if (last < 1)
+    {
+        computeRowScalar(above, row, below, out, width, table, stats);
+        return;
+    }
+    
+    const __m256i one = _mm256_set1_epi8(1);
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i deadTable = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128((const __m128i *)table));
+    const __m256i liveTable = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128((const __m128i *)(table + 16)));
+    __m256i births = zero;
+    __m256i deaths = zero;
+    __m256i births8 = zero;
+    __m256i deaths8 = zero;
+    __m256i live = zero;
+    __m256i touched = zero;
+    
+    // Byte counters hold at most 255, so they are summed that often
+    for (int x = 1; x <= last; )
+    {
+        int end = std::min(last + 1, x + 255 * 32);
+        for (; x < end; x += 32)
+        {
+            __m256i result = computeCellsAvx2(above, row, below, out, x,
+                                              deadTable, liveTable);
+            if (STATS)
+            {
+                __m256i cells = _mm256_loadu_si256((const __m256i *)(row + x));
+                births8 = _mm256_add_epi8(births8, _mm256_andnot_si256(cells, result));
+                deaths8 = _mm256_add_epi8(deaths8, _mm256_andnot_si256(result, cells));
+                live = _mm256_or_si256(live, result);
+                touched = _mm256_or_si256(touched, cells);
+            }
+        }
+        if (STATS)
+        {
+            births = _mm256_add_epi64(births, _mm256_sad_epu8(births8, zero));
+            deaths = _mm256_add_epi64(deaths, _mm256_sad_epu8(deaths8, zero));
+            births8 = zero;
+            deaths8 = zero;
+        }
+    }
+    
+    // The last register overlaps the previous one unless the row is a
+    // whole number of registers; only its new lanes are counted
+    int remaining = (width - 2) % 32;
+    if (remaining != 0)
+    {
+        __m256i result = computeCellsAvx2(above, row, below, out, last,
+                                          deadTable, liveTable);
+        if (STATS)
+        {
+            __m256i fresh = _mm256_loadu_si256((const __m256i *)(LAST_LANES + remaining));
+            __m256i cells = _mm256_and_si256(
+                _mm256_loadu_si256((const __m256i *)(row + last)), fresh);
+            result = _mm256_and_si256(result, fresh);
+            births = _mm256_add_epi64(births, _mm256_sad_epu8(_mm256_andnot_si256(cells, result), zero));
+            deaths = _mm256_add_epi64(deaths, _mm256_sad_epu8(_mm256_andnot_si256(result, cells), zero));
+            live = _mm256_or_si256(live, result);
+            touched = _mm256_or_si256(touched, cells);
+        }
+    }
+    if (!STATS)
+    {
+        return;
+    }
+    
+    Grid::RowStats sum = { 0, 0, width, -1 };
+    if (_mm256_testz_si256(_mm256_or_si256(live, touched), one))
+    {
+        *stats = sum;
+        return;
+    }
+    uint64_t lanes[8];
+    _mm256_storeu_si256((__m256i *)lanes, births);
+    _mm256_storeu_si256((__m256i *)(lanes + 4), deaths);
+    sum.births = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    sum.deaths = lanes[4] + lanes[5] + lanes[6] + lanes[7];
+    
+    // Search a register at a time from both ends; shifting each byte's
+    // low bit into its sign bit gives a mask of the live cells in it
+    if (!_mm256_testz_si256(live, one))
+    {
+        int left = 1;
+        unsigned int cells;
+        while ((cells = _mm256_movemask_epi8(_mm256_slli_epi16(
+                    _mm256_loadu_si256((const __m256i *)(out + left)), 7))) == 0)
+        {
+            left = std::min(left + 32, last);
+        }
+        sum.left = left + __builtin_ctz(cells);
+        int right = last;
+        while ((cells = _mm256_movemask_epi8(_mm256_slli_epi16(
+                    _mm256_loadu_si256((const __m256i *)(out + right)), 7))) == 0)
+        {
+            right = std::max(right - 32, 1);
+        }
+        sum.right = right + 31 - __builtin_clz(cells);
+    }
+    *stats = sum;
+}
+
+/********************************************************************
+ *  Function:       void computeRowAvx2(const unsigned char *above,
+ *                      const unsigned char *row, const unsigned char *below,
+ *                      unsigned char *out, int width,
+ *                      const unsigned char *table, Grid::RowStats *stats)
+ *  Description:    Selects the AVX2 kernel with or without statistics,
+ *                  so the kernel without them has no extra work.
+ *  Parameters:     See computeRowScalar
+ *  Preconditions:  width >= 3, CPU supports AVX2
+ *  Postconditions: out[1] to out[width - 2] contain the next generation
+ *******************************************************************/
+__attribute__((target("avx2")))
+static void computeRowAvx2(const unsigned char *above, const unsigned char *row,
+                           const unsigned char *below, unsigned char *out,
+                           int width, const unsigned char *table,
+                           Grid::RowStats *stats)
+{
+    if (stats)
+    {
+        computeRowAvx2<true>(above, row, below, out, width, table, stats);
+    }
+    else
+    {
+        computeRowAvx2<false>(above, row, below, out, width, table, NULL);
+    }
+}
+#endif // end of BYTEGRID_X86
+
+/********************************************************************
+ *  Function:       ByteGrid(int width, int height, Kernel requested)
+ *  Description:    Allocates both generation buffers with all cells
+ *                  dead and selects the row kernel. If the requested
+ *                  kernel is not supported by the CPU, the widest
+ *                  supported kernel is used instead.
+ *  Parameters:     width       Width of the grid including buffer cells
+ *                  height      Height of the grid including buffer cells
+ *                  requested   Kernel to use
+ *******************************************************************/
+ByteGrid::ByteGrid(int width, int height, Kernel requested) : Grid(width, height)
+{
+    current.assign(width * height, 0);
+    next.assign(width * height, 0);
+    
+    Kernel best = getBestKernel();
+    kernel = (requested == KERNEL_AUTO || requested > best) ? best : requested;
+    
+    setRule(rule);
+    
+    computeRow = computeRowScalar;
+    #if defined(BYTEGRID_X86)
+    if (kernel == KERNEL_SSE2)
+    {
+        computeRow = computeRowSse2;
+    }
+    else if (kernel == KERNEL_AVX2)
+    {
+        computeRow = computeRowAvx2;
+    }
+    #endif
+}
+
+/********************************************************************
+ *  Function:       Kernel getBestKernel()
+ *  Description:    Detects the widest kernel supported by the CPU.
+ *                  Detection runs once and the result is reused.
+ *  Parameters:     none
+ *  Preconditions:  none
+ *  Postconditions: Returns KERNEL_AVX2, KERNEL_SSE2 or KERNEL_SCALAR
+ *******************************************************************/
+ByteGrid::Kernel ByteGrid::getBestKernel()
+{
+    static Kernel best = KERNEL_AUTO;
+    
+    if (best == KERNEL_AUTO)
+    {
+        best = KERNEL_SCALAR;
+        #if defined(BYTEGRID_X86)
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+        {
+            best = KERNEL_AVX2;
+        }
+        else if (__builtin_cpu_supports("sse2"))
+        {
+            best = KERNEL_SSE2;
+        }
+        #endif
+    }
+    return best;
+}
+
+/********************************************************************
+ *  Function:       const char *getKernelName(Kernel k)
+ *  Description:    Gets a printable name for the specified kernel.
+ *  Parameters:     k   Kernel to name
+ *  Preconditions:  none
+ *  Postconditions: Returns the name of the kernel
+ *******************************************************************/
+const char *ByteGrid::getKernelName(Kernel k)
+{
+    switch (k)
+    {
+        case KERNEL_SCALAR:
+            return "scalar";
+        case KERNEL_SSE2:
+            return "sse2";
+        case KERNEL_AVX2:
+            return "avx2";
+        default:
+            return "auto";
+    }
+}
+
+/********************************************************************
+ *  Function:       long long getPopulation()
+ *  Description:    Counts the live cells inside the outermost ring.
+ *                  Since each byte is 0 or 1, multiplying 8 cells read
+ *                  as a word by 0x0101010101010101 adds them into the
+ *                  top byte, so no cell is read through getCell.
+ *  Parameters:     none
+ *  Preconditions:  none
+ *  Postconditions: Returns the number of live cells
+ *******************************************************************/
+long long ByteGrid::getPopulation() const
+{
+    const uint64_t ONES = 0x0101010101010101ULL;
+    long long count = 0;
+    for (int y = 1; y < height - 1; y++)
+    {
+        const unsigned char *row = &current[y * width];
+        int x = 1;
+        for (; x + 8 <= width - 1; x += 8)
+        {
+            uint64_t word;
+            std::memcpy(&word, row + x, 8);
+            count += (word * ONES) >> 56;
+        }
+        for (; x < width - 1; x++)
+        {
+            count += row[x];
+        }
+    }
+    return count;
+}
+
+/********************************************************************
+ *  Function:       void setRule(const Rule &newRule)
+ *  Description:    Sets the rule and fills the lookup table used by
+ *                  the row kernels.
+ *  Parameters:     newRule     Rule to use
+ *  Preconditions:  none
+ *  Postconditions: Later generations use newRule
+ *******************************************************************/
+void ByteGrid::setRule(const Rule &newRule)
+{
+    rule = newRule;
+    std::fill(ruleTable, ruleTable + 32, 0);
+    for (int n = 0; n <= 8; n++)
+    {
+        ruleTable[n] = rule.getNextState(false, n);
+        ruleTable[16 + n] = rule.getNextState(true, n);
+    }
+}
+
+/********************************************************************
+ *  Function:       void exchangeHalo()
+ *  Description:    Copies the edges of the interior into the outermost
+ *                  ring on the opposite side, copying whole rows (in
+ *                  reverse for a Klein bottle) once the columns are set.
+ *  Parameters:     none
+ *  Preconditions:  width >= 3, height >= 3
+ *  Postconditions: Ring cells match the cells they wrap around to
+ *******************************************************************/
+void ByteGrid::exchangeHalo()
+{
+    if (boundary == DEAD_EDGE)
+    {
+        return;
+    }
+    
+    // Left and right edges are joined for both wrapping modes
+    for (int y = 1; y < height - 1; y++)
+    {
+        unsigned char *row = &current[y * width];
+        row[0] = row[width - 2];
+        row[width - 1] = row[1];
+    }
+    
+    // Top and bottom edges, mirrored for a Klein bottle
+    std::vector<unsigned char>::iterator top = current.begin();
+    std::vector<unsigned char>::iterator bottom = current.begin() + (height - 1) * width;
+    std::vector<unsigned char>::iterator firstRow = current.begin() + width;
+    std::vector<unsigned char>::iterator lastRow = current.begin() + (height - 2) * width;
+    if (boundary == TORUS)
+    {
+        std::copy(lastRow, lastRow + width, top);
+        std::copy(firstRow, firstRow + width, bottom);
+    }
+    else
+    {
+        std::reverse_copy(lastRow, lastRow + width, top);
+        std::reverse_copy(firstRow, firstRow + width, bottom);
+    }
+}
+
+/********************************************************************
+ *  Function:       void computeRows(int first, int last)
+ *  Description:    Calculates the specified rows of the next generation
+ *                  according to the rule, as a tile of whole rows.
+ *  Parameters:     first   First row to calculate, at least 1
+ *                  last    Row after the last row, at most height - 1
+ *  Preconditions:  none
+ *  Postconditions: Rows first to last - 1 of next buffer are calculated
+ *******************************************************************/
+void ByteGrid::computeRows(int first, int last)
+{
+    computeTile(first, last, 0, width);
+}
+
+/********************************************************************
+ *  Function:       void computeTile(int top, int bottom, int left,
+ *                                   int right)
+ *  Description:    Calculates the cells of the specified rectangle.
+ *                  The row kernels calculate cells 1 to width - 2 of
+ *                  the rows they are given, so passing them the rows
+ *                  from the cell left of the tile with the width of
+ *                  the tile plus 2 calculates just the tile. In a
+ *                  tile narrower than a row, the cells of the tile a
+ *                  few rows ahead are prefetched, since the hardware
+ *                  prefetcher does not follow such short runs. When
+ *                  gathering statistics, the row kernel also fills in
+ *                  the RowStats of each row, and when hashing, the
+ *                  changes of each row are hashed as soon as it is
+ *                  calculated.
+ *  Parameters:     top     First row to calculate, at least 1
+ *                  bottom  Row after the last row, at most height - 1
+ *                  left    First column, a multiple of 32
+ *                  right   Column after the last column, a multiple of
+ *                          32 or the width
+ *  Preconditions:  Statistics are disabled unless the tile spans whole
+ *                  rows
+ *  Postconditions: Cells of the tile in the next buffer are calculated
+ *******************************************************************/
+void ByteGrid::computeTile(int top, int bottom, int left, int right)
+{
+    // First and last columns are never evaluated
+    int first = std::max(left, 1);
+    int last = std::min(right, width - 1);
+    bool narrow = left > 0 || right < width;
+    uint64_t hash = 0;
+    for (int y = top; y < bottom; y++)
+    {
+        const unsigned char *row = &current[y * width];
+        unsigned char *out = &next[y * width];
+        if (first < last)
+        {
+            // Each row of a narrow tile is too short for the hardware
+            // prefetcher, so the rows ahead are fetched by hand
+            if (narrow && y + PREFETCH_ROWS < height)
+            {
+                for (int x = first - 1; x <= last; x += 64)
+                {
+                    __builtin_prefetch(row + PREFETCH_ROWS * width + x);
+                    __builtin_prefetch(out + PREFETCH_ROWS * width + x, 1);
+                }
+            }
+            computeRow(row - width + first - 1, row + first - 1,
+                       row + width + first - 1, out + first - 1,
+                       last - first + 2, ruleTable,
+                       statsEnabled ? &rowStats[y] : NULL);
+        }
+        if (left == 0)
+        {
+            out[0] = 0;
+        }
+        if (right == width)
+        {
+            out[width - 1] = 0;
+        }
+        if (hashEnabled)
+        {
+            hash ^= hashRowChanges(row, out, first, last, y);
+        }
+    }
+    addChangeHash(hash);
+}
+
+/********************************************************************
+ *  Function:       void swapBuffers()
+ *  Description:    Clears the rows that are never evaluated and swaps
+ *                  the current and next buffers.
+ *  Parameters:     none
+ *  Preconditions:  All rows of the next buffer are calculated
+ *  Postconditions: Current buffer contains next generation
+ *******************************************************************/
+void ByteGrid::swapBuffers()
+{
+    // Top and bottom rows are never evaluated
+    std::fill(next.begin(), next.begin() + width, 0);
+    std::fill(next.end() - width, next.end(), 0);
+    
+    if (statsEnabled)
+    {
+        sumRowStats();
+    }
+    finishChangeHash();
+    current.swap(next);
+}
@@ -0,0 +1,130 @@
+/*************************************************************************
+ * Author:          David Rigert
+ * Date Created:    10/17/2026
+ * Last Modified:   10/17/2026
+ * Assignment:      Assignment 1
+ * Filename:        ByteGrid.hpp
+ *
+ * Description:     Grid backend that stores one byte per cell so that
+ *                  neighbor counts can be added with SIMD byte adds.
+ *                  The widest kernel supported by the CPU is selected
+ *                  at runtime, falling back to a scalar loop.
+ ************************************************************************/
+#ifndef BYTEGRID_HPP
+#define BYTEGRID_HPP
+
+#include <vector>
+#include "Grid.hpp"
+
+class ByteGrid : public Grid
+{
+public:
+    // Row kernels in order of increasing width
+    enum Kernel
+    {
+        KERNEL_AUTO,            // widest kernel supported by the CPU
+        KERNEL_SCALAR,          // one cell per iteration
+        KERNEL_SSE2,            // 16 cells per iteration
+        KERNEL_AVX2             // 32 cells per iteration
+    };
+
+    // Computes the next state of cells 1 to width - 2 of one row,
+    // and its statistics if given a RowStats
+    typedef void (*RowFunction)(const unsigned char *, const unsigned char *,
+                                const unsigned char *, unsigned char *, int,
+                                const unsigned char *, RowStats *);
+
+// member variables
+private:
+    std::vector<unsigned char> current; // cells of current generation
+    std::vector<unsigned char> next;    // cells of next generation
+    Kernel kernel;                      // kernel used by step
+    RowFunction computeRow;             // row function of kernel
+    unsigned char ruleTable[32];        // next state of dead cells by
+                                        // neighbor count, then live cells
+
+public:
+    // Instantiates a grid of the specified size with all cells dead.
+    ByteGrid(int, int, Kernel = KERNEL_AUTO);
+
+    // Gets the widest kernel supported by the CPU.
+    static Kernel getBestKernel();
+
+    // Gets the name of the specified kernel.
+    static const char *getKernelName(Kernel);
+
+    /********************************************************************
+     *  Function:       Kernel getKernel()
+     *  Description:    Gets the kernel selected for this grid.
+     *  Parameters:     none
+     *  Preconditions:  none
+     *  Postconditions: Returns the kernel used by step
+     *******************************************************************/
+    Kernel getKernel() const
+    {
+        return kernel;
+    }
+
+    /********************************************************************
+     *  Function:       bool getCell(int x, int y)
+     *  Description:    Gets whether the specified cell is alive.
+     *  Parameters:     x   X coordinate of cell
+     *                  y   Y coordinate of cell
+     *  Preconditions:  x,y is on the grid
+     *  Postconditions: Returns true if the cell is alive
+     *******************************************************************/
+    bool getCell(int x, int y) const
+    {
+        return current[y * width + x] != 0;
+    }
+
+    /********************************************************************
+     *  Function:       void setCell(int x, int y, bool alive)
+     *  Description:    Sets the state of the specified cell.
+     *  Parameters:     x       X coordinate of cell
+     *                  y       Y coordinate of cell
+     *                  alive   New state of the cell
+     *  Preconditions:  x,y is on the grid
+     *  Postconditions: Cell at x,y is set to alive
+     *******************************************************************/
+    void setCell(int x, int y, bool alive)
+    {
+        current[y * width + x] = alive ? 1 : 0;
+    }
+
+    // Counts the live cells inside the outermost ring 8 cells at a time.
+    long long getPopulation() const;
+
+    // Sets the rule and rebuilds the rule lookup table.
+    void setRule(const Rule &);
+
+    // Fills the outermost ring from the interior for wrapping boundaries.
+    void exchangeHalo();
+
+    // Calculates rows first to last - 1 of the next generation.
+    void computeRows(int, int);
+
+    /********************************************************************
+     *  Function:       int getTileAlignment()
+     *  Description:    Tiles of a Simulation span whole rows. The row
+     *                  kernel only reads three rows at a time, which
+     *                  stay in cache however long the rows are, so
+     *                  splitting rows into columns was measured slower
+     *                  than whole rows on one thread. computeTile still
+     *                  accepts columns at multiples of 32.
+     *  Parameters:     none
+     *  Preconditions:  none
+     *  Postconditions: Returns 0
+     *******************************************************************/
+    int getTileAlignment() const
+    {
+        return 0;
+    }
+
+    // Calculates the cells of a rectangle of the next generation.
+    void computeTile(int, int, int, int);
+
+    // Makes the next buffer the current generation.
+    void swapBuffers();
+};
+#endif // end of define BYTEGRID_HPP
@@ -0,0 +1,260 @@
+/*************************************************************************
+ * Author:          David Rigert
+ * Date Created:    10/17/2026
+ * Last Modified:   10/17/2026
+ * Assignment:      Assignment 1
+ * Filename:        Checkpoint.cpp
+ *
+ * Description:     Implementation of the Checkpoint class.
+ *                  On Linux the file is mapped read-only, so restoring
+ *                  a board reads its rows straight from the page cache
+ *                  without copying the file first.
+ ************************************************************************/
+#include <fstream>
+#include <algorithm>
+#include <stdexcept>
+#include <cstring>
+#include "Checkpoint.hpp"
+
+// Include unix headers if running on Linux
+#if defined(__linux__)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+static const char MAGIC[8] = { 'L', 'I', 'F', 'E', 'S', 'N', 'A', 'P' };
+
+// The header is read in place, so it must keep the words after it aligned
+static_assert(sizeof(Checkpoint::Header) % 8 == 0, "Header must be whole words");
+
+/********************************************************************
+ *  Function:       Checkpoint(const std::string &filename)
+ *  Description:    Maps the file into memory, or reads it into a buffer
+ *                  where mapping is not available, and checks that the
+ *                  header describes a rectangle the file can hold.
+ *  Parameters:     filename    Path of the checkpoint file
+ *  Preconditions:  none
+ *  Postconditions: Throws invalid_argument if the file cannot be read
+ *                  or is not a checkpoint of this version
+ *******************************************************************/
+Checkpoint::Checkpoint(const std::string &filename)
+{
+    mapping = NULL;
+    mappingSize = 0;
+    rowsRead = 0;
+    size_t size = 0;
+    const void *contents = NULL;
+
+    #if defined(__linux__)
+    int fd = open(filename.c_str(), O_RDONLY);
+    struct stat info;
+    if (fd < 0 || fstat(fd, &info) != 0)
+    {
+        if (fd >= 0)
+        {
+            close(fd);
+        }
+        throw std::invalid_argument("ERROR: Could not open checkpoint file.");
+    }
+    size = info.st_size;
+    if (size >= sizeof(Header))
+    {
+        mapping = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    close(fd);
+    if (mapping == MAP_FAILED)
+    {
+        throw std::invalid_argument("ERROR: Could not map checkpoint file.");
+    }
+    if (mapping)
+    {
+        mappingSize = size;
+        madvise(mapping, size, MADV_SEQUENTIAL);
+        contents = mapping;
+    }
+    #else
+    std::ifstream in(filename.c_str(), std::ios::binary);
+    if (!in)
+    {
+        throw std::invalid_argument("ERROR: Could not open checkpoint file.");
+    }
+    in.seekg(0, std::ios::end);
+    size = in.tellg();
+    in.seekg(0, std::ios::beg);
+    buffer.resize((size + 7) / 8);
+    in.read(reinterpret_cast<char *>(&buffer[0]), size);
+    contents = buffer.empty() ? NULL : &buffer[0];
+    #endif
+
+    // Validate header
+    if (size < sizeof(Header) || size % 8 != 0)
+    {
+        unmap();
+        throw std::invalid_argument("ERROR: File is not a checkpoint.");
+    }
+    std::memcpy(&header, contents, sizeof(Header));
+    data = static_cast<const uint64_t *>(contents) + sizeof(Header) / 8;
+    end = static_cast<const uint64_t *>(contents) + size / 8;
+    position = data;
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0
+        || header.version != VERSION)
+    {
+        unmap();
+        throw std::invalid_argument("ERROR: File is not a checkpoint.");
+    }
+    if (header.columns < 0 || header.rows < 0
+        || (!(header.flags & COMPRESSED)
+            && static_cast<uint64_t>(end - data)
+               != static_cast<uint64_t>(getWordsPerRow()) * header.rows))
+    {
+        unmap();
+        throw std::invalid_argument("ERROR: Checkpoint file is truncated.");
+    }
+}
+
+/********************************************************************
+ *  Function:       ~Checkpoint()
+ *  Description:    Unmaps the file.
+ *******************************************************************/
+Checkpoint::~Checkpoint()
+{
+    unmap();
+}
+
+/********************************************************************
+ *  Function:       void unmap()
+ *  Description:    Unmaps the file if it was mapped.
+ *  Parameters:     none
+ *  Preconditions:  none
+ *  Postconditions: No part of the file is mapped
+ *******************************************************************/
+void Checkpoint::unmap()
+{
+    #if defined(__linux__)
+    if (mapping)
+    {
+        munmap(mapping, mappingSize);
+        mapping = NULL;
+    }
+    #endif
+}
+
+/********************************************************************
+ *  Function:       const uint64_t *readRow(std::vector<uint64_t> &row)
+ *  Description:    Gets the words of the next row. An uncompressed row
+ *                  is returned in place in the mapped file; a
+ *                  compressed row is decoded into row first.
+ *  Parameters:     row     Buffer for a decoded row
+ *  Preconditions:  Fewer than header.rows rows have been read
+ *  Postconditions: Returns getWordsPerRow() words, or NULL if the row
+ *                  is stored as all dead cells; throws invalid_argument
+ *                  if the row runs past the end of the file
+ *******************************************************************/
+const uint64_t *Checkpoint::readRow(std::vector<uint64_t> &row)
+{
+    // Validate state
+    if (rowsRead >= header.rows)
+    {
+        throw std::logic_error("ERROR: All checkpoint rows have been read.");
+    }
+    rowsRead++;
+
+    int wordsPerRow = getWordsPerRow();
+    if (!(header.flags & COMPRESSED))
+    {
+        const uint64_t *words = position;
+        position += wordsPerRow;
+        return words;
+    }
+
+    // Decode runs until the row is full
+    row.resize(wordsPerRow);
+    bool empty = true;
+    int w = 0;
+    while (w < wordsPerRow)
+    {
+        if (position >= end)
+        {
+            throw std::invalid_argument("ERROR: Checkpoint file is truncated.");
+        }
+        uint64_t run = *position++;
+        uint64_t zeros = run >> 32;
+        uint64_t literals = run & 0xffffffffULL;
+        if (zeros + literals == 0 || zeros + literals > static_cast<uint64_t>(wordsPerRow - w)
+            || literals > static_cast<uint64_t>(end - position))
+        {
+            throw std::invalid_argument("ERROR: Checkpoint file is corrupt.");
+        }
+        std::fill(row.begin() + w, row.begin() + w + zeros, 0);
+        w += zeros;
+        std::copy(position, position + literals, row.begin() + w);
+        position += literals;
+        w += literals;
+        empty = empty && literals == 0;
+    }
+    return empty ? NULL : &row[0];
+}
+
+/********************************************************************
+ *  Function:       void writeHeader(std::ostream &out,
+ *                                   const Header &header)
+ *  Description:    Writes the header with the magic and version filled
+ *                  in.
+ *  Parameters:     out     Binary stream at the start of the file
+ *                  header  Header to write
+ *  Preconditions:  none
+ *  Postconditions: Header is written to out
+ *******************************************************************/
+void Checkpoint::writeHeader(std::ostream &out, const Header &header)
+{
+    Header copy = header;
+    std::memcpy(copy.magic, MAGIC, sizeof(MAGIC));
+    copy.version = VERSION;
+    copy.reserved = 0;
+    out.write(reinterpret_cast<const char *>(&copy), sizeof(copy));
+}
+
+/********************************************************************
+ *  Function:       void writeRow(std::ostream &out, const uint64_t *words,
+ *                                int count, bool compress)
+ *  Description:    Writes the words of a row as they are, or as runs
+ *                  of zero words each followed by the nonzero words up
+ *                  to the next zero word.
+ *  Parameters:     out         Binary stream after the previous row
+ *                  words       Words of the row
+ *                  count       Number of words in the row
+ *                  compress    Whether to write runs
+ *  Preconditions:  count > 0
+ *  Postconditions: Row is written to out
+ *******************************************************************/
+void Checkpoint::writeRow(std::ostream &out, const uint64_t *words, int count,
+                          bool compress)
+{
+    if (!compress)
+    {
+        out.write(reinterpret_cast<const char *>(words), count * sizeof(uint64_t));
+        return;
+    }
+
+    int w = 0;
+    while (w < count)
+    {
+        int start = w;
+        while (w < count && words[w] == 0)
+        {
+            w++;
+        }
+        int literalStart = w;
+        while (w < count && words[w] != 0)
+        {
+            w++;
+        }
+        uint64_t run = (static_cast<uint64_t>(literalStart - start) << 32)
+                     | static_cast<uint64_t>(w - literalStart);
+        out.write(reinterpret_cast<const char *>(&run), sizeof(run));
+        out.write(reinterpret_cast<const char *>(words + literalStart),
+                  (w - literalStart) * sizeof(uint64_t));
+    }
+}
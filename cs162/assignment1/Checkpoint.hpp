@@ -0,0 +1,122 @@
+/*************************************************************************
+ * Author:          David Rigert
+ * Date Created:    10/17/2026
+ * Last Modified:   10/17/2026
+ * Assignment:      Assignment 1
+ * Filename:        Checkpoint.hpp
+ *
+ * Description:     Reads and writes the binary checkpoint format used by
+ *                  Simulation::save and Simulation::restore. A file is
+ *                  a fixed header followed by one record per row of the
+ *                  saved rectangle, each row packed 64 cells per word in
+ *                  the layout of Grid::getRowBits. A compressed row is
+ *                  a list of runs, each a word holding the number of
+ *                  zero words in the high 32 bits and the number of
+ *                  literal words that follow in the low 32 bits.
+ *                  Everything is a multiple of 8 bytes, so the words of
+ *                  a mapped file can be read in place. Files use the
+ *                  byte order of the machine that wrote them.
+ ************************************************************************/
+#ifndef CHECKPOINT_HPP
+#define CHECKPOINT_HPP
+
+#include <string>
+#include <vector>
+#include <ostream>
+#include <stdint.h>
+
+class Checkpoint
+{
+public:
+    // Flags stored in the header
+    enum Flags
+    {
+        COMPRESSED = 1,         // rows are run-length encoded
+        SPARSE = 2              // grid was in sparse mode
+    };
+
+    static const uint32_t VERSION = 1;
+
+    // Fixed header at the start of a checkpoint file
+    struct Header
+    {
+        char magic[8];          // "LIFESNAP"
+        uint32_t version;       // VERSION
+        uint32_t flags;         // combination of Flags
+        uint64_t generationCount;
+        int32_t gridType;       // Simulation::GridType
+        int32_t boundary;       // Grid::Boundary
+        int32_t width;          // width of visible grid
+        int32_t height;         // height of visible grid
+        int32_t bufCellCount;   // hidden buffer cells on all sides
+        uint32_t birth;         // birth mask of the rule
+        uint32_t survival;      // survival mask of the rule
+        int32_t left;           // grid X coordinate of the saved rectangle
+        int32_t top;            // grid Y coordinate of the saved rectangle
+        int32_t columns;        // width of the saved rectangle
+        int32_t rows;           // height of the saved rectangle
+        int32_t reserved;       // 0, pads the header to 8 bytes
+    };
+
+// member variables
+private:
+    Header header;              // header of the file
+    const uint64_t *data;       // words of the file after the header
+    const uint64_t *end;        // end of the words of the file
+    const uint64_t *position;   // start of the next row record
+    void *mapping;              // mapped file, or NULL if read into buffer
+    size_t mappingSize;         // bytes mapped
+    std::vector<uint64_t> buffer;   // file contents if not mapped
+    int rowsRead;               // rows returned by readRow
+
+// member functions
+private:
+    // Checkpoint owns its mapping, so copying is not allowed
+    Checkpoint(const Checkpoint &);
+    Checkpoint &operator=(const Checkpoint &);
+
+    // Unmaps the file if it was mapped.
+    void unmap();
+
+public:
+    // Maps a checkpoint file and validates its header.
+    explicit Checkpoint(const std::string &);
+
+    // Unmaps the file.
+    ~Checkpoint();
+
+    /********************************************************************
+     *  Function:       const Header &getHeader()
+     *  Description:    Gets the header of the file.
+     *  Parameters:     none
+     *  Preconditions:  none
+     *  Postconditions: Returns the validated header
+     *******************************************************************/
+    const Header &getHeader() const
+    {
+        return header;
+    }
+
+    /********************************************************************
+     *  Function:       int getWordsPerRow()
+     *  Description:    Gets the number of words in each saved row.
+     *  Parameters:     none
+     *  Preconditions:  none
+     *  Postconditions: Returns the words needed for header.columns cells
+     *******************************************************************/
+    int getWordsPerRow() const
+    {
+        return (header.columns + 63) / 64;
+    }
+
+    // Gets the words of the next row, decoding it into row if compressed.
+    const uint64_t *readRow(std::vector<uint64_t> &);
+
+    // Writes the header of a checkpoint file.
+    static void writeHeader(std::ostream &, const Header &);
+
+    // Writes one row of a checkpoint file.
+    static void writeRow(std::ostream &, const uint64_t *, int, bool);
+};
+
+#endif // end of define CHECKPOINT_HPP
@@ -0,0 +1,317 @@
+/*************************************************************************
+ * Author:          David Rigert
+ * Date Created:    10/17/2026
+ * Last Modified:   10/17/2026
+ * Assignment:      Assignment 1
+ * Filename:        Grid.cpp
+ *
+ * Description:     Implementation of the Grid class.
+ ************************************************************************/
+#include <algorithm>
+#include "Grid.hpp"
+
+/********************************************************************
+ *  Function:       void setBoundary(Boundary mode)
+ *  Description:    Sets the topology of the grid. When changing to a
+ *                  dead edge, the halo left in the ring by a wrapping
+ *                  boundary is cleared.
+ *  Parameters:     mode    New boundary mode
+ *  Preconditions:  none
+ *  Postconditions: Later generations use the boundary mode
+ *******************************************************************/
+void Grid::setBoundary(Boundary mode)
+{
+    if (mode == DEAD_EDGE && boundary != DEAD_EDGE)
+    {
+        for (int x = 0; x < width; x++)
+        {
+            setCell(x, 0, false);
+            setCell(x, height - 1, false);
+        }
+        for (int y = 1; y < height - 1; y++)
+        {
+            setCell(0, y, false);
+            setCell(width - 1, y, false);
+        }
+    }
+    boundary = mode;
+}
+
+/********************************************************************
+ *  Function:       void exchangeHalo()
+ *  Description:    Copies the edges of the interior into the outermost
+ *                  ring on the opposite side. The columns are filled
+ *                  first so that copying whole rows also fills the
+ *                  corners. For a Klein bottle, the rows are copied
+ *                  mirrored. This version works for any backend one
+ *                  cell at a time; backends override it to copy words.
+ *  Parameters:     none
+ *  Preconditions:  width >= 3, height >= 3
+ *  Postconditions: Ring cells match the cells they wrap around to
+ *******************************************************************/
+void Grid::exchangeHalo()
+{
+    if (boundary == DEAD_EDGE)
+    {
+        return;
+    }
+    
+    // Left and right edges are joined for both wrapping modes
+    for (int y = 1; y < height - 1; y++)
+    {
+        setCell(0, y, getCell(width - 2, y));
+        setCell(width - 1, y, getCell(1, y));
+    }
+    
+    // Top and bottom edges, mirrored for a Klein bottle
+    bool flip = boundary == KLEIN_BOTTLE;
+    for (int x = 0; x < width; x++)
+    {
+        int from = flip ? width - 1 - x : x;
+        setCell(x, 0, getCell(from, height - 2));
+        setCell(x, height - 1, getCell(from, 1));
+    }
+}
+
+/********************************************************************
+ *  Function:       long long getPopulation()
+ *  Description:    Counts the live cells one cell at a time. The
+ *                  outermost ring is skipped since it only holds the
+ *                  halo of a wrapping boundary. Backends override this
+ *                  to count whole words.
+ *  Parameters:     none
+ *  Preconditions:  none
+ *  Postconditions: Returns the number of live cells
+ *******************************************************************/
+long long Grid::getPopulation() const
+{
+    long long count = 0;
+    for (int y = 1; y < height - 1; y++)
+    {
+        for (int x = 1; x < width - 1; x++)
+        {
+            count += getCell(x, y);
+        }
+    }
+    return count;
+}
+
+/********************************************************************
+ *  Function:       bool getBounds(int &left, int &top, int &right,
+ *                                 int &bottom)
+ *  Description:    Finds the live cells furthest in each direction,
+ *                  skipping the outermost ring like getPopulation.
+ *  Parameters:     left    Receives the X coordinate of the first column
+ *                  top     Receives the Y coordinate of the first row
+ *                  right   Receives the X coordinate of the last column
+ *                  bottom  Receives the Y coordinate of the last row
+ *  Preconditions:  none
+ *  Postconditions: Returns false and leaves the arguments unchanged
+ *                  if there are no live cells
+ *******************************************************************/
+bool Grid::getBounds(int &left, int &top, int &right, int &bottom) const
+{
+    bool found = false;
+    for (int y = 1; y < height - 1; y++)
+    {
+        for (int x = 1; x < width - 1; x++)
+        {
+            if (!getCell(x, y))
+            {
+                continue;
+            }
+            if (!found)
+            {
+                left = right = x;
+                top = y;
+                found = true;
+            }
+            left = std::min(left, x);
+            right = std::max(right, x);
+            bottom = y;
+        }
+    }
+    return found;
+}
+
+/********************************************************************
+ *  Function:       uint64_t getHash()
+ *  Description:    Calculates the Zobrist hash of the current
+ *                  generation one cell at a time, skipping the
+ *                  outermost ring like getPopulation. The hash of the
+ *                  next generation is this hash XOR getChangeHash.
+ *  Parameters:     none
+ *  Preconditions:  none
+ *  Postconditions: Returns the hash, 0 if no cells are alive
+ *******************************************************************/
+uint64_t Grid::getHash() const
+{
+    uint64_t hash = 0;
+    for (int y = 1; y < height - 1; y++)
+    {
+        for (int x = 1; x < width - 1; x++)
+        {
+            if (getCell(x, y))
+            {
+                hash ^= getCellKey(x, y);
+            }
+        }
+    }
+    return hash;
+}
+
+/********************************************************************
+ *  Function:       void setStatsEnabled(bool enabled)
+ *  Description:    Enables or disables gathering births, deaths and
+ *                  the live extent while calculating each generation.
+ *                  Row backends keep one RowStats per row, which the
+ *                  kernel fills for the rows it calculates, so bands
+ *                  on different threads never share an entry.
+ *  Parameters:     enabled     Whether to gather statistics
+ *  Preconditions:  none
+ *  Postconditions: getStepStats describes each later generation
+ *******************************************************************/
+void Grid::setStatsEnabled(bool enabled)
+{
+    statsEnabled = enabled;
+    RowStats empty = { 0, 0, width, -1 };
+    rowStats.assign(enabled ? height : 0, empty);
+    stepStats = StepStats();
+}
+
+/********************************************************************
+ *  Function:       void setHashEnabled(bool enabled)
+ *  Description:    Enables or disables hashing the cells each kernel
+ *                  call changes. The hash of the last generation is
+ *                  cleared, since it no longer describes the grid.
+ *  Parameters:     enabled     Whether to gather the change hash
+ *  Preconditions:  none
+ *  Postconditions: getChangeHash describes each later generation
+ *******************************************************************/
+void Grid::setHashEnabled(bool enabled)
+{
+    hashEnabled = enabled;
+    pendingHash = 0;
+    changeHash = 0;
+}
+
+/********************************************************************
+ *  Function:       void sumRowStats()
+ *  Description:    Adds up the statistics the kernel left for each
+ *                  interior row. This visits one entry per row, not
+ *                  the cells, so it costs little next to a generation.
+ *  Parameters:     none
+ *  Preconditions:  Every interior row of rowStats is up to date
+ *  Postconditions: stepStats describes the last generation
+ *******************************************************************/
+void Grid::sumRowStats()
+{
+    // An empty row has left = width and right = -1, so it leaves the
+    // columns alone without a branch on whether it has live cells
+    StepStats sum = { 0, 0, width, height, -1, -1 };
+    for (int y = 1; y < height - 1; y++)
+    {
+        const RowStats &row = rowStats[y];
+        bool live = row.left <= row.right;
+        sum.births += row.births;
+        sum.deaths += row.deaths;
+        sum.left = std::min(sum.left, row.left);
+        sum.right = std::max(sum.right, row.right);
+        sum.top = std::min(sum.top, live ? y : height);
+        sum.bottom = live ? y : sum.bottom;
+    }
+    stepStats = sum;
+}
+
+/********************************************************************
+ *  Function:       bool hasPopcount()
+ *  Description:    Detects whether the CPU has the popcnt instruction.
+ *                  The build does not assume it, so kernels that count
+ *                  bits keep a copy compiled for it and use that copy
+ *                  when this is true. Detection runs once and the
+ *                  result is reused.
+ *  Parameters:     none
+ *  Preconditions:  none
+ *  Postconditions: Returns true if popcnt can be used
+ *******************************************************************/
+bool Grid::hasPopcount()
+{
+    #if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    static int supported = -1;
+    if (supported < 0)
+    {
+        __builtin_cpu_init();
+        supported = __builtin_cpu_supports("popcnt") ? 1 : 0;
+    }
+    return supported != 0;
+    #else
+    return false;
+    #endif
+}
+
+/********************************************************************
+ *  Function:       void getRowBits(int x, int y, int count,
+ *                                  uint64_t *words)
+ *  Description:    Copies cells x to x + count - 1 of row y into bits,
+ *                  cell x + i at bit i % 64 of word i / 64, one cell at
+ *                  a time. Backends override this to copy whole words.
+ *  Parameters:     x       X coordinate of the first cell
+ *                  y       Y coordinate of the row
+ *                  count   Number of cells to copy
+ *                  words   Receives (count + 63) / 64 words
+ *  Preconditions:  All cells of the run are on the grid
+ *  Postconditions: Bits past count in the last word are 0
+ *******************************************************************/
+void Grid::getRowBits(int x, int y, int count, uint64_t *words) const
+{
+    for (int w = 0; w < (count + 63) / 64; w++)
+    {
+        words[w] = 0;
+    }
+    for (int i = 0; i < count; i++)
+    {
+        if (getCell(x + i, y))
+        {
+            words[i >> 6] |= static_cast<uint64_t>(1) << (i & 63);
+        }
+    }
+}
+
+/********************************************************************
+ *  Function:       void setRowBits(int x, int y, int count,
+ *                                  const uint64_t *words)
+ *  Description:    Sets cells x to x + count - 1 of row y from bits in
+ *                  the layout of getRowBits, one cell at a time.
+ *  Parameters:     x       X coordinate of the first cell
+ *                  y       Y coordinate of the row
+ *                  count   Number of cells to set
+ *                  words   (count + 63) / 64 words of cells
+ *  Preconditions:  All cells of the run are on the grid
+ *  Postconditions: Each cell of the run is alive if its bit is set
+ *******************************************************************/
+void Grid::setRowBits(int x, int y, int count, const uint64_t *words)
+{
+    for (int i = 0; i < count; i++)
+    {
+        setCell(x + i, y, (words[i >> 6] >> (i & 63)) & 1);
+    }
+}
+
+/********************************************************************
+ *  Function:       void clear()
+ *  Description:    Kills every cell one at a time. Backends override
+ *                  this to clear whole buffers.
+ *  Parameters:     none
+ *  Preconditions:  none
+ *  Postconditions: No cells are alive
+ *******************************************************************/
+void Grid::clear()
+{
+    for (int y = 0; y < height; y++)
+    {
+        for (int x = 0; x < width; x++)
+        {
+            setCell(x, y, false);
+        }
+    }
+}
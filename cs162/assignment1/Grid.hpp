@@ -0,0 +1,499 @@
+/*************************************************************************
+ * Author:          David Rigert
+ * Date Created:    10/17/2026
+ * Last Modified:   10/17/2026
+ * Assignment:      Assignment 1
+ * Filename:        Grid.hpp
+ *
+ * Description:     Abstract base class for the cell storage backends used
+ *                  by the Simulation class. The grid includes the hidden
+ *                  buffer cells, and the outermost ring of cells is never
+ *                  evaluated. With a dead edge the ring is always dead
+ *                  after a generation; with a wrapping boundary the ring
+ *                  is a halo filled from the opposite edge of the interior
+ *                  before each generation, so the kernels never need to
+ *                  wrap coordinates themselves.
+ ************************************************************************/
+#ifndef GRID_HPP
+#define GRID_HPP
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+#include <stdint.h>
+#include "Rule.hpp"
+
+class Grid
+{
+public:
+    // How the interior of the grid is connected at its edges
+    enum Boundary
+    {
+        DEAD_EDGE,              // cells beyond the edge are always dead
+        TORUS,                  // opposite edges are joined
+        KLEIN_BOTTLE            // left and right joined, top and bottom
+                                // joined with a horizontal flip
+    };
+
+    // Changes and live extent of the interior after the last generation
+    struct StepStats
+    {
+        long long births;       // cells that came to life
+        long long deaths;       // cells that died
+        int left;               // first column with a live cell
+        int top;                // first row with a live cell
+        int right;              // last column, less than left if none
+        int bottom;             // last row, less than top if none
+    };
+
+    // Changes and live extent of one row, gathered by the kernel
+    struct RowStats
+    {
+        int births;             // cells of the row that came to life
+        int deaths;             // cells of the row that died
+        int left;               // first live column, or width if none
+        int right;              // last live column, or -1 if none
+    };
+
+// member variables
+protected:
+    int width;                  // width of grid including buffer cells
+    int height;                 // height of grid including buffer cells
+    Boundary boundary;          // topology of the interior
+    Rule rule;                  // birth and survival counts
+    bool statsEnabled;          // whether generations gather StepStats
+    std::vector<RowStats> rowStats; // statistics of each row, if enabled
+    StepStats stepStats;        // statistics of the last generation
+    bool hashEnabled;           // whether generations gather changeHash
+    std::atomic<uint64_t> pendingHash;  // keys of the cells changed so far
+                                        // by the generation being calculated
+    uint64_t changeHash;        // keys of the cells changed by the last
+                                // generation
+
+// member functions
+protected:
+    // Adds up the statistics of the interior rows into stepStats.
+    void sumRowStats();
+
+    // Detects whether the CPU has the popcnt instruction.
+    static bool hasPopcount();
+
+    /********************************************************************
+     *  Function:       void addChangeHash(uint64_t hash)
+     *  Description:    Adds the keys of cells changed by a kernel call.
+     *                  Bands and tiles are calculated in parallel, so
+     *                  each call gathers its own hash and adds it once.
+     *  Parameters:     hash    XOR of the keys of the changed cells
+     *  Preconditions:  none
+     *  Postconditions: hash is added to the generation being calculated
+     *******************************************************************/
+    void addChangeHash(uint64_t hash)
+    {
+        if (hash)
+        {
+            pendingHash.fetch_xor(hash, std::memory_order_relaxed);
+        }
+    }
+
+    /********************************************************************
+     *  Function:       void finishChangeHash()
+     *  Description:    Makes the keys added by the kernels the change
+     *                  hash of the generation and starts over.
+     *  Parameters:     none
+     *  Preconditions:  Every kernel call of the generation has returned
+     *  Postconditions: getChangeHash describes the generation
+     *******************************************************************/
+    void finishChangeHash()
+    {
+        changeHash = pendingHash.exchange(0, std::memory_order_relaxed);
+    }
+
+public:
+    /********************************************************************
+     *  Function:       Grid(int width, int height)
+     *  Description:    Sets the dimensions of the grid.
+     *  Parameters:     width   Width of the grid including buffer cells
+     *                  height  Height of the grid including buffer cells
+     *******************************************************************/
+    Grid(int width, int height)
+    {
+        this->width = width;
+        this->height = height;
+        boundary = DEAD_EDGE;
+        statsEnabled = false;
+        stepStats = StepStats();
+        hashEnabled = false;
+        pendingHash = 0;
+        changeHash = 0;
+    }
+
+    virtual ~Grid() {}
+
+    /********************************************************************
+     *  Function:       Boundary getBoundary()
+     *  Description:    Gets the topology of the grid.
+     *  Parameters:     none
+     *  Preconditions:  none
+     *  Postconditions: Returns the boundary mode
+     *******************************************************************/
+    Boundary getBoundary() const
+    {
+        return boundary;
+    }
+
+    // Sets the topology of the grid.
+    virtual void setBoundary(Boundary);
+
+    /********************************************************************
+     *  Function:       const Rule &getRule()
+     *  Description:    Gets the rule used to calculate generations.
+     *  Parameters:     none
+     *  Preconditions:  none
+     *  Postconditions: Returns the rule
+     *******************************************************************/
+    const Rule &getRule() const
+    {
+        return rule;
+    }
+
+    /********************************************************************
+     *  Function:       void setRule(const Rule &newRule)
+     *  Description:    Sets the rule used to calculate generations.
+     *                  Backends with kernels specialized for each rule
+     *                  select the kernel here.
+     *  Parameters:     newRule     Rule to use
+     *  Preconditions:  none
+     *  Postconditions: Later generations use newRule
+     *******************************************************************/
+    virtual void setRule(const Rule &newRule)
+    {
+        rule = newRule;
+    }
+
+    // Fills the outermost ring from the interior for wrapping boundaries.
+    virtual void exchangeHalo();
+
+    /********************************************************************
+     *  Function:       int getWidth()
+     *  Description:    Gets the width of the grid.
+     *  Parameters:     none
+     *  Preconditions:  none
+     *  Postconditions: Returns the width including buffer cells
+     *******************************************************************/
+    int getWidth() const
+    {
+        return width;
+    }
+
+    /********************************************************************
+     *  Function:       int getHeight()
+     *  Description:    Gets the height of the grid.
+     *  Parameters:     none
+     *  Preconditions:  none
+     *  Postconditions: Returns the height including buffer cells
+     *******************************************************************/
+    int getHeight() const
+    {
+        return height;
+    }
+
+    // Gets whether the cell at x,y is alive in the current generation.
+    virtual bool getCell(int, int) const = 0;
+
+    // Sets the state of the cell at x,y in the current generation.
+    virtual void setCell(int, int, bool) = 0;
+
+    /********************************************************************
+     *  Function:       int getState(int x, int y)
+     *  Description:    Gets the state of a cell under a rule with more
+     *                  than two states. Two-state backends only have
+     *                  states 0 and 1.
+     *  Parameters:     x   X coordinate of cell
+     *                  y   Y coordinate of cell
+     *  Preconditions:  x,y is on the grid
+     *  Postconditions: Returns 0 if the cell is dead
+     *******************************************************************/
+    virtual int getState(int x, int y) const
+    {
+        return getCell(x, y) ? 1 : 0;
+    }
+
+    /********************************************************************
+     *  Function:       void setState(int x, int y, int state)
+     *  Description:    Sets the state of a cell under a rule with more
+     *                  than two states.
+     *  Parameters:     x       X coordinate of cell
+     *                  y       Y coordinate of cell
+     *                  state   New state, less than the state count
+     *  Preconditions:  x,y is on the grid
+     *  Postconditions: Cell is set to state; throws invalid_argument
+     *                  if the rule has no such state
+     *******************************************************************/
+    virtual void setState(int x, int y, int state)
+    {
+        if (state < 0 || state >= rule.getStateCount())
+        {
+            throw std::invalid_argument("ERROR: State is not used by the rule.");
+        }
+        setCell(x, y, state != 0);
+    }
+
+    /********************************************************************
+     *  Function:       void fillRun(int x, int y, int count)
+     *  Description:    Sets a horizontal run of cells to alive. Pattern
+     *                  loaders write whole runs at once, so backends
+     *                  can set many cells per store.
+     *  Parameters:     x       X coordinate of the first cell
+     *                  y       Y coordinate of the run
+     *                  count   Number of cells in the run
+     *  Preconditions:  All cells of the run are on the grid
+     *  Postconditions: Cells x to x + count - 1 of row y are alive
+     *******************************************************************/
+    virtual void fillRun(int x, int y, int count)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            setCell(x + i, y, true);
+        }
+    }
+
+    /********************************************************************
+     *  Function:       uint64_t getCellKey(int x, int y)
+     *  Description:    Gets the Zobrist key of a cell. Instead of a table
+     *                  of random numbers, the coordinates are scrambled
+     *                  with the splitmix64 finalizer, so any cell of an
+     *                  unbounded plane has a key without using memory.
+     *  Parameters:     x   X coordinate of the cell
+     *                  y   Y coordinate of the cell
+     *  Preconditions:  none
+     *  Postconditions: Returns a pseudorandom 64-bit key
+     *******************************************************************/
+    static uint64_t getCellKey(int x, int y)
+    {
+        uint64_t z = (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32)
+                   | static_cast<uint32_t>(y);
+        z += 0x9e3779b97f4a7c15ULL;
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+    /********************************************************************
+     *  Function:       uint64_t getWordHash(uint64_t bits, int x, int y)
+     *  Description:    Gets the XOR of the keys of the set bits of a
+     *                  word, where bit n is the cell at x + n, y.
+     *  Parameters:     bits    Cells of a row, one per bit
+     *                  x       X coordinate of bit 0
+     *                  y       Y coordinate of the row
+     *  Preconditions:  none
+     *  Postconditions: Returns 0 if no bits are set
+     *******************************************************************/
+    static uint64_t getWordHash(uint64_t bits, int x, int y)
+    {
+        uint64_t hash = 0;
+        while (bits)
+        {
+            hash ^= getCellKey(x + __builtin_ctzll(bits), y);
+            bits &= bits - 1;
+        }
+        return hash;
+    }
+
+    // Gets the XOR of the keys of the live cells inside the outermost ring.
+    virtual uint64_t getHash() const;
+
+    // Enables or disables gathering the change hash while calculating.
+    virtual void setHashEnabled(bool);
+
+    /********************************************************************
+     *  Function:       bool isHashEnabled()
+     *  Description:    Gets whether generations gather the change hash.
+     *  Parameters:     none
+     *  Preconditions:  none
+     *  Postconditions: Returns true if getChangeHash is kept up to date
+     *******************************************************************/
+    bool isHashEnabled() const
+    {
+        return hashEnabled;
+    }
+
+    /********************************************************************
+     *  Function:       uint64_t getChangeHash()
+     *  Description:    Gets the XOR of the keys of the cells changed by
+     *                  the last generation. The kernels hash the cells
+     *                  they flip while calculating, so regions that were
+     *                  not calculated or did not change cost nothing.
+     *  Parameters:     none
+     *  Preconditions:  Hashing was enabled for the last generation
+     *  Postconditions: Returns the hash XORed into getHash by the
+     *                  last generation
+     *******************************************************************/
+    uint64_t getChangeHash() const
+    {
+        return changeHash;
+    }
+
+    // Kills every cell, including the outermost ring.
+    virtual void clear();
+
+    // Counts the live cells inside the outermost ring.
+    virtual long long getPopulation() const;
+
+    // Finds the smallest rectangle holding all live cells.
+    virtual bool getBounds(int &, int &, int &, int &) const;
+
+    // Enables or disables gathering statistics while calculating.
+    virtual void setStatsEnabled(bool);
+
+    /********************************************************************
+     *  Function:       bool isStatsEnabled()
+     *  Description:    Gets whether generations gather statistics.
+     *  Parameters:     none
+     *  Preconditions:  none
+     *  Postconditions: Returns true if getStepStats is kept up to date
+     *******************************************************************/
+    bool isStatsEnabled() const
+    {
+        return statsEnabled;
+    }
+
+    /********************************************************************
+     *  Function:       const StepStats &getStepStats()
+     *  Description:    Gets the births, deaths and live extent of the
+     *                  interior that the last generation gathered.
+     *  Parameters:     none
+     *  Preconditions:  Statistics were enabled for the last generation
+     *  Postconditions: Returns the statistics of the last generation
+     *******************************************************************/
+    const StepStats &getStepStats() const
+    {
+        return stepStats;
+    }
+
+    // Copies a horizontal run of cells into words of 64 cells each.
+    virtual void getRowBits(int, int, int, uint64_t *) const;
+
+    // Sets a horizontal run of cells from words of 64 cells each.
+    virtual void setRowBits(int, int, int, const uint64_t *);
+
+    /********************************************************************
+     *  Function:       bool isBounded()
+     *  Description:    Gets whether cells outside width x height exist.
+     *  Parameters:     none
+     *  Preconditions:  none
+     *  Postconditions: Returns true unless overridden
+     *******************************************************************/
+    virtual bool isBounded() const
+    {
+        return true;
+    }
+
+    /********************************************************************
+     *  Function:       void setSparse(bool enabled)
+     *  Description:    Enables or disables evaluating only the regions
+     *                  near cells that changed. Backends that do not
+     *                  track changes only accept false.
+     *  Parameters:     enabled     Whether to enable sparse mode
+     *  Preconditions:  none
+     *  Postconditions: Throws invalid_argument if not supported
+     *******************************************************************/
+    virtual void setSparse(bool enabled)
+    {
+        if (enabled)
+        {
+            throw std::invalid_argument("ERROR: Grid type does not support sparse mode.");
+        }
+    }
+
+    /********************************************************************
+     *  Function:       int getActiveTileCount()
+     *  Description:    Gets the number of tiles evaluated in the last
+     *                  generation in sparse mode.
+     *  Parameters:     none
+     *  Preconditions:  none
+     *  Postconditions: Returns -1 if sparse mode is not enabled
+     *******************************************************************/
+    virtual int getActiveTileCount() const
+    {
+        return -1;
+    }
+
+    /********************************************************************
+     *  Function:       bool supportsBands()
+     *  Description:    Gets whether computeRows can be called on
+     *                  separate bands of rows in parallel.
+     *  Parameters:     none
+     *  Preconditions:  none
+     *  Postconditions: Returns true unless overridden
+     *******************************************************************/
+    virtual bool supportsBands() const
+    {
+        return true;
+    }
+
+    // Calculates rows first to last - 1 of the next generation.
+    virtual void computeRows(int, int) = 0;
+
+    /********************************************************************
+     *  Function:       int getTileAlignment()
+     *  Description:    Gets the multiple of columns at which computeTile
+     *                  can split a row. Backends whose kernels calculate
+     *                  whole rows return 0.
+     *  Parameters:     none
+     *  Preconditions:  none
+     *  Postconditions: Returns 0 unless overridden
+     *******************************************************************/
+    virtual int getTileAlignment() const
+    {
+        return 0;
+    }
+
+    /********************************************************************
+     *  Function:       void computeTile(int top, int bottom, int left,
+     *                                   int right)
+     *  Description:    Calculates a rectangle of the next generation.
+     *                  Tiles that do not overlap can be calculated in
+     *                  parallel, like bands. Without tile alignment a
+     *                  tile spans whole rows, so this version only
+     *                  accepts whole rows and calculates them as a band.
+     *  Parameters:     top     First row to calculate, at least 1
+     *                  bottom  Row after the last row, at most height - 1
+     *                  left    First column, a multiple of the alignment
+     *                  right   Column after the last column, a multiple
+     *                          of the alignment or the width
+     *  Preconditions:  left is 0 and right is the width if unaligned
+     *  Postconditions: Cells of the tile in the next buffer are
+     *                  calculated; throws logic_error if the tile does
+     *                  not span whole rows
+     *******************************************************************/
+    virtual void computeTile(int top, int bottom, int left, int right)
+    {
+        if (left != 0 || right != width)
+        {
+            throw std::logic_error("ERROR: Grid cannot split rows into tiles.");
+        }
+        computeRows(top, bottom);
+    }
+
+    // Makes the calculated next generation the current generation.
+    virtual void swapBuffers() = 0;
+
+    /********************************************************************
+     *  Function:       void step()
+     *  Description:    Replaces the current generation with the next
+     *                  generation. Rows 0 and height - 1 are never
+     *                  evaluated, so once the halo is filled the other
+     *                  rows can be calculated in independent bands
+     *                  before swapBuffers is called.
+     *  Parameters:     none
+     *  Preconditions:  none
+     *  Postconditions: Current generation is advanced by one
+     *******************************************************************/
+    virtual void step()
+    {
+        exchangeHalo();
+        computeRows(1, height - 1);
+        swapBuffers();
+    }
+};
+#endif // end of define GRID_HPP
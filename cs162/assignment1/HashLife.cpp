@@ -0,0 +1,634 @@
+/*************************************************************************
+ * Author:          David Rigert
+ * Date Created:    10/17/2026
+ * Last Modified:   10/17/2026
+ * Assignment:      Assignment 1
+ * Filename:        HashLife.cpp
+ *
+ * Description:     Implementation of the HashLife class.
+ *                  A node of level n covers 2^n x 2^n cells. Its result
+ *                  is the center 2^(n-1) x 2^(n-1) cells advanced by
+ *                  2^min(stepLog, n - 2) generations, which depends only
+ *                  on the contents of the node. Because nodes are
+ *                  canonical, each result is calculated once.
+ *
+ *                  The full speed result, 2^(n - 2) generations, is the
+ *                  same for every step size, so it is kept until the
+ *                  rule changes. A slower result is kept for the last
+ *                  step size it was calculated with, so a jump that
+ *                  needs another step size only recalculates the nodes
+ *                  it visits.
+ *
+ *                  Nodes are never freed while a jump runs. Between
+ *                  jumps and edits, once the table holds more than
+ *                  gcThreshold nodes, the nodes reachable from the root
+ *                  and the empty nodes are marked, together with their
+ *                  results, and the rest go on a free list.
+ ************************************************************************/
+#include <stdexcept>
+#include "HashLife.hpp"
+#include "Pattern.hpp"
+
+// Node table size that triggers the first garbage collection
+static const size_t FIRST_GC_THRESHOLD = 1 << 20;
+
+// Highest level whose cell offsets fit in 63 bits. Once the root is
+// larger, each int64_t quadrant of the plane lies in a node of this
+// level at the inner corner of a root quadrant.
+static const int OFFSET_LEVEL = 63;
+
+/********************************************************************
+ *  Function:       size_t operator()(const NodeKey &key)
+ *  Description:    Mixes the four quadrant addresses into a hash.
+ *  Parameters:     key     Quadrants of the node
+ *  Preconditions:  none
+ *  Postconditions: Returns the hash value of key
+ *******************************************************************/
+size_t HashLife::NodeKeyHash::operator()(const NodeKey &key) const
+{
+    uint64_t h = reinterpret_cast<uintptr_t>(key.nw);
+    h = h * 0x9e3779b97f4a7c15ULL + reinterpret_cast<uintptr_t>(key.ne);
+    h = h * 0x9e3779b97f4a7c15ULL + reinterpret_cast<uintptr_t>(key.sw);
+    h = h * 0x9e3779b97f4a7c15ULL + reinterpret_cast<uintptr_t>(key.se);
+    return static_cast<size_t>(h ^ (h >> 29));
+}
+
+/********************************************************************
+ *  Function:       HashLife()
+ *  Description:    Creates the two level 0 cells and an empty root.
+ *******************************************************************/
+HashLife::HashLife()
+{
+    Node cell = { NULL, NULL, NULL, NULL, 0, 0, NULL, NULL, 0, false };
+    nodes.push_back(cell);
+    deadCell = &nodes.back();
+    cell.population = 1;
+    nodes.push_back(cell);
+    liveCell = &nodes.back();
+    
+    emptyNodes.push_back(deadCell);
+    stepLog = 0;
+    generationCount = 0;
+    gcThreshold = FIRST_GC_THRESHOLD;
+    root = empty(3);
+}
+
+/********************************************************************
+ *  Function:       Node *join(Node *nw, Node *ne, Node *sw, Node *se)
+ *  Description:    Finds or creates the canonical node made of the
+ *                  specified quadrants. New nodes reuse the storage of
+ *                  collected nodes first.
+ *  Parameters:     nw, ne, sw, se  Quadrants of the same level
+ *  Preconditions:  Quadrants are canonical nodes
+ *  Postconditions: Returns the only node with these quadrants
+ *******************************************************************/
+HashLife::Node *HashLife::join(Node *nw, Node *ne, Node *sw, Node *se)
+{
+    NodeKey key = { nw, ne, sw, se };
+    std::unordered_map<NodeKey, Node *, NodeKeyHash>::iterator it = table.find(key);
+    if (it != table.end())
+    {
+        return it->second;
+    }
+    
+    Node node = { nw, ne, sw, se, nw->level + 1,
+        nw->population + ne->population + sw->population + se->population,
+        NULL, NULL, 0, false };
+    Node *n = NULL;
+    if (freeNodes.empty())
+    {
+        nodes.push_back(node);
+        n = &nodes.back();
+    }
+    else
+    {
+        n = freeNodes.back();
+        freeNodes.pop_back();
+        *n = node;
+    }
+    table[key] = n;
+    return n;
+}
+
+/********************************************************************
+ *  Function:       Node *empty(int level)
+ *  Description:    Gets the node of the specified level with no live
+ *                  cells, creating the smaller empty nodes as needed.
+ *  Parameters:     level   Level of the node
+ *  Preconditions:  level >= 0
+ *  Postconditions: Returns the empty node of the level
+ *******************************************************************/
+HashLife::Node *HashLife::empty(int level)
+{
+    while (static_cast<int>(emptyNodes.size()) <= level)
+    {
+        Node *e = emptyNodes.back();
+        emptyNodes.push_back(join(e, e, e, e));
+    }
+    return emptyNodes[level];
+}
+
+/********************************************************************
+ *  Function:       Node *center(Node *n)
+ *  Description:    Gets the center half of a node without advancing.
+ *  Parameters:     n   Node to take the center of
+ *  Preconditions:  n->level >= 2
+ *  Postconditions: Returns a node one level below n
+ *******************************************************************/
+HashLife::Node *HashLife::center(Node *n)
+{
+    return join(n->nw->se, n->ne->sw, n->sw->ne, n->se->nw);
+}
+
+/********************************************************************
+ *  Function:       void expand()
+ *  Description:    Replaces the root with a node twice the size that
+ *                  has the old root in its center and empty cells
+ *                  around it.
+ *  Parameters:     none
+ *  Preconditions:  root->level >= 1
+ *  Postconditions: root->level is increased by 1
+ *******************************************************************/
+void HashLife::expand()
+{
+    Node *e = empty(root->level - 1);
+    root = join(join(e, e, e, root->nw), join(e, e, root->ne, e),
+                join(e, root->sw, e, e), join(root->se, e, e, e));
+}
+
+/********************************************************************
+ *  Function:       Node *levelTwoResult(Node *n)
+ *  Description:    Applies the rule to the 4 center cells of a 4x4
+ *                  node.
+ *  Parameters:     n   Level 2 node
+ *  Preconditions:  n->level == 2
+ *  Postconditions: Returns the level 1 center one generation later
+ *******************************************************************/
+HashLife::Node *HashLife::levelTwoResult(Node *n)
+{
+    int cells[4][4];    // cells of n by row and column
+    
+    for (int r = 0; r < 4; r++)
+    {
+        for (int c = 0; c < 4; c++)
+        {
+            Node *quad = r < 2 ? (c < 2 ? n->nw : n->ne) : (c < 2 ? n->sw : n->se);
+            Node *cell = (r & 1) ? ((c & 1) ? quad->se : quad->sw)
+                                 : ((c & 1) ? quad->ne : quad->nw);
+            cells[r][c] = static_cast<int>(cell->population);
+        }
+    }
+    
+    Node *next[4];      // next state of center cells nw, ne, sw, se
+    for (int i = 0; i < 4; i++)
+    {
+        int r = 1 + i / 2;
+        int c = 1 + i % 2;
+        int count = cells[r - 1][c - 1] + cells[r - 1][c] + cells[r - 1][c + 1]
+                  + cells[r][c - 1] + cells[r][c + 1]
+                  + cells[r + 1][c - 1] + cells[r + 1][c] + cells[r + 1][c + 1];
+        bool alive = rule.getNextState(cells[r][c] != 0, count);
+        next[i] = alive ? liveCell : deadCell;
+    }
+    return join(next[0], next[1], next[2], next[3]);
+}
+
+/********************************************************************
+ *  Function:       Node *result(Node *n)
+ *  Description:    Gets the center of n after 2^min(stepLog, level - 2)
+ *                  generations, calculating it only if it is not
+ *                  memoized for the current step size.
+ *  Parameters:     n   Node to advance
+ *  Preconditions:  n->level >= 2
+ *  Postconditions: Returns a node one level below n and memoizes it
+ *******************************************************************/
+HashLife::Node *HashLife::result(Node *n)
+{
+    // Full speed results hold for any step size, slower ones for one
+    bool fullSpeed = stepLog >= n->level - 2;
+    if (fullSpeed && n->result)
+    {
+        return n->result;
+    }
+    if (!fullSpeed && n->slowResult && n->slowLog == stepLog)
+    {
+        return n->slowResult;
+    }
+    
+    Node *r = NULL;
+    if (n->population == 0)
+    {
+        r = empty(n->level - 1);
+    }
+    else if (n->level == 2)
+    {
+        r = levelTwoResult(n);
+    }
+    else
+    {
+        r = advance(n, fullSpeed);
+    }
+    
+    if (fullSpeed)
+    {
+        n->result = r;
+    }
+    else
+    {
+        n->slowResult = r;
+        n->slowLog = stepLog;
+    }
+    return r;
+}
+
+/********************************************************************
+ *  Function:       Node *advance(Node *n, bool fullSpeed)
+ *  Description:    Calculates the center of n after 2^min(stepLog,
+ *                  level - 2) generations. The node is split into 9
+ *                  overlapping sub-squares; those are advanced (or
+ *                  just centered when stepping slower than full
+ *                  speed) and combined into 4 squares that are
+ *                  advanced again to form the result.
+ *  Parameters:     n           Node to advance
+ *                  fullSpeed   Whether stepLog >= n->level - 2
+ *  Preconditions:  n->level >= 3
+ *  Postconditions: Returns a node one level below n
+ *******************************************************************/
+HashLife::Node *HashLife::advance(Node *n, bool fullSpeed)
+{
+
+    // The nine overlapping sub-squares one level down
+    Node *n00 = n->nw;
+    Node *n01 = join(n->nw->ne, n->ne->nw, n->nw->se, n->ne->sw);
+    Node *n02 = n->ne;
+    Node *n10 = join(n->nw->sw, n->nw->se, n->sw->nw, n->sw->ne);
+    Node *n11 = center(n);
+    Node *n12 = join(n->ne->sw, n->ne->se, n->se->nw, n->se->ne);
+    Node *n20 = n->sw;
+    Node *n21 = join(n->sw->ne, n->se->nw, n->sw->se, n->se->sw);
+    Node *n22 = n->se;
+    
+    // Full speed advances both halves; slower speeds only the second
+    Node *r[9];
+    Node *subs[9] = { n00, n01, n02, n10, n11, n12, n20, n21, n22 };
+    for (int i = 0; i < 9; i++)
+    {
+        r[i] = fullSpeed ? result(subs[i]) : center(subs[i]);
+    }
+    
+    Node *nw = result(join(r[0], r[1], r[3], r[4]));
+    Node *ne = result(join(r[1], r[2], r[4], r[5]));
+    Node *sw = result(join(r[3], r[4], r[6], r[7]));
+    Node *se = result(join(r[4], r[5], r[7], r[8]));
+    return join(nw, ne, sw, se);
+}
+
+/********************************************************************
+ *  Function:       void setRule(const Rule &newRule)
+ *  Description:    Sets the rule and discards the results memoized for
+ *                  the old rule. Empty nodes are assumed to stay empty,
+ *                  so rules with B0 are not accepted.
+ *  Parameters:     newRule     Rule to use
+ *  Preconditions:  none
+ *  Postconditions: Later generations use newRule; throws
+ *                  invalid_argument if newRule contains B0
+ *******************************************************************/
+void HashLife::setRule(const Rule &newRule)
+{
+    if (newRule.hasBirthOnZero())
+    {
+        throw std::invalid_argument("ERROR: HashLife cannot use a rule with B0.");
+    }
+    if (newRule == rule)
+    {
+        return;
+    }
+    
+    for (std::deque<Node>::iterator it = nodes.begin(); it != nodes.end(); ++it)
+    {
+        it->result = NULL;
+        it->slowResult = NULL;
+    }
+    rule = newRule;
+}
+
+/********************************************************************
+ *  Function:       void mark(Node *n)
+ *  Description:    Marks a node as reachable along with its quadrants
+ *                  and memoized results, so the results stay valid.
+ *  Parameters:     n   Node to mark, or NULL
+ *  Preconditions:  none
+ *  Postconditions: n and everything it points to are marked
+ *******************************************************************/
+void HashLife::mark(Node *n)
+{
+    if (n == NULL || n->marked)
+    {
+        return;
+    }
+    
+    n->marked = true;
+    if (n->level > 0)
+    {
+        mark(n->nw);
+        mark(n->ne);
+        mark(n->sw);
+        mark(n->se);
+    }
+    mark(n->result);
+    mark(n->slowResult);
+}
+
+/********************************************************************
+ *  Function:       void collectGarbage()
+ *  Description:    Marks the nodes reachable from the root and the
+ *                  empty nodes, and removes the others from the table
+ *                  and puts their storage on the free list. If most
+ *                  nodes are still reachable, the threshold is doubled
+ *                  so that collections do not run every jump.
+ *  Parameters:     none
+ *  Preconditions:  No node pointers are held outside the members
+ *  Postconditions: Only reachable nodes are in the table
+ *******************************************************************/
+void HashLife::collectGarbage()
+{
+    mark(root);
+    mark(liveCell);
+    for (size_t i = 0; i < emptyNodes.size(); i++)
+    {
+        mark(emptyNodes[i]);
+    }
+    
+    for (std::deque<Node>::iterator it = nodes.begin(); it != nodes.end(); ++it)
+    {
+        if (it->level < 0)
+        {
+            continue;
+        }
+        if (it->marked)
+        {
+            it->marked = false;
+            continue;
+        }
+        NodeKey key = { it->nw, it->ne, it->sw, it->se };
+        table.erase(key);
+        it->level = -1;
+        freeNodes.push_back(&*it);
+    }
+    
+    if (table.size() > gcThreshold / 2)
+    {
+        gcThreshold *= 2;
+    }
+}
+
+/********************************************************************
+ *  Function:       Node *setCell(Node *n, uint64_t x, uint64_t y,
+ *                                bool alive)
+ *  Description:    Builds a copy of n with the cell at x,y changed.
+ *  Parameters:     n       Node to copy
+ *                  x       X coordinate relative to left edge of n
+ *                  y       Y coordinate relative to top edge of n
+ *                  alive   New state of the cell
+ *  Preconditions:  x,y is inside n
+ *  Postconditions: Returns the canonical node with the cell changed
+ *******************************************************************/
+HashLife::Node *HashLife::setCell(Node *n, uint64_t x, uint64_t y, bool alive)
+{
+    if (n->level == 0)
+    {
+        return alive ? liveCell : deadCell;
+    }
+    
+    uint64_t half = static_cast<uint64_t>(1) << (n->level - 1);
+    if (y < half)
+    {
+        if (x < half)
+        {
+            return join(setCell(n->nw, x, y, alive), n->ne, n->sw, n->se);
+        }
+        return join(n->nw, setCell(n->ne, x - half, y, alive), n->sw, n->se);
+    }
+    if (x < half)
+    {
+        return join(n->nw, n->ne, setCell(n->sw, x, y - half, alive), n->se);
+    }
+    return join(n->nw, n->ne, n->sw, setCell(n->se, x - half, y - half, alive));
+}
+
+/********************************************************************
+ *  Function:       Node *setInnerCell(Node *n, bool east, bool south,
+ *                                     uint64_t x, uint64_t y,
+ *                                     bool alive)
+ *  Description:    Builds a copy of a node above OFFSET_LEVEL with a
+ *                  cell changed in its quadrant toward the origin,
+ *                  descending through that corner to OFFSET_LEVEL.
+ *  Parameters:     n       Node to copy
+ *                  east    Whether the quadrant is on the east side
+ *                  south   Whether the quadrant is on the south side
+ *                  x       X coordinate relative to the node at
+ *                          OFFSET_LEVEL
+ *                  y       Y coordinate relative to the node at
+ *                          OFFSET_LEVEL
+ *                  alive   New state of the cell
+ *  Preconditions:  n->level > OFFSET_LEVEL, x,y < 2^OFFSET_LEVEL
+ *  Postconditions: Returns the canonical node with the cell changed
+ *******************************************************************/
+HashLife::Node *HashLife::setInnerCell(Node *n, bool east, bool south,
+                                       uint64_t x, uint64_t y, bool alive)
+{
+    Node *quads[4] = { n->nw, n->ne, n->sw, n->se };
+    Node *&quad = quads[(south ? 2 : 0) + (east ? 1 : 0)];
+    quad = quad->level > OFFSET_LEVEL ? setInnerCell(quad, east, south, x, y, alive)
+                                      : setCell(quad, x, y, alive);
+    return join(quads[0], quads[1], quads[2], quads[3]);
+}
+
+/********************************************************************
+ *  Function:       void setCell(int64_t x, int64_t y, bool alive)
+ *  Description:    Sets the state of the cell at x,y, growing the
+ *                  plane if the cell is outside the root. A root
+ *                  above OFFSET_LEVEL holds every int64_t coordinate,
+ *                  so the cell is found by the quadrant of its signs.
+ *  Parameters:     x       X coordinate of cell
+ *                  y       Y coordinate of cell
+ *                  alive   New state of the cell
+ *  Preconditions:  none
+ *  Postconditions: Cell at x,y is set to alive
+ *******************************************************************/
+void HashLife::setCell(int64_t x, int64_t y, bool alive)
+{
+    // The half side fits in int64_t up to OFFSET_LEVEL
+    while (root->level <= OFFSET_LEVEL)
+    {
+        int64_t half = static_cast<int64_t>(1) << (root->level - 1);
+        if (x >= -half && x < half && y >= -half && y < half)
+        {
+            break;
+        }
+        expand();
+    }
+    
+    if (root->level <= OFFSET_LEVEL)
+    {
+        uint64_t half = static_cast<uint64_t>(1) << (root->level - 1);
+        root = setCell(root, static_cast<uint64_t>(x) + half,
+                       static_cast<uint64_t>(y) + half, alive);
+    }
+    else
+    {
+        // Negative coordinates count from the far edge of their node
+        bool east = x >= 0;
+        bool south = y >= 0;
+        uint64_t top = static_cast<uint64_t>(1) << OFFSET_LEVEL;
+        uint64_t nx = static_cast<uint64_t>(x) + (east ? 0 : top);
+        uint64_t ny = static_cast<uint64_t>(y) + (south ? 0 : top);
+        Node *quads[4] = { root->nw, root->ne, root->sw, root->se };
+        Node *&quad = quads[(south ? 2 : 0) + (east ? 1 : 0)];
+        quad = quad->level > OFFSET_LEVEL ? setInnerCell(quad, !east, !south, nx, ny, alive)
+                                          : setCell(quad, nx, ny, alive);
+        root = join(quads[0], quads[1], quads[2], quads[3]);
+    }
+    
+    // Each edit leaves the old path from the root behind
+    if (table.size() > gcThreshold)
+    {
+        collectGarbage();
+    }
+}
+
+/********************************************************************
+ *  Function:       bool getCell(int64_t x, int64_t y)
+ *  Description:    Gets whether the cell at x,y is alive. Offsets are
+ *                  kept in uint64_t, and a root above OFFSET_LEVEL is
+ *                  first descended to the node at OFFSET_LEVEL that
+ *                  holds the quadrant of the signs of x,y.
+ *  Parameters:     x   X coordinate of cell
+ *                  y   Y coordinate of cell
+ *  Preconditions:  none
+ *  Postconditions: Returns true if the cell is alive
+ *******************************************************************/
+bool HashLife::getCell(int64_t x, int64_t y) const
+{
+    const Node *n = root;
+    uint64_t nx;
+    uint64_t ny;
+    if (n->level <= OFFSET_LEVEL)
+    {
+        int64_t half = static_cast<int64_t>(1) << (n->level - 1);
+        if (x < -half || x >= half || y < -half || y >= half)
+        {
+            return false;
+        }
+        nx = static_cast<uint64_t>(x) + half;
+        ny = static_cast<uint64_t>(y) + half;
+    }
+    else
+    {
+        bool east = x >= 0;
+        bool south = y >= 0;
+        n = south ? (east ? n->se : n->sw) : (east ? n->ne : n->nw);
+        while (n->level > OFFSET_LEVEL && n->population > 0)
+        {
+            n = south ? (east ? n->nw : n->ne) : (east ? n->sw : n->se);
+        }
+        uint64_t top = static_cast<uint64_t>(1) << OFFSET_LEVEL;
+        nx = static_cast<uint64_t>(x) + (east ? 0 : top);
+        ny = static_cast<uint64_t>(y) + (south ? 0 : top);
+    }
+    
+    // Descend toward the cell, stopping early in empty regions
+    while (n->level > 0 && n->population > 0)
+    {
+        uint64_t half = static_cast<uint64_t>(1) << (n->level - 1);
+        if (ny < half)
+        {
+            n = nx < half ? n->nw : n->ne;
+        }
+        else
+        {
+            n = nx < half ? n->sw : n->se;
+            ny -= half;
+        }
+        if (nx >= half)
+        {
+            nx -= half;
+        }
+    }
+    return n->population > 0;
+}
+
+/********************************************************************
+ *  Function:       void addPattern(const Pattern &p, int64_t x, int64_t y)
+ *  Description:    Adds a pattern to the plane with the top-left
+ *                  corner at the specified x, y coordinates.
+ *  Parameters:     p   Pattern to add
+ *                  x   X coordinate of top-left corner of pattern
+ *                  y   Y coordinate of top-left corner of pattern
+ *  Preconditions:  none
+ *  Postconditions: Specified pattern is on the plane
+ *******************************************************************/
+void HashLife::addPattern(const Pattern &p, int64_t x, int64_t y)
+{
+    for (int i = 0; i < p.getHeight(); i++)
+    {
+        for (int j = 0; j < p.getWidth(); j++)
+        {
+            setCell(x + j, y + i, p.getCellState(j, i));
+        }
+    }
+}
+
+/********************************************************************
+ *  Function:       void advanceGeneration()
+ *  Description:    Makes the simulation transition to the next
+ *                  generation.
+ *  Parameters:     none
+ *  Preconditions:  none
+ *  Postconditions: Generation count is incremented by 1
+ *******************************************************************/
+void HashLife::advanceGeneration()
+{
+    advanceBy(1);
+}
+
+/********************************************************************
+ *  Function:       void advanceBy(uint64_t generations)
+ *  Description:    Advances the simulation by jumping 2^k generations
+ *                  for each bit k set in the number of generations.
+ *                  Before each jump the root is expanded until the
+ *                  pattern fits in its center quarter and the jump is
+ *                  at most 1/8 of its size, so no cell can reach the
+ *                  edge of the result even at the speed of light.
+ *                  Unreachable nodes are collected between jumps.
+ *  Parameters:     generations     Number of generations to advance
+ *  Preconditions:  none
+ *  Postconditions: Generation count is incremented by generations
+ *******************************************************************/
+void HashLife::advanceBy(uint64_t generations)
+{
+    for (int k = 0; k < 64 && (generations >> k) != 0; k++)
+    {
+        if (((generations >> k) & 1) == 0)
+        {
+            continue;
+        }
+        
+        if (table.size() > gcThreshold)
+        {
+            collectGarbage();
+        }
+        
+        stepLog = k;
+        while (root->level < k + 3
+            || root->population != root->nw->se->se->population
+                                  + root->ne->sw->sw->population
+                                  + root->sw->ne->ne->population
+                                  + root->se->nw->nw->population)
+        {
+            expand();
+        }
+        root = result(root);
+        generationCount += static_cast<uint64_t>(1) << k;
+    }
+}
@@ -0,0 +1,188 @@
+/*************************************************************************
+ * Author:          David Rigert
+ * Date Created:    10/17/2026
+ * Last Modified:   10/17/2026
+ * Assignment:      Assignment 1
+ * Filename:        HashLife.hpp
+ *
+ * Description:     Represents a Life-like simulator on an unbounded
+ *                  plane using the HashLife algorithm. The plane is a
+ *                  quadtree of canonical macrocells, so identical regions
+ *                  are stored once and the future of each region is
+ *                  calculated once, allowing jumps of 2^k generations.
+ *                  Nodes no longer reachable from the plane are freed
+ *                  once the node table grows past a threshold.
+ ************************************************************************/
+#ifndef HASHLIFE_HPP
+#define HASHLIFE_HPP
+
+#include <deque>
+#include <vector>
+#include <unordered_map>
+#include <stdint.h>
+#include "Rule.hpp"
+
+// forward declaration
+class Pattern;
+
+class HashLife
+{
+    friend class UnitTest;      // for unit testing
+private:
+    // A square of 2^level cells on each side made of four quadrants
+    struct Node
+    {
+        Node *nw;               // north-west quadrant (NULL at level 0)
+        Node *ne;               // north-east quadrant
+        Node *sw;               // south-west quadrant
+        Node *se;               // south-east quadrant
+        int level;              // log2 of the side length, -1 if free
+        uint64_t population;    // number of live cells
+        Node *result;           // center after 2^(level - 2) gens, or NULL
+        Node *slowResult;       // center after 2^slowLog gens, or NULL
+        int slowLog;            // step of slowResult, less than level - 2
+        bool marked;            // reachable, during garbage collection
+    };
+
+    // Identifies a node by its four canonical quadrants
+    struct NodeKey
+    {
+        Node *nw, *ne, *sw, *se;
+        bool operator==(const NodeKey &other) const
+        {
+            return nw == other.nw && ne == other.ne
+                && sw == other.sw && se == other.se;
+        }
+    };
+
+    // Combines the quadrant addresses into a hash value
+    struct NodeKeyHash
+    {
+        size_t operator()(const NodeKey &key) const;
+    };
+
+// member variables
+private:
+    std::deque<Node> nodes;     // storage for every node, live or free
+    std::vector<Node *> freeNodes;  // storage of collected nodes to reuse
+    std::unordered_map<NodeKey, Node *, NodeKeyHash> table; // canonical nodes
+    size_t gcThreshold;         // table size that triggers a collection
+    std::vector<Node *> emptyNodes; // empty node of each level
+    Node *deadCell;             // level 0 dead cell
+    Node *liveCell;             // level 0 live cell
+    Node *root;                 // whole plane, centered on 0,0
+    int stepLog;                // result advances 2^stepLog gens at most
+    Rule rule;                  // birth and survival counts
+    uint64_t generationCount;   // number of generations that have passed
+
+// member functions
+private:
+    // HashLife shares nodes between members, so copying is not allowed
+    HashLife(const HashLife &);
+    HashLife &operator=(const HashLife &);
+
+    // Returns the center quadrant of a node one level down.
+    Node *center(Node *);
+
+    // Frees the nodes not reachable from the root or the empty nodes.
+    void collectGarbage();
+
+    // Returns the empty node of the specified level.
+    Node *empty(int);
+
+    // Grows the root by one level keeping its contents centered.
+    void expand();
+
+    // Returns the canonical node with the specified quadrants.
+    Node *join(Node *, Node *, Node *, Node *);
+
+    // Returns the center of a level 2 node advanced by one generation.
+    Node *levelTwoResult(Node *);
+
+    // Calculates the center of a node advanced by 2^min(stepLog, level - 2).
+    Node *advance(Node *, bool);
+
+    // Returns the center of a node advanced by 2^min(stepLog, level - 2).
+    Node *result(Node *);
+
+    // Marks a node, its quadrants and its results as reachable.
+    void mark(Node *);
+
+    // Returns a copy of a node with one cell changed.
+    Node *setCell(Node *, uint64_t, uint64_t, bool);
+
+    // Returns a copy of a node above OFFSET_LEVEL with one cell changed
+    // in its quadrant toward the origin.
+    Node *setInnerCell(Node *, bool, bool, uint64_t, uint64_t, bool);
+
+public:
+    // Instantiates an empty plane.
+    HashLife();
+
+    /********************************************************************
+     *  Function:       const Rule &getRule()
+     *  Description:    Gets the rule used to calculate generations.
+     *  Parameters:     none
+     *  Preconditions:  none
+     *  Postconditions: Returns the rule
+     *******************************************************************/
+    const Rule &getRule() const
+    {
+        return rule;
+    }
+
+    // Sets the rule used to calculate generations.
+    void setRule(const Rule &);
+
+    // Adds a pattern with its top-left corner at x,y.
+    void addPattern(const Pattern &, int64_t, int64_t);
+
+    // Advances the simulation to the next generation.
+    void advanceGeneration();
+
+    // Advances the simulation by the specified number of generations.
+    void advanceBy(uint64_t);
+
+    // Gets whether the cell at x,y is alive.
+    bool getCell(int64_t, int64_t) const;
+
+    /********************************************************************
+     *  Function:       uint64_t getGenerationCount()
+     *  Description:    Gets the number of generations that have passed.
+     *  Parameters:     none
+     *  Preconditions:  none
+     *  Postconditions: Returns the generation count
+     *******************************************************************/
+    uint64_t getGenerationCount() const
+    {
+        return generationCount;
+    }
+
+    /********************************************************************
+     *  Function:       size_t getNodeCount()
+     *  Description:    Gets the number of distinct macrocells stored.
+     *  Parameters:     none
+     *  Preconditions:  none
+     *  Postconditions: Returns the number of live nodes
+     *******************************************************************/
+    size_t getNodeCount() const
+    {
+        return nodes.size() - freeNodes.size();
+    }
+
+    /********************************************************************
+     *  Function:       uint64_t getPopulation()
+     *  Description:    Gets the number of live cells on the plane.
+     *  Parameters:     none
+     *  Preconditions:  none
+     *  Postconditions: Returns the population of the root node
+     *******************************************************************/
+    uint64_t getPopulation() const
+    {
+        return root->population;
+    }
+
+    // Sets the state of the cell at x,y.
+    void setCell(int64_t, int64_t, bool);
+};
+#endif // end of define HASHLIFE_HPP
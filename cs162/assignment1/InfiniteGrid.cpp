@@ -0,0 +1,708 @@
+/*************************************************************************
+ * Author:          David Rigert
+ * Date Created:    10/17/2026
+ * Last Modified:   10/17/2026
+ * Assignment:      Assignment 1
+ * Filename:        InfiniteGrid.cpp
+ *
+ * Description:     Implementation of the InfiniteGrid class.
+ *                  Cells outside the allocated tiles are dead. Before
+ *                  each generation every non-empty tile gets all 8
+ *                  neighbors allocated, so births just outside the
+ *                  live region have a tile to land in.
+ ************************************************************************/
+#include <cstring>
+#include <algorithm>
+#include <climits>
+#include <stdexcept>
+#include "InfiniteGrid.hpp"
+#include "LifeWord.hpp"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define INFINITEGRID_X86
+#endif
+
+/********************************************************************
+ *  Function:       InfiniteGrid(int width, int height)
+ *  Description:    Creates an empty plane.
+ *  Parameters:     width   Width of the visible window
+ *                  height  Height of the visible window
+ *******************************************************************/
+InfiniteGrid::InfiniteGrid(int width, int height) : Grid(width, height)
+{
+    currentIndex = 0;
+    lastActiveCount = 0;
+    computeTile = &InfiniteGrid::computeRuleTile<Rule::CONWAY_BIRTH, Rule::CONWAY_SURVIVAL, false, false>;
+    countTileStats = &InfiniteGrid::countTileChanges;
+    #if defined(INFINITEGRID_X86)
+    if (hasPopcount())
+    {
+        countTileStats = &InfiniteGrid::countPopcountChanges;
+    }
+    #endif
+}
+
+/********************************************************************
+ *  Function:       ~InfiniteGrid()
+ *  Description:    Frees the allocated and released tiles.
+ *******************************************************************/
+InfiniteGrid::~InfiniteGrid()
+{
+    std::unordered_map<uint64_t, Tile *>::iterator it;
+    for (it = tiles.begin(); it != tiles.end(); ++it)
+    {
+        delete it->second;
+    }
+    for (unsigned i = 0; i < freeTiles.size(); i++)
+    {
+        delete freeTiles[i];
+    }
+}
+
+/********************************************************************
+ *  Function:       Tile *findTile(int tx, int ty)
+ *  Description:    Looks up an allocated tile.
+ *  Parameters:     tx  Tile column
+ *                  ty  Tile row
+ *  Preconditions:  none
+ *  Postconditions: Returns the tile or NULL if it is not allocated
+ *******************************************************************/
+InfiniteGrid::Tile *InfiniteGrid::findTile(int tx, int ty) const
+{
+    std::unordered_map<uint64_t, Tile *>::const_iterator it = tiles.find(makeKey(tx, ty));
+    return it == tiles.end() ? NULL : it->second;
+}
+
+/********************************************************************
+ *  Function:       Tile *getTile(int tx, int ty)
+ *  Description:    Looks up a tile and allocates an empty one if it
+ *                  does not exist, reusing a released tile if possible.
+ *  Parameters:     tx  Tile column
+ *                  ty  Tile row
+ *  Preconditions:  none
+ *  Postconditions: Returns the tile at tx,ty
+ *******************************************************************/
+InfiniteGrid::Tile *InfiniteGrid::getTile(int tx, int ty)
+{
+    Tile *&tile = tiles[makeKey(tx, ty)];
+    if (!tile)
+    {
+        if (freeTiles.empty())
+        {
+            tile = new Tile;
+        }
+        else
+        {
+            tile = freeTiles.back();
+            freeTiles.pop_back();
+        }
+        std::memset(tile->rows, 0, sizeof(tile->rows));
+    }
+    return tile;
+}
+
+/********************************************************************
+ *  Function:       bool isEmpty(const Tile *tile)
+ *  Description:    Checks a tile for live cells.
+ *  Parameters:     tile    Tile to check or NULL
+ *  Preconditions:  none
+ *  Postconditions: Returns true if tile is NULL or has no live cells
+ *******************************************************************/
+bool InfiniteGrid::isEmpty(const Tile *tile) const
+{
+    if (!tile)
+    {
+        return true;
+    }
+    for (int y = 0; y < TILE_SIZE; y++)
+    {
+        if (tile->rows[currentIndex][y])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/********************************************************************
+ *  Function:       bool getCell(int x, int y)
+ *  Description:    Gets whether the specified cell is alive.
+ *  Parameters:     x   X coordinate of cell
+ *                  y   Y coordinate of cell
+ *  Preconditions:  none
+ *  Postconditions: Returns true if the cell is alive
+ *******************************************************************/
+bool InfiniteGrid::getCell(int x, int y) const
+{
+    int tx = tileCoord(x);
+    int ty = tileCoord(y);
+    const Tile *tile = findTile(tx, ty);
+    if (!tile)
+    {
+        return false;
+    }
+    return (tile->rows[currentIndex][y - ty * TILE_SIZE] >> (x - tx * TILE_SIZE)) & 1;
+}
+
+/********************************************************************
+ *  Function:       void setCell(int x, int y, bool alive)
+ *  Description:    Sets the state of the specified cell, allocating
+ *                  its tile if needed.
+ *  Parameters:     x       X coordinate of cell
+ *                  y       Y coordinate of cell
+ *                  alive   New state of the cell
+ *  Preconditions:  none
+ *  Postconditions: Cell at x,y is set to alive
+ *******************************************************************/
+void InfiniteGrid::setCell(int x, int y, bool alive)
+{
+    int tx = tileCoord(x);
+    int ty = tileCoord(y);
+    Tile *tile = alive ? getTile(tx, ty) : findTile(tx, ty);
+    if (!tile)
+    {
+        return;     // already dead
+    }
+    
+    uint64_t bit = static_cast<uint64_t>(1) << (x - tx * TILE_SIZE);
+    uint64_t &word = tile->rows[currentIndex][y - ty * TILE_SIZE];
+    if (alive)
+    {
+        word |= bit;
+    }
+    else
+    {
+        word &= ~bit;
+    }
+}
+
+/********************************************************************
+ *  Function:       void fillRun(int x, int y, int count)
+ *  Description:    Sets a horizontal run of cells to alive, looking
+ *                  up each tile once and masking its row word.
+ *  Parameters:     x       X coordinate of the first cell
+ *                  y       Y coordinate of the run
+ *                  count   Number of cells in the run
+ *  Preconditions:  none
+ *  Postconditions: Cells x to x + count - 1 of row y are alive
+ *******************************************************************/
+void InfiniteGrid::fillRun(int x, int y, int count)
+{
+    int ty = tileCoord(y);
+    int row = y - ty * TILE_SIZE;
+    int end = x + count;
+    while (x < end)
+    {
+        int tx = tileCoord(x);
+        int first = x - tx * TILE_SIZE;
+        int bits = std::min(end - x, TILE_SIZE - first);
+        uint64_t mask = bits == 64 ? ~static_cast<uint64_t>(0)
+                                   : ((static_cast<uint64_t>(1) << bits) - 1) << first;
+        getTile(tx, ty)->rows[currentIndex][row] |= mask;
+        x += bits;
+    }
+}
+
+/********************************************************************
+ *  Function:       uint64_t getHash()
+ *  Description:    Calculates the Zobrist hash of every live cell of
+ *                  the plane, only visiting the live bits of each row.
+ *  Parameters:     none
+ *  Preconditions:  none
+ *  Postconditions: Returns the hash, 0 if no cells are alive
+ *******************************************************************/
+uint64_t InfiniteGrid::getHash() const
+{
+    uint64_t hash = 0;
+    for (std::unordered_map<uint64_t, Tile *>::const_iterator it = tiles.begin();
+         it != tiles.end(); ++it)
+    {
+        int x0 = static_cast<int32_t>(it->first >> 32) * TILE_SIZE;
+        int y0 = static_cast<int32_t>(it->first & 0xffffffff) * TILE_SIZE;
+        for (int y = 0; y < TILE_SIZE; y++)
+        {
+            hash ^= getWordHash(it->second->rows[currentIndex][y], x0, y0 + y);
+        }
+    }
+    return hash;
+}
+
+/********************************************************************
+ *  Function:       long long getPopulation()
+ *  Description:    Counts the live cells with countPopulation, using
+ *                  its popcnt copy when the CPU has the instruction.
+ *  Parameters:     none
+ *  Preconditions:  none
+ *  Postconditions: Returns the number of live cells
+ *******************************************************************/
+long long InfiniteGrid::getPopulation() const
+{
+    #if defined(INFINITEGRID_X86)
+    if (hasPopcount())
+    {
+        return countPopcountPopulation();
+    }
+    #endif
+    return countPopulation();
+}
+
+/********************************************************************
+ *  Function:       long long countPopulation()
+ *  Description:    Counts the live cells of every tile with one
+ *                  population count per tile row. The plane has no
+ *                  outer ring, so every cell counts.
+ *  Parameters:     none
+ *  Preconditions:  none
+ *  Postconditions: Returns the number of live cells
+ *******************************************************************/
+long long InfiniteGrid::countPopulation() const
+{
+    long long count = 0;
+    for (std::unordered_map<uint64_t, Tile *>::const_iterator it = tiles.begin();
+         it != tiles.end(); ++it)
+    {
+        const uint64_t *rows = it->second->rows[currentIndex];
+        for (int y = 0; y < TILE_SIZE; y++)
+        {
+            count += __builtin_popcountll(rows[y]);
+        }
+    }
+    return count;
+}
+
+/********************************************************************
+ *  Function:       long long countPopcountPopulation()
+ *  Description:    Counts the live cells like countPopulation, which
+ *                  is inlined here so its bit counts compile to the
+ *                  popcnt instruction instead of a library call.
+ *  Parameters:     none
+ *  Preconditions:  CPU supports popcnt
+ *  Postconditions: Returns the number of live cells
+ *******************************************************************/
+#if defined(INFINITEGRID_X86)
+__attribute__((target("popcnt"), flatten))
+long long InfiniteGrid::countPopcountPopulation() const
+{
+    return countPopulation();
+}
+#endif
+
+/********************************************************************
+ *  Function:       bool getBounds(int &left, int &top, int &right,
+ *                                 int &bottom)
+ *  Description:    Finds the live cells furthest in each direction.
+ *                  The columns of a tile come from the lowest and
+ *                  highest bits of all its rows combined.
+ *  Parameters:     left    Receives the X coordinate of the first column
+ *                  top     Receives the Y coordinate of the first row
+ *                  right   Receives the X coordinate of the last column
+ *                  bottom  Receives the Y coordinate of the last row
+ *  Preconditions:  none
+ *  Postconditions: Returns false and leaves the arguments unchanged
+ *                  if there are no live cells
+ *******************************************************************/
+bool InfiniteGrid::getBounds(int &left, int &top, int &right, int &bottom) const
+{
+    bool found = false;
+    for (std::unordered_map<uint64_t, Tile *>::const_iterator it = tiles.begin();
+         it != tiles.end(); ++it)
+    {
+        const uint64_t *rows = it->second->rows[currentIndex];
+        uint64_t columns = 0;
+        int first = -1;
+        int last = -1;
+        for (int y = 0; y < TILE_SIZE; y++)
+        {
+            if (rows[y])
+            {
+                columns |= rows[y];
+                first = first < 0 ? y : first;
+                last = y;
+            }
+        }
+        if (!columns)
+        {
+            continue;
+        }
+    
+        int x0 = static_cast<int32_t>(it->first >> 32) * TILE_SIZE;
+        int y0 = static_cast<int32_t>(it->first & 0xffffffff) * TILE_SIZE;
+        int tileLeft = x0 + __builtin_ctzll(columns);
+        int tileRight = x0 + 63 - __builtin_clzll(columns);
+        if (!found)
+        {
+            left = tileLeft;
+            right = tileRight;
+            top = y0 + first;
+            bottom = y0 + last;
+            found = true;
+        }
+        left = std::min(left, tileLeft);
+        right = std::max(right, tileRight);
+        top = std::min(top, y0 + first);
+        bottom = std::max(bottom, y0 + last);
+    }
+    return found;
+}
+
+/********************************************************************
+ *  Function:       void setRule(const Rule &newRule)
+ *  Description:    Sets the rule and selects the tile kernel. Rules
+ *                  with B0 would bring the whole plane to life, so
+ *                  they are not accepted.
+ *  Parameters:     newRule     Rule to use
+ *  Preconditions:  none
+ *  Postconditions: Later generations use newRule; throws
+ *                  invalid_argument if newRule contains B0
+ *******************************************************************/
+void InfiniteGrid::setRule(const Rule &newRule)
+{
+    if (newRule.hasBirthOnZero())
+    {
+        throw std::invalid_argument("ERROR: An infinite plane cannot use a rule with B0.");
+    }
+    
+    rule = newRule;
+    updateKernel();
+}
+
+/********************************************************************
+ *  Function:       void updateKernel()
+ *  Description:    Selects the tile kernel for the rule with or
+ *                  without statistics and hashing, so a kernel only
+ *                  does the work that is enabled.
+ *  Parameters:     none
+ *  Preconditions:  none
+ *  Postconditions: computeTile matches the rule and enabled features
+ *******************************************************************/
+void InfiniteGrid::updateKernel()
+{
+    if (statsEnabled && hashEnabled)
+    {
+        selectKernel<true, true>();
+    }
+    else if (statsEnabled)
+    {
+        selectKernel<true, false>();
+    }
+    else if (hashEnabled)
+    {
+        selectKernel<false, true>();
+    }
+    else
+    {
+        selectKernel<false, false>();
+    }
+}
+
+/********************************************************************
+ *  Function:       void selectKernel<STATS, HASH>()
+ *  Description:    Selects the tile kernel for the rule. Common rules
+ *                  have kernels specialized at compile time; other
+ *                  rules read the masks from the rule member.
+ *  Parameters:     none
+ *  Preconditions:  none
+ *  Postconditions: computeTile calculates the rule, counting changes
+ *                  if STATS and hashing them if HASH
+ *******************************************************************/
+template <bool STATS, bool HASH>
+void InfiniteGrid::selectKernel()
+{
+    unsigned birth = rule.getBirth();
+    unsigned survival = rule.getSurvival();
+    
+    if (birth == Rule::CONWAY_BIRTH && survival == Rule::CONWAY_SURVIVAL)
+    {
+        computeTile = &InfiniteGrid::computeRuleTile<Rule::CONWAY_BIRTH, Rule::CONWAY_SURVIVAL, STATS, HASH>;
+    }
+    else if (birth == Rule::HIGHLIFE_BIRTH && survival == Rule::HIGHLIFE_SURVIVAL)
+    {
+        computeTile = &InfiniteGrid::computeRuleTile<Rule::HIGHLIFE_BIRTH, Rule::HIGHLIFE_SURVIVAL, STATS, HASH>;
+    }
+    else if (birth == Rule::DAY_NIGHT_BIRTH && survival == Rule::DAY_NIGHT_SURVIVAL)
+    {
+        computeTile = &InfiniteGrid::computeRuleTile<Rule::DAY_NIGHT_BIRTH, Rule::DAY_NIGHT_SURVIVAL, STATS, HASH>;
+    }
+    else
+    {
+        computeTile = &InfiniteGrid::computeRuleTile<RUNTIME_RULE, RUNTIME_RULE, STATS, HASH>;
+    }
+}
+
+/********************************************************************
+ *  Function:       void setStatsEnabled(bool enabled)
+ *  Description:    Enables or disables statistics. The tile kernel
+ *                  counts the changes of each tile with live cells
+ *                  it calculates, so no rows are kept; the kernel
+ *                  without statistics is selected when disabled.
+ *  Parameters:     enabled     Whether to gather statistics
+ *  Preconditions:  none
+ *  Postconditions: getStepStats describes each later generation
+ *******************************************************************/
+void InfiniteGrid::setStatsEnabled(bool enabled)
+{
+    statsEnabled = enabled;
+    stepStats = StepStats();
+    updateKernel();
+}
+
+/********************************************************************
+ *  Function:       void setHashEnabled(bool enabled)
+ *  Description:    Enables or disables the change hash. The tile
+ *                  kernel hashes the bits of each row that differ
+ *                  from the current row, including the cells that die
+ *                  in tiles released afterwards.
+ *  Parameters:     enabled     Whether to gather the change hash
+ *  Preconditions:  none
+ *  Postconditions: getChangeHash describes each later generation
+ *******************************************************************/
+void InfiniteGrid::setHashEnabled(bool enabled)
+{
+    Grid::setHashEnabled(enabled);
+    updateKernel();
+}
+
+/********************************************************************
+ *  Function:       void computeRuleTile<BIRTH, SURVIVAL, STATS, HASH>(
+ *                      Tile *tile, int tx, int ty)
+ *  Description:    Calculates the next generation of a tile, taking
+ *                  the rows and carry bits at its edges from the 8
+ *                  neighboring tiles. With STATS, the births, deaths
+ *                  and live extent of the tile are added to stepStats;
+ *                  the empty tiles around the live ones only note
+ *                  that they stayed empty.
+ *                  With HASH, the keys of the bits that flipped are
+ *                  added to the change hash.
+ *  Parameters:     tile    Tile to calculate
+ *                  tx      Tile column
+ *                  ty      Tile row
+ *  Preconditions:  none
+ *  Postconditions: Next generation of tile is calculated
+ *******************************************************************/
+template <unsigned BIRTH, unsigned SURVIVAL, bool STATS, bool HASH>
+void InfiniteGrid::computeRuleTile(Tile *tile, int tx, int ty)
+{
+    static const uint64_t EMPTY[TILE_SIZE] = { 0 };
+    const int cur = currentIndex;
+    const unsigned birth = BIRTH == RUNTIME_RULE ? rule.getBirth() : BIRTH;
+    const unsigned survival = SURVIVAL == RUNTIME_RULE ? rule.getSurvival() : SURVIVAL;
+    
+    // Current rows of the tile and its neighbors (EMPTY if missing)
+    const Tile *neighbors[3][3];
+    for (int r = 0; r < 3; r++)
+    {
+        for (int c = 0; c < 3; c++)
+        {
+            neighbors[r][c] = findTile(tx + c - 1, ty + r - 1);
+        }
+    }
+    const uint64_t *rows[3][3];
+    for (int r = 0; r < 3; r++)
+    {
+        for (int c = 0; c < 3; c++)
+        {
+            rows[r][c] = neighbors[r][c] ? neighbors[r][c]->rows[cur] : EMPTY;
+        }
+    }
+    
+    uint64_t *out = tile->rows[1 - cur];
+    uint64_t touched = 0;
+    uint64_t hash = 0;
+    for (int y = 0; y < TILE_SIZE; y++)
+    {
+        // Row above: from the tiles to the north on the first row
+        int ra = y > 0 ? 1 : 0;
+        int ya = y > 0 ? y - 1 : TILE_SIZE - 1;
+        // Row below: from the tiles to the south on the last row
+        int rb = y < TILE_SIZE - 1 ? 1 : 2;
+        int yb = y < TILE_SIZE - 1 ? y + 1 : 0;
+    
+        LifePlanes counts = countLifeNeighbors(
+            rows[ra][0][ya], rows[ra][1][ya], rows[ra][2][ya],
+            rows[1][0][y], rows[1][1][y], rows[1][2][y],
+            rows[rb][0][yb], rows[rb][1][yb], rows[rb][2][yb]);
+        out[y] = BIRTH == RUNTIME_RULE
+               ? applyLifeRule(counts, rows[1][1][y], birth, survival)
+               : applyLifeRule<BIRTH, SURVIVAL>(counts, rows[1][1][y]);
+    
+        if (STATS)
+        {
+            touched |= out[y] | rows[1][1][y];
+        }
+        if (HASH)
+        {
+            hash ^= getWordHash(out[y] ^ rows[1][1][y], tx * TILE_SIZE, ty * TILE_SIZE + y);
+        }
+    }
+    
+    if (HASH)
+    {
+        addChangeHash(hash);
+    }
+    if (STATS && touched)
+    {
+        (this->*countTileStats)(tile, tx, ty);
+    }
+}
+
+/********************************************************************
+ *  Function:       void countTileChanges(Tile *tile, int tx, int ty)
+ *  Description:    Adds the births, deaths and live extent of a tile
+ *                  the kernel just calculated to stepStats, comparing
+ *                  its rows in both generations while they are still
+ *                  in cache.
+ *  Parameters:     tile    Tile to count
+ *                  tx      Tile column
+ *                  ty      Tile row
+ *  Preconditions:  Next generation of tile is calculated
+ *  Postconditions: stepStats includes the tile
+ *******************************************************************/
+void InfiniteGrid::countTileChanges(Tile *tile, int tx, int ty)
+{
+    const uint64_t *old = tile->rows[currentIndex];
+    const uint64_t *out = tile->rows[1 - currentIndex];
+    long long births = 0;
+    long long deaths = 0;
+    uint64_t columns = 0;
+    int firstRow = TILE_SIZE;
+    int lastRow = -1;
+    for (int y = 0; y < TILE_SIZE; y++)
+    {
+        births += __builtin_popcountll(out[y] & ~old[y]);
+        deaths += __builtin_popcountll(old[y] & ~out[y]);
+        columns |= out[y];
+        firstRow = out[y] && firstRow > y ? y : firstRow;
+        lastRow = out[y] ? y : lastRow;
+    }
+    
+    stepStats.births += births;
+    stepStats.deaths += deaths;
+    if (columns)
+    {
+        int x0 = tx * TILE_SIZE;
+        int y0 = ty * TILE_SIZE;
+        stepStats.left = std::min(stepStats.left, x0 + __builtin_ctzll(columns));
+        stepStats.right = std::max(stepStats.right, x0 + 63 - __builtin_clzll(columns));
+        stepStats.top = std::min(stepStats.top, y0 + firstRow);
+        stepStats.bottom = std::max(stepStats.bottom, y0 + lastRow);
+    }
+}
+
+/********************************************************************
+ *  Function:       void countPopcountChanges(Tile *tile, int tx, int ty)
+ *  Description:    Counts the changes of a tile like countTileChanges,
+ *                  which is inlined here so its bit counts compile to
+ *                  the popcnt instruction instead of a library call.
+ *  Parameters:     See countTileChanges
+ *  Preconditions:  See countTileChanges, CPU supports popcnt
+ *  Postconditions: stepStats includes the tile
+ *******************************************************************/
+#if defined(INFINITEGRID_X86)
+__attribute__((target("popcnt"), flatten))
+void InfiniteGrid::countPopcountChanges(Tile *tile, int tx, int ty)
+{
+    countTileChanges(tile, tx, ty);
+}
+#endif
+
+/********************************************************************
+ *  Function:       void computeRows(int first, int last)
+ *  Description:    Not supported because tiles are not stored in rows.
+ *                  supportsBands returns false, so Simulation never
+ *                  calls it.
+ *  Parameters:     first   Ignored
+ *                  last    Ignored
+ *  Preconditions:  none
+ *  Postconditions: Throws logic_error
+ *******************************************************************/
+void InfiniteGrid::computeRows(int, int)
+{
+    throw std::logic_error("ERROR: InfiniteGrid cannot be stepped in row bands.");
+}
+
+/********************************************************************
+ *  Function:       void swapBuffers()
+ *  Description:    Not supported because tiles are not stored in rows.
+ *  Parameters:     none
+ *  Preconditions:  none
+ *  Postconditions: Throws logic_error
+ *******************************************************************/
+void InfiniteGrid::swapBuffers()
+{
+    throw std::logic_error("ERROR: InfiniteGrid cannot be stepped in row bands.");
+}
+
+/********************************************************************
+ *  Function:       void step()
+ *  Description:    Makes the plane transition to the next generation
+ *                  according to the rule.
+ *                  Neighbors of live tiles are allocated first, and
+ *                  afterwards tiles with no live cells in them or
+ *                  their neighbors are released.
+ *  Parameters:     none
+ *  Preconditions:  none
+ *  Postconditions: Current generation is advanced by one
+ *******************************************************************/
+void InfiniteGrid::step()
+{
+    std::unordered_map<uint64_t, Tile *>::iterator it;
+    std::vector<int> coords;    // tile coordinates as x,y pairs
+    
+    // Find the live tiles, then give each of them all 8 neighbors
+    for (it = tiles.begin(); it != tiles.end(); ++it)
+    {
+        if (!isEmpty(it->second))
+        {
+            coords.push_back(static_cast<int32_t>(it->first >> 32));
+            coords.push_back(static_cast<int32_t>(it->first & 0xffffffff));
+        }
+    }
+    for (unsigned i = 0; i < coords.size(); i += 2)
+    {
+        for (int dy = -1; dy <= 1; dy++)
+        {
+            for (int dx = -1; dx <= 1; dx++)
+            {
+                getTile(coords[i] + dx, coords[i + 1] + dy);
+            }
+        }
+    }
+    
+    // Calculate every allocated tile
+    if (statsEnabled)
+    {
+        StepStats none = { 0, 0, INT_MAX, INT_MAX, INT_MIN, INT_MIN };
+        stepStats = none;
+    }
+    coords.clear();
+    for (it = tiles.begin(); it != tiles.end(); ++it)
+    {
+        int tx = static_cast<int32_t>(it->first >> 32);
+        int ty = static_cast<int32_t>(it->first & 0xffffffff);
+        (this->*computeTile)(it->second, tx, ty);
+        coords.push_back(tx);
+        coords.push_back(ty);
+    }
+    lastActiveCount = tiles.size();
+    finishChangeHash();
+    currentIndex = 1 - currentIndex;
+    
+    // Release tiles that are no longer near any live cell
+    for (unsigned i = 0; i < coords.size(); i += 2)
+    {
+        bool quiet = true;
+        for (int dy = -1; dy <= 1 && quiet; dy++)
+        {
+            for (int dx = -1; dx <= 1 && quiet; dx++)
+            {
+                quiet = isEmpty(findTile(coords[i] + dx, coords[i + 1] + dy));
+            }
+        }
+        if (quiet)
+        {
+            it = tiles.find(makeKey(coords[i], coords[i + 1]));
+            freeTiles.push_back(it->second);
+            tiles.erase(it);
+        }
+    }
+}
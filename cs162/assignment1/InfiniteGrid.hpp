@@ -0,0 +1,239 @@
+/*************************************************************************
+ * Author:          David Rigert
+ * Date Created:    10/17/2026
+ * Last Modified:   10/17/2026
+ * Assignment:      Assignment 1
+ * Filename:        InfiniteGrid.hpp
+ *
+ * Description:     Grid backend for an unbounded plane made of bit packed
+ *                  tiles of 64 x 64 cells. Tiles are allocated on demand
+ *                  in a hash map keyed by tile coordinate and released
+ *                  when they and their neighbors are empty, so memory and
+ *                  work follow the live cells instead of a fixed size.
+ ************************************************************************/
+#ifndef INFINITEGRID_HPP
+#define INFINITEGRID_HPP
+
+#include <vector>
+#include <unordered_map>
+#include <stdint.h>
+#include "Grid.hpp"
+
+class InfiniteGrid : public Grid
+{
+public:
+    static const int TILE_SIZE = 64;    // cells on each side of a tile
+
+private:
+    // A square of cells; row y holds cell x in bit x
+    struct Tile
+    {
+        uint64_t rows[2][TILE_SIZE];    // rows of both generations
+    };
+
+public:
+    // Calculates the next generation of one tile
+    typedef void (InfiniteGrid::*TileFunction)(Tile *, int, int);
+
+// member variables
+private:
+    std::unordered_map<uint64_t, Tile *> tiles; // allocated tiles by key
+    std::vector<Tile *> freeTiles;      // released tiles for reuse
+    int currentIndex;                   // generation index in each tile
+    int lastActiveCount;                // tiles evaluated last generation
+    TileFunction computeTile;           // tile kernel specialized for the rule
+    TileFunction countTileStats;        // countTileChanges, or its popcnt copy
+
+// member functions
+private:
+    // InfiniteGrid owns its tiles, so copying is not allowed
+    InfiniteGrid(const InfiniteGrid &);
+    InfiniteGrid &operator=(const InfiniteGrid &);
+
+    // Calculates the next generation of one tile under the rule
+    // BIRTH/SURVIVAL, or the rule member if both are RUNTIME_RULE, adds
+    // its changes to stepStats if STATS and hashes them if HASH.
+    template <unsigned BIRTH, unsigned SURVIVAL, bool STATS, bool HASH>
+    void computeRuleTile(Tile *, int, int);
+
+    // Adds the births, deaths and extent of a tile to stepStats.
+    void countTileChanges(Tile *, int, int);
+
+    // Counts the changes of a tile with the popcnt instruction.
+    void countPopcountChanges(Tile *, int, int);
+
+    // Counts the live cells of every tile one row at a time.
+    long long countPopulation() const;
+
+    // Counts the live cells with the popcnt instruction.
+    long long countPopcountPopulation() const;
+
+    // Selects the tile kernel for the rule.
+    template <bool STATS, bool HASH>
+    void selectKernel();
+
+    // Selects the tile kernel for the rule, statistics and hashing.
+    void updateKernel();
+
+    // Gets the tile at the specified tile coordinates or NULL.
+    Tile *findTile(int, int) const;
+
+    // Gets the tile at the specified tile coordinates, creating it.
+    Tile *getTile(int, int);
+
+    // Gets whether a tile has no live cells in the current generation.
+    bool isEmpty(const Tile *) const;
+
+    /********************************************************************
+     *  Function:       uint64_t makeKey(int tx, int ty)
+     *  Description:    Packs tile coordinates into a hash map key.
+     *  Parameters:     tx  Tile column
+     *                  ty  Tile row
+     *  Preconditions:  none
+     *  Postconditions: Returns a key unique to tx,ty
+     *******************************************************************/
+    static uint64_t makeKey(int tx, int ty)
+    {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(tx)) << 32)
+             | static_cast<uint32_t>(ty);
+    }
+
+    /********************************************************************
+     *  Function:       int tileCoord(int v)
+     *  Description:    Gets the tile coordinate containing a cell
+     *                  coordinate, rounding down for negative values.
+     *  Parameters:     v   Cell coordinate
+     *  Preconditions:  none
+     *  Postconditions: Returns floor(v / TILE_SIZE)
+     *******************************************************************/
+    static int tileCoord(int v)
+    {
+        return v >= 0 ? v / TILE_SIZE : -((-v + TILE_SIZE - 1) / TILE_SIZE);
+    }
+
+public:
+    // Instantiates an empty plane. The size is only the visible window.
+    InfiniteGrid(int, int);
+
+    // Frees all tiles.
+    ~InfiniteGrid();
+
+    // Enables or disables counting changes in the tile kernel.
+    void setStatsEnabled(bool);
+
+    // Enables or disables hashing changes in the tile kernel.
+    void setHashEnabled(bool);
+
+    // Gets whether the specified cell is alive.
+    bool getCell(int, int) const;
+
+    // Sets the state of the specified cell.
+    void setCell(int, int, bool);
+
+    // Sets a horizontal run of cells to alive a tile row at a time.
+    void fillRun(int, int, int);
+
+    /********************************************************************
+     *  Function:       bool isBounded()
+     *  Description:    The plane extends past the visible window.
+     *  Parameters:     none
+     *  Preconditions:  none
+     *  Postconditions: Returns false
+     *******************************************************************/
+    // Gets the XOR of the keys of the live cells of every tile.
+    uint64_t getHash() const;
+
+    // Counts the live cells of every tile.
+    long long getPopulation() const;
+
+    // Finds the smallest rectangle holding all live cells of every tile.
+    bool getBounds(int &, int &, int &, int &) const;
+
+    bool isBounded() const
+    {
+        return false;
+    }
+
+    /********************************************************************
+     *  Function:       void setSparse(bool enabled)
+     *  Description:    Only allocated tiles are ever evaluated, so the
+     *                  plane is always sparse and only accepts true.
+     *  Parameters:     enabled     Whether to enable sparse mode
+     *  Preconditions:  none
+     *  Postconditions: Throws invalid_argument if enabled is false
+     *******************************************************************/
+    void setSparse(bool enabled)
+    {
+        if (!enabled)
+        {
+            throw std::invalid_argument("ERROR: An infinite plane is always sparse.");
+        }
+    }
+
+    /********************************************************************
+     *  Function:       int getActiveTileCount()
+     *  Description:    Gets the number of tiles evaluated in the last
+     *                  generation.
+     *  Parameters:     none
+     *  Preconditions:  none
+     *  Postconditions: Returns the active tile count
+     *******************************************************************/
+    int getActiveTileCount() const
+    {
+        return lastActiveCount;
+    }
+
+    /********************************************************************
+     *  Function:       int getTileCount()
+     *  Description:    Gets the number of allocated tiles.
+     *  Parameters:     none
+     *  Preconditions:  none
+     *  Postconditions: Returns the size of the tile map
+     *******************************************************************/
+    int getTileCount() const
+    {
+        return tiles.size();
+    }
+
+    /********************************************************************
+     *  Function:       void setBoundary(Boundary mode)
+     *  Description:    The plane has no edge, so only DEAD_EDGE, which
+     *                  has no effect, is accepted.
+     *  Parameters:     mode    Boundary mode
+     *  Preconditions:  none
+     *  Postconditions: Throws invalid_argument for wrapping modes
+     *******************************************************************/
+    void setBoundary(Boundary mode)
+    {
+        if (mode != DEAD_EDGE)
+        {
+            throw std::invalid_argument("ERROR: An infinite plane has no edges to wrap.");
+        }
+    }
+
+    // Sets the rule and selects its tile kernel.
+    void setRule(const Rule &);
+
+    /********************************************************************
+     *  Function:       bool supportsBands()
+     *  Description:    Tiles are not arranged in rows, so the plane
+     *                  cannot be split into row bands.
+     *  Parameters:     none
+     *  Preconditions:  none
+     *  Postconditions: Returns false
+     *******************************************************************/
+    bool supportsBands() const
+    {
+        return false;
+    }
+
+    // Not supported; use step.
+    void computeRows(int, int);
+
+    // Not supported; use step.
+    void swapBuffers();
+
+    // Advances the plane to the next generation.
+    void step();
+};
+#endif // end of define INFINITEGRID_HPP
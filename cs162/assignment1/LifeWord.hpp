@@ -0,0 +1,158 @@
+/*************************************************************************
+ * Author:          David Rigert
+ * Date Created:    10/17/2026
+ * Last Modified:   10/17/2026
+ * Assignment:      Assignment 1
+ * Filename:        LifeWord.hpp
+ *
+ * Description:     Word-parallel Life-like kernels shared by the bit
+ *                  packed grids. Cell x of a word is stored in bit x, so
+ *                  shifting a word left by one moves every cell onto its
+ *                  east neighbor. The neighbor count is kept separate
+ *                  from the rule so that each rule can be specialized.
+ ************************************************************************/
+#ifndef LIFEWORD_HPP
+#define LIFEWORD_HPP
+
+#include <stdint.h>
+#include "Rule.hpp"
+
+// Neighbor counts of 64 cells as bit planes: bit x of each plane is
+// one binary digit of the count of cell x
+struct LifePlanes
+{
+    uint64_t ones;
+    uint64_t twos;
+    uint64_t fours;
+    uint64_t eights;
+};
+
+// Selects the rule masks at runtime instead of at compile time
+static const unsigned RUNTIME_RULE = ~0u;
+
+/********************************************************************
+ *  Function:       LifePlanes countLifeNeighbors(uint64_t aPrev,
+ *                      uint64_t a, uint64_t aNext, uint64_t cPrev,
+ *                      uint64_t c, uint64_t cNext, uint64_t bPrev,
+ *                      uint64_t b, uint64_t bNext)
+ *  Description:    Counts the live neighbors of the 64 cells in word c.
+ *                  The neighbors are added in parallel as bit planes:
+ *                  the three cells above and below and the two cells
+ *                  beside are combined with full adders into a 4-bit
+ *                  count per cell.
+ *  Parameters:     a       Word above c
+ *                  c       Word to count
+ *                  b       Word below c
+ *                  xPrev   Word west of word x (only bit 63 is used)
+ *                  xNext   Word east of word x (only bit 0 is used)
+ *  Preconditions:  none
+ *  Postconditions: Returns the neighbor counts of word c
+ *******************************************************************/
+inline LifePlanes countLifeNeighbors(uint64_t aPrev, uint64_t a, uint64_t aNext,
+                                     uint64_t cPrev, uint64_t c, uint64_t cNext,
+                                     uint64_t bPrev, uint64_t b, uint64_t bNext)
+{
+    // West neighbors: cell x - 1 lands on bit x
+    uint64_t aW = (a << 1) | (aPrev >> 63);
+    uint64_t cW = (c << 1) | (cPrev >> 63);
+    uint64_t bW = (b << 1) | (bPrev >> 63);
+    // East neighbors: cell x + 1 lands on bit x
+    uint64_t aE = (a >> 1) | (aNext << 63);
+    uint64_t cE = (c >> 1) | (cNext << 63);
+    uint64_t bE = (b >> 1) | (bNext << 63);
+    
+    // Sum of the three cells above: ones in a0, twos in a1
+    uint64_t a0 = aW ^ a ^ aE;
+    uint64_t a1 = (aW & a) | (aE & (aW ^ a));
+    // Sum of the three cells below
+    uint64_t b0 = bW ^ b ^ bE;
+    uint64_t b1 = (bW & b) | (bE & (bW ^ b));
+    // Sum of the two cells beside
+    uint64_t c0 = cW ^ cE;
+    uint64_t c1 = cW & cE;
+    
+    // Add the ones: result bit and carry into the twos
+    LifePlanes n;
+    n.ones = a0 ^ b0 ^ c0;
+    uint64_t carry = (a0 & b0) | (c0 & (a0 ^ b0));
+    // Add the four twos bit planes
+    uint64_t t = a1 ^ b1 ^ c1;
+    uint64_t tCarry = (a1 & b1) | (c1 & (a1 ^ b1));
+    n.twos = t ^ carry;
+    n.fours = tCarry ^ (t & carry);
+    n.eights = tCarry & t & carry;
+    return n;
+}
+
+/********************************************************************
+ *  Function:       uint64_t applyLifeRule(const LifePlanes &n,
+ *                      uint64_t c, unsigned birth, unsigned survival)
+ *  Description:    Calculates the next state of the 64 cells in word c
+ *                  under any Life-like rule. Each neighbor count in the
+ *                  rule is matched against all four planes at once, so
+ *                  the only branches are on the rule, not on cells.
+ *  Parameters:     n           Neighbor counts of word c
+ *                  c           Current state of the cells
+ *                  birth       Birth mask of the rule
+ *                  survival    Survival mask of the rule
+ *  Preconditions:  none
+ *  Postconditions: Returns the next generation of word c
+ *******************************************************************/
+inline uint64_t applyLifeRule(const LifePlanes &n, uint64_t c,
+                              unsigned birth, unsigned survival)
+{
+    uint64_t result = 0;
+    #pragma GCC unroll 9
+    for (int count = 0; count <= 8; count++)
+    {
+        unsigned bit = 1u << count;
+        if (!((birth | survival) & bit))
+        {
+            continue;
+        }
+        uint64_t match = ((count & 1) ? n.ones : ~n.ones)
+                       & ((count & 2) ? n.twos : ~n.twos)
+                       & ((count & 4) ? n.fours : ~n.fours)
+                       & ((count & 8) ? n.eights : ~n.eights);
+        uint64_t born = (birth & bit) ? ~c : 0;
+        uint64_t stays = (survival & bit) ? c : 0;
+        result |= match & (born | stays);
+    }
+    return result;
+}
+
+/********************************************************************
+ *  Function:       uint64_t applyLifeRule<BIRTH, SURVIVAL>(
+ *                      const LifePlanes &n, uint64_t c)
+ *  Description:    Calculates the next state of word c under a rule
+ *                  known at compile time. The loop over the counts is
+ *                  unrolled and the counts outside the rule are
+ *                  removed by the compiler.
+ *  Parameters:     n   Neighbor counts of word c
+ *                  c   Current state of the cells
+ *  Preconditions:  none
+ *  Postconditions: Returns the next generation of word c
+ *******************************************************************/
+template <unsigned BIRTH, unsigned SURVIVAL>
+inline uint64_t applyLifeRule(const LifePlanes &n, uint64_t c)
+{
+    return applyLifeRule(n, c, BIRTH, SURVIVAL);
+}
+
+/********************************************************************
+ *  Function:       uint64_t applyLifeRule<B3, S23>(const LifePlanes &n,
+ *                      uint64_t c)
+ *  Description:    Conway's rule reduced by hand: alive with exactly 2
+ *                  or 3 neighbors, or dead with exactly 3.
+ *  Parameters:     n   Neighbor counts of word c
+ *                  c   Current state of the cells
+ *  Preconditions:  none
+ *  Postconditions: Returns the next generation of word c
+ *******************************************************************/
+template <>
+inline uint64_t applyLifeRule<Rule::CONWAY_BIRTH, Rule::CONWAY_SURVIVAL>(
+    const LifePlanes &n, uint64_t c)
+{
+    return n.twos & ~n.fours & ~n.eights & (n.ones | c);
+}
+#endif // end of define LIFEWORD_HPP
@@ -0,0 +1,1105 @@
+/*************************************************************************
+ * Author:          David Rigert
+ * Date Created:    10/17/2026
+ * Last Modified:   10/17/2026
+ * Assignment:      Assignment 1
+ * Filename:        PackedGrid.cpp
+ *
+ * Description:     Implementation of the PackedGrid class.
+ *                  Cell x of a row is stored in bit (x % 64) of word
+ *                  (x / 64), so shifting a word left by one moves every
+ *                  cell onto its east neighbor.
+ *
+ *                  In sparse mode the grid is divided into tiles one
+ *                  word wide and TILE_HEIGHT rows high. A tile can only
+ *                  change if a cell in it or a neighboring tile changed
+ *                  in the last generation, so only those tiles are
+ *                  evaluated. A tile that is skipped did not change in
+ *                  the last generation, so both buffers already hold
+ *                  the same cells for it and no copy is needed.
+ ************************************************************************/
+#include <algorithm>
+#include "PackedGrid.hpp"
+#include "LifeWord.hpp"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define PACKEDGRID_X86
+#endif
+
+/********************************************************************
+ *  Function:       PackedGrid(int width, int height)
+ *  Description:    Allocates both generation buffers with all cells
+ *                  dead and calculates the masks that keep the
+ *                  outermost ring of cells dead.
+ *  Parameters:     width   Width of the grid including buffer cells
+ *                  height  Height of the grid including buffer cells
+ *******************************************************************/
+PackedGrid::PackedGrid(int width, int height) : Grid(width, height)
+{
+    wordsPerRow = (width + 63) / 64;
+    current.assign(wordsPerRow * height, 0);
+    next.assign(wordsPerRow * height, 0);
+    
+    computeWords = &PackedGrid::computeRuleWords<Rule::CONWAY_BIRTH, Rule::CONWAY_SURVIVAL, false, false>;
+    sparse = false;
+    rowWordsValid = false;
+    tileRows = (height + TILE_HEIGHT - 1) / TILE_HEIGHT;
+    lastActiveCount = 0;
+    
+    // Column 0 and column width - 1 are never evaluated
+    int lastBit = (width - 1) & 63;
+    firstMask = ~static_cast<uint64_t>(1);
+    lastMask = (static_cast<uint64_t>(1) << lastBit) - 1;
+    if (wordsPerRow == 1)
+    {
+        firstMask &= lastMask;
+        lastMask = firstMask;
+    }
+}
+
+/********************************************************************
+ *  Function:       void setCell(int x, int y, bool alive)
+ *  Description:    Sets the state of the specified cell.
+ *  Parameters:     x       X coordinate of cell
+ *                  y       Y coordinate of cell
+ *                  alive   New state of the cell
+ *  Preconditions:  x,y is on the grid
+ *  Postconditions: Cell at x,y is set to alive
+ *******************************************************************/
+void PackedGrid::setCell(int x, int y, bool alive)
+{
+    uint64_t bit = static_cast<uint64_t>(1) << (x & 63);
+    uint64_t &word = current[y * wordsPerRow + (x >> 6)];
+    if (alive)
+    {
+        word |= bit;
+    }
+    else
+    {
+        word &= ~bit;
+    }
+    
+    // The buffers now differ, so the tile must be evaluated
+    if (sparse)
+    {
+        activateAround((y / TILE_HEIGHT) * wordsPerRow + (x >> 6));
+    }
+    rowWordsValid = false;
+}
+
+/********************************************************************
+ *  Function:       void fillRun(int x, int y, int count)
+ *  Description:    Sets a horizontal run of cells to alive, masking
+ *                  whole words instead of setting single bits.
+ *  Parameters:     x       X coordinate of the first cell
+ *                  y       Y coordinate of the run
+ *                  count   Number of cells in the run
+ *  Preconditions:  All cells of the run are on the grid
+ *  Postconditions: Cells x to x + count - 1 of row y are alive
+ *******************************************************************/
+void PackedGrid::fillRun(int x, int y, int count)
+{
+    uint64_t *row = &current[y * wordsPerRow];
+    int end = x + count;
+    while (x < end)
+    {
+        int w = x >> 6;
+        int bits = std::min(end - x, 64 - (x & 63));
+        uint64_t mask = bits == 64 ? ~static_cast<uint64_t>(0)
+                                   : ((static_cast<uint64_t>(1) << bits) - 1) << (x & 63);
+        row[w] |= mask;
+        if (sparse)
+        {
+            activateAround((y / TILE_HEIGHT) * wordsPerRow + w);
+        }
+        x += bits;
+    }
+    rowWordsValid = false;
+}
+
+/********************************************************************
+ *  Function:       void clear()
+ *  Description:    Kills every cell. Both buffers are cleared, since
+ *                  tiles skipped in sparse mode take their next
+ *                  generation from the other buffer.
+ *  Parameters:     none
+ *  Preconditions:  none
+ *  Postconditions: No cells are alive
+ *******************************************************************/
+void PackedGrid::clear()
+{
+    std::fill(current.begin(), current.end(), 0);
+    std::fill(next.begin(), next.end(), 0);
+    rowWordsValid = false;
+}
+
+/********************************************************************
+ *  Function:       long long getPopulation()
+ *  Description:    Counts the live cells with countPopulation, using
+ *                  its popcnt copy when the CPU has the instruction.
+ *  Parameters:     none
+ *  Preconditions:  none
+ *  Postconditions: Returns the number of live cells
+ *******************************************************************/
+long long PackedGrid::getPopulation() const
+{
+    #if defined(PACKEDGRID_X86)
+    if (hasPopcount())
+    {
+        return countPopcountPopulation();
+    }
+    #endif
+    return countPopulation();
+}
+
+/********************************************************************
+ *  Function:       long long countPopulation()
+ *  Description:    Counts the live cells of the interior rows with one
+ *                  population count per word. The edge masks drop the
+ *                  halo columns of a wrapping boundary.
+ *  Parameters:     none
+ *  Preconditions:  none
+ *  Postconditions: Returns the number of live cells
+ *******************************************************************/
+long long PackedGrid::countPopulation() const
+{
+    long long count = 0;
+    for (int y = 1; y < height - 1; y++)
+    {
+        const uint64_t *row = &current[y * wordsPerRow];
+        for (int w = 0; w < wordsPerRow; w++)
+        {
+            uint64_t word = row[w];
+            if (w == 0)
+            {
+                word &= firstMask;
+            }
+            if (w == wordsPerRow - 1)
+            {
+                word &= lastMask;
+            }
+            count += __builtin_popcountll(word);
+        }
+    }
+    return count;
+}
+
+/********************************************************************
+ *  Function:       long long countPopcountPopulation()
+ *  Description:    Counts the live cells like countPopulation, which
+ *                  is inlined here so its bit counts compile to the
+ *                  popcnt instruction instead of a library call.
+ *  Parameters:     none
+ *  Preconditions:  CPU supports popcnt
+ *  Postconditions: Returns the number of live cells
+ *******************************************************************/
+#if defined(PACKEDGRID_X86)
+__attribute__((target("popcnt"), flatten))
+long long PackedGrid::countPopcountPopulation() const
+{
+    return countPopulation();
+}
+#endif
+
+/********************************************************************
+ *  Function:       bool getBounds(int &left, int &top, int &right,
+ *                                 int &bottom)
+ *  Description:    Finds the live cells furthest in each direction.
+ *                  Empty words are skipped, and the columns come from
+ *                  the lowest and highest bits of the words at each
+ *                  column of words combined over all rows.
+ *  Parameters:     left    Receives the X coordinate of the first column
+ *                  top     Receives the Y coordinate of the first row
+ *                  right   Receives the X coordinate of the last column
+ *                  bottom  Receives the Y coordinate of the last row
+ *  Preconditions:  none
+ *  Postconditions: Returns false and leaves the arguments unchanged
+ *                  if there are no live cells
+ *******************************************************************/
+bool PackedGrid::getBounds(int &left, int &top, int &right, int &bottom) const
+{
+    int first = -1;
+    int last = -1;
+    int firstWord = wordsPerRow;
+    int lastWord = -1;
+    uint64_t firstBits = 0;     // bits of the words at firstWord
+    uint64_t lastBits = 0;      // bits of the words at lastWord
+    for (int y = 1; y < height - 1; y++)
+    {
+        const uint64_t *row = &current[y * wordsPerRow];
+        for (int w = 0; w < wordsPerRow; w++)
+        {
+            uint64_t word = row[w];
+            word &= w == 0 ? firstMask : ~static_cast<uint64_t>(0);
+            word &= w == wordsPerRow - 1 ? lastMask : ~static_cast<uint64_t>(0);
+            if (!word)
+            {
+                continue;
+            }
+            first = first < 0 ? y : first;
+            last = y;
+            if (w < firstWord)
+            {
+                firstWord = w;
+                firstBits = 0;
+            }
+            if (w == firstWord)
+            {
+                firstBits |= word;
+            }
+            if (w > lastWord)
+            {
+                lastWord = w;
+                lastBits = 0;
+            }
+            if (w == lastWord)
+            {
+                lastBits |= word;
+            }
+        }
+    }
+    if (first < 0)
+    {
+        return false;
+    }
+    
+    left = firstWord * 64 + __builtin_ctzll(firstBits);
+    right = lastWord * 64 + 63 - __builtin_clzll(lastBits);
+    top = first;
+    bottom = last;
+    return true;
+}
+
+/********************************************************************
+ *  Function:       void getRowBits(int x, int y, int count,
+ *                                  uint64_t *words)
+ *  Description:    Copies a run of cells in the layout of the grid
+ *                  rows, so a run starting on a word boundary is copied
+ *                  a word at a time. Other runs are copied by Grid.
+ *  Parameters:     x       X coordinate of the first cell
+ *                  y       Y coordinate of the row
+ *                  count   Number of cells to copy
+ *                  words   Receives (count + 63) / 64 words
+ *  Preconditions:  All cells of the run are on the grid
+ *  Postconditions: Bits past count in the last word are 0
+ *******************************************************************/
+void PackedGrid::getRowBits(int x, int y, int count, uint64_t *words) const
+{
+    if (x & 63)
+    {
+        Grid::getRowBits(x, y, count, words);
+        return;
+    }
+    
+    const uint64_t *row = &current[y * wordsPerRow + (x >> 6)];
+    int wordCount = (count + 63) / 64;
+    std::copy(row, row + wordCount, words);
+    if (count & 63)
+    {
+        words[wordCount - 1] &= (static_cast<uint64_t>(1) << (count & 63)) - 1;
+    }
+}
+
+/********************************************************************
+ *  Function:       void setRowBits(int x, int y, int count,
+ *                                  const uint64_t *words)
+ *  Description:    Sets a run of cells a word at a time. Each word of
+ *                  the grid takes the bits of the source word shifted
+ *                  into place, ORed with the bits carried over from the
+ *                  source word before it, and keeps its cells outside
+ *                  the run. In sparse mode only the tiles of words that
+ *                  changed are activated.
+ *  Parameters:     x       X coordinate of the first cell
+ *                  y       Y coordinate of the row
+ *                  count   Number of cells to set
+ *                  words   (count + 63) / 64 words of cells
+ *  Preconditions:  All cells of the run are on the grid
+ *  Postconditions: Each cell of the run is alive if its bit is set
+ *******************************************************************/
+void PackedGrid::setRowBits(int x, int y, int count, const uint64_t *words)
+{
+    if (count <= 0)
+    {
+        return;
+    }
+    
+    int shift = x & 63;
+    int first = x >> 6;
+    int last = (x + count - 1) >> 6;
+    int wordCount = (count + 63) / 64;
+    uint64_t *row = &current[y * wordsPerRow];
+    for (int w = first; w <= last; w++)
+    {
+        // Source words w - first and the one before it overlap this word
+        int i = w - first;
+        uint64_t bits = i < wordCount ? words[i] << shift : 0;
+        if (shift && i > 0)
+        {
+            bits |= words[i - 1] >> (64 - shift);
+        }
+    
+        // Only the cells of the run in this word change
+        int low = w == first ? shift : 0;
+        int high = w == last ? ((x + count - 1) & 63) + 1 : 64;
+        uint64_t mask = (high == 64 ? ~static_cast<uint64_t>(0)
+                                    : (static_cast<uint64_t>(1) << high) - 1)
+                      & ~((static_cast<uint64_t>(1) << low) - 1);
+        uint64_t word = (row[w] & ~mask) | (bits & mask);
+        if (word != row[w])
+        {
+            row[w] = word;
+            if (sparse)
+            {
+                activateAround((y / TILE_HEIGHT) * wordsPerRow + w);
+            }
+        }
+    }
+    rowWordsValid = false;
+}
+
+/********************************************************************
+ *  Function:       void setSparse(bool enabled)
+ *  Description:    Enables or disables sparse mode. When enabled, all
+ *                  tiles are evaluated in the first generation since
+ *                  the buffers may differ anywhere.
+ *  Parameters:     enabled     Whether to enable sparse mode
+ *  Preconditions:  none
+ *  Postconditions: Sparse mode is set to enabled
+ *******************************************************************/
+void PackedGrid::setSparse(bool enabled)
+{
+    sparse = enabled;
+    rowWordsValid = false;
+    active.assign(getTileCount(), enabled ? 1 : 0);
+    activeTiles.clear();
+    changedTiles.clear();
+    lastActiveCount = 0;
+    
+    if (enabled)
+    {
+        for (int t = 0; t < getTileCount(); t++)
+        {
+            activeTiles.push_back(t);
+        }
+    }
+}
+
+/********************************************************************
+ *  Function:       void setBoundary(Boundary mode)
+ *  Description:    Sets the topology of the grid. In sparse mode all
+ *                  tiles are evaluated in the next generation because
+ *                  the halo may change everywhere on the edge.
+ *  Parameters:     mode    New boundary mode
+ *  Preconditions:  none
+ *  Postconditions: Later generations use the boundary mode
+ *******************************************************************/
+void PackedGrid::setBoundary(Boundary mode)
+{
+    Grid::setBoundary(mode);
+    if (sparse)
+    {
+        setSparse(true);
+    }
+}
+
+/********************************************************************
+ *  Function:       void exchangeHalo()
+ *  Description:    Copies the edges of the interior into the outermost
+ *                  ring on the opposite side, whole words at a time
+ *                  for unflipped rows. In sparse mode, ring cells that
+ *                  differ from the halo of the last generation (still
+ *                  in the next buffer) wake up their tiles.
+ *  Parameters:     none
+ *  Preconditions:  width >= 3, height >= 3
+ *  Postconditions: Ring cells match the cells they wrap around to
+ *******************************************************************/
+void PackedGrid::exchangeHalo()
+{
+    if (boundary == DEAD_EDGE)
+    {
+        return;
+    }
+    
+    // Left and right edges are joined for both wrapping modes
+    int lastWord = wordsPerRow - 1;
+    uint64_t rightBit = static_cast<uint64_t>(1) << ((width - 1) & 63);
+    for (int y = 1; y < height - 1; y++)
+    {
+        uint64_t *row = &current[y * wordsPerRow];
+        uint64_t fromRight = (row[(width - 2) >> 6] >> ((width - 2) & 63)) & 1;
+        uint64_t fromLeft = (row[0] >> 1) & 1;
+        row[0] = (row[0] & ~static_cast<uint64_t>(1)) | fromRight;
+        row[lastWord] = (row[lastWord] & ~rightBit) | (fromLeft ? rightBit : 0);
+    }
+    
+    // Top and bottom edges, mirrored for a Klein bottle
+    uint64_t *top = &current[0];
+    uint64_t *bottom = &current[(height - 1) * wordsPerRow];
+    const uint64_t *firstRow = &current[wordsPerRow];
+    const uint64_t *lastRow = &current[(height - 2) * wordsPerRow];
+    if (boundary == TORUS)
+    {
+        std::copy(lastRow, lastRow + wordsPerRow, top);
+        std::copy(firstRow, firstRow + wordsPerRow, bottom);
+    }
+    else
+    {
+        std::fill(top, top + wordsPerRow, 0);
+        std::fill(bottom, bottom + wordsPerRow, 0);
+        for (int x = 0; x < width; x++)
+        {
+            int from = width - 1 - x;
+            uint64_t bit = static_cast<uint64_t>(1) << (x & 63);
+            top[x >> 6] |= (lastRow[from >> 6] >> (from & 63)) & 1 ? bit : 0;
+            bottom[x >> 6] |= (firstRow[from >> 6] >> (from & 63)) & 1 ? bit : 0;
+        }
+    }
+    
+    if (!sparse)
+    {
+        return;
+    }
+    
+    // Wake up the tiles whose halo changed since the last generation
+    int bottomTiles = ((height - 1) / TILE_HEIGHT) * wordsPerRow;
+    for (int w = 0; w < wordsPerRow; w++)
+    {
+        if (current[w] != next[w])
+        {
+            activateAround(w);
+        }
+        int b = (height - 1) * wordsPerRow + w;
+        if (current[b] != next[b])
+        {
+            activateAround(bottomTiles + w);
+        }
+    }
+    for (int y = 1; y < height - 1; y++)
+    {
+        int first = y * wordsPerRow;
+        int last = first + lastWord;
+        if ((current[first] ^ next[first]) & 1)
+        {
+            activateAround((y / TILE_HEIGHT) * wordsPerRow);
+        }
+        if ((current[last] ^ next[last]) & rightBit)
+        {
+            activateAround((y / TILE_HEIGHT) * wordsPerRow + lastWord);
+        }
+    }
+}
+
+/********************************************************************
+ *  Function:       void activateAround(int tile)
+ *  Description:    Adds the specified tile and its 8 neighbors to the
+ *                  list of tiles to evaluate if not already there.
+ *  Parameters:     tile    Index of tile (row * wordsPerRow + column)
+ *  Preconditions:  Sparse mode is enabled
+ *  Postconditions: Tile and neighbors are active
+ *******************************************************************/
+void PackedGrid::activateAround(int tile)
+{
+    int row = tile / wordsPerRow;
+    int col = tile % wordsPerRow;
+    
+    for (int r = row - 1; r <= row + 1; r++)
+    {
+        for (int c = col - 1; c <= col + 1; c++)
+        {
+            if (r < 0 || r >= tileRows || c < 0 || c >= wordsPerRow)
+            {
+                continue;
+            }
+            int t = r * wordsPerRow + c;
+            if (!active[t])
+            {
+                active[t] = 1;
+                activeTiles.push_back(t);
+            }
+        }
+    }
+}
+
+/********************************************************************
+ *  Function:       void setRule(const Rule &newRule)
+ *  Description:    Sets the rule and selects the word kernel. Common
+ *                  rules have kernels specialized at compile time;
+ *                  other rules read the masks from the rule member.
+ *  Parameters:     newRule     Rule to use
+ *  Preconditions:  none
+ *  Postconditions: Later generations use newRule
+ *******************************************************************/
+void PackedGrid::setRule(const Rule &newRule)
+{
+    rule = newRule;
+    updateKernel();
+    
+    // Cells that were stable under the old rule may not be now
+    if (sparse)
+    {
+        setSparse(true);
+    }
+}
+
+/********************************************************************
+ *  Function:       void updateKernel()
+ *  Description:    Selects the word kernel for the rule with or
+ *                  without statistics and hashing, so a kernel only
+ *                  does the work that is enabled.
+ *  Parameters:     none
+ *  Preconditions:  none
+ *  Postconditions: computeWords matches the rule and enabled features
+ *******************************************************************/
+void PackedGrid::updateKernel()
+{
+    if (statsEnabled && hashEnabled)
+    {
+        selectKernel<true, true>();
+    }
+    else if (statsEnabled)
+    {
+        selectKernel<true, false>();
+    }
+    else if (hashEnabled)
+    {
+        selectKernel<false, true>();
+    }
+    else
+    {
+        selectKernel<false, false>();
+    }
+}
+
+/********************************************************************
+ *  Function:       WordFunction getWordKernel<BIRTH, SURVIVAL, STATS,
+ *                                             HASH>()
+ *  Description:    Gets the word kernel for the rule. The build does
+ *                  not assume popcnt, so __builtin_popcountll is a
+ *                  library call unless the kernel is compiled inside
+ *                  computePopcountWords; the statistics kernel is
+ *                  taken from there when the CPU has the instruction.
+ *  Parameters:     none
+ *  Preconditions:  none
+ *  Postconditions: Returns the kernel for the rule and features
+ *******************************************************************/
+template <unsigned BIRTH, unsigned SURVIVAL, bool STATS, bool HASH>
+PackedGrid::WordFunction PackedGrid::getWordKernel() const
+{
+    #if defined(PACKEDGRID_X86)
+    if (STATS && hasPopcount())
+    {
+        return &PackedGrid::computePopcountWords<BIRTH, SURVIVAL, HASH>;
+    }
+    #endif
+    return &PackedGrid::computeRuleWords<BIRTH, SURVIVAL, STATS, HASH>;
+}
+
+/********************************************************************
+ *  Function:       void selectKernel<STATS, HASH>()
+ *  Description:    Selects the word kernel for the rule. Common rules
+ *                  have kernels specialized at compile time; other
+ *                  rules read the masks from the rule member.
+ *  Parameters:     none
+ *  Preconditions:  none
+ *  Postconditions: computeWords calculates the rule, counting changes
+ *                  if STATS and hashing them if HASH
+ *******************************************************************/
+template <bool STATS, bool HASH>
+void PackedGrid::selectKernel()
+{
+    unsigned birth = rule.getBirth();
+    unsigned survival = rule.getSurvival();
+    
+    if (birth == Rule::CONWAY_BIRTH && survival == Rule::CONWAY_SURVIVAL)
+    {
+        computeWords = getWordKernel<Rule::CONWAY_BIRTH, Rule::CONWAY_SURVIVAL, STATS, HASH>();
+    }
+    else if (birth == Rule::HIGHLIFE_BIRTH && survival == Rule::HIGHLIFE_SURVIVAL)
+    {
+        computeWords = getWordKernel<Rule::HIGHLIFE_BIRTH, Rule::HIGHLIFE_SURVIVAL, STATS, HASH>();
+    }
+    else if (birth == Rule::DAY_NIGHT_BIRTH && survival == Rule::DAY_NIGHT_SURVIVAL)
+    {
+        computeWords = getWordKernel<Rule::DAY_NIGHT_BIRTH, Rule::DAY_NIGHT_SURVIVAL, STATS, HASH>();
+    }
+    else
+    {
+        computeWords = getWordKernel<RUNTIME_RULE, RUNTIME_RULE, STATS, HASH>();
+    }
+}
+
+/********************************************************************
+ *  Function:       void setStatsEnabled(bool enabled)
+ *  Description:    Enables or disables statistics. The kernel counts
+ *                  the births and deaths of each row with live cells
+ *                  while its words are in cache and skips empty rows,
+ *                  so no extra pass over the grid is needed. The
+ *                  kernel without statistics is selected when
+ *                  disabled, so it costs nothing. The active tiles
+ *                  are kept, so switching every few generations does
+ *                  not make a sparse grid calculate every tile.
+ *  Parameters:     enabled     Whether to gather statistics
+ *  Preconditions:  none
+ *  Postconditions: getStepStats describes each later generation
+ *******************************************************************/
+void PackedGrid::setStatsEnabled(bool enabled)
+{
+    Grid::setStatsEnabled(enabled);
+    firstWords.assign(enabled ? height : 0, wordsPerRow);
+    lastWords.assign(enabled ? height : 0, -1);
+    rowWordsValid = false;
+    updateKernel();
+}
+
+/********************************************************************
+ *  Function:       void setHashEnabled(bool enabled)
+ *  Description:    Enables or disables the change hash. The kernel
+ *                  hashes the bits of each word it calculates that
+ *                  differ from the current word, so in sparse mode
+ *                  only the active tiles are hashed.
+ *  Parameters:     enabled     Whether to gather the change hash
+ *  Preconditions:  none
+ *  Postconditions: getChangeHash describes each later generation
+ *******************************************************************/
+void PackedGrid::setHashEnabled(bool enabled)
+{
+    Grid::setHashEnabled(enabled);
+    updateKernel();
+}
+
+/********************************************************************
+ *  Function:       void computeRuleWords<BIRTH, SURVIVAL, STATS, HASH>(
+ *                      int y, int first, int last)
+ *  Description:    Calculates the next state of every cell in words
+ *                  first to last - 1 of row y, 64 cells at a time.
+ *                  With STATS in sparse mode, the births and deaths of
+ *                  the words are added to rowStats[y], and its left
+ *                  and right hold the first and last nonzero words
+ *                  calculated; in dense mode the whole row is always
+ *                  calculated, so rowStats[y] is complete. With
+ *                  HASH, the keys of the bits that flipped are added
+ *                  to the change hash.
+ *  Parameters:     y       Row to calculate
+ *                  first   First word to calculate
+ *                  last    Word after the last word to calculate
+ *  Preconditions:  0 < y < height - 1, 0 <= first < last <= wordsPerRow
+ *  Postconditions: Words of row y in next buffer contain next generation
+ *******************************************************************/
+template <unsigned BIRTH, unsigned SURVIVAL, bool STATS, bool HASH>
+void PackedGrid::computeRuleWords(int y, int first, int last)
+{
+    const unsigned birth = BIRTH == RUNTIME_RULE ? rule.getBirth() : BIRTH;
+    const unsigned survival = SURVIVAL == RUNTIME_RULE ? rule.getSurvival() : SURVIVAL;
+    const uint64_t *above = &current[(y - 1) * wordsPerRow];
+    const uint64_t *row = &current[y * wordsPerRow];
+    const uint64_t *below = &current[(y + 1) * wordsPerRow];
+    uint64_t *out = &next[y * wordsPerRow];
+    uint64_t touched = 0;
+    uint64_t hash = 0;
+    
+    for (int w = first; w < last; w++)
+    {
+        // Carry bits from the neighboring words (0 beyond the edge)
+        bool hasPrev = w > 0;
+        bool hasNext = w < wordsPerRow - 1;
+        LifePlanes counts = countLifeNeighbors(
+            hasPrev ? above[w - 1] : 0, above[w], hasNext ? above[w + 1] : 0,
+            hasPrev ? row[w - 1] : 0, row[w], hasNext ? row[w + 1] : 0,
+            hasPrev ? below[w - 1] : 0, below[w], hasNext ? below[w + 1] : 0);
+        uint64_t result = BIRTH == RUNTIME_RULE
+                        ? applyLifeRule(counts, row[w], birth, survival)
+                        : applyLifeRule<BIRTH, SURVIVAL>(counts, row[w]);
+        uint64_t old = row[w];
+    
+        if (w == 0)
+        {
+            result &= firstMask;
+            old &= firstMask;
+        }
+        if (w == wordsPerRow - 1)
+        {
+            result &= lastMask;
+            old &= lastMask;
+        }
+        out[w] = result;
+    
+        // Most rows of a board are empty, so the loop only notes whether
+        // the row has any live cells before or after
+        if (STATS)
+        {
+            touched |= result | old;
+        }
+        if (HASH)
+        {
+            hash ^= getWordHash(result ^ old, w * 64, y);
+        }
+    }
+    
+    if (HASH)
+    {
+        addChangeHash(hash);
+    }
+    if (STATS)
+    {
+        // Count the changes of a row with live cells while its words are
+        // still in cache, and search for the extent from both ends; a
+        // live row usually ends in the first word checked from either
+        int births = 0;
+        int deaths = 0;
+        int firstLive = last;
+        if (touched)
+        {
+            for (int w = first; w < last; w++)
+            {
+                uint64_t old = row[w];
+                old &= w == 0 ? firstMask : ~static_cast<uint64_t>(0);
+                old &= w == wordsPerRow - 1 ? lastMask : ~static_cast<uint64_t>(0);
+                births += __builtin_popcountll(out[w] & ~old);
+                deaths += __builtin_popcountll(old & ~out[w]);
+            }
+            firstLive = first;
+        }
+        while (firstLive < last && !out[firstLive])
+        {
+            firstLive++;
+        }
+        int lastLive = last - 1;
+        while (lastLive >= firstLive && !out[lastLive])
+        {
+            lastLive--;
+        }
+        RowStats &stats = rowStats[y];
+    
+        // Whole rows are only calculated in dense mode, so the columns
+        // are found here and gatherRowStats has nothing left to do
+        if (!sparse)
+        {
+            stats.births = births;
+            stats.deaths = deaths;
+            stats.left = width;
+            stats.right = -1;
+            if (firstLive <= lastLive)
+            {
+                stats.left = firstLive * 64 + __builtin_ctzll(out[firstLive]);
+                stats.right = lastLive * 64 + 63 - __builtin_clzll(out[lastLive]);
+            }
+        }
+        else
+        {
+            if (firstLive > lastLive)
+            {
+                firstLive = wordsPerRow;
+                lastLive = -1;
+            }
+            stats.births += births;
+            stats.deaths += deaths;
+            stats.left = std::min(stats.left, firstLive);
+            stats.right = std::max(stats.right, lastLive);
+        }
+    }
+}
+
+/********************************************************************
+ *  Function:       void computePopcountWords<BIRTH, SURVIVAL, HASH>(
+ *                      int y, int first, int last)
+ *  Description:    Calculates words first to last - 1 of row y with
+ *                  statistics. The kernel is inlined here, so its
+ *                  bit counts compile to the popcnt instruction.
+ *  Parameters:     See computeRuleWords
+ *  Preconditions:  See computeRuleWords, CPU supports popcnt
+ *  Postconditions: Words of row y in next buffer contain next generation
+ *******************************************************************/
+#if defined(PACKEDGRID_X86)
+template <unsigned BIRTH, unsigned SURVIVAL, bool HASH>
+__attribute__((target("popcnt"), flatten))
+void PackedGrid::computePopcountWords(int y, int first, int last)
+{
+    computeRuleWords<BIRTH, SURVIVAL, true, HASH>(y, first, last);
+}
+#endif
+
+/********************************************************************
+ *  Function:       void computeRows(int first, int last)
+ *  Description:    Calculates the specified rows of the next generation
+ *                  according to the rule. The statistics of the rows
+ *                  are cleared first, since sparse mode only adds the
+ *                  words it calculates.
+ *  Parameters:     first   First row to calculate, at least 1
+ *                  last    Row after the last row, at most height - 1
+ *  Preconditions:  none
+ *  Postconditions: Rows first to last - 1 of next buffer are calculated
+ *******************************************************************/
+void PackedGrid::computeRows(int first, int last)
+{
+    if (!sparse)
+    {
+        for (int y = first; y < last; y++)
+        {
+            (this->*computeWords)(y, 0, wordsPerRow);
+        }
+        return;
+    }
+    
+    if (statsEnabled)
+    {
+        RowStats none = { 0, 0, wordsPerRow, -1 };
+        std::fill(rowStats.begin() + first, rowStats.begin() + last, none);
+    }
+    
+    // Calculate the part of each active tile inside the band
+    for (unsigned i = 0; i < activeTiles.size(); i++)
+    {
+        int tile = activeTiles[i];
+        int col = tile % wordsPerRow;
+        int top = (tile / wordsPerRow) * TILE_HEIGHT;
+        int start = std::max(first, top);
+        int end = std::min(last, top + TILE_HEIGHT);
+        for (int y = start; y < end; y++)
+        {
+            (this->*computeWords)(y, col, col + 1);
+        }
+    }
+}
+
+/********************************************************************
+ *  Function:       void computeTile(int top, int bottom, int left,
+ *                                   int right)
+ *  Description:    Calculates the words of the specified rectangle. In
+ *                  sparse mode only the active tiles inside it are
+ *                  calculated, so a rectangle of empty space costs one
+ *                  check per sparse tile.
+ *  Parameters:     top     First row to calculate, at least 1
+ *                  bottom  Row after the last row, at most height - 1
+ *                  left    First column, a multiple of 64
+ *                  right   Column after the last column, a multiple of
+ *                          64 or the width
+ *  Preconditions:  Statistics are disabled unless the tile spans whole
+ *                  rows
+ *  Postconditions: Words of the tile in the next buffer are calculated
+ *******************************************************************/
+void PackedGrid::computeTile(int top, int bottom, int left, int right)
+{
+    int first = left >> 6;
+    int last = (right + 63) >> 6;
+    if (statsEnabled || (!sparse && first == 0 && last == wordsPerRow))
+    {
+        computeRows(top, bottom);
+        return;
+    }
+    
+    if (!sparse)
+    {
+        for (int y = top; y < bottom; y++)
+        {
+            (this->*computeWords)(y, first, last);
+        }
+        return;
+    }
+    
+    // Calculate each run of neighboring active sparse tiles a row at a
+    // time, so the words of a row are read in order
+    for (int row = top / TILE_HEIGHT; row * TILE_HEIGHT < bottom; row++)
+    {
+        int start = std::max(top, row * TILE_HEIGHT);
+        int end = std::min(bottom, (row + 1) * TILE_HEIGHT);
+        const unsigned char *tiles = &active[row * wordsPerRow];
+        for (int col = first; col < last; col++)
+        {
+            if (!tiles[col])
+            {
+                continue;
+            }
+            int runEnd = col + 1;
+            while (runEnd < last && tiles[runEnd])
+            {
+                runEnd++;
+            }
+            for (int y = start; y < end; y++)
+            {
+                (this->*computeWords)(y, col, runEnd);
+            }
+            col = runEnd;
+        }
+    }
+}
+
+/********************************************************************
+ *  Function:       void swapBuffers()
+ *  Description:    Clears the rows that are never evaluated and swaps
+ *                  the current and next buffers. In sparse mode, the
+ *                  evaluated tiles are compared with the current
+ *                  generation to find the tiles to evaluate next.
+ *  Parameters:     none
+ *  Preconditions:  All rows of the next buffer are calculated
+ *  Postconditions: Current buffer contains next generation
+ *******************************************************************/
+void PackedGrid::swapBuffers()
+{
+    // Top and bottom rows are never evaluated
+    std::fill(next.begin(), next.begin() + wordsPerRow, 0);
+    std::fill(next.end() - wordsPerRow, next.end(), 0);
+    
+    // Needs the active tiles of this generation in sparse mode
+    if (statsEnabled)
+    {
+        gatherRowStats();
+    }
+    finishChangeHash();
+    
+    if (sparse)
+    {
+        // Find the evaluated tiles that changed
+        // With a wrapping boundary the ring is a halo whose changes
+        // are found by exchangeHalo, so only the interior is compared
+        bool wrap = boundary != DEAD_EDGE;
+        changedTiles.clear();
+        for (unsigned i = 0; i < activeTiles.size(); i++)
+        {
+            int tile = activeTiles[i];
+            int col = tile % wordsPerRow;
+            int top = (tile / wordsPerRow) * TILE_HEIGHT;
+            int end = std::min(height, top + TILE_HEIGHT);
+            uint64_t mask = ~static_cast<uint64_t>(0);
+            if (wrap)
+            {
+                top = std::max(top, 1);
+                end = std::min(end, height - 1);
+                mask = (col == 0 ? firstMask : mask) & (col == wordsPerRow - 1 ? lastMask : mask);
+            }
+            for (int y = top; y < end; y++)
+            {
+                int w = y * wordsPerRow + col;
+                if ((next[w] ^ current[w]) & mask)
+                {
+                    changedTiles.push_back(tile);
+                    break;
+                }
+            }
+            active[tile] = 0;
+        }
+    
+        // Changed tiles and their neighbors are evaluated next
+        lastActiveCount = activeTiles.size();
+        activeTiles.clear();
+        for (unsigned i = 0; i < changedTiles.size(); i++)
+        {
+            activateAround(changedTiles[i]);
+        }
+    }
+    
+    current.swap(next);
+}
+
+/********************************************************************
+ *  Function:       void gatherRowStats()
+ *  Description:    Turns the nonzero words the kernel found in each
+ *                  row into the live columns of the row, and adds up
+ *                  the rows. In sparse mode the kernel only sees the
+ *                  active tiles, but a tile it skipped holds the same
+ *                  words as before, so the nonzero words of the row
+ *                  from the last generation still count if their tile
+ *                  was skipped. Only a row whose first or last live
+ *                  word was calculated and died is searched again.
+ *  Parameters:     none
+ *  Preconditions:  Every interior row of the next buffer is calculated
+ *                  and active still marks the tiles calculated
+ *  Postconditions: stepStats describes the next buffer
+ *******************************************************************/
+void PackedGrid::gatherRowStats()
+{
+    // Dense mode calculates whole rows, so the kernel completed them
+    if (!sparse)
+    {
+        rowWordsValid = false;
+        sumRowStats();
+        return;
+    }
+    
+    for (int y = 1; y < height - 1; y++)
+    {
+        RowStats &stats = rowStats[y];
+        const uint64_t *row = &next[y * wordsPerRow];
+        int first = stats.left;
+        int last = stats.right;
+        const unsigned char *tiles = &active[(y / TILE_HEIGHT) * wordsPerRow];
+        bool search = !rowWordsValid;
+        if (!search && firstWords[y] <= lastWords[y])
+        {
+            if (!tiles[firstWords[y]])
+            {
+                first = std::min(first, firstWords[y]);
+            }
+            else if (first > firstWords[y])
+            {
+                search = true;
+            }
+            if (!tiles[lastWords[y]])
+            {
+                last = std::max(last, lastWords[y]);
+            }
+            else if (last < lastWords[y])
+            {
+                search = true;
+            }
+        }
+        if (search)
+        {
+            first = wordsPerRow;
+            last = -1;
+            for (int w = 0; w < wordsPerRow; w++)
+            {
+                uint64_t word = row[w];
+                word &= w == 0 ? firstMask : ~static_cast<uint64_t>(0);
+                word &= w == wordsPerRow - 1 ? lastMask : ~static_cast<uint64_t>(0);
+                if (word)
+                {
+                    first = std::min(first, w);
+                    last = w;
+                }
+            }
+        }
+        firstWords[y] = first;
+        lastWords[y] = last;
+    
+        // Live columns from the lowest and highest bits of those words
+        if (first <= last)
+        {
+            uint64_t low = row[first] & (first == 0 ? firstMask : ~static_cast<uint64_t>(0));
+            uint64_t high = row[last] & (last == wordsPerRow - 1 ? lastMask : ~static_cast<uint64_t>(0));
+            stats.left = first * 64 + __builtin_ctzll(low);
+            stats.right = last * 64 + 63 - __builtin_clzll(high);
+        }
+        else
+        {
+            stats.left = width;
+            stats.right = -1;
+        }
+    }
+    rowWordsValid = true;
+    sumRowStats();
+}
+
+/********************************************************************
+ *  Function:       uint64_t getHash()
+ *  Description:    Calculates the Zobrist hash of the interior, only
+ *                  visiting the live bits of each word.
+ *  Parameters:     none
+ *  Preconditions:  none
+ *  Postconditions: Returns the hash, 0 if no cells are alive
+ *******************************************************************/
+uint64_t PackedGrid::getHash() const
+{
+    uint64_t hash = 0;
+    for (int y = 1; y < height - 1; y++)
+    {
+        const uint64_t *row = &current[y * wordsPerRow];
+        for (int w = 0; w < wordsPerRow; w++)
+        {
+            uint64_t word = row[w];
+            word &= w == 0 ? firstMask : ~static_cast<uint64_t>(0);
+            word &= w == wordsPerRow - 1 ? lastMask : ~static_cast<uint64_t>(0);
+            hash ^= getWordHash(word, w * 64, y);
+        }
+    }
+    return hash;
+}
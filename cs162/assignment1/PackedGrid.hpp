@@ -0,0 +1,195 @@
+/*************************************************************************
+ * Author:          David Rigert
+ * Date Created:    10/17/2026
+ * Last Modified:   10/17/2026
+ * Assignment:      Assignment 1
+ * Filename:        PackedGrid.hpp
+ *
+ * Description:     Grid backend that packs 64 cells into each 64-bit word
+ *                  of a row and computes the next generation of a whole
+ *                  word at once with bitwise full-adder logic.
+ ************************************************************************/
+#ifndef PACKEDGRID_HPP
+#define PACKEDGRID_HPP
+
+#include <vector>
+#include <stdint.h>
+#include "Grid.hpp"
+
+class PackedGrid : public Grid
+{
+public:
+    // Computes the specified words of a row into the next buffer
+    typedef void (PackedGrid::*WordFunction)(int, int, int);
+
+// member variables
+private:
+    std::vector<uint64_t> current;  // words of current generation
+    std::vector<uint64_t> next;     // words of next generation
+    int wordsPerRow;                // number of words in each row
+    uint64_t firstMask;             // live bits allowed in first word of row
+    uint64_t lastMask;              // live bits allowed in last word of row
+    WordFunction computeWords;      // word kernel specialized for the rule
+    
+    // sparse mode: only tiles near a change are evaluated
+    bool sparse;                    // whether sparse mode is enabled
+    int tileRows;                   // number of rows of tiles
+    std::vector<unsigned char> active;  // whether each tile is in activeTiles
+    std::vector<int> activeTiles;   // tiles to evaluate next generation
+    std::vector<int> changedTiles;  // tiles that changed last generation
+    int lastActiveCount;            // tiles evaluated last generation
+
+    // statistics: the nonzero words of each row, so sparse mode can find
+    // the live extent without visiting the tiles it skipped
+    std::vector<int> firstWords;    // first nonzero word of each row
+    std::vector<int> lastWords;     // last nonzero word, -1 if none
+    bool rowWordsValid;             // false after cells were edited
+
+public:
+    static const int TILE_HEIGHT = 16;  // rows in a tile one word wide
+
+// member functions
+private:
+    // Adds a tile and its neighbors to the active tiles.
+    void activateAround(int);
+
+    // Computes the specified words of a row under the rule BIRTH/SURVIVAL,
+    // or the rule member if both are RUNTIME_RULE, counts the changes
+    // into rowStats if STATS and hashes them if HASH.
+    template <unsigned BIRTH, unsigned SURVIVAL, bool STATS, bool HASH>
+    void computeRuleWords(int, int, int);
+
+    // Computes the specified words of a row with statistics, counting
+    // the changes with the popcnt instruction.
+    template <unsigned BIRTH, unsigned SURVIVAL, bool HASH>
+    void computePopcountWords(int, int, int);
+
+    // Counts the live cells inside the outermost ring a word at a time.
+    long long countPopulation() const;
+
+    // Counts the live cells with the popcnt instruction.
+    long long countPopcountPopulation() const;
+
+    // Gets the word kernel for the rule, statistics and hashing.
+    template <unsigned BIRTH, unsigned SURVIVAL, bool STATS, bool HASH>
+    WordFunction getWordKernel() const;
+
+    // Selects the word kernel for the rule.
+    template <bool STATS, bool HASH>
+    void selectKernel();
+
+    // Selects the word kernel for the rule, statistics and hashing.
+    void updateKernel();
+
+    // Finds the live extent of each row and adds up the row statistics.
+    void gatherRowStats();
+
+public:
+    // Instantiates a grid of the specified size with all cells dead.
+    PackedGrid(int, int);
+
+    /********************************************************************
+     *  Function:       bool getCell(int x, int y)
+     *  Description:    Gets whether the specified cell is alive.
+     *  Parameters:     x   X coordinate of cell
+     *                  y   Y coordinate of cell
+     *  Preconditions:  x,y is on the grid
+     *  Postconditions: Returns true if the cell is alive
+     *******************************************************************/
+    bool getCell(int x, int y) const
+    {
+        return (current[y * wordsPerRow + (x >> 6)] >> (x & 63)) & 1;
+    }
+
+    // Sets the state of the specified cell.
+    void setCell(int, int, bool);
+
+    // Sets a horizontal run of cells to alive a word at a time.
+    void fillRun(int, int, int);
+
+    // Kills every cell in both buffers.
+    void clear();
+
+    // Counts the live cells inside the outermost ring a word at a time.
+    long long getPopulation() const;
+
+    // Finds the smallest rectangle holding all live cells a word at a time.
+    bool getBounds(int &, int &, int &, int &) const;
+
+    // Copies a horizontal run of cells a word at a time.
+    void getRowBits(int, int, int, uint64_t *) const;
+
+    // Sets a horizontal run of cells a word at a time.
+    void setRowBits(int, int, int, const uint64_t *);
+
+    // Enables or disables evaluating only tiles near changes.
+    void setSparse(bool);
+
+    // Sets the topology of the grid.
+    void setBoundary(Boundary);
+
+    // Fills the outermost ring from the interior for wrapping boundaries.
+    void exchangeHalo();
+
+    // Sets the rule and selects its word kernel.
+    void setRule(const Rule &);
+
+    // Enables or disables counting changes in the word kernel.
+    void setStatsEnabled(bool);
+
+    // Enables or disables hashing changes in the word kernel.
+    void setHashEnabled(bool);
+
+    /********************************************************************
+     *  Function:       int getActiveTileCount()
+     *  Description:    Gets the number of tiles evaluated in the last
+     *                  generation.
+     *  Parameters:     none
+     *  Preconditions:  none
+     *  Postconditions: Returns the active tile count or -1 if sparse
+     *                  mode is disabled
+     *******************************************************************/
+    int getActiveTileCount() const
+    {
+        return sparse ? lastActiveCount : -1;
+    }
+
+    /********************************************************************
+     *  Function:       int getTileCount()
+     *  Description:    Gets the number of tiles in the grid.
+     *  Parameters:     none
+     *  Preconditions:  none
+     *  Postconditions: Returns the total tile count
+     *******************************************************************/
+    int getTileCount() const
+    {
+        return tileRows * wordsPerRow;
+    }
+
+    // Calculates rows first to last - 1 of the next generation.
+    void computeRows(int, int);
+
+    /********************************************************************
+     *  Function:       int getTileAlignment()
+     *  Description:    Gets the multiple of columns at which tiles can
+     *                  split a row, one word. Statistics are added up
+     *                  per row, so with statistics tiles span whole rows.
+     *  Parameters:     none
+     *  Preconditions:  none
+     *  Postconditions: Returns 64, or 0 if statistics are enabled
+     *******************************************************************/
+    int getTileAlignment() const
+    {
+        return statsEnabled ? 0 : 64;
+    }
+
+    // Calculates the words of a rectangle of the next generation.
+    void computeTile(int, int, int, int);
+
+    // Makes the next buffer the current generation.
+    void swapBuffers();
+
+    // Gets the XOR of the keys of the live cells a word at a time.
+    uint64_t getHash() const;
+};
+#endif // end of define PACKEDGRID_HPP
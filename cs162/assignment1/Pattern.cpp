@@ -1,7 +1,7 @@
 /*************************************************************************
  * Author:          David Rigert
  * Date Created:    1/10/2015
- * Last Modified:   1/13/2015
+ * Last Modified:   10/17/2026
  * Assignment:      Assignment 1
  * Filename:        Pattern.cpp
  *
@@ -12,15 +12,17 @@
 #include "Pattern.hpp"
 
 /********************************************************************
- *  Function:       Pattern(std::string name, vgrid &sourceGrid)
+ *  Function:       Pattern(const std::string &name,
+ *                          const vgrid &sourceGrid)
  *  Description:    Instantiates a Pattern with the specified name
  *                  and pattern.
  *  Parameters:     name        Name to assign to pattern
  *                  sourceGrid  Grid pattern to copy to new object
  *******************************************************************/
-Pattern::Pattern(std::string name, vgrid &sourceGrid)
+Pattern::Pattern(const std::string &name, const vgrid &sourceGrid)
 {
     this->name = name;
+    rowsValid = 0;
     
     // Copy source grid to member variable
     std::copy(sourceGrid.begin(), sourceGrid.end(), std::back_inserter(grid));
@@ -35,7 +37,7 @@ Pattern::Pattern(std::string name, vgrid &sourceGrid)
  *  Preconditions:  x,y is a valid cell
  *  Postconditions: Returns true if the cell is alive; false otherwise
  *******************************************************************/
-bool Pattern::getCellState(int x, int y)
+bool Pattern::getCellState(int x, int y) const
 {
     // Validate arguments
     if (x < 0 || y < 0 || x >= getWidth() || y >= getHeight())
@@ -44,4 +46,122 @@ bool Pattern::getCellState(int x, int y)
     }
     
     return grid[y][x];
-}
\ No newline at end of file
+}
+
+/********************************************************************
+ *  Function:       void setCellState(int x, int y, bool alive)
+ *  Description:    Sets the state of the cell at the specified
+ *                  coordinates, so one pattern can be reused for many
+ *                  generated patterns of the same size.
+ *  Parameters:     x       X coordinate of the cell to set
+ *                  y       Y coordinate of the cell to set
+ *                  alive   New state of the cell
+ *  Preconditions:  x,y is a valid cell
+ *  Postconditions: Cell at x,y is alive if alive is true
+ *******************************************************************/
+void Pattern::setCellState(int x, int y, bool alive)
+{
+    // Validate arguments
+    if (x < 0 || y < 0 || x >= getWidth() || y >= getHeight())
+    {
+        throw std::invalid_argument("ERROR: Specified coordinates out of bounds.");
+    }
+    grid[y][x] = alive;
+    rowsValid = 0;
+}
+
+/********************************************************************
+ *  Function:       const uint64_t *getRowBits(int y, Orientation o)
+ *  Description:    Gets a row of the pattern in the specified
+ *                  orientation, packed 64 cells per word with the
+ *                  leftmost cell in the lowest bit. The orientation is
+ *                  packed on first use and kept until a cell changes,
+ *                  so stamping a pattern many times reads its cells
+ *                  only once. Building it writes to the pattern, so
+ *                  threads must not share a pattern whose orientation
+ *                  has not been used yet.
+ *  Parameters:     y   Row of the oriented pattern
+ *                  o   Orientation of the pattern
+ *  Preconditions:  0 <= y < getHeight(o)
+ *  Postconditions: Returns (getWidth(o) + 63) / 64 words, valid until
+ *                  a cell of the pattern changes
+ *******************************************************************/
+const uint64_t *Pattern::getRowBits(int y, Orientation o) const
+{
+    // Validate arguments
+    if (o < IDENTITY || o >= ORIENTATION_COUNT || y < 0 || y >= getHeight(o))
+    {
+        throw std::invalid_argument("ERROR: Specified row out of bounds.");
+    }
+    
+    if (!(rowsValid & (1u << o)))
+    {
+        packRows(o);
+    }
+    return &rows[o][y * ((getWidth(o) + 63) / 64)];
+}
+
+/********************************************************************
+ *  Function:       void packRows(Orientation o)
+ *  Description:    Packs every row of the specified orientation by
+ *                  mapping each of its cells back to the stored cell.
+ *  Parameters:     o   Orientation to pack
+ *  Preconditions:  none
+ *  Postconditions: rows[o] holds the orientation and is marked valid
+ *******************************************************************/
+void Pattern::packRows(Orientation o) const
+{
+    int w = getWidth();
+    int h = getHeight();
+    int width = getWidth(o);
+    int height = getHeight(o);
+    int wordsPerRow = (width + 63) / 64;
+    rows[o].assign(wordsPerRow * height, 0);
+    
+    for (int v = 0; v < height; v++)
+    {
+        uint64_t *row = &rows[o][v * wordsPerRow];
+        for (int u = 0; u < width; u++)
+        {
+            // Find the stored cell that lands on u,v
+            int x = u;
+            int y = v;
+            switch (o)
+            {
+                case ROTATE_90:
+                    x = v;
+                    y = h - 1 - u;
+                    break;
+                case ROTATE_180:
+                    x = w - 1 - u;
+                    y = h - 1 - v;
+                    break;
+                case ROTATE_270:
+                    x = w - 1 - v;
+                    y = u;
+                    break;
+                case FLIP_HORIZONTAL:
+                    x = w - 1 - u;
+                    break;
+                case FLIP_VERTICAL:
+                    y = h - 1 - v;
+                    break;
+                case TRANSPOSE:
+                    x = v;
+                    y = u;
+                    break;
+                case ANTI_TRANSPOSE:
+                    x = w - 1 - v;
+                    y = h - 1 - u;
+                    break;
+                default:
+                    break;
+            }
+            if (grid[y][x])
+            {
+                row[u >> 6] |= static_cast<uint64_t>(1) << (u & 63);
+            }
+        }
+    }
+    rowsValid |= 1u << o;
+}
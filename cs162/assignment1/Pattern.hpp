@@ -1,27 +1,56 @@
 /*************************************************************************
  * Author:          David Rigert
  * Date Created:    1/10/2015
- * Last Modified:   1/13/2015
+ * Last Modified:   10/17/2026
  * Assignment:      Assignment 1
  * Filename:        Pattern.hpp
  *
  * Description:     Represents a pattern of live and dead cells.
+ *                  Besides the cells, a pattern keeps each of its eight
+ *                  orientations packed 64 cells per word in the layout
+ *                  of Grid::setRowBits, built the first time it is
+ *                  stamped in that orientation and reused until a cell
+ *                  changes.
  ************************************************************************/
 #ifndef PATTERN_HPP
 #define PATTERN_HPP
 
 #include <string>
 #include <vector>
+#include <stdint.h>
 
 // Define 2D bool vector as vgrid
 typedef std::vector<std::vector<bool> > vgrid;
 
 class Pattern
 {
+public:
+    // Rotations and reflections of the pattern
+    enum Orientation
+    {
+        IDENTITY,               // as stored
+        ROTATE_90,              // rotated a quarter turn clockwise
+        ROTATE_180,             // rotated a half turn
+        ROTATE_270,             // rotated a quarter turn counterclockwise
+        FLIP_HORIZONTAL,        // left and right swapped
+        FLIP_VERTICAL,          // top and bottom swapped
+        TRANSPOSE,              // reflected across the main diagonal
+        ANTI_TRANSPOSE,         // reflected across the other diagonal
+        ORIENTATION_COUNT
+    };
+
 // member variables
 private:
     std::vector<std::vector<bool> > grid;   // holds the pattern
     std::string name;                       // name of pattern
+    mutable std::vector<uint64_t> rows[ORIENTATION_COUNT];
+                                            // packed rows of orientations
+    mutable unsigned rowsValid;             // bit set for each built one
+
+// member functions
+private:
+    // Packs the rows of the specified orientation.
+    void packRows(Orientation) const;
 
 // member functions    
 public:
@@ -33,49 +62,77 @@ public:
     Pattern()
     {
         name = "";
+        rowsValid = 0;
     }
     
     // Constructs a Pattern object with the specified name and pattern
-    Pattern(std::string, vgrid &);
+    Pattern(const std::string &, const vgrid &);
     
     /********************************************************************
-     *  Function:       int getWidth()
+     *  Function:       int getWidth(Orientation o)
      *  Description:    Gets the width of the pattern grid.
-     *  Parameters:     none
+     *  Parameters:     o   Orientation of the pattern
      *  Preconditions:  none
      *  Postconditions: Returns the width of the grid or 0 if uninitialized
      *******************************************************************/
-    int getWidth()
+    int getWidth(Orientation o = IDENTITY) const
     {
+        if (isTransposed(o))
+        {
+            return grid.size();
+        }
         return grid.size() > 0 ? grid[0].size() : 0;
     }
     
     /********************************************************************
-     *  Function:       int getHeight()
+     *  Function:       int getHeight(Orientation o)
      *  Description:    Gets the height of the pattern grid.
-     *  Parameters:     none
+     *  Parameters:     o   Orientation of the pattern
      *  Preconditions:  none
      *  Postconditions: Returns the height of the grid
      *******************************************************************/
-    int getHeight()
+    int getHeight(Orientation o = IDENTITY) const
     {
+        if (isTransposed(o))
+        {
+            return grid.size() > 0 ? grid[0].size() : 0;
+        }
         return grid.size();
     }
     
     /********************************************************************
-     *  Function:       std::string getName()
+     *  Function:       const std::string &getName()
      *  Description:    Gets the name of the pattern.
      *  Parameters:     none
      *  Preconditions:  none
      *  Postconditions: Returns the name of the pattern
      *******************************************************************/
-    std::string getName()
+    const std::string &getName() const
     {
         return name;
     }
     
+    /********************************************************************
+     *  Function:       bool isTransposed(Orientation o)
+     *  Description:    Gets whether an orientation swaps the width and
+     *                  height of the pattern.
+     *  Parameters:     o   Orientation of the pattern
+     *  Preconditions:  none
+     *  Postconditions: Returns true for quarter turns and diagonals
+     *******************************************************************/
+    static bool isTransposed(Orientation o)
+    {
+        return o == ROTATE_90 || o == ROTATE_270 || o == TRANSPOSE || o == ANTI_TRANSPOSE;
+    }
+    
     // Gets whether the specified cell is alive
-    bool getCellState(int, int);
+    bool getCellState(int, int) const;
+    
+    // Gets the packed cells of a row of the specified orientation
+    const uint64_t *getRowBits(int, Orientation = IDENTITY) const;
+
+    // Sets the state of the specified cell
+    void setCellState(int, int, bool);
 };
 
 #endif // end of define PATTERN_HPP
@@ -0,0 +1,415 @@
+/*************************************************************************
+ * Author:          David Rigert
+ * Date Created:    10/17/2026
+ * Last Modified:   10/17/2026
+ * Assignment:      Assignment 1
+ * Filename:        PatternReader.cpp
+ *
+ * Description:     Implementation of the PatternReader class.
+ *                  Characters are taken straight from the stream buffer
+ *                  instead of through the formatted stream functions,
+ *                  and nothing past the end of the pattern is consumed.
+ ************************************************************************/
+#include <stdexcept>
+#include <cstdlib>
+#include <climits>
+#include <stdint.h>
+#include "PatternReader.hpp"
+#include "Grid.hpp"
+
+// Largest run count accepted, so counts cannot overflow
+static const int MAX_RUN = 100000000;
+
+// Removes spaces and tabs from both ends of a string
+static std::string trim(const std::string &text)
+{
+    size_t first = text.find_first_not_of(" \t");
+    if (first == std::string::npos)
+    {
+        return "";
+    }
+    size_t last = text.find_last_not_of(" \t");
+    return text.substr(first, last - first + 1);
+}
+
+// Throws if a run of live cells at x,y does not fit on a bounded grid
+static void checkRun(const Grid *grid, int x, int y, int count)
+{
+    if (grid->isBounded() && (x < 0 || y < 0 || y >= grid->getHeight()
+                              || count > grid->getWidth() - x))
+    {
+        throw std::invalid_argument("ERROR: Pattern too large for coordinates.");
+    }
+}
+
+// Moves a position by run cells, throwing if the position or the
+// coordinate origin + position would no longer fit in an int
+static int advance(int origin, int position, int run)
+{
+    int64_t end = static_cast<int64_t>(position) + run;
+    if (end > INT_MAX || origin + end > INT_MAX)
+    {
+        throw std::invalid_argument("ERROR: Pattern too large for coordinates.");
+    }
+    return static_cast<int>(end);
+}
+
+/********************************************************************
+ *  Function:       PatternReader(std::istream &stream)
+ *  Description:    Skips blank lines, detects the format from the
+ *                  first character and reads the header. A .cells
+ *                  pattern starts with ! or a row of cells; anything
+ *                  else is read as RLE.
+ *  Parameters:     stream  Stream positioned at the start of a pattern
+ *******************************************************************/
+PatternReader::PatternReader(std::istream &stream)
+{
+    in = stream.rdbuf();
+    width = -1;
+    height = -1;
+    ruleGiven = false;
+    done = false;
+    
+    int c = in->sgetc();
+    while (c == ' ' || c == '\t' || c == '\r' || c == '\n')
+    {
+        c = in->snextc();
+    }
+    if (c == EOF)
+    {
+        throw std::invalid_argument("ERROR: No pattern found.");
+    }
+    
+    if (c == '!' || c == '.' || c == 'O' || c == '*')
+    {
+        format = FORMAT_CELLS;
+        readCellsHeader();
+    }
+    else
+    {
+        format = FORMAT_RLE;
+        readRleHeader();
+    }
+}
+
+/********************************************************************
+ *  Function:       std::string readLine()
+ *  Description:    Reads up to the end of the line, dropping the line
+ *                  break and any carriage return.
+ *  Parameters:     none
+ *  Preconditions:  none
+ *  Postconditions: Returns the line; the stream is after the line break
+ *******************************************************************/
+std::string PatternReader::readLine()
+{
+    std::string line;
+    int c = in->sbumpc();
+    while (c != EOF && c != '\n')
+    {
+        if (c != '\r')
+        {
+            line += static_cast<char>(c);
+        }
+        c = in->sbumpc();
+    }
+    return line;
+}
+
+/********************************************************************
+ *  Function:       void readRleHeader()
+ *  Description:    Reads the # comment lines, keeping the name from
+ *                  #N and an old-style rule from #r, and then the
+ *                  "x = m, y = n, rule = B3/S23" header line. Anything
+ *                  after a colon in the rule, such as a bounded grid
+ *                  suffix, is ignored.
+ *  Parameters:     none
+ *  Preconditions:  Stream is at the start of an RLE pattern
+ *  Postconditions: Header fields are set; throws invalid_argument if
+ *                  the header is missing or invalid
+ *******************************************************************/
+void PatternReader::readRleHeader()
+{
+    std::string line = readLine();
+    while (line.empty() || line[0] == '#')
+    {
+        if (line.empty() && in->sgetc() == EOF)
+        {
+            throw std::invalid_argument("ERROR: RLE header must give x and y.");
+        }
+        if (line.size() > 1 && line[1] == 'N')
+        {
+            name = trim(line.substr(2));
+        }
+        else if (line.size() > 1 && line[1] == 'r')
+        {
+            rule = Rule(trim(line.substr(2)));
+            ruleGiven = true;
+        }
+        line = readLine();
+    }
+    
+    // Header fields are separated by commas
+    size_t start = 0;
+    while (start < line.size())
+    {
+        size_t comma = line.find(',', start);
+        if (comma == std::string::npos)
+        {
+            comma = line.size();
+        }
+        std::string field = line.substr(start, comma - start);
+        start = comma + 1;
+    
+        size_t equals = field.find('=');
+        if (equals == std::string::npos)
+        {
+            throw std::invalid_argument("ERROR: Invalid RLE header.");
+        }
+        std::string key = trim(field.substr(0, equals));
+        std::string value = trim(field.substr(equals + 1));
+        if (key == "x")
+        {
+            width = std::atoi(value.c_str());
+        }
+        else if (key == "y")
+        {
+            height = std::atoi(value.c_str());
+        }
+        else if (key == "rule")
+        {
+            rule = Rule(value.substr(0, value.find(':')));
+            ruleGiven = true;
+        }
+    }
+    
+    if (width < 0 || height < 0)
+    {
+        throw std::invalid_argument("ERROR: RLE header must give x and y.");
+    }
+}
+
+/********************************************************************
+ *  Function:       void readCellsHeader()
+ *  Description:    Reads the ! comment lines at the top of a .cells
+ *                  pattern, keeping the name from "!Name:".
+ *  Parameters:     none
+ *  Preconditions:  Stream is at the start of a .cells pattern
+ *  Postconditions: Stream is at the first row of cells
+ *******************************************************************/
+void PatternReader::readCellsHeader()
+{
+    while (in->sgetc() == '!')
+    {
+        std::string line = readLine();
+        if (line.compare(0, 6, "!Name:") == 0)
+        {
+            name = trim(line.substr(6));
+        }
+    }
+}
+
+/********************************************************************
+ *  Function:       void readRleCells(Grid *grid, int left, int top)
+ *  Description:    Decodes the runs up to the closing !. Each run of
+ *                  live cells is written with Grid::fillRun; dead
+ *                  cells and line ends only move the position, so the
+ *                  existing cells under dead cells are kept. In the
+ *                  multi-state form, A is state 1 like o and the
+ *                  letters B to X are states 2 to 24, set one cell at
+ *                  a time with Grid::setState. Every run is checked so
+ *                  the position never leaves the int range.
+ *  Parameters:     grid    Grid to write to, or NULL to skip the cells
+ *                  left    X coordinate of the top-left corner
+ *                  top     Y coordinate of the top-left corner
+ *  Preconditions:  Header has been read
+ *  Postconditions: Stream is after the line holding the !; throws
+ *                  invalid_argument if the cells are invalid
+ *******************************************************************/
+void PatternReader::readRleCells(Grid *grid, int left, int top)
+{
+    int x = 0;
+    int y = 0;
+    int end = 0;                // x after the current run
+    int count = 0;
+    
+    for (;;)
+    {
+        int c = in->sbumpc();
+        if (c >= '0' && c <= '9')
+        {
+            count = count * 10 + (c - '0');
+            if (count > MAX_RUN)
+            {
+                throw std::invalid_argument("ERROR: RLE run count too large.");
+            }
+            continue;
+        }
+    
+        int run = count > 0 ? count : 1;
+        count = 0;
+        switch (c)
+        {
+            case 'b':
+            case '.':
+                x = advance(left, x, run);
+                break;
+            case 'o':
+            case 'A':
+                end = advance(left, x, run);
+                if (grid)
+                {
+                    checkRun(grid, left + x, top + y, run);
+                    grid->fillRun(left + x, top + y, run);
+                }
+                x = end;
+                break;
+            case '$':
+                x = 0;
+                y = advance(top, y, run);
+                break;
+            case '!':
+                readLine();
+                return;
+            case ' ':
+            case '\t':
+            case '\r':
+            case '\n':
+                break;
+            case EOF:
+                throw std::invalid_argument("ERROR: RLE pattern ended without !.");
+            default:
+                if (c < 'B' || c > 'X')
+                {
+                    throw std::invalid_argument("ERROR: Invalid character in RLE pattern.");
+                }
+                end = advance(left, x, run);
+                if (grid)
+                {
+                    checkRun(grid, left + x, top + y, run);
+                    for (int i = 0; i < run; i++)
+                    {
+                        grid->setState(left + x + i, top + y, c - 'A' + 1);
+                    }
+                }
+                x = end;
+        }
+    }
+}
+
+/********************************************************************
+ *  Function:       void readCellsCells(Grid *grid, int left, int top)
+ *  Description:    Reads rows of . (dead) and O or * (alive) up to the
+ *                  end of the stream, writing each run of live cells
+ *                  with Grid::fillRun. Later ! lines are comments.
+ *  Parameters:     grid    Grid to write to, or NULL to skip the cells
+ *                  left    X coordinate of the top-left corner
+ *                  top     Y coordinate of the top-left corner
+ *  Preconditions:  Header has been read
+ *  Postconditions: Stream is at its end; throws invalid_argument if
+ *                  the cells are invalid
+ *******************************************************************/
+void PatternReader::readCellsCells(Grid *grid, int left, int top)
+{
+    int x = 0;
+    int y = 0;
+    int run = 0;                // live cells not yet written
+    
+    for (;;)
+    {
+        int c = in->sbumpc();
+        if (c == 'O' || c == '*')
+        {
+            run++;
+            x++;
+            continue;
+        }
+    
+        if (run > 0 && grid)
+        {
+            checkRun(grid, left + x - run, top + y, run);
+            grid->fillRun(left + x - run, top + y, run);
+        }
+        run = 0;
+    
+        switch (c)
+        {
+            case '.':
+                x++;
+                break;
+            case '\n':
+                x = 0;
+                y++;
+                break;
+            case '!':
+                if (x == 0)
+                {
+                    readLine();
+                    break;
+                }
+                throw std::invalid_argument("ERROR: Invalid character in .cells pattern.");
+            case ' ':
+            case '\t':
+            case '\r':
+                break;
+            case EOF:
+                return;
+            default:
+                throw std::invalid_argument("ERROR: Invalid character in .cells pattern.");
+        }
+    }
+}
+
+/********************************************************************
+ *  Function:       void readInto(Grid &grid, int x, int y)
+ *  Description:    Streams the live cells of the pattern into a grid.
+ *                  On a bounded grid a run that does not fit throws,
+ *                  leaving the runs before it on the grid.
+ *  Parameters:     grid    Grid to write to
+ *                  x       X coordinate of the top-left corner
+ *                  y       Y coordinate of the top-left corner
+ *  Preconditions:  Cells have not been read yet
+ *  Postconditions: Live cells of the pattern are set on grid
+ *******************************************************************/
+void PatternReader::readInto(Grid &grid, int x, int y)
+{
+    if (done)
+    {
+        throw std::logic_error("ERROR: Pattern cells have already been read.");
+    }
+    done = true;
+    
+    if (format == FORMAT_RLE)
+    {
+        readRleCells(&grid, x, y);
+    }
+    else
+    {
+        readCellsCells(&grid, x, y);
+    }
+}
+
+/********************************************************************
+ *  Function:       void skip()
+ *  Description:    Reads past the cells so that the next pattern in
+ *                  the stream can be read.
+ *  Parameters:     none
+ *  Preconditions:  Cells have not been read yet
+ *  Postconditions: Stream is after the pattern
+ *******************************************************************/
+void PatternReader::skip()
+{
+    if (done)
+    {
+        throw std::logic_error("ERROR: Pattern cells have already been read.");
+    }
+    done = true;
+    
+    if (format == FORMAT_RLE)
+    {
+        readRleCells(NULL, 0, 0);
+    }
+    else
+    {
+        readCellsCells(NULL, 0, 0);
+    }
+}
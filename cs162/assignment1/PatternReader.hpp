@@ -0,0 +1,151 @@
+/*************************************************************************
+ * Author:          David Rigert
+ * Date Created:    10/17/2026
+ * Last Modified:   10/17/2026
+ * Assignment:      Assignment 1
+ * Filename:        PatternReader.hpp
+ *
+ * Description:     Reads patterns in the run length encoded (RLE) format
+ *                  used by Golly and in the plaintext .cells format. The
+ *                  header is read when the reader is created, and the
+ *                  cells are streamed straight into a Grid one run of
+ *                  live cells at a time, so no copy of the whole pattern
+ *                  is ever built in memory. Several RLE patterns can be
+ *                  read from the same stream one after another.
+ ************************************************************************/
+#ifndef PATTERNREADER_HPP
+#define PATTERNREADER_HPP
+
+#include <istream>
+#include <string>
+#include "Rule.hpp"
+
+// forward declaration
+class Grid;
+
+class PatternReader
+{
+public:
+    // Supported file formats
+    enum Format
+    {
+        FORMAT_RLE,             // x = 3, y = 3 header and b/o/$ runs
+        FORMAT_CELLS            // ! comments and rows of . and O
+    };
+
+// member variables
+private:
+    std::streambuf *in;         // buffer of the stream being read
+    Format format;              // format detected from the first line
+    std::string name;           // from #N or !Name:, or empty
+    int width;                  // from the RLE header, or -1
+    int height;                 // from the RLE header, or -1
+    Rule rule;                  // from the RLE header, or Conway's rule
+    bool ruleGiven;             // whether the header specified a rule
+    bool done;                  // whether the cells have been read
+
+// member functions
+private:
+    // PatternReader reads from a borrowed stream, so copying is not allowed
+    PatternReader(const PatternReader &);
+    PatternReader &operator=(const PatternReader &);
+
+    // Reads the rest of the current line.
+    std::string readLine();
+
+    // Reads the comments and header of an RLE pattern.
+    void readRleHeader();
+
+    // Reads the comments of a .cells pattern.
+    void readCellsHeader();
+
+    // Streams the cells of an RLE pattern into a grid.
+    void readRleCells(Grid *, int, int);
+
+    // Streams the cells of a .cells pattern into a grid.
+    void readCellsCells(Grid *, int, int);
+
+public:
+    // Detects the format and reads the header of the next pattern.
+    PatternReader(std::istream &);
+
+    /********************************************************************
+     *  Function:       Format getFormat()
+     *  Description:    Gets the format detected from the stream.
+     *  Parameters:     none
+     *  Preconditions:  none
+     *  Postconditions: Returns FORMAT_RLE or FORMAT_CELLS
+     *******************************************************************/
+    Format getFormat() const
+    {
+        return format;
+    }
+
+    /********************************************************************
+     *  Function:       std::string getName()
+     *  Description:    Gets the name of the pattern.
+     *  Parameters:     none
+     *  Preconditions:  none
+     *  Postconditions: Returns the name or an empty string
+     *******************************************************************/
+    std::string getName() const
+    {
+        return name;
+    }
+
+    /********************************************************************
+     *  Function:       int getWidth()
+     *  Description:    Gets the width given in the RLE header.
+     *  Parameters:     none
+     *  Preconditions:  none
+     *  Postconditions: Returns the width or -1 for .cells patterns
+     *******************************************************************/
+    int getWidth() const
+    {
+        return width;
+    }
+
+    /********************************************************************
+     *  Function:       int getHeight()
+     *  Description:    Gets the height given in the RLE header.
+     *  Parameters:     none
+     *  Preconditions:  none
+     *  Postconditions: Returns the height or -1 for .cells patterns
+     *******************************************************************/
+    int getHeight() const
+    {
+        return height;
+    }
+
+    /********************************************************************
+     *  Function:       bool hasRule()
+     *  Description:    Gets whether the header specified a rule.
+     *  Parameters:     none
+     *  Preconditions:  none
+     *  Postconditions: Returns true if getRule was read from the header
+     *******************************************************************/
+    bool hasRule() const
+    {
+        return ruleGiven;
+    }
+
+    /********************************************************************
+     *  Function:       const Rule &getRule()
+     *  Description:    Gets the rule given in the header.
+     *  Parameters:     none
+     *  Preconditions:  none
+     *  Postconditions: Returns the rule, Conway's rule if none was given
+     *******************************************************************/
+    const Rule &getRule() const
+    {
+        return rule;
+    }
+
+    // Reads the cells into a grid with the top-left corner at x,y.
+    void readInto(Grid &, int, int);
+
+    // Reads past the cells without storing them.
+    void skip();
+};
+
+#endif // end of define PATTERNREADER_HPP
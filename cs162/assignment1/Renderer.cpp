@@ -0,0 +1,266 @@
+/*************************************************************************
+ * Author:          David Rigert
+ * Date Created:    10/17/2026
+ * Last Modified:   10/17/2026
+ * Assignment:      Assignment 1
+ * Filename:        Renderer.cpp
+ *
+ * Description:     Implementation of the Renderer class.
+ ************************************************************************/
+#include <iostream>
+#include "Renderer.hpp"
+#include "Grid.hpp"
+
+// Include unix headers if running on Linux
+#if defined(__linux__)
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+// A cursor move costs at least 6 bytes, so shorter gaps are overwritten
+static const int MAX_GAP = 5;
+
+// Appends a positive number to a string without a stream
+static void appendNumber(std::string &text, int value)
+{
+    char digits[12];
+    int count = 0;
+    do
+    {
+        digits[count++] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while (value > 0);
+    while (count > 0)
+    {
+        text += digits[--count];
+    }
+}
+
+// Appends the escape code that moves the cursor to a 0-based row and column
+static void appendMove(std::string &text, int row, int col)
+{
+    text += "\033[";
+    appendNumber(text, row + 1);
+    text += ';';
+    appendNumber(text, col + 1);
+    text += 'H';
+}
+
+/********************************************************************
+ *  Function:       Renderer(int width, int height, int fd)
+ *  Description:    Instantiates a renderer with nothing on screen, so
+ *                  the first frame clears the screen, hides the cursor
+ *                  and draws every cell.
+ *  Parameters:     width   Columns of cells to draw
+ *                  height  Rows of cells to draw
+ *                  fd      File descriptor to write frames to, or -1 to
+ *                          discard them
+ *******************************************************************/
+Renderer::Renderer(int width, int height, int fd)
+{
+    this->width = width;
+    this->height = height;
+    this->fd = fd;
+    screen.assign(width * height, UNKNOWN);
+    changedCount = 0;
+    fresh = true;
+}
+
+/********************************************************************
+ *  Function:       const std::string &renderFrame(
+ *                      const unsigned char *cells, const std::string &status)
+ *  Description:    Compares the cells with the screen and builds the
+ *                  output for the cells that changed. In a row, the
+ *                  cursor only moves for gaps longer than MAX_GAP;
+ *                  shorter gaps are overwritten with the cells already
+ *                  on screen. The status lines are drawn below the
+ *                  cells, clearing the rest of each line.
+ *  Parameters:     cells   Rows of the window, 1 for a live cell and 0
+ *                          for a dead cell
+ *                  status  Lines to show below the cells, each ending
+ *                          with a newline
+ *  Preconditions:  cells holds width * height values
+ *  Postconditions: Returns the output; the screen is assumed updated
+ *******************************************************************/
+const std::string &Renderer::renderFrame(const unsigned char *cells,
+                                         const std::string &status)
+{
+    output.clear();
+    changedCount = 0;
+    if (fresh)
+    {
+        output += "\033[2J\033[?25l";
+        fresh = false;
+    }
+    
+    for (int y = 0; y < height; y++)
+    {
+        unsigned char *row = &screen[y * width];
+        const unsigned char *next = cells + y * width;
+        int cursor = -1 - MAX_GAP;  // column of the cursor in this row
+        for (int x = 0; x < width; x++)
+        {
+            if (next[x] == row[x])
+            {
+                continue;
+            }
+    
+            if (x - cursor > MAX_GAP)
+            {
+                appendMove(output, y, x);
+            }
+            else
+            {
+                for (int gap = cursor; gap < x; gap++)
+                {
+                    output += row[gap] ? '#' : ' ';
+                }
+            }
+            output += next[x] ? '#' : ' ';
+            row[x] = next[x];
+            cursor = x + 1;
+            changedCount++;
+        }
+    }
+    
+    // Status lines replace whatever was below the cells
+    appendMove(output, height, 0);
+    size_t start = 0;
+    size_t end = status.find('\n');
+    while (end != std::string::npos)
+    {
+        output.append(status, start, end - start);
+        output += "\033[K\n";
+        start = end + 1;
+        end = status.find('\n', start);
+    }
+    return output;
+}
+
+/********************************************************************
+ *  Function:       const std::string &renderFrame(const Grid &grid,
+ *                      int left, int top, const std::string &status)
+ *  Description:    Copies the window of the grid and renders it.
+ *  Parameters:     grid    Grid to draw
+ *                  left    X coordinate of the first column drawn
+ *                  top     Y coordinate of the first row drawn
+ *                  status  Lines to show below the cells, each ending
+ *                          with a newline
+ *  Preconditions:  The window is on the grid
+ *  Postconditions: Returns the output; the screen is assumed updated
+ *******************************************************************/
+const std::string &Renderer::renderFrame(const Grid &grid, int left, int top,
+                                         const std::string &status)
+{
+    copyWindow(grid, left, top, window);
+    return renderFrame(window.data(), status);
+}
+
+/********************************************************************
+ *  Function:       void copyWindow(const Grid &grid, int left, int top,
+ *                                  std::vector<unsigned char> &cells)
+ *  Description:    Copies the cells of the window of a grid, so they
+ *                  can be drawn later while the grid keeps changing.
+ *  Parameters:     grid    Grid to copy from
+ *                  left    X coordinate of the first column copied
+ *                  top     Y coordinate of the first row copied
+ *                  cells   Receives the rows of the window
+ *  Preconditions:  The window is on the grid
+ *  Postconditions: cells holds width * height values of 0 or 1
+ *******************************************************************/
+void Renderer::copyWindow(const Grid &grid, int left, int top,
+                          std::vector<unsigned char> &cells) const
+{
+    cells.resize(width * height);
+    for (int y = 0; y < height; y++)
+    {
+        for (int x = 0; x < width; x++)
+        {
+            cells[y * width + x] = grid.getCell(left + x, top + y);
+        }
+    }
+}
+
+/********************************************************************
+ *  Function:       void drawFrame(const unsigned char *cells,
+ *                                 const std::string &status)
+ *  Description:    Renders a frame and writes it with one write call,
+ *                  after flushing anything buffered in std::cout.
+ *  Parameters:     See renderFrame
+ *  Preconditions:  cells holds width * height values
+ *  Postconditions: The terminal shows the cells
+ *******************************************************************/
+void Renderer::drawFrame(const unsigned char *cells, const std::string &status)
+{
+    renderFrame(cells, status);
+    writeOutput();
+}
+
+/********************************************************************
+ *  Function:       void drawFrame(const Grid &grid, int left, int top,
+ *                                 const std::string &status)
+ *  Description:    Renders a frame of a grid window and writes it.
+ *  Parameters:     See renderFrame
+ *  Preconditions:  The window is on the grid
+ *  Postconditions: The terminal shows the window of the grid
+ *******************************************************************/
+void Renderer::drawFrame(const Grid &grid, int left, int top,
+                         const std::string &status)
+{
+    renderFrame(grid, left, top, status);
+    writeOutput();
+}
+
+/********************************************************************
+ *  Function:       void writeOutput()
+ *  Description:    Writes the rendered frame with one write call,
+ *                  after flushing anything buffered in std::cout.
+ *  Parameters:     none
+ *  Preconditions:  A frame has been rendered
+ *  Postconditions: The frame has been written to the file descriptor
+ *******************************************************************/
+void Renderer::writeOutput()
+{
+    if (fd < 0)
+    {
+        return;
+    }
+    std::cout.flush();
+    
+    #if defined(__linux__)
+    const char *data = output.data();
+    size_t remaining = output.size();
+    while (remaining > 0)
+    {
+        ssize_t written = write(fd, data, remaining);
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            break;
+        }
+        data += written;
+        remaining -= written;
+    }
+    #else
+    std::cout.write(output.data(), output.size());
+    std::cout.flush();
+    #endif
+}
+
+/********************************************************************
+ *  Function:       void showCursor()
+ *  Description:    Shows the cursor hidden by the first frame again.
+ *                  The next frame clears the screen.
+ *  Parameters:     none
+ *  Preconditions:  none
+ *  Postconditions: Cursor is visible
+ *******************************************************************/
+void Renderer::showCursor()
+{
+    output = "\033[?25h";
+    writeOutput();
+    invalidate();
+}
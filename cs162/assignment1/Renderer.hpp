@@ -0,0 +1,94 @@
+/*************************************************************************
+ * Author:          David Rigert
+ * Date Created:    10/17/2026
+ * Last Modified:   10/17/2026
+ * Assignment:      Assignment 1
+ * Filename:        Renderer.hpp
+ *
+ * Description:     Draws a window of a Grid in an ANSI terminal. The
+ *                  renderer remembers the last frame it drew, so each
+ *                  new frame only moves the cursor to the cells that
+ *                  changed, and the whole frame is written with a single
+ *                  write() call so the terminal never shows half a frame.
+ ************************************************************************/
+#ifndef RENDERER_HPP
+#define RENDERER_HPP
+
+#include <string>
+#include <vector>
+
+// forward declaration
+class Grid;
+
+class Renderer
+{
+// member variables
+private:
+    int width;                  // columns of cells drawn
+    int height;                 // rows of cells drawn
+    int fd;                     // file descriptor written to, or -1
+    std::vector<unsigned char> screen;  // cells on screen, or UNKNOWN
+    std::string output;         // escape codes and cells of the frame
+    int changedCount;           // cells drawn in the last frame
+    bool fresh;                 // whether the screen must be cleared first
+    std::vector<unsigned char> window;  // cells copied from the grid
+
+    enum { UNKNOWN = 2 };       // screen value of a cell not yet drawn
+
+// member functions
+private:
+    // Writes the output of the last frame to the file descriptor.
+    void writeOutput();
+
+public:
+    // Instantiates a renderer for a window of the specified size.
+    Renderer(int, int, int = 1);
+
+    /********************************************************************
+     *  Function:       void invalidate()
+     *  Description:    Forgets the screen contents, so the next frame
+     *                  clears the screen and draws every cell. Call this
+     *                  after anything else has been written to the
+     *                  terminal.
+     *  Parameters:     none
+     *  Preconditions:  none
+     *  Postconditions: Next frame is a full redraw
+     *******************************************************************/
+    void invalidate()
+    {
+        screen.assign(screen.size(), UNKNOWN);
+        fresh = true;
+    }
+
+    /********************************************************************
+     *  Function:       int getChangedCount()
+     *  Description:    Gets the number of cells drawn in the last frame.
+     *  Parameters:     none
+     *  Preconditions:  none
+     *  Postconditions: Returns the changed cell count
+     *******************************************************************/
+    int getChangedCount() const
+    {
+        return changedCount;
+    }
+
+    // Copies the cells of a grid window into a vector.
+    void copyWindow(const Grid &, int, int, std::vector<unsigned char> &) const;
+
+    // Builds the output that updates the screen to the cells.
+    const std::string &renderFrame(const unsigned char *, const std::string &);
+
+    // Builds the output that updates the screen to the grid window.
+    const std::string &renderFrame(const Grid &, int, int, const std::string &);
+
+    // Renders a frame of cells and writes it to the file descriptor.
+    void drawFrame(const unsigned char *, const std::string &);
+
+    // Renders a frame of a grid window and writes it to the file descriptor.
+    void drawFrame(const Grid &, int, int, const std::string &);
+
+    // Shows the cursor again after the frames have been drawn.
+    void showCursor();
+};
+
+#endif // end of define RENDERER_HPP
@@ -0,0 +1,197 @@
+/*************************************************************************
+ * Author:          David Rigert
+ * Date Created:    10/17/2026
+ * Last Modified:   10/17/2026
+ * Assignment:      Assignment 1
+ * Filename:        Rule.cpp
+ *
+ * Description:     Implementation of the Rule class.
+ ************************************************************************/
+#include <stdexcept>
+#include <cctype>
+#include <cstdlib>
+#include <sstream>
+#include <vector>
+#include "Rule.hpp"
+
+// Converts the digits of one part of a rule string into a count mask
+static unsigned parseCounts(const std::string &digits)
+{
+    unsigned mask = 0;
+    for (unsigned i = 0; i < digits.size(); i++)
+    {
+        if (digits[i] < '0' || digits[i] > '8')
+        {
+            throw std::invalid_argument("ERROR: Neighbor counts must be digits from 0 to 8.");
+        }
+        mask |= 1u << (digits[i] - '0');
+    }
+    return mask;
+}
+
+/********************************************************************
+ *  Function:       Rule(unsigned birth, unsigned survival, int states)
+ *  Description:    Instantiates a rule from count masks. With more
+ *                  than two states it is a Generations rule.
+ *  Parameters:     birth       Bit n set if n neighbors bring a cell to life
+ *                  survival    Bit n set if n neighbors keep a cell alive
+ *                  states      Number of states, including dead and alive
+ *******************************************************************/
+Rule::Rule(unsigned birth, unsigned survival, int states)
+{
+    // Validate arguments
+    if (birth > ALL_COUNTS || survival > ALL_COUNTS)
+    {
+        throw std::invalid_argument("ERROR: Neighbor counts must be from 0 to 8.");
+    }
+    if (states < 2 || states > MAX_STATES)
+    {
+        throw std::invalid_argument("ERROR: Rule must have 2 to 16 states.");
+    }
+    
+    masks[0] = birth;
+    masks[1] = survival;
+    family = states > 2 ? GENERATIONS : LIFE_LIKE;
+    this->states = states;
+}
+
+/********************************************************************
+ *  Function:       Rule wireworld()
+ *  Description:    Creates the Wireworld rule. The masks hold the head
+ *                  counts that turn a conductor into a head.
+ *  Parameters:     none
+ *  Preconditions:  none
+ *  Postconditions: Returns a rule with 4 states
+ *******************************************************************/
+Rule Rule::wireworld()
+{
+    Rule rule((1 << 1) | (1 << 2), 0);
+    rule.family = WIREWORLD;
+    rule.states = 4;
+    return rule;
+}
+
+/********************************************************************
+ *  Function:       Rule(const std::string &notation)
+ *  Description:    Instantiates a rule from B/S notation, such as
+ *                  "B3/S23" or "B36/S23", in either order and either
+ *                  case. The older S/B form without letters, such as
+ *                  "23/3", is also accepted. A third part gives the
+ *                  states of a Generations rule, such as "B2/S/C3" or
+ *                  "/2/3", and "Wireworld" names that rule.
+ *  Parameters:     notation    Rule string to parse
+ *******************************************************************/
+Rule::Rule(const std::string &notation)
+{
+    std::string lower;
+    for (unsigned i = 0; i < notation.size(); i++)
+    {
+        lower += static_cast<char>(std::tolower(notation[i]));
+    }
+    if (lower == "wireworld")
+    {
+        *this = wireworld();
+        return;
+    }
+    
+    // Split into two or three parts
+    std::vector<std::string> parts;
+    size_t start = 0;
+    for (;;)
+    {
+        size_t slash = notation.find('/', start);
+        parts.push_back(notation.substr(start, slash - start));
+        if (slash == std::string::npos)
+        {
+            break;
+        }
+        start = slash + 1;
+    }
+    if (parts.size() < 2 || parts.size() > 3)
+    {
+        throw std::invalid_argument("ERROR: Rule must have the form B3/S23.");
+    }
+    
+    // States come last, with a letter only in the B/S form
+    states = 2;
+    if (parts.size() == 3)
+    {
+        std::string count = parts[2];
+        if (!count.empty() && (std::toupper(count[0]) == 'C' || std::toupper(count[0]) == 'G'))
+        {
+            count = count.substr(1);
+        }
+        if (count.empty() || count.size() > 2
+            || count.find_first_not_of("0123456789") != std::string::npos)
+        {
+            throw std::invalid_argument("ERROR: Rule must have the form B2/S/C3.");
+        }
+        states = std::atoi(count.c_str());
+        if (states < 2 || states > MAX_STATES)
+        {
+            throw std::invalid_argument("ERROR: Rule must have 2 to 16 states.");
+        }
+    }
+    family = states > 2 ? GENERATIONS : LIFE_LIKE;
+    
+    // Without letters the survival counts come first
+    if (parts[0].empty() || std::isdigit(parts[0][0]))
+    {
+        masks[1] = parseCounts(parts[0]);
+        masks[0] = parseCounts(parts[1]);
+        return;
+    }
+    
+    bool seen[2] = { false, false };
+    for (int i = 0; i < 2; i++)
+    {
+        char letter = parts[i].empty() ? '\0' : std::toupper(parts[i][0]);
+        int which = letter == 'B' ? 0 : (letter == 'S' ? 1 : -1);
+        if (which < 0 || seen[which])
+        {
+            throw std::invalid_argument("ERROR: Rule must have the form B3/S23.");
+        }
+        seen[which] = true;
+        masks[which] = parseCounts(parts[i].substr(1));
+    }
+}
+
+/********************************************************************
+ *  Function:       std::string toString()
+ *  Description:    Formats the rule in B/S notation, with the states
+ *                  of a Generations rule after a third slash.
+ *  Parameters:     none
+ *  Preconditions:  none
+ *  Postconditions: Returns the rule, such as "B3/S23" or "B2/S/C3"
+ *******************************************************************/
+std::string Rule::toString() const
+{
+    if (family == WIREWORLD)
+    {
+        return "Wireworld";
+    }
+    
+    std::string text = "B";
+    for (int n = 0; n <= 8; n++)
+    {
+        if (getNextState(false, n))
+        {
+            text += static_cast<char>('0' + n);
+        }
+    }
+    text += "/S";
+    for (int n = 0; n <= 8; n++)
+    {
+        if (getNextState(true, n))
+        {
+            text += static_cast<char>('0' + n);
+        }
+    }
+    if (family == GENERATIONS)
+    {
+        std::ostringstream count;
+        count << "/C" << states;
+        text += count.str();
+    }
+    return text;
+}
@@ -0,0 +1,186 @@
+/*************************************************************************
+ * Author:          David Rigert
+ * Date Created:    10/17/2026
+ * Last Modified:   10/17/2026
+ * Assignment:      Assignment 1
+ * Filename:        Rule.hpp
+ *
+ * Description:     Represents a Life-like (outer totalistic) rule. The
+ *                  rule is stored as two masks of neighbor counts: bit
+ *                  n of the birth mask is set if a dead cell with n live
+ *                  neighbors comes to life, and bit n of the survival
+ *                  mask is set if a live cell with n live neighbors
+ *                  stays alive. Conway's Game of Life is B3/S23.
+ *
+ *                  A rule can also have more than two states. In a
+ *                  Generations rule such as Brian's Brain (B2/S/C3),
+ *                  state 1 is alive and a live cell that does not
+ *                  survive decays through states 2 to C - 1 before it
+ *                  is dead again; only live cells are counted as
+ *                  neighbors and decaying cells cannot be born. In
+ *                  Wireworld, state 1 is an electron head, 2 a tail and
+ *                  3 a conductor, which becomes a head next to 1 or 2
+ *                  heads. State 0 is always dead.
+ ************************************************************************/
+#ifndef RULE_HPP
+#define RULE_HPP
+
+#include <string>
+
+class Rule
+{
+public:
+    // Masks of the rules with kernels specialized at compile time
+    static const unsigned CONWAY_BIRTH = 1 << 3;
+    static const unsigned CONWAY_SURVIVAL = (1 << 2) | (1 << 3);
+    static const unsigned HIGHLIFE_BIRTH = (1 << 3) | (1 << 6);
+    static const unsigned HIGHLIFE_SURVIVAL = (1 << 2) | (1 << 3);
+    static const unsigned DAY_NIGHT_BIRTH = (1 << 3) | (1 << 6) | (1 << 7) | (1 << 8);
+    static const unsigned DAY_NIGHT_SURVIVAL = (1 << 3) | (1 << 4) | (1 << 6)
+                                             | (1 << 7) | (1 << 8);
+    static const unsigned ALL_COUNTS = (1 << 9) - 1;
+    static const int MAX_STATES = 16;   // most states a rule can have
+
+    // Kinds of rules, each with its own kernels
+    enum Family
+    {
+        LIFE_LIKE,              // two states, births and survivals
+        GENERATIONS,            // live cells decay through more states
+        WIREWORLD               // electrons moving along conductors
+    };
+
+// member variables
+private:
+    unsigned masks[2];          // birth mask, then survival mask
+    Family family;              // kind of rule
+    int states;                 // number of states, 2 if LIFE_LIKE
+
+// member functions
+public:
+    /********************************************************************
+     *  Function:       Rule()
+     *  Description:    The default constructor. Creates Conway's rule.
+     *******************************************************************/
+    Rule()
+    {
+        masks[0] = CONWAY_BIRTH;
+        masks[1] = CONWAY_SURVIVAL;
+        family = LIFE_LIKE;
+        states = 2;
+    }
+
+    // Constructs a rule from birth and survival masks and a state count.
+    Rule(unsigned, unsigned, int = 2);
+
+    // Constructs a rule from notation such as "B36/S23" or "B2/S/C3".
+    Rule(const std::string &);
+
+    // Creates the Wireworld rule.
+    static Rule wireworld();
+
+    /********************************************************************
+     *  Function:       Family getFamily()
+     *  Description:    Gets the kind of rule.
+     *  Parameters:     none
+     *  Preconditions:  none
+     *  Postconditions: Returns LIFE_LIKE for rules with two states
+     *******************************************************************/
+    Family getFamily() const
+    {
+        return family;
+    }
+
+    /********************************************************************
+     *  Function:       int getStateCount()
+     *  Description:    Gets the number of states a cell can be in.
+     *  Parameters:     none
+     *  Preconditions:  none
+     *  Postconditions: Returns 2 to MAX_STATES
+     *******************************************************************/
+    int getStateCount() const
+    {
+        return states;
+    }
+
+    /********************************************************************
+     *  Function:       unsigned getBirth()
+     *  Description:    Gets the neighbor counts that bring a cell to life.
+     *  Parameters:     none
+     *  Preconditions:  none
+     *  Postconditions: Returns the birth mask
+     *******************************************************************/
+    unsigned getBirth() const
+    {
+        return masks[0];
+    }
+
+    /********************************************************************
+     *  Function:       unsigned getSurvival()
+     *  Description:    Gets the neighbor counts that keep a cell alive.
+     *  Parameters:     none
+     *  Preconditions:  none
+     *  Postconditions: Returns the survival mask
+     *******************************************************************/
+    unsigned getSurvival() const
+    {
+        return masks[1];
+    }
+
+    /********************************************************************
+     *  Function:       bool getNextState(bool alive, int count)
+     *  Description:    Gets the next state of a cell. The current state
+     *                  selects the mask, so no branch is taken.
+     *  Parameters:     alive   Current state of the cell
+     *                  count   Number of live neighbors, 0 to 8
+     *  Preconditions:  0 <= count <= 8
+     *  Postconditions: Returns true if the cell is alive next generation
+     *******************************************************************/
+    bool getNextState(bool alive, int count) const
+    {
+        return (masks[alive] >> count) & 1;
+    }
+
+    /********************************************************************
+     *  Function:       bool isConway()
+     *  Description:    Gets whether this is Conway's Game of Life.
+     *  Parameters:     none
+     *  Preconditions:  none
+     *  Postconditions: Returns true if the rule is B3/S23
+     *******************************************************************/
+    bool isConway() const
+    {
+        return masks[0] == CONWAY_BIRTH && masks[1] == CONWAY_SURVIVAL;
+    }
+
+    /********************************************************************
+     *  Function:       bool hasBirthOnZero()
+     *  Description:    Gets whether dead cells with no live neighbors
+     *                  come to life, which fills empty space every
+     *                  generation.
+     *  Parameters:     none
+     *  Preconditions:  none
+     *  Postconditions: Returns true if the rule contains B0
+     *******************************************************************/
+    bool hasBirthOnZero() const
+    {
+        return masks[0] & 1;
+    }
+
+    // Gets the rule in B/S notation.
+    std::string toString() const;
+
+    /********************************************************************
+     *  Function:       bool operator==(const Rule &other)
+     *  Description:    Compares the masks and states of two rules.
+     *  Parameters:     other   Rule to compare with
+     *  Preconditions:  none
+     *  Postconditions: Returns true if both rules behave the same
+     *******************************************************************/
+    bool operator==(const Rule &other) const
+    {
+        return masks[0] == other.masks[0] && masks[1] == other.masks[1]
+            && family == other.family && states == other.states;
+    }
+};
+
+#endif // end of define RULE_HPP
@@ -8,172 +8,473 @@
  * Description:     Implementation of the Simulation class.
  ************************************************************************/
 #include <iostream>
+#include <algorithm>
+#include <sstream>
 #include <stdexcept>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <fstream>
 #include "Simulation.hpp"
 #include "Pattern.hpp"
+#include "PatternReader.hpp"
+#include "VectorGrid.hpp"
+#include "PackedGrid.hpp"
+#include "ByteGrid.hpp"
+#include "InfiniteGrid.hpp"
+#include "StateGrid.hpp"
+#include "ThreadPool.hpp"
+#include "Renderer.hpp"
+#include "Checkpoint.hpp"
 #include "utility.hpp"
 
+// Definition for the std::chrono constructor, which takes a reference
+const int Simulation::FRAME_MS;
+
 /********************************************************************
- *  Function:       Simulation(int width, int height, int bufCellCount)
+ *  Function:       Simulation(int width, int height, int bufCellCount,
+ *                             GridType type)
  *  Description:    The constructor takes the width and height of the
- *                  visible grid and creates a vgrid with bufCellCount 
- *                  cells added to all sides.
+ *                  visible grid and creates a grid of the specified
+ *                  type with bufCellCount cells added to all sides.
+ *                  An INFINITE_GRID has no edges, so it ignores
+ *                  bufCellCount and the size is only the visible window.
  *  Parameters:     width           Width of the visible grid
  *                  height          Height of the visible grid
  *                  bufCellCount    Number of padding cells added 
  *                                  to all sides
+ *                  type            Backend used to store the cells
  *******************************************************************/
-Simulation::Simulation(int width, int height, int bufCellCount)
+Simulation::Simulation(int width, int height, int bufCellCount, GridType type)
 {
+    if (type == INFINITE_GRID)
+    {
+        bufCellCount = 0;
+    }
+    
     this->bufCellCount = bufCellCount;
     this->width = width + (bufCellCount * 2);
     this->height = height + (bufCellCount * 2);
     generationCount = 0;
+    gridType = type;
+    pool = NULL;
+    tileWidth = 0;
+    tileHeight = 0;
+    historySize = 0;
+    epoch = 1;
+    recorded = 0;
+    hashValid = false;
+    hash = 0;
+    period = 0;
+    statsCount = 0;
+    statsNext = 0;
+    statsInterval = 1;
+    populationValid = false;
+    population = 0;
     
-    // Initialize grids
-    initializeGrid(currentGrid);
-    initializeGrid(nextGrid);
+    // Initialize grid
+    grid = createGrid(type, this->width, this->height);
 }
 
 /********************************************************************
- *  Function:       bool getCellNextState(int x, int y)
- *  Description:    Gets whether the specified cell will be alive in
- *                  the next generation. Live cells will be alive if
- *                  there are 2-3 live neighbors. Dead cells will
- *                  come to life if there are 3 live neighbors.
- *  Parameters:     x   X coordinate of cell to check
- *                  y   Y coordinate of cell to check
- *  Preconditions:  Grids are initialized
- *                  Specified coords are at least 1 cell away from real edge
- *  Postconditions: Returns true if cell is alive in next generation.
+ *  Function:       Grid *createGrid(GridType type, int width, int height)
+ *  Description:    Allocates an empty grid of the specified backend.
+ *  Parameters:     type    Backend used to store the cells
+ *                  width   Width of the grid including buffer cells
+ *                  height  Height of the grid including buffer cells
+ *  Preconditions:  none
+ *  Postconditions: Returns a new grid owned by the caller
  *******************************************************************/
-bool Simulation::getCellNextState(int x, int y)
+Grid *Simulation::createGrid(GridType type, int width, int height)
 {
-    // Validate argument values
-    if ((x < 1 || x > width - 2) || (y < 1 || y > width - 2))
+    if (type == PACKED_GRID)
     {
-        throw std::invalid_argument("ERROR: Invalid cell coordinates specified.");
+        return new PackedGrid(width, height);
     }
-    
-    int liveNeighborCount = 0;  // number of live neighbor cells
-    bool currentState = false;  // stores state of cell in current generation
-    bool nextState = false;        // stores state of cell in next generation
-    
-    // Check number of live neighbors
-    for (int i = y - 1; i <= y + 1; i++)
+    else if (type == BYTE_GRID)
     {
-        for (int j = x - 1; j <= x + 1; j++)
-        {
-            if (y == i && x == j)         // specified cell
-            {
-                currentState = currentGrid[i][j];
-            }
-            else if (currentGrid[i][j]) // neighbor is alive
-            {
-                liveNeighborCount++;
-            }
-        }
+        return new ByteGrid(width, height);
     }
-    
-    // Determine next state
-    if (currentState)   // currently alive
+    else if (type == INFINITE_GRID)
     {
-        // stays alive if 2 or 3 live neighbors
-        nextState = liveNeighborCount > 1 && liveNeighborCount < 4;
+        return new InfiniteGrid(width, height);
     }
-    else                // currently dead
+    else if (type == STATE_GRID)
     {
-        // becomes alive if 3 live neighbors
-        nextState = liveNeighborCount == 3;
+        return new StateGrid(width, height);
     }
-    return nextState;
+    return new VectorGrid(width, height);
+}
+
+/********************************************************************
+ *  Function:       ~Simulation()
+ *  Description:    Frees the memory used by the grid.
+ *******************************************************************/
+Simulation::~Simulation()
+{
+    delete pool;
+    delete grid;
+}
+
+/********************************************************************
+ *  Function:       int getThreadCount()
+ *  Description:    Gets the number of threads that calculate each
+ *                  generation.
+ *  Parameters:     none
+ *  Preconditions:  none
+ *  Postconditions: Returns 1 if running on the calling thread only
+ *******************************************************************/
+int Simulation::getThreadCount() const
+{
+    return pool ? pool->getThreadCount() : 1;
 }
 
 /********************************************************************
- *  Function:       void initializeGrid(vgrid &grid)
- *  Description:    Creates the specified vgrid based on the width and
- *                  height member variables and sets all values to false.
- *  Parameters:     &grid   Grid to initialize
- *  Preconditions:  width and height are set
- *  Postconditions: Specified grid is initialized as 2D vector with
- *                  height rows, width columns, and all elements set to false.
+ *  Function:       void setThreadCount(int threadCount)
+ *  Description:    Sets the number of threads that calculate each
+ *                  generation. The grid is split into one horizontal
+ *                  band of rows per thread. A count of 0 uses one
+ *                  thread per hardware core. Grids that do not
+ *                  support bands always run on the calling thread.
+ *  Parameters:     threadCount     Number of threads including caller
+ *  Preconditions:  none
+ *  Postconditions: Later generations are calculated by threadCount
+ *                  threads with the same results as a single thread
  *******************************************************************/
-void Simulation::initializeGrid(vgrid &grid)
+void Simulation::setThreadCount(int threadCount)
 {
-    // Clear any existing data
-    grid.clear();
+    if (threadCount < 0)
+    {
+        throw std::invalid_argument("ERROR: Thread count cannot be negative.");
+    }
+    if (threadCount == 0)
+    {
+        threadCount = std::thread::hardware_concurrency();
+    }
+    // No more bands than rows to calculate
+    if (threadCount > height - 2)
+    {
+        threadCount = height - 2;
+    }
     
-    // Initialize rows and set all values to false
-    for (int i = 0; i < height; i++)
+    delete pool;
+    pool = threadCount > 1 ? new ThreadPool(threadCount) : NULL;
+}
+
+/********************************************************************
+ *  Function:       void setTileSize(int width, int height)
+ *  Description:    Splits each generation into tiles of the specified
+ *                  size instead of one band of rows per thread. Each
+ *                  thread starts with an equal run of tiles and steals
+ *                  tiles from the others when it runs out, so threads
+ *                  in empty regions help the ones in busy regions.
+ *                  The tile width is rounded up to the columns the
+ *                  backend can split a row at, and backends that only
+ *                  calculate whole rows use tiles of whole rows. A
+ *                  tile whose rows of both buffers fit in L2 cache is
+ *                  read from cache by every row of its kernel.
+ *  Parameters:     width   Columns of a tile, 0 for whole rows
+ *                  height  Rows of a tile, 0 to split into bands
+ *  Preconditions:  none
+ *  Postconditions: Later generations are calculated a tile at a time;
+ *                  throws invalid_argument if a size is negative
+ *******************************************************************/
+void Simulation::setTileSize(int width, int height)
+{
+    if (width < 0 || height < 0)
     {
-        std::vector<bool> row;
-        for (int j = 0; j < width; j++)
-        {
-            row.push_back(false);
-        }
-        grid.push_back(row);
+        throw std::invalid_argument("ERROR: Tile size cannot be negative.");
     }
+    tileWidth = width;
+    tileHeight = height;
 }
 
 /********************************************************************
- *  Function:       void resetGrid(vgrid &grid)
- *  Description:    Sets all values of the specified vgrid to false.
- *  Parameters:     &grid   Grid to reset
+ *  Function:       int getStealCount()
+ *  Description:    Gets the number of tiles of the last generation
+ *                  that were calculated by another thread than the
+ *                  one they were first given to.
+ *  Parameters:     none
  *  Preconditions:  none
- *  Postconditions: Specified grid has all elements set to false.
+ *  Postconditions: Returns 0 if not tiled or running on one thread
  *******************************************************************/
-void Simulation::resetGrid(vgrid &grid)
+int Simulation::getStealCount() const
 {
-    // Set entire grid to false
-    for (int i = 0; i < height; i++)
+    return pool && tileHeight > 0 ? pool->getStealCount() : 0;
+}
+
+/********************************************************************
+ *  Function:       int getActiveTileCount()
+ *  Description:    Gets the number of tiles evaluated in the last
+ *                  generation when sparse mode is enabled.
+ *  Parameters:     none
+ *  Preconditions:  none
+ *  Postconditions: Returns the tile count or -1 if not in sparse mode
+ *******************************************************************/
+int Simulation::getActiveTileCount() const
+{
+    return grid->getActiveTileCount();
+}
+
+/********************************************************************
+ *  Function:       bool getBoundingBox(int &x, int &y, int &w, int &h)
+ *  Description:    Gets the smallest rectangle holding all live cells
+ *                  in visible coordinates. Cells in the hidden buffer
+ *                  have negative coordinates or lie past the visible
+ *                  width and height.
+ *  Parameters:     x   Receives the X coordinate of the left column
+ *                  y   Receives the Y coordinate of the top row
+ *                  w   Receives the width of the rectangle
+ *                  h   Receives the height of the rectangle
+ *  Preconditions:  none
+ *  Postconditions: Returns false and leaves the arguments unchanged
+ *                  if there are no live cells
+ *******************************************************************/
+bool Simulation::getBoundingBox(int &x, int &y, int &w, int &h) const
+{
+    int left, top, right, bottom;
+    if (!grid->getBounds(left, top, right, bottom))
     {
-        for (int j = 0; j < width; j++)
-        {
-            grid[i][j] = false;
-        }
+        return false;
     }
+    x = left - bufCellCount;
+    y = top - bufCellCount;
+    w = right - left + 1;
+    h = bottom - top + 1;
+    return true;
 }
 
 /********************************************************************
- *  Function:       void addPattern(Pattern p, int x, int y)
+ *  Function:       void setSparse(bool enabled)
+ *  Description:    Enables or disables sparse mode, in which only the
+ *                  tiles whose neighborhood changed in the previous
+ *                  generation are evaluated. Only PACKED_GRID
+ *                  supports sparse mode, and INFINITE_GRID is always
+ *                  sparse.
+ *  Parameters:     enabled     Whether to enable sparse mode
+ *  Preconditions:  none
+ *  Postconditions: Throws invalid_argument if not supported by grid
+ *******************************************************************/
+void Simulation::setSparse(bool enabled)
+{
+    grid->setSparse(enabled);
+}
+
+/********************************************************************
+ *  Function:       void setBoundary(Grid::Boundary mode)
+ *  Description:    Sets how the edges of the grid are connected. The
+ *                  wrapping modes join the edges of the whole grid
+ *                  inside the outermost ring of cells, including the
+ *                  hidden buffer cells, so a bufCellCount of 1 wraps
+ *                  exactly at the edge of the visible grid.
+ *  Parameters:     mode    DEAD_EDGE, TORUS or KLEIN_BOTTLE
+ *  Preconditions:  none
+ *  Postconditions: Later generations use the boundary mode
+ *******************************************************************/
+void Simulation::setBoundary(Grid::Boundary mode)
+{
+    grid->setBoundary(mode);
+    hashValid = false;
+    period = 0;
+}
+
+/********************************************************************
+ *  Function:       void setRule(const Rule &rule)
+ *  Description:    Sets the birth and survival rule, such as
+ *                  Rule("B36/S23") for HighLife. Only STATE_GRID
+ *                  has room for rules with more than two states.
+ *  Parameters:     rule    Rule to use
+ *  Preconditions:  none
+ *  Postconditions: Later generations use rule; throws invalid_argument
+ *                  if the grid type cannot use the rule
+ *******************************************************************/
+void Simulation::setRule(const Rule &rule)
+{
+    if (rule.getStateCount() > 2 && gridType != STATE_GRID)
+    {
+        throw std::invalid_argument("ERROR: Rules with more than two states need a state grid.");
+    }
+    grid->setRule(rule);
+    hashValid = false;
+    period = 0;
+}
+
+/********************************************************************
+ *  Function:       void setCell(int x, int y, bool alive)
+ *  Description:    Sets the state of a cell. Coordinates in the
+ *                  hidden buffer are negative or past the visible size.
+ *  Parameters:     x       X coordinate on the visible grid
+ *                  y       Y coordinate on the visible grid
+ *                  alive   New state of the cell
+ *  Preconditions:  x,y is on the grid, including the hidden buffer
+ *  Postconditions: Cell is set and the cycle history starts over
+ *******************************************************************/
+void Simulation::setCell(int x, int y, bool alive)
+{
+    grid->setCell(x + bufCellCount, y + bufCellCount, alive);
+    hashValid = false;
+    populationValid = false;
+    period = 0;
+}
+
+/********************************************************************
+ *  Function:       void setRowBits(int x, int y, int count,
+ *                                  const uint64_t *words)
+ *  Description:    Sets cells x to x + count - 1 of row y, cell x + i
+ *                  from bit i % 64 of word i / 64, so callers that
+ *                  build rows in a buffer of their own can stamp them
+ *                  without a Pattern.
+ *  Parameters:     x       X coordinate of the first cell
+ *                  y       Y coordinate of the row
+ *                  count   Number of cells to set
+ *                  words   (count + 63) / 64 words of cells
+ *  Preconditions:  x,y is on the grid, including the hidden buffer
+ *  Postconditions: Cells are set and the cycle history starts over;
+ *                  throws invalid_argument if the run is off the grid
+ *******************************************************************/
+void Simulation::setRowBits(int x, int y, int count, const uint64_t *words)
+{
+    int realX = x + bufCellCount;
+    int realY = y + bufCellCount;
+    if (gridType != INFINITE_GRID
+        && (realX < 0 || realY < 0 || realX + count > width || realY >= height))
+    {
+        throw std::invalid_argument("ERROR: Row too large for coordinates.");
+    }
+    
+    grid->setRowBits(realX, realY, count, words);
+    hashValid = false;
+    populationValid = false;
+    period = 0;
+}
+
+/********************************************************************
+ *  Function:       void setState(int x, int y, int state)
+ *  Description:    Sets a cell to one of the states of the rule, such
+ *                  as a Wireworld conductor.
+ *  Parameters:     x       X coordinate on the visible grid
+ *                  y       Y coordinate on the visible grid
+ *                  state   New state, less than the state count
+ *  Preconditions:  x,y is on the grid, including the hidden buffer
+ *  Postconditions: Cell is set and the cycle history starts over;
+ *                  throws invalid_argument if the rule has no such state
+ *******************************************************************/
+void Simulation::setState(int x, int y, int state)
+{
+    grid->setState(x + bufCellCount, y + bufCellCount, state);
+    hashValid = false;
+    populationValid = false;
+    period = 0;
+}
+
+/********************************************************************
+ *  Function:       void clear()
+ *  Description:    Kills every cell and starts over from generation 0,
+ *                  keeping the grid and its settings, so one simulation
+ *                  can run many patterns without reallocating.
+ *  Parameters:     none
+ *  Preconditions:  none
+ *  Postconditions: No cells are alive and the generation count is 0
+ *******************************************************************/
+void Simulation::clear()
+{
+    grid->clear();
+    generationCount = 0;
+    hashValid = false;
+    populationValid = false;
+    period = 0;
+}
+
+/********************************************************************
+ *  Function:       void addPattern(const Pattern &p, int x, int y,
+ *                                  Pattern::Orientation o)
  *  Description:    Adds a pattern to the current grid with the top-left
- *                  corner at the specified x, y coordinates.
+ *                  corner at the specified x, y coordinates. Cells of
+ *                  the rectangle are set a row at a time from the
+ *                  packed rows of the pattern, so backends with packed
+ *                  rows copy whole words instead of single cells.
  *  Parameters:     p   Pattern to add
  *                  x   X coordinate of top-left corner of pattern
  *                  y   Y coordinate of top-left corner of pattern
+ *                  o   Rotation or reflection of the pattern
  *  Preconditions:  Current grid is initialized, x,y is on visible grid
  *  Postconditions: Specified pattern is on current grid
  *******************************************************************/
-void Simulation::addPattern(Pattern p, int x, int y)
+void Simulation::addPattern(const Pattern &p, int x, int y, Pattern::Orientation o)
 {
     // Convert visible x and y to actual x and y
     int realX = x + bufCellCount;
     int realY = y + bufCellCount;
-    int patternX = p.getWidth();
-    int patternY = p.getHeight();
+    int patternX = p.getWidth(o);
+    int patternY = p.getHeight(o);
     
-    // Validate argument values
-    if ((realX + patternX > width)
-          || (realY + patternY > height))
+    // Validate argument values (the infinite plane has no edge)
+    if (gridType != INFINITE_GRID
+        && ((realX + patternX > width) || (realY + patternY > height)))
     {
         throw std::invalid_argument("ERROR: Pattern too large for coordinates.");
     }
     
+    // Earlier generations no longer lead to the current one
+    hashValid = false;
+    populationValid = false;
+    period = 0;
+    
     // Update currentGrid with specified Pattern
-    for (int i = 0; i < patternY; i++)
+    for (int i = 0; i < patternY && patternX > 0; i++)
     {
-        for (int j = 0; j < patternX; j++)
-        {
-            currentGrid[i + realY][j + realX] = p.getCellState(j, i);
-        }
+        grid->setRowBits(realX, realY + i, patternX, p.getRowBits(i, o));
     }
 }
 
+/********************************************************************
+ *  Function:       void addPattern(PatternReader &reader, int x, int y)
+ *  Description:    Streams the live cells of a pattern file onto the
+ *                  current grid with the top-left corner at the
+ *                  specified x, y coordinates. The size in an RLE
+ *                  header is checked before any cells are written, and
+ *                  a rule in the header replaces the current rule.
+ *  Parameters:     reader  Reader positioned after the pattern header
+ *                  x       X coordinate of top-left corner of pattern
+ *                  y       Y coordinate of top-left corner of pattern
+ *  Preconditions:  x,y is on visible grid
+ *  Postconditions: Live cells of the pattern are on current grid
+ *******************************************************************/
+void Simulation::addPattern(PatternReader &reader, int x, int y)
+{
+    // Convert visible x and y to actual x and y
+    int realX = x + bufCellCount;
+    int realY = y + bufCellCount;
+    
+    // Validate the size from the header (the infinite plane has no edge)
+    if (grid->isBounded() && reader.getWidth() >= 0
+        && ((realX + reader.getWidth() > grid->getWidth())
+            || (realY + reader.getHeight() > grid->getHeight())))
+    {
+        throw std::invalid_argument("ERROR: Pattern too large for coordinates.");
+    }
+    
+    // Earlier generations no longer lead to the current one
+    hashValid = false;
+    populationValid = false;
+    period = 0;
+    
+    if (reader.hasRule())
+    {
+        setRule(reader.getRule());
+    }
+    reader.readInto(*grid, realX, realY);
+}
+
 /********************************************************************
  *  Function:       void advanceGeneration()
  *  Description:    Makes the simulation transition to the next generation
- *                  and updates all cells according to the rules of
- *                  Conway's Game of Life.
+ *                  and updates all cells according to the rule of the
+ *                  grid, Conway's Game of Life unless set otherwise.
  *  Parameters:     none
  *  Preconditions:  Current grid is initialized
  *  Postconditions: Current grid contains next generation and
@@ -181,35 +482,593 @@ void Simulation::addPattern(Pattern p, int x, int y)
  *******************************************************************/
 void Simulation::advanceGeneration()
 {
-    bool nextState = false; // stores the next state
+    if (historySize > 0 && !hashValid)
+    {
+        resetHistory();
+    }
     
-    // Get state in next generation and set nextState grid
-    for (int i = 1; i < height - 1; i++)
+    // Only every statsInterval-th generation is counted, so the kernels
+    // without statistics calculate the ones in between
+    bool sample = !stats.empty() && generationCount % statsInterval == 0;
+    if (sample != grid->isStatsEnabled())
     {
-        for (int j = 1; j < width - 1; j++)
+        grid->setStatsEnabled(sample);
+    }
+    
+    typedef std::chrono::steady_clock clock;
+    clock::time_point start;
+    if (sample)
+    {
+        if (!populationValid)
         {
-            nextState = getCellNextState(j, i);
-            nextGrid[i][j] = nextState;
+            population = grid->getPopulation();
+            populationValid = true;
         }
+        start = clock::now();
     }
     
-    // Copy nextGrid to currentGrid
-    for (int i = 0; i < height; i++)
+    // Calculate next generation; grids without rows only step whole
+    if (!grid->supportsBands())
+    {
+        grid->step();
+    }
+    else if (tileHeight > 0)
     {
-        for (int j = 0; j < width; j++)
+        // Tile columns start at a multiple of the alignment
+        int align = grid->getTileAlignment();
+        int columns = width;
+        if (align > 0 && tileWidth > 0)
+        {
+            columns = std::min(width, (tileWidth + align - 1) / align * align);
+        }
+        // The last column of tiles takes the rest of the row, so no
+        // sliver of the buffer cells is left over as a tile of its own
+        int rows = tileHeight;
+        int across = std::max(1, width / columns);
+        int down = (height - 2 + rows - 1) / rows;
+        int w = width;
+        int h = height;
+        Grid *g = grid;
+        std::function<void(int)> tile = [g, w, h, columns, rows, across](int t)
         {
-            currentGrid[i][j] = nextGrid[i][j];
+            int top = 1 + (t / across) * rows;
+            int left = (t % across) * columns;
+            int right = t % across == across - 1 ? w : left + columns;
+            g->computeTile(top, std::min(h - 1, top + rows), left, right);
+        };
+        grid->exchangeHalo();
+        if (pool)
+        {
+            pool->runStealing(across * down, tile);
         }
+        else
+        {
+            for (int t = 0; t < across * down; t++)
+            {
+                tile(t);
+            }
+        }
+        grid->swapBuffers();
+    }
+    else if (pool)
+    {
+        // Split rows 1 to height - 2 into one band per thread
+        int rows = height - 2;
+        int bands = pool->getThreadCount();
+        Grid *g = grid;
+        grid->exchangeHalo();
+        pool->run([g, rows, bands](int band)
+        {
+            g->computeRows(1 + rows * band / bands,
+                           1 + rows * (band + 1) / bands);
+        });
+        grid->swapBuffers();
+    }
+    else
+    {
+        grid->step();
     }
-    // Set nextGrid to all false
-    resetGrid(nextGrid);
     // Increment generation counter
     generationCount++;
+    
+    // The kernel gathered the changes, so nothing is counted again;
+    // a generation in between leaves the population unknown
+    if (sample)
+    {
+        double seconds = std::chrono::duration<double>(clock::now() - start).count();
+        const Grid::StepStats &step = grid->getStepStats();
+        population += step.births - step.deaths;
+        GenerationStats &entry = stats[statsNext];
+        entry.generation = generationCount;
+        entry.population = population;
+        entry.births = step.births;
+        entry.deaths = step.deaths;
+        entry.x = 0;
+        entry.y = 0;
+        entry.width = 0;
+        entry.height = 0;
+        if (step.left <= step.right)
+        {
+            entry.x = step.left - bufCellCount;
+            entry.y = step.top - bufCellCount;
+            entry.width = step.right - step.left + 1;
+            entry.height = step.bottom - step.top + 1;
+        }
+        entry.stepSeconds = seconds;
+        statsNext = (statsNext + 1) % stats.size();
+        statsCount = std::min(statsCount + 1, static_cast<int>(stats.size()));
+    }
+    else
+    {
+        populationValid = false;
+    }
+    
+    // Only the cells that changed update the hash
+    if (historySize > 0)
+    {
+        hash ^= grid->getChangeHash();
+        recordHash();
+    }
+}
+
+/********************************************************************
+ *  Function:       void setStatsHistory(int generations)
+ *  Description:    Enables or disables statistics. When enabled, the
+ *                  population, births, deaths, bounding box and step
+ *                  time of each sampled generation go into a ring
+ *                  allocated here, so the oldest entry is overwritten
+ *                  once it is full. The kernels count births and
+ *                  deaths while calculating, and the population is
+ *                  kept from them, so with an interval of 1 the cells
+ *                  are only counted again after an edit.
+ *  Parameters:     generations     Generations to remember, 0 to disable
+ *  Preconditions:  generations >= 0
+ *  Postconditions: Statistics start over with the next generation
+ *******************************************************************/
+void Simulation::setStatsHistory(int generations)
+{
+    // Validate argument
+    if (generations < 0)
+    {
+        throw std::invalid_argument("ERROR: History size cannot be negative.");
+    }
+    
+    stats.assign(generations, GenerationStats());
+    statsCount = 0;
+    statsNext = 0;
+    populationValid = false;
+    grid->setStatsEnabled(generations > 0);
+}
+
+/********************************************************************
+ *  Function:       void setStatsInterval(int generations)
+ *  Description:    Sets how often statistics are sampled. Only
+ *                  generations 1, generations + 1, 2 * generations + 1
+ *                  and so on are counted by the kernels with
+ *                  statistics; the others run the plain kernels, and
+ *                  the population is counted again before the next
+ *                  sampled one. The counting cost is spread over the
+ *                  interval, so a long run can keep statistics on.
+ *  Parameters:     generations     Generations per entry, 1 for all
+ *  Preconditions:  generations > 0
+ *  Postconditions: Later entries are every generations generations;
+ *                  throws invalid_argument if generations < 1
+ *******************************************************************/
+void Simulation::setStatsInterval(int generations)
+{
+    // Validate argument
+    if (generations < 1)
+    {
+        throw std::invalid_argument("ERROR: Statistics interval must be positive.");
+    }
+    
+    statsInterval = generations;
+}
+
+/********************************************************************
+ *  Function:       const GenerationStats &getStats(int index)
+ *  Description:    Gets the statistics of a remembered generation.
+ *  Parameters:     index   0 for the oldest, getStatsCount() - 1 for
+ *                          the last generation
+ *  Preconditions:  0 <= index < getStatsCount()
+ *  Postconditions: Returns the statistics; throws invalid_argument if
+ *                  index is out of range
+ *******************************************************************/
+const Simulation::GenerationStats &Simulation::getStats(int index) const
+{
+    // Validate argument
+    if (index < 0 || index >= statsCount)
+    {
+        throw std::invalid_argument("ERROR: Specified statistics out of range.");
+    }
+    
+    int size = stats.size();
+    return stats[(statsNext - statsCount + index + size) % size];
+}
+
+/********************************************************************
+ *  Function:       void writeStatsCsv(std::ostream &out)
+ *  Description:    Writes a header line and one line per remembered
+ *                  generation, oldest first. An empty bounding box has
+ *                  a width and height of 0.
+ *  Parameters:     out     Stream to write to
+ *  Preconditions:  none
+ *  Postconditions: Statistics are written to out
+ *******************************************************************/
+void Simulation::writeStatsCsv(std::ostream &out) const
+{
+    out << "generation,population,births,deaths,x,y,width,height,step_seconds\n";
+    for (int i = 0; i < statsCount; i++)
+    {
+        const GenerationStats &entry = getStats(i);
+        out << entry.generation << ',' << entry.population << ','
+            << entry.births << ',' << entry.deaths << ',' << entry.x << ','
+            << entry.y << ',' << entry.width << ',' << entry.height << ','
+            << std::scientific << std::setprecision(3) << entry.stepSeconds
+            << std::defaultfloat << '\n';
+    }
+}
+
+/********************************************************************
+ *  Function:       void setCycleDetection(int generations)
+ *  Description:    Enables or disables cycle detection. When enabled,
+ *                  the hash of each generation is compared with the
+ *                  hashes of the specified number of generations before
+ *                  it, so oscillators with a period up to that number
+ *                  are found. Hashes are 64 bits, so a false match is
+ *                  possible but very unlikely. The grid kernels hash
+ *                  the cells they change only while this is enabled.
+ *                  The ring of hashes and the table that finds a hash
+ *                  in it are allocated here and reused by every run.
+ *  Parameters:     generations     Generations to remember, 0 to disable
+ *  Preconditions:  generations >= 0
+ *  Postconditions: getPeriod reports cycles from the next generation
+ *******************************************************************/
+void Simulation::setCycleDetection(int generations)
+{
+    // Validate argument
+    if (generations < 0)
+    {
+        throw std::invalid_argument("ERROR: History size cannot be negative.");
+    }
+    
+    historySize = generations;
+    history.assign(generations, 0);
+    int size = generations > 0 ? 2 : 0;
+    while (size > 0 && size < generations * 2)
+    {
+        size *= 2;
+    }
+    HashSlot empty = { 0, 0, 0 };
+    slots.assign(size, empty);
+    epoch = 1;
+    recorded = 0;
+    hashValid = false;
+    period = 0;
+    grid->setHashEnabled(generations > 0);
+}
+
+/********************************************************************
+ *  Function:       void resetHistory()
+ *  Description:    Hashes every cell of the current generation and
+ *                  forgets earlier generations, which no longer lead
+ *                  to the current cells after an edit. Moving to the
+ *                  next epoch empties every slot at once; only when
+ *                  the epoch wraps around are the slots cleared.
+ *  Parameters:     none
+ *  Preconditions:  historySize > 0
+ *  Postconditions: History holds only the current generation
+ *******************************************************************/
+void Simulation::resetHistory()
+{
+    hash = grid->getHash();
+    recorded = 0;
+    if (++epoch == 0)
+    {
+        HashSlot empty = { 0, 0, 0 };
+        std::fill(slots.begin(), slots.end(), empty);
+        epoch = 1;
+    }
+    recordHash();
+    hashValid = true;
+}
+
+/********************************************************************
+ *  Function:       void recordHash()
+ *  Description:    Looks up the hash of the current generation in the
+ *                  table to find the period, and then remembers it in
+ *                  place of the oldest hash. The table keeps the newest
+ *                  generation of each hash in the ring, so the oldest
+ *                  hash is only removed if it did not come back since.
+ *                  Both are allocated by setCycleDetection, so each
+ *                  generation costs a few probes and allocates nothing.
+ *  Parameters:     none
+ *  Preconditions:  historySize > 0
+ *  Postconditions: period is set and the hash is in the history
+ *******************************************************************/
+void Simulation::recordHash()
+{
+    int slot = findSlot(hash);
+    period = slots[slot].epoch == epoch ? generationCount - slots[slot].generation : 0;
+    slots[slot].hash = hash;
+    slots[slot].generation = generationCount;
+    slots[slot].epoch = epoch;
+    
+    int index = generationCount % historySize;
+    if (recorded == historySize)
+    {
+        int oldest = findSlot(history[index]);
+        if (slots[oldest].generation == generationCount - historySize)
+        {
+            removeSlot(oldest);
+        }
+    }
+    history[index] = hash;
+    recorded = std::min(recorded + 1, historySize);
+}
+
+/********************************************************************
+ *  Function:       int findSlot(uint64_t key)
+ *  Description:    Searches the table by linear probing from the slot
+ *                  the low bits of the hash select. Zobrist hashes are
+ *                  already random, so they are used as they are.
+ *  Parameters:     key     Hash to find
+ *  Preconditions:  historySize > 0
+ *  Postconditions: Returns the slot of key in the current epoch, or
+ *                  the first empty slot of its probe sequence
+ *******************************************************************/
+int Simulation::findSlot(uint64_t key) const
+{
+    int mask = slots.size() - 1;
+    int slot = key & mask;
+    while (slots[slot].epoch == epoch && slots[slot].hash != key)
+    {
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+/********************************************************************
+ *  Function:       void removeSlot(int slot)
+ *  Description:    Removes an entry without leaving a gap in the probe
+ *                  sequence of a later entry. Each later entry up to the
+ *                  next empty slot moves into the gap if the gap is not
+ *                  before the slot its hash selects.
+ *  Parameters:     slot    Slot to empty
+ *  Preconditions:  slot holds an entry of the current epoch
+ *  Postconditions: The entry is gone and every other one can be found
+ *******************************************************************/
+void Simulation::removeSlot(int slot)
+{
+    int mask = slots.size() - 1;
+    slots[slot].epoch = 0;
+    for (int next = (slot + 1) & mask; slots[next].epoch == epoch; next = (next + 1) & mask)
+    {
+        int home = slots[next].hash & mask;
+        if (((next - home) & mask) >= ((next - slot) & mask))
+        {
+            slots[slot] = slots[next];
+            slots[next].epoch = 0;
+            slot = next;
+        }
+    }
+}
+
+/********************************************************************
+ *  Function:       int advanceUntilCycle(int generations)
+ *  Description:    Advances generation by generation until the grid
+ *                  repeats a remembered generation, so still lifes and
+ *                  oscillators stop the run early.
+ *  Parameters:     generations     Most generations to advance
+ *  Preconditions:  Cycle detection is enabled
+ *  Postconditions: Returns the number of generations advanced;
+ *                  getPeriod is nonzero if the run stopped early
+ *******************************************************************/
+int Simulation::advanceUntilCycle(int generations)
+{
+    if (historySize == 0)
+    {
+        throw std::logic_error("ERROR: Cycle detection is not enabled.");
+    }
+    
+    int count = 0;
+    while (count < generations && period == 0)
+    {
+        advanceGeneration();
+        count++;
+    }
+    return count;
+}
+
+/********************************************************************
+ *  Function:       void save(const std::string &filename, bool compress)
+ *  Description:    Writes the generation count, size, backend, rule,
+ *                  boundary and cells to a checkpoint file. A bounded
+ *                  grid is saved whole, including its buffer cells; an
+ *                  infinite plane is saved as the rectangle around its
+ *                  live cells. Compression stores each row as runs of
+ *                  dead words and live words, which suits boards that
+ *                  are mostly empty.
+ *  Parameters:     filename    Path of the file to write
+ *                  compress    Whether to run-length encode the rows
+ *  Preconditions:  none
+ *  Postconditions: Throws invalid_argument if the file cannot be written
+ *                  or the rule has more than two states
+ *******************************************************************/
+void Simulation::save(const std::string &filename, bool compress) const
+{
+    // Rows are stored one bit per cell
+    if (grid->getRule().getStateCount() > 2)
+    {
+        throw std::invalid_argument("ERROR: Checkpoints only hold rules with two states.");
+    }
+    
+    Checkpoint::Header header;
+    header.flags = compress ? Checkpoint::COMPRESSED : 0;
+    if (gridType == PACKED_GRID && grid->getActiveTileCount() >= 0)
+    {
+        header.flags |= Checkpoint::SPARSE;
+    }
+    header.generationCount = generationCount;
+    header.gridType = gridType;
+    header.boundary = grid->getBoundary();
+    header.width = width - bufCellCount * 2;
+    header.height = height - bufCellCount * 2;
+    header.bufCellCount = bufCellCount;
+    header.birth = grid->getRule().getBirth();
+    header.survival = grid->getRule().getSurvival();
+    header.left = 0;
+    header.top = 0;
+    header.columns = width;
+    header.rows = height;
+    if (!grid->isBounded())
+    {
+        int right, bottom;
+        if (grid->getBounds(header.left, header.top, right, bottom))
+        {
+            header.columns = right - header.left + 1;
+            header.rows = bottom - header.top + 1;
+        }
+        else
+        {
+            header.columns = 0;
+            header.rows = 0;
+        }
+    }
+    
+    std::ofstream out(filename.c_str(), std::ios::binary | std::ios::trunc);
+    if (!out)
+    {
+        throw std::invalid_argument("ERROR: Could not create checkpoint file.");
+    }
+    Checkpoint::writeHeader(out, header);
+    std::vector<uint64_t> row((header.columns + 63) / 64);
+    for (int y = 0; y < header.rows; y++)
+    {
+        grid->getRowBits(header.left, header.top + y, header.columns, &row[0]);
+        Checkpoint::writeRow(out, &row[0], row.size(), compress);
+    }
+    out.close();
+    if (out.fail())
+    {
+        throw std::invalid_argument("ERROR: Could not write checkpoint file.");
+    }
+}
+
+/********************************************************************
+ *  Function:       void restore(const std::string &filename)
+ *  Description:    Replaces the grid with the one saved in a checkpoint
+ *                  file, including its size, backend, rule, boundary,
+ *                  sparse mode and generation count. The file is mapped
+ *                  and each row is copied into the new grid, a word at
+ *                  a time for PACKED_GRID, so restoring a large board
+ *                  costs about as much as reading the file. The thread
+ *                  count and cycle detection setting are kept, but the
+ *                  cycle history starts over.
+ *  Parameters:     filename    Path of a file written by save
+ *  Preconditions:  none
+ *  Postconditions: Simulation continues from the saved generation;
+ *                  throws invalid_argument and keeps the current grid
+ *                  if the file is not a valid checkpoint
+ *******************************************************************/
+void Simulation::restore(const std::string &filename)
+{
+    Checkpoint checkpoint(filename);
+    const Checkpoint::Header &header = checkpoint.getHeader();
+    
+    // Validate header
+    int newWidth = header.width + header.bufCellCount * 2;
+    int newHeight = header.height + header.bufCellCount * 2;
+    if (header.gridType < VECTOR_GRID || header.gridType > STATE_GRID
+        || header.boundary < Grid::DEAD_EDGE || header.boundary > Grid::KLEIN_BOTTLE
+        || header.width < 1 || header.height < 1 || header.bufCellCount < 0
+        || (header.gridType == INFINITE_GRID && header.bufCellCount != 0)
+        || (header.gridType != INFINITE_GRID
+            && (header.left != 0 || header.top != 0
+                || header.columns != newWidth || header.rows != newHeight)))
+    {
+        throw std::invalid_argument("ERROR: Checkpoint header is invalid.");
+    }
+    
+    // Fill a new grid so the current one survives a bad file
+    Grid *restored = createGrid(static_cast<GridType>(header.gridType), newWidth, newHeight);
+    try
+    {
+        restored->setRule(Rule(header.birth, header.survival));
+        restored->setBoundary(static_cast<Grid::Boundary>(header.boundary));
+        if (header.flags & Checkpoint::SPARSE)
+        {
+            restored->setSparse(true);
+        }
+        restored->setStatsEnabled(!stats.empty());
+        restored->setHashEnabled(historySize > 0);
+        std::vector<uint64_t> row;
+        for (int y = 0; y < header.rows; y++)
+        {
+            const uint64_t *words = checkpoint.readRow(row);
+            if (words)
+            {
+                restored->setRowBits(header.left, header.top + y, header.columns, words);
+            }
+        }
+    }
+    catch (...)
+    {
+        delete restored;
+        throw;
+    }
+    
+    delete grid;
+    grid = restored;
+    gridType = static_cast<GridType>(header.gridType);
+    bufCellCount = header.bufCellCount;
+    width = newWidth;
+    height = newHeight;
+    generationCount = header.generationCount;
+    hashValid = false;
+    populationValid = false;
+    period = 0;
+    if (pool && pool->getThreadCount() > height - 2)
+    {
+        setThreadCount(height - 2);
+    }
+}
+
+/********************************************************************
+ *  Function:       std::string getStatus()
+ *  Description:    Builds the lines shown below the grid.
+ *  Parameters:     none
+ *  Preconditions:  none
+ *  Postconditions: Returns the status lines, each ending with a newline
+ *******************************************************************/
+std::string Simulation::getStatus() const
+{
+    std::ostringstream status;
+    status << "Current generation number: " << generationCount << '\n';
+    if (!grid->getRule().isConway())
+    {
+        status << "Rule: " << grid->getRule().toString() << '\n';
+    }
+    if (period == 1)
+    {
+        status << "Still life\n";
+    }
+    else if (period > 1)
+    {
+        status << "Oscillating with period " << period << '\n';
+    }
+    if (grid->getActiveTileCount() >= 0)
+    {
+        status << "Active tiles last generation: "
+               << grid->getActiveTileCount() << '\n';
+    }
+    return status.str();
 }
 
 /********************************************************************
  *  Function:       void printCurrent()
  *  Description:    Prints the current generation to the console window.
+ *                  The whole frame is built first and written at once.
  *  Parameters:     none
  *  Preconditions:  none
  *  Postconditions: Grid of current generation is displayed in console
@@ -222,34 +1081,43 @@ void Simulation::printCurrent()
     int endX = width - bufCellCount - 1;
     int endY = height - bufCellCount - 1;
     
+    std::string frame;
+    frame.reserve((endX - startX + 1) * (endY - startY));
     for (int i = startY; i < endY; i++)
     {
         for (int j = startX; j < endX; j++)
         {
-            if (currentGrid[i][j])  // alive
-            {
-                std::cout << '#';
-            }
-            else                    // dead
-            {
-                std::cout << ' ';
-            }
+            frame += grid->getCell(j, i) ? '#' : ' ';
         }
-        std::cout << std::endl;
+        frame += '\n';
     }
-    std::cout << "Current generation number: " << generationCount << std::endl;
+    frame += getStatus();
+    std::cout << frame << std::flush;
 }
 
 /********************************************************************
  *  Function:       void runInConsole(int generations)
  *  Description:    Runs the simulation for the specified number of
  *                  generations and displays the output in the console.
+ *                  On Linux a Renderer redraws only the cells that
+ *                  changed since the last frame, with the cursor hidden.
  *  Parameters:     none
  *  Preconditions:  none
  *  Postconditions: Grid of the last generation is displayed in console
  *******************************************************************/
 void Simulation::runInConsole(int generations)
 {
+    #if defined(__linux__)
+    Renderer renderer(width - 2 * bufCellCount - 1, height - 2 * bufCellCount - 1);
+    renderer.drawFrame(*grid, bufCellCount, bufCellCount, getStatus());
+    for (int i = 0; i < generations; i++)
+    {
+        sleepMilliseconds(SLEEP_MS);
+        advanceGeneration();
+        renderer.drawFrame(*grid, bufCellCount, bufCellCount, getStatus());
+    }
+    renderer.showCursor();
+    #else
     for (int i = 0; i < generations; i++)
     {
         sleepMilliseconds(SLEEP_MS);
@@ -259,4 +1127,122 @@ void Simulation::runInConsole(int generations)
     }
     clearWindow();
     printCurrent();
+    #endif
 }
+
+/********************************************************************
+ *  Function:       void runDecoupled(int generations, int targetRate,
+ *                                    int fd)
+ *  Description:    Runs the simulation on its own thread while the
+ *                  calling thread draws the latest finished generation
+ *                  every FRAME_MS milliseconds. The simulation thread
+ *                  only copies the visible cells when the render thread
+ *                  has asked for a frame, so drawing never holds it up,
+ *                  and a frame with no new generation redraws nothing
+ *                  but the status. Simulated generations per second and
+ *                  drawn frames per second are shown separately.
+ *  Parameters:     generations Number of generations to run
+ *                  targetRate  Generations per second, or 0 to run as
+ *                              fast as possible
+ *                  fd          File descriptor to draw to, or -1 to
+ *                              run without drawing
+ *  Preconditions:  generations >= 0 and targetRate >= 0
+ *  Postconditions: Grid of the last generation is displayed in console
+ *******************************************************************/
+void Simulation::runDecoupled(int generations, int targetRate, int fd)
+{
+    // Validate arguments
+    if (generations < 0 || targetRate < 0)
+    {
+        throw std::invalid_argument("ERROR: Generations and rate cannot be negative.");
+    }
+    
+    typedef std::chrono::steady_clock clock;
+    Renderer renderer(width - 2 * bufCellCount - 1, height - 2 * bufCellCount - 1, fd);
+    
+    // Latest generation handed from the simulation thread to the render thread
+    std::mutex mutex;
+    std::condition_variable frameCond;
+    std::atomic<bool> wanted(true); // render thread is waiting for a frame
+    bool ready = false;             // frame holds a generation not drawn yet
+    bool finished = false;          // frame holds the last generation
+    std::vector<unsigned char> frame;
+    std::string frameStatus;
+    unsigned frameGeneration = generationCount;
+    
+    unsigned startGeneration = generationCount;
+    clock::time_point start = clock::now();
+    
+    // Copies the current generation into the frame
+    auto publish = [&](bool last)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        renderer.copyWindow(*grid, bufCellCount, bufCellCount, frame);
+        frameStatus = getStatus();
+        frameGeneration = generationCount;
+        ready = true;
+        finished = last;
+        wanted = false;
+        frameCond.notify_one();
+    };
+    
+    std::thread simulator([&]()
+    {
+        for (int i = 0; i < generations; i++)
+        {
+            if (wanted)
+            {
+                publish(false);
+            }
+            if (targetRate > 0)
+            {
+                std::this_thread::sleep_until(start + std::chrono::microseconds(
+                    1000000LL * i / targetRate));
+            }
+            advanceGeneration();
+        }
+        publish(true);
+    });
+    
+    std::vector<unsigned char> cells;
+    std::string status;
+    unsigned shownGeneration = startGeneration;
+    int frameCount = 0;
+    bool done = false;
+    while (!done)
+    {
+        clock::time_point next = clock::now() + std::chrono::milliseconds(FRAME_MS);
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wanted = true;
+            frameCond.wait_until(lock, next, [&]() { return ready; });
+            if (ready)
+            {
+                cells.swap(frame);
+                status.swap(frameStatus);
+                shownGeneration = frameGeneration;
+                done = finished;
+                ready = false;
+            }
+        }
+        if (cells.empty())
+        {
+            continue;
+        }
+    
+        frameCount++;
+        double seconds = std::chrono::duration<double>(clock::now() - start).count();
+        std::ostringstream rates;
+        rates << std::fixed << std::setprecision(1)
+              << "Generations per second: " << (shownGeneration - startGeneration) / seconds
+              << '\n' << "Frames per second: " << frameCount / seconds << '\n';
+        renderer.drawFrame(cells.data(), status + rates.str());
+        if (!done)
+        {
+            std::this_thread::sleep_until(next);
+        }
+    }
+    simulator.join();
+    renderer.showCursor();
+}
+
@@ -5,58 +5,367 @@
  * Assignment:      Assignment 1
  * Filename:        Simulation.hpp
  *
- * Description:     Represents a Game of Life simulator.
+ * Description:     Represents a Life-like simulator.
  ************************************************************************/
 #ifndef SIMULATION_HPP
 #define SIMULATION_HPP
 
 #include <vector>
+#include <ostream>
+#include "Grid.hpp"
+#include "Pattern.hpp"
 
-// Define 2D bool vector as vgrid
-typedef std::vector<std::vector<bool> > vgrid;
-
-// forward declaration
-class Pattern;
+// forward declarations
+class PatternReader;
+class ThreadPool;
 
 class Simulation
 {
+    friend class UnitTest;      // for unit testing
+public:
+    // Cell storage backends that can run the simulation
+    enum GridType
+    {
+        VECTOR_GRID,            // one bool per cell, evaluated per cell
+        PACKED_GRID,            // 64 cells per word, evaluated per word
+        BYTE_GRID,              // one byte per cell, evaluated with SIMD
+        INFINITE_GRID,          // unbounded plane of tiles allocated on demand
+        STATE_GRID              // 2 or 4 bits per cell for multi-state rules
+    };
+
+    // Statistics of one generation
+    struct GenerationStats
+    {
+        unsigned generation;    // generation the statistics describe
+        long long population;   // live cells
+        long long births;       // cells that came to life in this generation
+        long long deaths;       // cells that died in this generation
+        int x;                  // left column of the bounding box
+        int y;                  // top row of the bounding box
+        int width;              // width of the bounding box, 0 if empty
+        int height;             // height of the bounding box, 0 if empty
+        double stepSeconds;     // wall time spent calculating it
+    };
+
+private:
+    // Entry of the table that finds a hash in the history
+    struct HashSlot
+    {
+        uint64_t hash;          // hash of a generation in the history
+        unsigned generation;    // newest generation with the hash
+        unsigned epoch;         // history the entry belongs to; entries of
+                                // an earlier history are empty
+    };
+
 // member variables
 private:
-    vgrid currentGrid;          // grid in current generation
-    vgrid nextGrid;             // grid in next generation
+    Grid *grid;                 // cells of the current generation
+    GridType gridType;          // backend used by grid
+    ThreadPool *pool;           // threads for parallel stepping or NULL
     unsigned generationCount;   // number of generations that have passed
     int width;                  // width of visible grid
     int height;                 // height of visible grid
     int bufCellCount;           // hidden buffer cells on all sides of grid
+    int tileWidth;              // columns of a tile, 0 for whole rows
+    int tileHeight;             // rows of a tile, 0 if not tiled
+
+    // cycle detection: Zobrist hashes of recent generations
+    int historySize;            // generations remembered, 0 if disabled
+    bool hashValid;             // false after cells were edited
+    uint64_t hash;              // hash of the current generation
+    std::vector<uint64_t> history;  // hash of generation g at g % historySize
+    std::vector<HashSlot> slots;    // hashes of history by open addressing,
+                                    // a power of two at least twice its size
+    unsigned epoch;             // current history, never 0
+    int recorded;               // hashes in history since the last reset
+    int period;                 // period found at this generation, or 0
+
+    // statistics: a ring of the most recent generations
+    std::vector<GenerationStats> stats;    // filled in order, then reused
+    int statsCount;             // entries of stats in use
+    int statsNext;              // entry for the next generation
+    int statsInterval;          // generations per entry
+    bool populationValid;       // false after cells were edited
+    long long population;       // live cells, kept from births and deaths
 
 public:
     static const int SLEEP_MS = 50; // Sleep time between frames
+    static const int FRAME_MS = 16; // Time between frames of runDecoupled
     
 // member functions    
 private:
-    // Gets whether a cell will be alive or dead next generation.
-    bool getCellNextState(int, int);
-    
-    // Creates the specified vgrid with all values set to false.
-    void initializeGrid(vgrid &);
+    // Simulation owns its grid, so copying is not allowed
+    Simulation(const Simulation &);
+    Simulation &operator=(const Simulation &);
+
+    // Hashes the current generation and starts a new history.
+    void resetHistory();
+
+    // Adds the hash of the current generation to the history.
+    void recordHash();
+
+    // Finds the slot holding a hash, or the empty slot it would go in.
+    int findSlot(uint64_t) const;
+
+    // Empties a slot, moving later slots back so no search stops early.
+    void removeSlot(int);
 
-    // Sets the specified vgrid to all false.
-    void resetGrid(vgrid &);
+    // Allocates an empty grid of the specified backend and size.
+    static Grid *createGrid(GridType, int, int);
     
 public:
     // Instantiates a simulation object with a grid of the specified size.
-    Simulation(int, int, int);
+    Simulation(int, int, int, GridType = VECTOR_GRID);
+    
+    // Frees the grid.
+    ~Simulation();
+    
+    /********************************************************************
+     *  Function:       GridType getGridType()
+     *  Description:    Gets the backend used to store the cells.
+     *  Parameters:     none
+     *  Preconditions:  none
+     *  Postconditions: Returns the grid type passed to the constructor
+     *******************************************************************/
+    GridType getGridType() const
+    {
+        return gridType;
+    }
+    
+    /********************************************************************
+     *  Function:       int getWidth()
+     *  Description:    Gets the width of the visible grid.
+     *  Parameters:     none
+     *  Preconditions:  none
+     *  Postconditions: Returns the width without buffer cells
+     *******************************************************************/
+    int getWidth() const
+    {
+        return width - bufCellCount * 2;
+    }
+
+    /********************************************************************
+     *  Function:       int getHeight()
+     *  Description:    Gets the height of the visible grid.
+     *  Parameters:     none
+     *  Preconditions:  none
+     *  Postconditions: Returns the height without buffer cells
+     *******************************************************************/
+    int getHeight() const
+    {
+        return height - bufCellCount * 2;
+    }
+
+    // Gets the number of threads used to advance a generation.
+    int getThreadCount() const;
+    
+    // Sets the number of threads used to advance a generation.
+    void setThreadCount(int);
+    
+    // Splits each generation into tiles shared out by work stealing.
+    void setTileSize(int, int);
+    
+    /********************************************************************
+     *  Function:       int getTileWidth()
+     *  Description:    Gets the requested number of columns of a tile.
+     *  Parameters:     none
+     *  Preconditions:  none
+     *  Postconditions: Returns 0 if tiles span whole rows
+     *******************************************************************/
+    int getTileWidth() const
+    {
+        return tileWidth;
+    }
+    
+    /********************************************************************
+     *  Function:       int getTileHeight()
+     *  Description:    Gets the number of rows of a tile.
+     *  Parameters:     none
+     *  Preconditions:  none
+     *  Postconditions: Returns 0 if generations are split into bands
+     *******************************************************************/
+    int getTileHeight() const
+    {
+        return tileHeight;
+    }
+    
+    // Gets the number of tiles stolen by other threads last generation.
+    int getStealCount() const;
+    
+    /********************************************************************
+     *  Function:       unsigned getGenerationCount()
+     *  Description:    Gets the number of generations that have passed.
+     *  Parameters:     none
+     *  Preconditions:  none
+     *  Postconditions: Returns the generation count
+     *******************************************************************/
+    unsigned getGenerationCount() const
+    {
+        return generationCount;
+    }
+    
+    /********************************************************************
+     *  Function:       long long getPopulation()
+     *  Description:    Gets the number of live cells, including the
+     *                  hidden buffer cells.
+     *  Parameters:     none
+     *  Preconditions:  none
+     *  Postconditions: Returns the live cell count
+     *******************************************************************/
+    long long getPopulation() const
+    {
+        return grid->getPopulation();
+    }
+    
+    // Gets the smallest rectangle holding all live cells.
+    bool getBoundingBox(int &, int &, int &, int &) const;
+    
+    // Gets the number of tiles evaluated last generation in sparse mode.
+    int getActiveTileCount() const;
+    
+    // Enables or disables evaluating only tiles near changed cells.
+    void setSparse(bool);
+    
+    // Sets how the edges of the grid are connected.
+    void setBoundary(Grid::Boundary);
+    
+    // Sets the birth and survival rule.
+    void setRule(const Rule &);
+    
+    /********************************************************************
+     *  Function:       const Rule &getRule()
+     *  Description:    Gets the birth and survival rule.
+     *  Parameters:     none
+     *  Preconditions:  none
+     *  Postconditions: Returns the rule of the grid
+     *******************************************************************/
+    const Rule &getRule() const
+    {
+        return grid->getRule();
+    }
+    
+    /********************************************************************
+     *  Function:       bool getCell(int x, int y)
+     *  Description:    Gets whether a cell is alive.
+     *  Parameters:     x   X coordinate on the visible grid
+     *                  y   Y coordinate on the visible grid
+     *  Preconditions:  x,y is on the grid, including the hidden buffer
+     *  Postconditions: Returns true if the cell is alive
+     *******************************************************************/
+    bool getCell(int x, int y) const
+    {
+        return grid->getCell(x + bufCellCount, y + bufCellCount);
+    }
+    
+    // Sets the state of a cell on the visible grid.
+    void setCell(int, int, bool);
+    
+    // Sets a run of cells on the visible grid from words of 64 cells each.
+    void setRowBits(int, int, int, const uint64_t *);
+    
+    /********************************************************************
+     *  Function:       int getState(int x, int y)
+     *  Description:    Gets the state of a cell under a rule with more
+     *                  than two states.
+     *  Parameters:     x   X coordinate on the visible grid
+     *                  y   Y coordinate on the visible grid
+     *  Preconditions:  x,y is on the grid, including the hidden buffer
+     *  Postconditions: Returns 0 if the cell is dead
+     *******************************************************************/
+    int getState(int x, int y) const
+    {
+        return grid->getState(x + bufCellCount, y + bufCellCount);
+    }
+    
+    // Sets a cell on the visible grid to one of the states of the rule.
+    void setState(int, int, int);
+    
+    // Kills every cell and resets the generation count.
+    void clear();
     
     // Adds a pattern to the current grid starting from x,y
-    void addPattern(Pattern, int, int);
+    void addPattern(const Pattern &, int, int, Pattern::Orientation = Pattern::IDENTITY);
+    
+    // Streams the cells of an RLE or .cells pattern onto the grid at x,y
+    void addPattern(PatternReader &, int, int);
     
     // Advances the simulation to the next generation
     void advanceGeneration();
 
+    // Remembers statistics of the specified number of generations.
+    void setStatsHistory(int);
+
+    /********************************************************************
+     *  Function:       int getStatsCount()
+     *  Description:    Gets the number of generations with statistics.
+     *  Parameters:     none
+     *  Preconditions:  none
+     *  Postconditions: Returns at most the history size
+     *******************************************************************/
+    int getStatsCount() const
+    {
+        return statsCount;
+    }
+
+    // Samples statistics every specified number of generations.
+    void setStatsInterval(int);
+
+    /********************************************************************
+     *  Function:       int getStatsInterval()
+     *  Description:    Gets the generations per statistics entry.
+     *  Parameters:     none
+     *  Preconditions:  none
+     *  Postconditions: Returns 1 unless set otherwise
+     *******************************************************************/
+    int getStatsInterval() const
+    {
+        return statsInterval;
+    }
+
+    // Gets the statistics of a remembered generation, oldest first.
+    const GenerationStats &getStats(int) const;
+
+    // Writes the remembered statistics as comma-separated values.
+    void writeStatsCsv(std::ostream &) const;
+
+    // Remembers the specified number of generations to find cycles.
+    void setCycleDetection(int);
+
+    /********************************************************************
+     *  Function:       int getPeriod()
+     *  Description:    Gets the period of the cycle the current
+     *                  generation is in, found by matching its hash
+     *                  with one of the remembered generations. A still
+     *                  life, including an empty grid, has period 1.
+     *  Parameters:     none
+     *  Preconditions:  none
+     *  Postconditions: Returns 0 if no repeat was found or cycle
+     *                  detection is disabled
+     *******************************************************************/
+    int getPeriod() const
+    {
+        return period;
+    }
+
+    // Advances until a cycle is found or the generations run out.
+    int advanceUntilCycle(int);
+
+    // Writes the grid and its settings to a checkpoint file.
+    void save(const std::string &, bool = false) const;
+
+    // Replaces the grid and its settings with a checkpoint file.
+    void restore(const std::string &);
+
+    // Builds the status lines shown below the visible grid
+    std::string getStatus() const;
+
     // Prints the current state of the visible grid to the console
     void printCurrent();
     
     // Runs for specified number of generations and displays output in console.
     void runInConsole(int);
+
+    // Runs generations on a separate thread from the one drawing frames.
+    void runDecoupled(int, int = 0, int = 1);
 };
 #endif // end of define SIMULATION_HPP
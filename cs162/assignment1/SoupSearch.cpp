@@ -0,0 +1,551 @@
+/*************************************************************************
+ * Author:          David Rigert
+ * Date Created:    10/17/2026
+ * Last Modified:   10/17/2026
+ * Assignment:      Assignment 1
+ * Filename:        SoupSearch.cpp
+ *
+ * Description:     Implementation of the SoupSearch class.
+ *                  A soup runs on a bounded board until its Zobrist hash
+ *                  repeats. Objects that reach the band of cells near
+ *                  the edge are removed and counted as spaceships before
+ *                  they can hit the edge, so gliders do not keep the
+ *                  board from repeating. Once it repeats, the cells
+ *                  covered over one period are split into 8-connected
+ *                  objects, so each oscillator is one shape whatever
+ *                  phase it is in, and each shape is looked up by a
+ *                  hash that does not depend on rotation or reflection.
+ ************************************************************************/
+#include <stdexcept>
+#include <sstream>
+#include <atomic>
+#include <thread>
+#include <algorithm>
+#include <climits>
+#include "SoupSearch.hpp"
+#include "Simulation.hpp"
+#include "PatternReader.hpp"
+#include "ThreadPool.hpp"
+
+// An object recognized by the census
+struct KnownObject
+{
+    const char *name;
+    const char *rle;            // cells of one phase
+    int period;                 // generations until the shape repeats
+    bool escapes;               // whether it moves and leaves the board
+};
+
+// Common objects of random soups, from most to least common
+static const KnownObject KNOWN_OBJECTS[] =
+{
+    { "block", "2o$2o!", 1, false },
+    { "blinker", "3o!", 2, false },
+    { "beehive", "b2o$o2bo$b2o!", 1, false },
+    { "glider", "bo$2bo$3o!", 4, true },
+    { "loaf", "b2o$o2bo$bobo$2bo!", 1, false },
+    { "boat", "2o$obo$bo!", 1, false },
+    { "pond", "b2o$o2bo$o2bo$b2o!", 1, false },
+    { "tub", "bo$obo$bo!", 1, false },
+    { "ship", "2o$obo$b2o!", 1, false },
+    { "beacon", "2o$2o$2b2o$2b2o!", 2, false },
+    { "toad", "b3o$3o!", 2, false },
+    { "long boat", "2o$obo$bobo$2bo!", 1, false },
+    { "barge", "bo$obo$bobo$2bo!", 1, false },
+    { "mango", "b2o$o2bo$bo2bo$2b2o!", 1, false },
+    { "lightweight spaceship", "bo2bo$o$o3bo$4o!", 4, true }
+};
+static const int KNOWN_OBJECT_COUNT = sizeof(KNOWN_OBJECTS) / sizeof(KNOWN_OBJECTS[0]);
+
+// Census name of objects that are not in the table
+static const char OTHER_NAME[] = "other";
+static const int OTHER_INDEX = 0;
+
+// State owned by one thread, allocated once and reused for every soup
+struct SoupSearch::Worker
+{
+    Simulation sim;                     // board the soups run on
+    std::vector<unsigned char> covered; // cells live at any time in a period
+    std::vector<int> stack;             // cells left to visit in a flood fill
+    std::vector<int> marked;            // cells marked in covered by an edge scan
+    std::vector<int> cellsX;            // X coordinates of one object
+    std::vector<int> cellsY;            // Y coordinates of one object
+    std::vector<long long> counts;      // objects found by census index
+    long long soups;                    // soups run
+    long long unstable;                 // soups stopped at MAX_GENERATIONS
+    long long generations;              // generations run
+    
+    Worker() : sim(BOARD_SIZE, BOARD_SIZE, 1, Simulation::PACKED_GRID)
+    {
+        covered.assign(BOARD_SIZE * BOARD_SIZE, 0);
+        sim.setSparse(true);
+        sim.setCycleDetection(MAX_PERIOD);
+        soups = 0;
+        unstable = 0;
+        generations = 0;
+    }
+};
+
+// Gets the next number of a splitmix64 sequence
+static uint64_t nextRandom(uint64_t &state)
+{
+    uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+// Gets a hash of a set of cells that is the same after moving, rotating
+// or reflecting them: the smallest hash of the 8 orientations, each
+// moved so that its top-left corner is at 0,0
+static uint64_t getShapeKey(const std::vector<int> &xs, const std::vector<int> &ys)
+{
+    uint64_t best = ~static_cast<uint64_t>(0);
+    for (int t = 0; t < 8; t++)
+    {
+        int minA = INT_MAX;
+        int minB = INT_MAX;
+        for (unsigned i = 0; i < xs.size(); i++)
+        {
+            int a = (t & 1) ? -xs[i] : xs[i];
+            int b = (t & 2) ? -ys[i] : ys[i];
+            minA = std::min(minA, (t & 4) ? b : a);
+            minB = std::min(minB, (t & 4) ? a : b);
+        }
+        uint64_t key = 0;
+        for (unsigned i = 0; i < xs.size(); i++)
+        {
+            int a = (t & 1) ? -xs[i] : xs[i];
+            int b = (t & 2) ? -ys[i] : ys[i];
+            if (t & 4)
+            {
+                std::swap(a, b);
+            }
+            key ^= Grid::getCellKey(a - minA, b - minB);
+        }
+        best = std::min(best, key);
+    }
+    return best;
+}
+
+// Adds the live cells of the bounding box of a board to an object
+static void collectLiveCells(const Simulation &sim, std::vector<int> &xs,
+                             std::vector<int> &ys)
+{
+    xs.clear();
+    ys.clear();
+    int left, top, w, h;
+    if (!sim.getBoundingBox(left, top, w, h))
+    {
+        return;
+    }
+    for (int y = top; y < top + h; y++)
+    {
+        for (int x = left; x < left + w; x++)
+        {
+            if (sim.getCell(x, y))
+            {
+                xs.push_back(x);
+                ys.push_back(y);
+            }
+        }
+    }
+}
+
+/********************************************************************
+ *  Function:       SoupSearch(int threadCount)
+ *  Description:    Creates one worker per thread and builds the census
+ *                  tables by running each known object on the first
+ *                  worker.
+ *  Parameters:     threadCount     Number of threads, 0 for one per core
+ *******************************************************************/
+SoupSearch::SoupSearch(int threadCount)
+{
+    // Validate argument
+    if (threadCount < 0)
+    {
+        throw std::invalid_argument("ERROR: Thread count cannot be negative.");
+    }
+    if (threadCount == 0)
+    {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    
+    pool = threadCount > 1 ? new ThreadPool(threadCount) : NULL;
+    for (int i = 0; i < threadCount; i++)
+    {
+        workers.push_back(new Worker);
+    }
+    
+    names.push_back(OTHER_NAME);
+    for (int i = 0; i < KNOWN_OBJECT_COUNT; i++)
+    {
+        addObject(KNOWN_OBJECTS[i].name, KNOWN_OBJECTS[i].rle,
+                  KNOWN_OBJECTS[i].period, KNOWN_OBJECTS[i].escapes);
+    }
+    counts.assign(names.size(), 0);
+    for (int i = 0; i < threadCount; i++)
+    {
+        workers[i]->counts.assign(names.size(), 0);
+    }
+    soupCount = 0;
+    unstableCount = 0;
+    generationCount = 0;
+}
+
+/********************************************************************
+ *  Function:       ~SoupSearch()
+ *  Description:    Stops the threads and frees the workers.
+ *******************************************************************/
+SoupSearch::~SoupSearch()
+{
+    delete pool;
+    for (unsigned i = 0; i < workers.size(); i++)
+    {
+        delete workers[i];
+    }
+}
+
+/********************************************************************
+ *  Function:       int addObject(const std::string &name, const char *rle,
+ *                                int period, bool escapes)
+ *  Description:    Runs an object by itself and adds it to the census.
+ *                  A spaceship is found at the edge band, so each of
+ *                  its phases is added. Any other object is found after
+ *                  the board repeats, so the cells it covers over one
+ *                  period are added as one shape.
+ *  Parameters:     name        Name of the object
+ *                  rle         Cells of one phase in RLE
+ *                  period      Generations until the shape repeats
+ *                  escapes     Whether the object moves
+ *  Preconditions:  The first worker exists, and the cells of a stable
+ *                  object over its period are 8-connected
+ *  Postconditions: Returns the census index of the object
+ *******************************************************************/
+int SoupSearch::addObject(const std::string &name, const char *rle, int period,
+                          bool escapes)
+{
+    Worker &w = *workers[0];
+    w.sim.clear();
+    std::istringstream in(std::string("x = 0, y = 0\n") + rle + "\n");
+    PatternReader reader(in);
+    w.sim.addPattern(reader, BOARD_SIZE / 2, BOARD_SIZE / 2);
+    
+    int index = names.size();
+    names.push_back(name);
+    if (escapes)
+    {
+        for (int phase = 0; phase < period; phase++)
+        {
+            collectLiveCells(w.sim, w.cellsX, w.cellsY);
+            escapeKeys[getShapeKey(w.cellsX, w.cellsY)] = index;
+            w.sim.advanceGeneration();
+        }
+    }
+    else
+    {
+        // The census of the object alone finds one object, or the
+        // object is made of pieces that would be counted separately
+        w.counts.assign(names.size(), 0);
+        takeCensus(w, period);
+        long long found = 0;
+        for (unsigned i = 0; i < w.counts.size(); i++)
+        {
+            found += w.counts[i];
+        }
+        if (found != 1)
+        {
+            throw std::logic_error("ERROR: " + name + " is not one object.");
+        }
+        stableKeys[getShapeKey(w.cellsX, w.cellsY)] = index;
+    }
+    w.sim.clear();
+    return index;
+}
+
+/********************************************************************
+ *  Function:       void run(uint64_t seed, uint64_t first, int count)
+ *  Description:    Runs soups first to first + count - 1 of the seed.
+ *                  Each thread takes the next soup number until all are
+ *                  taken, and the counts of the workers are added to
+ *                  the totals at the end.
+ *  Parameters:     seed    Seed shared by all soups of a search
+ *                  first   Number of the first soup
+ *                  count   Number of soups to run
+ *  Preconditions:  count >= 0
+ *  Postconditions: Census includes the objects of every soup
+ *******************************************************************/
+void SoupSearch::run(uint64_t seed, uint64_t first, int count)
+{
+    // Validate argument
+    if (count < 0)
+    {
+        throw std::invalid_argument("ERROR: Soup count cannot be negative.");
+    }
+    
+    std::atomic<uint64_t> next(first);
+    uint64_t end = first + count;
+    std::function<void(int)> task = [&](int index)
+    {
+        Worker &w = *workers[index];
+        for (uint64_t n = next++; n < end; n = next++)
+        {
+            runSoup(w, seed ^ (n * 0xd1b54a32d192ed03ULL));
+        }
+    };
+    if (pool)
+    {
+        pool->run(task);
+    }
+    else
+    {
+        task(0);
+    }
+    
+    for (unsigned i = 0; i < workers.size(); i++)
+    {
+        Worker &w = *workers[i];
+        for (unsigned j = 0; j < counts.size(); j++)
+        {
+            counts[j] += w.counts[j];
+            w.counts[j] = 0;
+        }
+        soupCount += w.soups;
+        unstableCount += w.unstable;
+        generationCount += w.generations;
+        w.soups = w.unstable = w.generations = 0;
+    }
+}
+
+/********************************************************************
+ *  Function:       void runSoup(Worker &w, uint64_t state)
+ *  Description:    Fills the soup with random cells at a density of
+ *                  one half, stamping it in the middle of the board a
+ *                  row at a time straight from the random words, and
+ *                  runs it until the board repeats. Every 8 generations
+ *                  the objects that reached the edge band are removed,
+ *                  which a glider cannot cross in less than 32.
+ *  Parameters:     w       Worker to run the soup on
+ *                  state   Random state that generates the soup
+ *  Preconditions:  none
+ *  Postconditions: Census of the soup is added to the worker counts
+ *******************************************************************/
+void SoupSearch::runSoup(Worker &w, uint64_t state)
+{
+    const int corner = (BOARD_SIZE - SOUP_SIZE) / 2;
+    w.sim.clear();
+    for (int y = 0; y < SOUP_SIZE; y += 4)
+    {
+        // Each random word holds 4 rows of the soup
+        uint64_t bits = nextRandom(state);
+        for (int i = 0; i < 4; i++)
+        {
+            uint64_t row = (bits >> (i * SOUP_SIZE)) & ((1 << SOUP_SIZE) - 1);
+            w.sim.setRowBits(corner, corner + y + i, SOUP_SIZE, &row);
+        }
+    }
+    
+    int generation = 0;
+    while (w.sim.getPeriod() == 0 && generation < MAX_GENERATIONS)
+    {
+        w.sim.advanceGeneration();
+        generation++;
+        if (generation % 8 == 0)
+        {
+            removeEscapes(w);
+        }
+    }
+    
+    w.soups++;
+    w.generations += generation;
+    if (w.sim.getPeriod() == 0)
+    {
+        w.unstable++;
+        return;
+    }
+    takeCensus(w, w.sim.getPeriod());
+}
+
+/********************************************************************
+ *  Function:       void removeEscapes(Worker &w)
+ *  Description:    If the bounding box reaches the edge band, finds
+ *                  each 8-connected object with a cell in the band.
+ *                  Objects in a phase of a known spaceship are erased
+ *                  and counted; anything else is debris that is left to
+ *                  settle, or to die at the edge.
+ *  Parameters:     w       Worker whose board is checked
+ *  Preconditions:  none
+ *  Postconditions: No known spaceships are in the edge band
+ *******************************************************************/
+void SoupSearch::removeEscapes(Worker &w)
+{
+    int left, top, width, height;
+    if (!w.sim.getBoundingBox(left, top, width, height)
+        || (left >= EDGE_BAND && top >= EDGE_BAND
+            && left + width <= BOARD_SIZE - EDGE_BAND
+            && top + height <= BOARD_SIZE - EDGE_BAND))
+    {
+        return;
+    }
+    
+    for (int y = top; y < top + height; y++)
+    {
+        bool inBand = y < EDGE_BAND || y >= BOARD_SIZE - EDGE_BAND;
+        for (int x = left; x < left + width; x++)
+        {
+            if (!inBand && x >= EDGE_BAND && x < BOARD_SIZE - EDGE_BAND)
+            {
+                x = BOARD_SIZE - EDGE_BAND;
+            }
+            if (!w.sim.getCell(x, y) || w.covered[y * BOARD_SIZE + x])
+            {
+                continue;
+            }
+    
+            // Mark the object in covered while collecting its cells
+            w.cellsX.clear();
+            w.cellsY.clear();
+            w.stack.push_back(y * BOARD_SIZE + x);
+            w.covered[y * BOARD_SIZE + x] = 1;
+            while (!w.stack.empty())
+            {
+                int cell = w.stack.back();
+                w.stack.pop_back();
+                int cx = cell % BOARD_SIZE;
+                int cy = cell / BOARD_SIZE;
+                w.cellsX.push_back(cx);
+                w.cellsY.push_back(cy);
+                w.marked.push_back(cell);
+                for (int ny = std::max(cy - 1, 0); ny <= std::min(cy + 1, BOARD_SIZE - 1); ny++)
+                {
+                    for (int nx = std::max(cx - 1, 0); nx <= std::min(cx + 1, BOARD_SIZE - 1); nx++)
+                    {
+                        if (w.sim.getCell(nx, ny) && !w.covered[ny * BOARD_SIZE + nx])
+                        {
+                            w.covered[ny * BOARD_SIZE + nx] = 1;
+                            w.stack.push_back(ny * BOARD_SIZE + nx);
+                        }
+                    }
+                }
+            }
+    
+            // Debris is left to settle or hit the edge
+            std::unordered_map<uint64_t, int>::const_iterator it =
+                escapeKeys.find(getShapeKey(w.cellsX, w.cellsY));
+            if (it == escapeKeys.end())
+            {
+                continue;
+            }
+            for (unsigned i = 0; i < w.cellsX.size(); i++)
+            {
+                w.sim.setCell(w.cellsX[i], w.cellsY[i], false);
+            }
+            w.counts[it->second]++;
+        }
+    }
+    
+    for (unsigned i = 0; i < w.marked.size(); i++)
+    {
+        w.covered[w.marked[i]] = 0;
+    }
+    w.marked.clear();
+}
+
+/********************************************************************
+ *  Function:       void takeCensus(Worker &w, int period)
+ *  Description:    Marks the cells live at any time during one period,
+ *                  splits them into 8-connected objects and counts each
+ *                  object by its shape. The cells of the last object
+ *                  are left in cellsX and cellsY.
+ *  Parameters:     w       Worker whose board has stabilized
+ *                  period  Period of the board
+ *  Preconditions:  Board repeats every period generations
+ *  Postconditions: Objects are added to the worker counts
+ *******************************************************************/
+void SoupSearch::takeCensus(Worker &w, int period)
+{
+    int left = BOARD_SIZE;
+    int top = BOARD_SIZE;
+    int right = -1;
+    int bottom = -1;
+    for (int i = 0; i < period; i++)
+    {
+        int x0, y0, width, height;
+        if (w.sim.getBoundingBox(x0, y0, width, height))
+        {
+            for (int y = y0; y < y0 + height; y++)
+            {
+                for (int x = x0; x < x0 + width; x++)
+                {
+                    w.covered[y * BOARD_SIZE + x] |= w.sim.getCell(x, y);
+                }
+            }
+            left = std::min(left, x0);
+            top = std::min(top, y0);
+            right = std::max(right, x0 + width - 1);
+            bottom = std::max(bottom, y0 + height - 1);
+        }
+        w.sim.advanceGeneration();
+    }
+    
+    for (int y = top; y <= bottom; y++)
+    {
+        for (int x = left; x <= right; x++)
+        {
+            if (!w.covered[y * BOARD_SIZE + x])
+            {
+                continue;
+            }
+    
+            // Clear the object from covered while collecting its cells
+            w.cellsX.clear();
+            w.cellsY.clear();
+            w.stack.push_back(y * BOARD_SIZE + x);
+            w.covered[y * BOARD_SIZE + x] = 0;
+            while (!w.stack.empty())
+            {
+                int cell = w.stack.back();
+                w.stack.pop_back();
+                int cx = cell % BOARD_SIZE;
+                int cy = cell / BOARD_SIZE;
+                w.cellsX.push_back(cx);
+                w.cellsY.push_back(cy);
+                for (int ny = std::max(cy - 1, top); ny <= std::min(cy + 1, bottom); ny++)
+                {
+                    for (int nx = std::max(cx - 1, left); nx <= std::min(cx + 1, right); nx++)
+                    {
+                        if (w.covered[ny * BOARD_SIZE + nx])
+                        {
+                            w.covered[ny * BOARD_SIZE + nx] = 0;
+                            w.stack.push_back(ny * BOARD_SIZE + nx);
+                        }
+                    }
+                }
+            }
+    
+            std::unordered_map<uint64_t, int>::const_iterator it =
+                stableKeys.find(getShapeKey(w.cellsX, w.cellsY));
+            w.counts[it == stableKeys.end() ? OTHER_INDEX : it->second]++;
+        }
+    }
+}
+
+/********************************************************************
+ *  Function:       long long getCount(const std::string &name)
+ *  Description:    Gets the number of objects with the specified name
+ *                  found by all soups run so far.
+ *  Parameters:     name    Name from getNames
+ *  Preconditions:  none
+ *  Postconditions: Returns the count, 0 if the name is unknown
+ *******************************************************************/
+long long SoupSearch::getCount(const std::string &name) const
+{
+    for (unsigned i = 0; i < names.size(); i++)
+    {
+        if (names[i] == name)
+        {
+            return counts[i];
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,145 @@
+/*************************************************************************
+ * Author:          David Rigert
+ * Date Created:    10/17/2026
+ * Last Modified:   10/17/2026
+ * Assignment:      Assignment 1
+ * Filename:        SoupSearch.hpp
+ *
+ * Description:     Runs random 16x16 soups to stabilization on a pool of
+ *                  threads and counts the objects they leave behind.
+ *                  Each worker owns a Simulation and the buffers used
+ *                  for the census, all allocated once and reused for
+ *                  every soup it runs, and soups are stamped a row at a
+ *                  time from random words. Soup n is generated
+ *                  from the seed and n alone, so the census of a range
+ *                  of soups does not depend on the number of threads.
+ ************************************************************************/
+#ifndef SOUPSEARCH_HPP
+#define SOUPSEARCH_HPP
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <stdint.h>
+
+// forward declarations
+class ThreadPool;
+
+class SoupSearch
+{
+public:
+    static const int SOUP_SIZE = 16;        // cells on each side of a soup
+    static const int BOARD_SIZE = 128;      // cells on each side of the board
+    static const int EDGE_BAND = 8;         // cells near the edge that escape
+    static const int MAX_PERIOD = 64;       // longest period detected
+    static const int MAX_GENERATIONS = 20000;   // soups still running stop
+
+private:
+    struct Worker;
+
+// member variables
+private:
+    ThreadPool *pool;           // threads running the soups, or NULL
+    std::vector<Worker *> workers;  // state owned by each thread
+    std::vector<std::string> names; // object names by census index
+    std::unordered_map<uint64_t, int> stableKeys;   // object by shape over a period
+    std::unordered_map<uint64_t, int> escapeKeys;   // spaceship by shape of a phase
+    std::vector<long long> counts;  // objects found by census index
+    long long soupCount;        // soups run
+    long long unstableCount;    // soups stopped at MAX_GENERATIONS
+    long long generationCount;  // generations run by all soups
+
+// member functions
+private:
+    // SoupSearch owns its threads and workers, so copying is not allowed
+    SoupSearch(const SoupSearch &);
+    SoupSearch &operator=(const SoupSearch &);
+
+    // Adds an object to the census table under each of its phases.
+    int addObject(const std::string &, const char *, int, bool);
+
+    // Runs one soup on a worker and adds its objects to the worker counts.
+    void runSoup(Worker &, uint64_t);
+
+    // Removes and counts the objects that reached the edge band.
+    void removeEscapes(Worker &);
+
+    // Counts the objects left on the board over one period.
+    void takeCensus(Worker &, int);
+
+public:
+    // Creates the workers and the table of known objects.
+    explicit SoupSearch(int = 1);
+
+    // Stops the threads and frees the workers.
+    ~SoupSearch();
+
+    /********************************************************************
+     *  Function:       int getThreadCount()
+     *  Description:    Gets the number of threads running soups.
+     *  Parameters:     none
+     *  Preconditions:  none
+     *  Postconditions: Returns the number of workers
+     *******************************************************************/
+    int getThreadCount() const
+    {
+        return workers.size();
+    }
+
+    // Runs the specified number of soups starting with soup number first.
+    void run(uint64_t, uint64_t, int);
+
+    /********************************************************************
+     *  Function:       const std::vector<std::string> &getNames()
+     *  Description:    Gets the names of the objects in the census.
+     *  Parameters:     none
+     *  Preconditions:  none
+     *  Postconditions: Returns the names by census index
+     *******************************************************************/
+    const std::vector<std::string> &getNames() const
+    {
+        return names;
+    }
+
+    // Gets the number of objects found with the specified name.
+    long long getCount(const std::string &) const;
+
+    /********************************************************************
+     *  Function:       long long getSoupCount()
+     *  Description:    Gets the number of soups run so far.
+     *  Parameters:     none
+     *  Preconditions:  none
+     *  Postconditions: Returns the soup count
+     *******************************************************************/
+    long long getSoupCount() const
+    {
+        return soupCount;
+    }
+
+    /********************************************************************
+     *  Function:       long long getUnstableCount()
+     *  Description:    Gets the number of soups that did not stabilize
+     *                  within MAX_GENERATIONS generations.
+     *  Parameters:     none
+     *  Preconditions:  none
+     *  Postconditions: Returns the unstabilized soup count
+     *******************************************************************/
+    long long getUnstableCount() const
+    {
+        return unstableCount;
+    }
+
+    /********************************************************************
+     *  Function:       long long getGenerationCount()
+     *  Description:    Gets the number of generations run by all soups.
+     *  Parameters:     none
+     *  Preconditions:  none
+     *  Postconditions: Returns the generation count
+     *******************************************************************/
+    long long getGenerationCount() const
+    {
+        return generationCount;
+    }
+};
+
+#endif // end of define SOUPSEARCH_HPP
@@ -0,0 +1,829 @@
+/*************************************************************************
+ * Author:          David Rigert
+ * Date Created:    10/17/2026
+ * Last Modified:   10/17/2026
+ * Assignment:      Assignment 1
+ * Filename:        StateGrid.cpp
+ *
+ * Description:     Implementation of the StateGrid class.
+ *                  Cell x of a row is stored in bit (x % 64) of word
+ *                  (x / 64) of every plane, and plane p holds bit p of
+ *                  the state. Rules with up to 4 states use 2 planes and
+ *                  the others use 4, so a cell takes 2 or 4 bits.
+ *
+ *                  Only cells in state 1 are counted as neighbors, so
+ *                  the Life-like neighbor count and rule of LifeWord.hpp
+ *                  are shared with PackedGrid. The kernels then advance
+ *                  the other states by adding 1 to the planes of the
+ *                  cells that change, one ripple carry per plane.
+ ************************************************************************/
+#include <algorithm>
+#include "StateGrid.hpp"
+#include "LifeWord.hpp"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define STATEGRID_X86
+#endif
+
+// Rows ahead of the kernel fetched into cache in tiles narrower than a row
+static const int PREFETCH_ROWS = 8;
+
+/********************************************************************
+ *  Function:       StateGrid(int width, int height)
+ *  Description:    Allocates both generation buffers with two planes
+ *                  and all cells dead, and calculates the masks that
+ *                  keep the outermost ring of cells dead.
+ *  Parameters:     width   Width of the grid including buffer cells
+ *                  height  Height of the grid including buffer cells
+ *******************************************************************/
+StateGrid::StateGrid(int width, int height) : Grid(width, height)
+{
+    wordsPerRow = (width + 63) / 64;
+    planes = 2;
+    current.assign(wordsPerRow * height * planes, 0);
+    next.assign(wordsPerRow * height * planes, 0);
+    computeRow = &StateGrid::computeGenerationsRow<2>;
+    countRowStats = &StateGrid::countRowChanges;
+    #if defined(STATEGRID_X86)
+    if (hasPopcount())
+    {
+        countRowStats = &StateGrid::countPopcountChanges;
+    }
+    #endif
+    
+    // Column 0 and column width - 1 are never evaluated
+    int lastBit = (width - 1) & 63;
+    firstMask = ~static_cast<uint64_t>(1);
+    lastMask = (static_cast<uint64_t>(1) << lastBit) - 1;
+    if (wordsPerRow == 1)
+    {
+        firstMask &= lastMask;
+        lastMask = firstMask;
+    }
+}
+
+/********************************************************************
+ *  Function:       int getWordState(const uint64_t *word, int bit)
+ *  Description:    Gathers the state of one cell from the planes of
+ *                  its word.
+ *  Parameters:     word    Plane 0 of the word
+ *                  bit     Bit of the cell in the word
+ *  Preconditions:  0 <= bit < 64
+ *  Postconditions: Returns the state of the cell
+ *******************************************************************/
+int StateGrid::getWordState(const uint64_t *word, int bit) const
+{
+    int state = 0;
+    for (int p = 0; p < planes; p++)
+    {
+        state |= static_cast<int>((word[p] >> bit) & 1) << p;
+    }
+    return state;
+}
+
+/********************************************************************
+ *  Function:       uint64_t getStateKey(int x, int y, int state)
+ *  Description:    Gets the Zobrist key of a cell in a state. State 1
+ *                  uses the key of a live cell of the other backends,
+ *                  and each other state moves the row far away, so
+ *                  every state of every cell has its own key.
+ *  Parameters:     x       X coordinate of the cell
+ *                  y       Y coordinate of the cell
+ *                  state   State of the cell
+ *  Preconditions:  none
+ *  Postconditions: Returns 0 for state 0
+ *******************************************************************/
+uint64_t StateGrid::getStateKey(int x, int y, int state)
+{
+    if (state == 0)
+    {
+        return 0;
+    }
+    return getCellKey(x, y ^ static_cast<int>(static_cast<unsigned>(state - 1) << 24));
+}
+
+/********************************************************************
+ *  Function:       int getState(int x, int y)
+ *  Description:    Gets the state of the specified cell.
+ *  Parameters:     x   X coordinate of cell
+ *                  y   Y coordinate of cell
+ *  Preconditions:  x,y is on the grid
+ *  Postconditions: Returns 0 to the state count of the rule - 1
+ *******************************************************************/
+int StateGrid::getState(int x, int y) const
+{
+    return getWordState(&current[index(y, x >> 6)], x & 63);
+}
+
+/********************************************************************
+ *  Function:       void setState(int x, int y, int state)
+ *  Description:    Sets the state of the specified cell in each plane.
+ *  Parameters:     x       X coordinate of cell
+ *                  y       Y coordinate of cell
+ *                  state   New state of the cell
+ *  Preconditions:  x,y is on the grid
+ *  Postconditions: Cell at x,y is in state; throws invalid_argument
+ *                  if the rule has no such state
+ *******************************************************************/
+void StateGrid::setState(int x, int y, int state)
+{
+    if (state < 0 || state >= rule.getStateCount())
+    {
+        throw std::invalid_argument("ERROR: State is not used by the rule.");
+    }
+    
+    uint64_t bit = static_cast<uint64_t>(1) << (x & 63);
+    uint64_t *word = &current[index(y, x >> 6)];
+    for (int p = 0; p < planes; p++)
+    {
+        if ((state >> p) & 1)
+        {
+            word[p] |= bit;
+        }
+        else
+        {
+            word[p] &= ~bit;
+        }
+    }
+}
+
+/********************************************************************
+ *  Function:       void clear()
+ *  Description:    Kills every cell in both buffers.
+ *  Parameters:     none
+ *  Preconditions:  none
+ *  Postconditions: Every cell is in state 0
+ *******************************************************************/
+void StateGrid::clear()
+{
+    std::fill(current.begin(), current.end(), 0);
+    std::fill(next.begin(), next.end(), 0);
+}
+
+/********************************************************************
+ *  Function:       long long getPopulation()
+ *  Description:    Counts the cells not in state 0 with
+ *                  countPopulation, using its popcnt copy when the CPU
+ *                  has the instruction.
+ *  Parameters:     none
+ *  Preconditions:  none
+ *  Postconditions: Returns the number of cells not in state 0
+ *******************************************************************/
+long long StateGrid::getPopulation() const
+{
+    #if defined(STATEGRID_X86)
+    if (hasPopcount())
+    {
+        return countPopcountPopulation();
+    }
+    #endif
+    return countPopulation();
+}
+
+/********************************************************************
+ *  Function:       long long countPopulation()
+ *  Description:    Counts the cells inside the outermost ring that are
+ *                  in any state but 0, 64 cells at a time.
+ *  Parameters:     none
+ *  Preconditions:  none
+ *  Postconditions: Returns the number of cells not in state 0
+ *******************************************************************/
+long long StateGrid::countPopulation() const
+{
+    long long count = 0;
+    for (int y = 1; y < height - 1; y++)
+    {
+        for (int w = 0; w < wordsPerRow; w++)
+        {
+            uint64_t word = getOccupied(&current[index(y, w)]);
+            word &= w == 0 ? firstMask : ~static_cast<uint64_t>(0);
+            word &= w == wordsPerRow - 1 ? lastMask : ~static_cast<uint64_t>(0);
+            count += __builtin_popcountll(word);
+        }
+    }
+    return count;
+}
+
+/********************************************************************
+ *  Function:       long long countPopcountPopulation()
+ *  Description:    Counts the cells like countPopulation, which is
+ *                  inlined here so its bit counts compile to the
+ *                  popcnt instruction instead of a library call.
+ *  Parameters:     none
+ *  Preconditions:  CPU supports popcnt
+ *  Postconditions: Returns the number of cells not in state 0
+ *******************************************************************/
+#if defined(STATEGRID_X86)
+__attribute__((target("popcnt"), flatten))
+long long StateGrid::countPopcountPopulation() const
+{
+    return countPopulation();
+}
+#endif
+
+/********************************************************************
+ *  Function:       bool getBounds(int &left, int &top, int &right,
+ *                                 int &bottom)
+ *  Description:    Finds the cells not in state 0 furthest in each
+ *                  direction, skipping the outermost ring.
+ *  Parameters:     left    Receives the X coordinate of the first column
+ *                  top     Receives the Y coordinate of the first row
+ *                  right   Receives the X coordinate of the last column
+ *                  bottom  Receives the Y coordinate of the last row
+ *  Preconditions:  none
+ *  Postconditions: Returns false and leaves the arguments unchanged
+ *                  if every cell is in state 0
+ *******************************************************************/
+bool StateGrid::getBounds(int &left, int &top, int &right, int &bottom) const
+{
+    bool found = false;
+    for (int y = 1; y < height - 1; y++)
+    {
+        for (int w = 0; w < wordsPerRow; w++)
+        {
+            uint64_t word = getOccupied(&current[index(y, w)]);
+            word &= w == 0 ? firstMask : ~static_cast<uint64_t>(0);
+            word &= w == wordsPerRow - 1 ? lastMask : ~static_cast<uint64_t>(0);
+            if (!word)
+            {
+                continue;
+            }
+            int first = w * 64 + __builtin_ctzll(word);
+            int last = w * 64 + 63 - __builtin_clzll(word);
+            if (!found)
+            {
+                left = first;
+                right = last;
+                top = y;
+                found = true;
+            }
+            left = std::min(left, first);
+            right = std::max(right, last);
+            bottom = y;
+        }
+    }
+    return found;
+}
+
+/********************************************************************
+ *  Function:       void exchangeHalo()
+ *  Description:    Copies the edges of the interior into the outermost
+ *                  ring on the opposite side with their states, whole
+ *                  rows of planes at a time for a torus.
+ *  Parameters:     none
+ *  Preconditions:  width >= 3, height >= 3
+ *  Postconditions: Ring cells match the cells they wrap around to
+ *******************************************************************/
+void StateGrid::exchangeHalo()
+{
+    if (boundary == DEAD_EDGE)
+    {
+        return;
+    }
+    
+    // Left and right edges are joined for both wrapping modes
+    int lastWord = wordsPerRow - 1;
+    int fromWord = (width - 2) >> 6;
+    int fromBit = (width - 2) & 63;
+    uint64_t rightBit = static_cast<uint64_t>(1) << ((width - 1) & 63);
+    for (int y = 1; y < height - 1; y++)
+    {
+        uint64_t *first = &current[index(y, 0)];
+        uint64_t *last = &current[index(y, lastWord)];
+        const uint64_t *from = &current[index(y, fromWord)];
+        for (int p = 0; p < planes; p++)
+        {
+            uint64_t fromRight = (from[p] >> fromBit) & 1;
+            uint64_t fromLeft = (first[p] >> 1) & 1;
+            first[p] = (first[p] & ~static_cast<uint64_t>(1)) | fromRight;
+            last[p] = (last[p] & ~rightBit) | (fromLeft ? rightBit : 0);
+        }
+    }
+    
+    // Top and bottom edges, mirrored for a Klein bottle
+    int rowSize = wordsPerRow * planes;
+    uint64_t *top = &current[0];
+    uint64_t *bottom = &current[index(height - 1, 0)];
+    const uint64_t *firstRow = &current[index(1, 0)];
+    const uint64_t *lastRow = &current[index(height - 2, 0)];
+    if (boundary == TORUS)
+    {
+        std::copy(lastRow, lastRow + rowSize, top);
+        std::copy(firstRow, firstRow + rowSize, bottom);
+    }
+    else
+    {
+        std::fill(top, top + rowSize, 0);
+        std::fill(bottom, bottom + rowSize, 0);
+        for (int x = 0; x < width; x++)
+        {
+            int from = width - 1 - x;
+            const uint64_t *fromTop = &lastRow[(from >> 6) * planes];
+            const uint64_t *fromBottom = &firstRow[(from >> 6) * planes];
+            for (int p = 0; p < planes; p++)
+            {
+                top[(x >> 6) * planes + p] |= ((fromTop[p] >> (from & 63)) & 1) << (x & 63);
+                bottom[(x >> 6) * planes + p] |= ((fromBottom[p] >> (from & 63)) & 1) << (x & 63);
+            }
+        }
+    }
+}
+
+/********************************************************************
+ *  Function:       void setRule(const Rule &newRule)
+ *  Description:    Sets the rule and selects the kernel of its family.
+ *                  If the rule needs a different number of planes or
+ *                  has fewer states, the cells are copied into the new
+ *                  layout and cells in states the rule does not have
+ *                  are killed.
+ *  Parameters:     newRule     Rule to use
+ *  Preconditions:  none
+ *  Postconditions: Later generations use newRule
+ *******************************************************************/
+void StateGrid::setRule(const Rule &newRule)
+{
+    int states = newRule.getStateCount();
+    int newPlanes = states > 4 ? 4 : 2;
+    if (newPlanes != planes || states < rule.getStateCount())
+    {
+        std::vector<uint64_t> cells(wordsPerRow * height * newPlanes, 0);
+        for (int i = 0; i < wordsPerRow * height; i++)
+        {
+            const uint64_t *word = &current[i * planes];
+            uint64_t *copy = &cells[i * newPlanes];
+            std::copy(word, word + std::min(planes, newPlanes), copy);
+            uint64_t bits = getOccupied(word);
+            while (bits)
+            {
+                int bit = __builtin_ctzll(bits);
+                if (getWordState(word, bit) >= states)
+                {
+                    for (int p = 0; p < newPlanes; p++)
+                    {
+                        copy[p] &= ~(static_cast<uint64_t>(1) << bit);
+                    }
+                }
+                bits &= bits - 1;
+            }
+        }
+        current.swap(cells);
+        next.assign(current.size(), 0);
+        planes = newPlanes;
+    }
+    rule = newRule;
+    
+    if (rule.getFamily() == Rule::WIREWORLD)
+    {
+        computeRow = &StateGrid::computeWireworldRow;
+    }
+    else if (planes == 4)
+    {
+        computeRow = &StateGrid::computeGenerationsRow<4>;
+    }
+    else
+    {
+        computeRow = &StateGrid::computeGenerationsRow<2>;
+    }
+}
+
+/********************************************************************
+ *  Function:       void countWordStats(RowStats &stats, uint64_t old,
+ *                      uint64_t result, int w)
+ *  Description:    Adds the cells of a word that left or reached state
+ *                  0 to the births and deaths of a row, and widens the
+ *                  extent of the row to the cells not in state 0.
+ *  Parameters:     stats   Statistics of the row
+ *                  old     Cells of the word not in state 0 before
+ *                  result  Cells of the word not in state 0 after
+ *                  w       Word of the row
+ *  Preconditions:  none
+ *  Postconditions: stats includes the word
+ *******************************************************************/
+void StateGrid::countWordStats(RowStats &stats, uint64_t old, uint64_t result, int w) const
+{
+    stats.births += __builtin_popcountll(result & ~old);
+    stats.deaths += __builtin_popcountll(old & ~result);
+    if (result)
+    {
+        stats.left = std::min(stats.left, w * 64 + __builtin_ctzll(result));
+        stats.right = w * 64 + 63 - __builtin_clzll(result);
+    }
+}
+
+/********************************************************************
+ *  Function:       void countRowChanges(int y)
+ *  Description:    Counts the births, deaths and extent of row y of
+ *                  the next generation into rowStats[y] by comparing
+ *                  the occupied cells of each word in both buffers.
+ *                  The kernels only call this for rows with cells not
+ *                  in state 0, right after calculating the row, so its
+ *                  words are still in cache.
+ *  Parameters:     y   Row to count
+ *  Preconditions:  Row y of next buffer is calculated
+ *  Postconditions: rowStats[y] describes row y
+ *******************************************************************/
+void StateGrid::countRowChanges(int y)
+{
+    RowStats stats = { 0, 0, width, -1 };
+    for (int w = 0; w < wordsPerRow; w++)
+    {
+        uint64_t mask = (w == 0 ? firstMask : ~static_cast<uint64_t>(0))
+                      & (w == wordsPerRow - 1 ? lastMask : ~static_cast<uint64_t>(0));
+        uint64_t old = getOccupied(&current[index(y, w)]) & mask;
+        countWordStats(stats, old, getOccupied(&next[index(y, w)]), w);
+    }
+    rowStats[y] = stats;
+}
+
+/********************************************************************
+ *  Function:       void countPopcountChanges(int y)
+ *  Description:    Counts the changes of row y like countRowChanges,
+ *                  which is inlined here so its bit counts compile to
+ *                  the popcnt instruction instead of a library call.
+ *  Parameters:     y   Row to count
+ *  Preconditions:  See countRowChanges, CPU supports popcnt
+ *  Postconditions: rowStats[y] describes row y
+ *******************************************************************/
+#if defined(STATEGRID_X86)
+__attribute__((target("popcnt"), flatten))
+void StateGrid::countPopcountChanges(int y)
+{
+    countRowChanges(y);
+}
+#endif
+
+/********************************************************************
+ *  Function:       uint64_t hashWordChanges(const uint64_t *before,
+ *                      const uint64_t *after, uint64_t mask, int w,
+ *                      int y)
+ *  Description:    Finds the cells of a word whose state differs
+ *                  between its planes before and after a generation,
+ *                  and XORs the keys of their old and new states.
+ *  Parameters:     before  Planes of the word in the current generation
+ *                  after   Planes of the word in the next generation
+ *                  mask    Cells of the word inside the outermost ring
+ *                  w       Word of the row
+ *                  y       Row of the word
+ *  Preconditions:  none
+ *  Postconditions: Returns 0 if no cells changed
+ *******************************************************************/
+uint64_t StateGrid::hashWordChanges(const uint64_t *before, const uint64_t *after,
+                                    uint64_t mask, int w, int y) const
+{
+    uint64_t flips = 0;
+    for (int p = 0; p < planes; p++)
+    {
+        flips |= before[p] ^ after[p];
+    }
+    flips &= mask;
+    
+    uint64_t hash = 0;
+    while (flips)
+    {
+        int bit = __builtin_ctzll(flips);
+        int x = w * 64 + bit;
+        hash ^= getStateKey(x, y, getWordState(after, bit))
+              ^ getStateKey(x, y, getWordState(before, bit));
+        flips &= flips - 1;
+    }
+    return hash;
+}
+
+/********************************************************************
+ *  Function:       void countTouchedRow(int y, uint64_t touched)
+ *  Description:    Fills the statistics of a row the kernel just
+ *                  calculated. Most rows of a board are empty before
+ *                  and after, so the kernels only OR the occupied
+ *                  cells together, and the changes are counted for
+ *                  the other rows.
+ *  Parameters:     y       Row the kernel calculated
+ *                  touched Occupied cells of the row before or after
+ *  Preconditions:  Row y of next buffer is calculated
+ *  Postconditions: rowStats[y] describes row y if statistics are on
+ *******************************************************************/
+void StateGrid::countTouchedRow(int y, uint64_t touched)
+{
+    if (!statsEnabled)
+    {
+        return;
+    }
+    if (touched)
+    {
+        (this->*countRowStats)(y);
+    }
+    else
+    {
+        RowStats empty = { 0, 0, width, -1 };
+        rowStats[y] = empty;
+    }
+}
+
+/********************************************************************
+ *  Function:       void computeGenerationsRow<PLANES>(int y, int first,
+ *                      int last)
+ *  Description:    Calculates words first to last - 1 of row y of a
+ *                  Generations rule. A cell in state 0 is born and a
+ *                  cell in state 1 survives by the masks of the rule;
+ *                  every other cell that is not in state 0 moves to
+ *                  the next state, and reaching the state count wraps
+ *                  to 0. With two states this is the Life-like rule,
+ *                  since a dying cell wraps at once. When hashing,
+ *                  each word is compared with its planes before the
+ *                  generation as soon as it is calculated.
+ *  Parameters:     y       Row to calculate
+ *                  first   First word to calculate
+ *                  last    Word after the last word to calculate
+ *  Preconditions:  0 < y < height - 1, 0 <= first < last <= wordsPerRow;
+ *                  statistics are disabled unless the whole row is
+ *                  calculated
+ *  Postconditions: Words of row y in next buffer contain next generation
+ *******************************************************************/
+template <int PLANES>
+void StateGrid::computeGenerationsRow(int y, int first, int last)
+{
+    const unsigned birth = rule.getBirth();
+    const unsigned survival = rule.getSurvival();
+    const unsigned states = rule.getStateCount();
+    const uint64_t *above = &current[index(y - 1, 0)];
+    const uint64_t *row = &current[index(y, 0)];
+    const uint64_t *below = &current[index(y + 1, 0)];
+    uint64_t *out = &next[index(y, 0)];
+    uint64_t touched = 0;
+    uint64_t hash = 0;
+    
+    // Live cells are the cells in state 1, of the words west of and at
+    // first (0 beyond the edge)
+    uint64_t alive[3][3] = { { 0 } };
+    const uint64_t *rows[3] = { above, row, below };
+    for (int r = 0; r < 3; r++)
+    {
+        for (int c = first > 0 ? 0 : 1; c < 2; c++)
+        {
+            const uint64_t *word = rows[r] + (first - 1 + c) * PLANES;
+            uint64_t higher = 0;
+            for (int p = 1; p < PLANES; p++)
+            {
+                higher |= word[p];
+            }
+            alive[r][c] = word[0] & ~higher;
+        }
+    }
+    
+    for (int w = first; w < last; w++)
+    {
+        // Live cells of the word east of w
+        for (int r = 0; r < 3; r++)
+        {
+            uint64_t east = 0;
+            if (w < wordsPerRow - 1)
+            {
+                const uint64_t *word = rows[r] + (w + 1) * PLANES;
+                uint64_t higher = 0;
+                for (int p = 1; p < PLANES; p++)
+                {
+                    higher |= word[p];
+                }
+                east = word[0] & ~higher;
+            }
+            alive[r][2] = east;
+        }
+    
+        const uint64_t *word = row + w * PLANES;
+        uint64_t c = alive[1][1];
+        uint64_t occupied = 0;
+        for (int p = 0; p < PLANES; p++)
+        {
+            occupied |= word[p];
+        }
+        LifePlanes counts = countLifeNeighbors(
+            alive[0][0], alive[0][1], alive[0][2],
+            alive[1][0], c, alive[1][2],
+            alive[2][0], alive[2][1], alive[2][2]);
+    
+        // Only dead cells are born, and cells that stay alive keep state 1
+        uint64_t result = applyLifeRule(counts, c, birth, survival) & (c | ~occupied);
+        uint64_t born = result & ~c;
+        uint64_t carry = occupied & ~(c & result);
+        uint64_t planesOut[PLANES];
+        for (int p = 0; p < PLANES; p++)
+        {
+            planesOut[p] = word[p] ^ carry;
+            carry &= word[p];
+        }
+    
+        // Cells that reach the state count are dead again
+        uint64_t wrap = ~static_cast<uint64_t>(0);
+        for (int p = 0; p < PLANES; p++)
+        {
+            wrap &= ((states >> p) & 1) ? planesOut[p] : ~planesOut[p];
+        }
+        uint64_t mask = (w == 0 ? firstMask : ~static_cast<uint64_t>(0))
+                      & (w == wordsPerRow - 1 ? lastMask : ~static_cast<uint64_t>(0));
+        uint64_t after = 0;
+        for (int p = 0; p < PLANES; p++)
+        {
+            planesOut[p] = (planesOut[p] & ~wrap) | (p == 0 ? born : 0);
+            out[w * PLANES + p] = planesOut[p] & mask;
+            after |= planesOut[p] & mask;
+        }
+        touched |= (occupied & mask) | after;
+        if (hashEnabled)
+        {
+            hash ^= hashWordChanges(word, out + w * PLANES, mask, w, y);
+        }
+    
+        for (int r = 0; r < 3; r++)
+        {
+            alive[r][0] = alive[r][1];
+            alive[r][1] = alive[r][2];
+        }
+    }
+    
+    countTouchedRow(y, touched);
+    addChangeHash(hash);
+}
+
+/********************************************************************
+ *  Function:       void computeWireworldRow(int y, int first, int last)
+ *  Description:    Calculates words first to last - 1 of row y of
+ *                  Wireworld, where state 1 is an electron head, 2 a
+ *                  tail and 3 a conductor. A head becomes a tail, a
+ *                  tail becomes a conductor, and a conductor becomes a
+ *                  head if 1 or 2 of its neighbors are heads. With the
+ *                  state in two planes, the new planes are a few
+ *                  operations on the old ones.
+ *  Parameters:     y       Row to calculate
+ *                  first   First word to calculate
+ *                  last    Word after the last word to calculate
+ *  Preconditions:  0 < y < height - 1, rule has 2 planes,
+ *                  0 <= first < last <= wordsPerRow; statistics are
+ *                  disabled unless the whole row is calculated
+ *  Postconditions: Words of row y in next buffer contain next generation
+ *******************************************************************/
+void StateGrid::computeWireworldRow(int y, int first, int last)
+{
+    const uint64_t *rows[3] = { &current[index(y - 1, 0)], &current[index(y, 0)],
+                                &current[index(y + 1, 0)] };
+    uint64_t *out = &next[index(y, 0)];
+    uint64_t touched = 0;
+    uint64_t hash = 0;
+    
+    // Heads of the words west of, at and east of w (0 beyond the edge)
+    uint64_t heads[3][3] = { { 0 } };
+    for (int r = 0; r < 3; r++)
+    {
+        const uint64_t *word = rows[r] + first * 2;
+        heads[r][0] = first > 0 ? word[-2] & ~word[-1] : 0;
+        heads[r][1] = word[0] & ~word[1];
+    }
+    
+    for (int w = first; w < last; w++)
+    {
+        for (int r = 0; r < 3; r++)
+        {
+            const uint64_t *east = rows[r] + (w + 1) * 2;
+            heads[r][2] = w < wordsPerRow - 1 ? east[0] & ~east[1] : 0;
+        }
+    
+        const uint64_t *word = rows[1] + w * 2;
+        LifePlanes counts = countLifeNeighbors(
+            heads[0][0], heads[0][1], heads[0][2],
+            heads[1][0], heads[1][1], heads[1][2],
+            heads[2][0], heads[2][1], heads[2][2]);
+        uint64_t fire = applyLifeRule<(1 << 1) | (1 << 2), 0>(counts, 0);
+        uint64_t conductor = word[0] & word[1];
+        uint64_t mask = (w == 0 ? firstMask : ~static_cast<uint64_t>(0))
+                      & (w == wordsPerRow - 1 ? lastMask : ~static_cast<uint64_t>(0));
+    
+        // Plane 0 is set for heads and conductors, plane 1 for tails
+        // and conductors
+        out[w * 2] = word[1] & mask;
+        out[w * 2 + 1] = ((word[0] ^ word[1]) | (conductor & ~fire)) & mask;
+        touched |= (word[0] | word[1]) & mask;
+        if (hashEnabled)
+        {
+            hash ^= hashWordChanges(word, out + w * 2, mask, w, y);
+        }
+    
+        for (int r = 0; r < 3; r++)
+        {
+            heads[r][0] = heads[r][1];
+            heads[r][1] = heads[r][2];
+        }
+    }
+    
+    countTouchedRow(y, touched);
+    addChangeHash(hash);
+}
+
+/********************************************************************
+ *  Function:       void computeRows(int first, int last)
+ *  Description:    Calculates the specified rows of the next generation
+ *                  with the kernel of the rule family.
+ *  Parameters:     first   First row to calculate, at least 1
+ *                  last    Row after the last row, at most height - 1
+ *  Preconditions:  none
+ *  Postconditions: Rows first to last - 1 of next buffer are calculated
+ *******************************************************************/
+void StateGrid::computeRows(int first, int last)
+{
+    for (int y = first; y < last; y++)
+    {
+        (this->*computeRow)(y, 0, wordsPerRow);
+    }
+}
+
+/********************************************************************
+ *  Function:       void computeTile(int top, int bottom, int left,
+ *                                   int right)
+ *  Description:    Calculates the words of the specified rectangle
+ *                  with the kernel of the rule family. A tile narrower
+ *                  than a row reads a short run of each row, which the
+ *                  hardware prefetcher does not follow, so the words
+ *                  of the tile a few rows ahead are prefetched.
+ *  Parameters:     top     First row to calculate, at least 1
+ *                  bottom  Row after the last row, at most height - 1
+ *                  left    First column, a multiple of 64
+ *                  right   Column after the last column, a multiple of
+ *                          64 or the width
+ *  Preconditions:  Statistics are disabled unless the tile spans whole
+ *                  rows
+ *  Postconditions: Words of the tile in the next buffer are calculated
+ *******************************************************************/
+void StateGrid::computeTile(int top, int bottom, int left, int right)
+{
+    int first = left >> 6;
+    int last = (right + 63) >> 6;
+    int begin = index(0, std::max(first - 1, 0));
+    int end = index(0, std::min(last + 1, wordsPerRow));
+    bool narrow = first > 0 || last < wordsPerRow;
+    for (int y = top; y < bottom; y++)
+    {
+        // Each row of a narrow tile is too short for the hardware
+        // prefetcher, so the rows ahead are fetched by hand
+        if (narrow && y + PREFETCH_ROWS < height)
+        {
+            const uint64_t *ahead = &current[index(y + PREFETCH_ROWS, 0)];
+            uint64_t *aheadOut = &next[index(y + PREFETCH_ROWS, 0)];
+            for (int i = begin; i < end; i += 8)
+            {
+                __builtin_prefetch(ahead + i);
+                __builtin_prefetch(aheadOut + i, 1);
+            }
+        }
+        (this->*computeRow)(y, first, last);
+    }
+}
+
+/********************************************************************
+ *  Function:       void swapBuffers()
+ *  Description:    Clears the rows that are never evaluated, adds up
+ *                  the row statistics and swaps the buffers.
+ *  Parameters:     none
+ *  Preconditions:  All rows of the next buffer are calculated
+ *  Postconditions: Current buffer contains next generation
+ *******************************************************************/
+void StateGrid::swapBuffers()
+{
+    // Top and bottom rows are never evaluated
+    int rowSize = wordsPerRow * planes;
+    std::fill(next.begin(), next.begin() + rowSize, 0);
+    std::fill(next.end() - rowSize, next.end(), 0);
+    
+    if (statsEnabled)
+    {
+        sumRowStats();
+    }
+    finishChangeHash();
+    current.swap(next);
+}
+
+/********************************************************************
+ *  Function:       uint64_t getHash()
+ *  Description:    Calculates the Zobrist hash of the interior from the
+ *                  state of each cell not in state 0.
+ *  Parameters:     none
+ *  Preconditions:  none
+ *  Postconditions: Returns the hash, 0 if every cell is in state 0
+ *******************************************************************/
+uint64_t StateGrid::getHash() const
+{
+    uint64_t hash = 0;
+    for (int y = 1; y < height - 1; y++)
+    {
+        for (int w = 0; w < wordsPerRow; w++)
+        {
+            const uint64_t *word = &current[index(y, w)];
+            uint64_t bits = getOccupied(word);
+            bits &= w == 0 ? firstMask : ~static_cast<uint64_t>(0);
+            bits &= w == wordsPerRow - 1 ? lastMask : ~static_cast<uint64_t>(0);
+            while (bits)
+            {
+                int bit = __builtin_ctzll(bits);
+                hash ^= getStateKey(w * 64 + bit, y, getWordState(word, bit));
+                bits &= bits - 1;
+            }
+        }
+    }
+    return hash;
+}
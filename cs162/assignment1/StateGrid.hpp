@@ -0,0 +1,205 @@
+/*************************************************************************
+ * Author:          David Rigert
+ * Date Created:    10/17/2026
+ * Last Modified:   10/17/2026
+ * Assignment:      Assignment 1
+ * Filename:        StateGrid.hpp
+ *
+ * Description:     Grid backend for rules with more than two states,
+ *                  such as Generations rules and Wireworld. Like
+ *                  PackedGrid it keeps 64 cells per word, but each word
+ *                  of a row is split into 2 or 4 bit planes, one per
+ *                  binary digit of the state, so the next generation of
+ *                  64 cells is still calculated at once with bitwise
+ *                  logic. Each rule family has its own kernel.
+ ************************************************************************/
+#ifndef STATEGRID_HPP
+#define STATEGRID_HPP
+
+#include <vector>
+#include <stdint.h>
+#include "Grid.hpp"
+
+class StateGrid : public Grid
+{
+public:
+    // Computes the specified words of a row into the next buffer
+    typedef void (StateGrid::*RowFunction)(int, int, int);
+
+    // Counts the statistics of a row into rowStats
+    typedef void (StateGrid::*StatsFunction)(int);
+
+// member variables
+private:
+    std::vector<uint64_t> current;  // planes of current generation
+    std::vector<uint64_t> next;     // planes of next generation
+    int wordsPerRow;                // number of words in each row
+    int planes;                     // bit planes per word, 2 or 4
+    uint64_t firstMask;             // cells allowed in first word of row
+    uint64_t lastMask;              // cells allowed in last word of row
+    RowFunction computeRow;         // row kernel for the rule family
+    StatsFunction countRowStats;    // countRowChanges, or its popcnt copy
+
+// member functions
+private:
+    /********************************************************************
+     *  Function:       int index(int y, int w)
+     *  Description:    Gets the position of plane 0 of a word. The
+     *                  planes of a word are stored together, so a
+     *                  kernel reads one cache line for all of them.
+     *  Parameters:     y   Row of the word
+     *                  w   Word of the row
+     *  Preconditions:  none
+     *  Postconditions: Returns the index of the word in a buffer
+     *******************************************************************/
+    int index(int y, int w) const
+    {
+        return (y * wordsPerRow + w) * planes;
+    }
+
+    /********************************************************************
+     *  Function:       uint64_t getOccupied(const uint64_t *word)
+     *  Description:    Gets the cells of a word in any state but 0.
+     *  Parameters:     word    Plane 0 of the word
+     *  Preconditions:  none
+     *  Postconditions: Returns bit x set if cell x is not dead
+     *******************************************************************/
+    uint64_t getOccupied(const uint64_t *word) const
+    {
+        uint64_t any = word[0] | word[1];
+        if (planes == 4)
+        {
+            any |= word[2] | word[3];
+        }
+        return any;
+    }
+
+    // Gets the state of a cell from the planes of its word.
+    int getWordState(const uint64_t *, int) const;
+
+    // Gets the Zobrist key of a cell in the specified state.
+    static uint64_t getStateKey(int, int, int);
+
+    // Calculates the specified words of a row of a Generations or
+    // Life-like rule.
+    template <int PLANES>
+    void computeGenerationsRow(int, int, int);
+
+    // Calculates the specified words of a row of Wireworld.
+    void computeWireworldRow(int, int, int);
+
+    // Counts the births, deaths and extent of a word into a RowStats.
+    void countWordStats(RowStats &, uint64_t, uint64_t, int) const;
+
+    // Counts the births, deaths and extent of a row into rowStats.
+    void countRowChanges(int);
+
+    // Counts the changes of a row with the popcnt instruction.
+    void countPopcountChanges(int);
+
+    // Counts the cells not in state 0 a word at a time.
+    long long countPopulation() const;
+
+    // Counts the cells not in state 0 with the popcnt instruction.
+    long long countPopcountPopulation() const;
+
+    // Fills the statistics of a row if it had occupied cells.
+    void countTouchedRow(int, uint64_t);
+
+    // Gets the XOR of the keys of the cells of a word whose state changed.
+    uint64_t hashWordChanges(const uint64_t *, const uint64_t *, uint64_t,
+                             int, int) const;
+
+public:
+    // Instantiates a grid of the specified size with all cells dead.
+    StateGrid(int, int);
+
+    /********************************************************************
+     *  Function:       int getPlaneCount()
+     *  Description:    Gets the number of bit planes of each word.
+     *  Parameters:     none
+     *  Preconditions:  none
+     *  Postconditions: Returns 2 for up to 4 states, otherwise 4
+     *******************************************************************/
+    int getPlaneCount() const
+    {
+        return planes;
+    }
+
+    /********************************************************************
+     *  Function:       bool getCell(int x, int y)
+     *  Description:    Gets whether the specified cell is in any state
+     *                  but 0, so dying and conducting cells are shown.
+     *  Parameters:     x   X coordinate of cell
+     *                  y   Y coordinate of cell
+     *  Preconditions:  x,y is on the grid
+     *  Postconditions: Returns true if the cell is not dead
+     *******************************************************************/
+    bool getCell(int x, int y) const
+    {
+        return (getOccupied(&current[index(y, x >> 6)]) >> (x & 63)) & 1;
+    }
+
+    /********************************************************************
+     *  Function:       void setCell(int x, int y, bool alive)
+     *  Description:    Sets the specified cell to state 1 or 0.
+     *  Parameters:     x       X coordinate of cell
+     *                  y       Y coordinate of cell
+     *                  alive   Whether the cell is alive
+     *  Preconditions:  x,y is on the grid
+     *  Postconditions: Cell at x,y is in state 1 if alive, else 0
+     *******************************************************************/
+    void setCell(int x, int y, bool alive)
+    {
+        setState(x, y, alive ? 1 : 0);
+    }
+
+    // Gets the state of the specified cell.
+    int getState(int, int) const;
+
+    // Sets the state of the specified cell.
+    void setState(int, int, int);
+
+    // Kills every cell in both buffers.
+    void clear();
+
+    // Counts the cells not in state 0 a word at a time.
+    long long getPopulation() const;
+
+    // Finds the smallest rectangle holding all cells not in state 0.
+    bool getBounds(int &, int &, int &, int &) const;
+
+    // Fills the outermost ring from the interior for wrapping boundaries.
+    void exchangeHalo();
+
+    // Sets the rule, its plane count and its row kernel.
+    void setRule(const Rule &);
+
+    // Calculates rows first to last - 1 of the next generation.
+    void computeRows(int, int);
+
+    /********************************************************************
+     *  Function:       int getTileAlignment()
+     *  Description:    Tiles of a Simulation span whole rows, which
+     *                  the plane kernels stream faster than columns of
+     *                  words. computeTile still accepts columns at
+     *                  multiples of 64.
+     *  Parameters:     none
+     *  Preconditions:  none
+     *  Postconditions: Returns 0
+     *******************************************************************/
+    int getTileAlignment() const
+    {
+        return 0;
+    }
+
+    // Calculates the words of a rectangle of the next generation.
+    void computeTile(int, int, int, int);
+
+    // Makes the next buffer the current generation.
+    void swapBuffers();
+
+    // Gets the XOR of the keys of the states of the cells.
+    uint64_t getHash() const;
+};
+#endif // end of define STATEGRID_HPP
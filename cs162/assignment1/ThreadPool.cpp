@@ -0,0 +1,230 @@
+/*************************************************************************
+ * Author:          David Rigert
+ * Date Created:    10/17/2026
+ * Last Modified:   10/17/2026
+ * Assignment:      Assignment 1
+ * Filename:        ThreadPool.cpp
+ *
+ * Description:     Implementation of the ThreadPool class.
+ ************************************************************************/
+#include <stdexcept>
+#include "ThreadPool.hpp"
+
+/********************************************************************
+ *  Function:       ThreadPool(int threadCount)
+ *  Description:    Starts threadCount - 1 worker threads. The thread
+ *                  that calls run is the remaining thread.
+ *  Parameters:     threadCount     Total number of threads, at least 1
+ *******************************************************************/
+ThreadPool::ThreadPool(int threadCount)
+{
+    if (threadCount < 1)
+    {
+        throw std::invalid_argument("ERROR: Thread count must be at least 1.");
+    }
+    
+    task = NULL;
+    round = 0;
+    pending = 0;
+    stopping = false;
+    std::vector<TaskRange>(threadCount).swap(ranges);
+    steals = 0;
+    
+    for (int i = 1; i < threadCount; i++)
+    {
+        workers.push_back(std::thread(&ThreadPool::workerLoop, this, i));
+    }
+}
+
+/********************************************************************
+ *  Function:       ~ThreadPool()
+ *  Description:    Tells the workers to exit and waits for them.
+ *******************************************************************/
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    startCond.notify_all();
+    
+    for (unsigned i = 0; i < workers.size(); i++)
+    {
+        workers[i].join();
+    }
+}
+
+/********************************************************************
+ *  Function:       void workerLoop(int index)
+ *  Description:    Waits for each new round, runs the task with this
+ *                  worker's index and reports completion.
+ *  Parameters:     index   Task index of this worker
+ *  Preconditions:  none
+ *  Postconditions: Returns when the pool is destroyed
+ *******************************************************************/
+void ThreadPool::workerLoop(int index)
+{
+    unsigned long lastRound = 0;
+    
+    while (true)
+    {
+        const std::function<void(int)> *current;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            while (!stopping && round == lastRound)
+            {
+                startCond.wait(lock);
+            }
+            if (stopping)
+            {
+                return;
+            }
+            lastRound = round;
+            current = task;
+        }
+        
+        (*current)(index);
+        
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            pending--;
+            if (pending == 0)
+            {
+                doneCond.notify_one();
+            }
+        }
+    }
+}
+
+/********************************************************************
+ *  Function:       void run(const std::function<void(int)> &work)
+ *  Description:    Runs work(0) on the calling thread and work(i) on
+ *                  worker i, then waits until every call has returned.
+ *  Parameters:     work    Task to run with each thread index
+ *  Preconditions:  work does not throw
+ *  Postconditions: work has finished for every index
+ *******************************************************************/
+void ThreadPool::run(const std::function<void(int)> &work)
+{
+    if (!workers.empty())
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        task = &work;
+        pending = workers.size();
+        round++;
+    }
+    startCond.notify_all();
+    
+    work(0);
+    
+    // Barrier: wait for the workers to finish their indices
+    std::unique_lock<std::mutex> lock(mutex);
+    while (pending > 0)
+    {
+        doneCond.wait(lock);
+    }
+}
+
+/********************************************************************
+ *  Function:       int takeFirst(TaskRange &range)
+ *  Description:    Takes the first task of a range. Both ends are in
+ *                  one word, so a compare-and-swap moves the first end
+ *                  without a lock and never passes a thief at the
+ *                  other end.
+ *  Parameters:     range   Range to take from
+ *  Preconditions:  none
+ *  Postconditions: Returns the task, or -1 if the range is empty
+ *******************************************************************/
+int ThreadPool::takeFirst(TaskRange &range)
+{
+    uint64_t tasks = range.tasks.load();
+    for (;;)
+    {
+        uint32_t first = static_cast<uint32_t>(tasks);
+        uint32_t end = static_cast<uint32_t>(tasks >> 32);
+        if (first >= end)
+        {
+            return -1;
+        }
+        uint64_t rest = (static_cast<uint64_t>(end) << 32) | (first + 1);
+        if (range.tasks.compare_exchange_weak(tasks, rest))
+        {
+            return first;
+        }
+    }
+}
+
+/********************************************************************
+ *  Function:       int takeLast(TaskRange &range)
+ *  Description:    Takes the last task of a range, furthest from the
+ *                  tasks its owner is working on.
+ *  Parameters:     range   Range to take from
+ *  Preconditions:  none
+ *  Postconditions: Returns the task, or -1 if the range is empty
+ *******************************************************************/
+int ThreadPool::takeLast(TaskRange &range)
+{
+    uint64_t tasks = range.tasks.load();
+    for (;;)
+    {
+        uint32_t first = static_cast<uint32_t>(tasks);
+        uint32_t end = static_cast<uint32_t>(tasks >> 32);
+        if (first >= end)
+        {
+            return -1;
+        }
+        uint64_t rest = (static_cast<uint64_t>(end - 1) << 32) | first;
+        if (range.tasks.compare_exchange_weak(tasks, rest))
+        {
+            return end - 1;
+        }
+    }
+}
+
+/********************************************************************
+ *  Function:       void runStealing(int count,
+ *                                   const std::function<void(int)> &work)
+ *  Description:    Runs work(i) for every task i from 0 to count - 1.
+ *                  Each thread starts with an equal run of neighboring
+ *                  tasks and takes them from the front. A thread that
+ *                  finishes its run steals from the back of the runs
+ *                  of the other threads, so a thread with cheap tasks
+ *                  takes over part of the work of a thread with costly
+ *                  ones.
+ *  Parameters:     count   Number of tasks
+ *                  work    Task to run with each task index
+ *  Preconditions:  work does not throw
+ *  Postconditions: work has finished for every task exactly once
+ *******************************************************************/
+void ThreadPool::runStealing(int count, const std::function<void(int)> &work)
+{
+    int threads = getThreadCount();
+    for (int t = 0; t < threads; t++)
+    {
+        uint64_t first = static_cast<uint64_t>(count) * t / threads;
+        uint64_t end = static_cast<uint64_t>(count) * (t + 1) / threads;
+        ranges[t].tasks = (end << 32) | first;
+    }
+    steals = 0;
+    
+    std::vector<TaskRange> &queues = ranges;
+    std::atomic<int> &stolen = steals;
+    run([&queues, &stolen, &work, threads](int index)
+    {
+        for (int i = takeFirst(queues[index]); i >= 0; i = takeFirst(queues[index]))
+        {
+            work(i);
+        }
+    
+        // Steal from the other threads, nearest first
+        for (int k = 1; k < threads; k++)
+        {
+            TaskRange &victim = queues[(index + k) % threads];
+            for (int i = takeLast(victim); i >= 0; i = takeLast(victim))
+            {
+                stolen++;
+                work(i);
+            }
+        }
+    });
+}
@@ -0,0 +1,103 @@
+/*************************************************************************
+ * Author:          David Rigert
+ * Date Created:    10/17/2026
+ * Last Modified:   10/17/2026
+ * Assignment:      Assignment 1
+ * Filename:        ThreadPool.hpp
+ *
+ * Description:     A fixed set of worker threads that run one task index
+ *                  each per call to run. The calling thread runs index 0
+ *                  and waits at a single barrier until all indices finish.
+ *                  runStealing instead spreads any number of tasks over
+ *                  the threads, and a thread that runs out of tasks
+ *                  steals from the others.
+ ************************************************************************/
+#ifndef THREADPOOL_HPP
+#define THREADPOOL_HPP
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <stdint.h>
+
+class ThreadPool
+{
+    // Tasks left to one thread by runStealing, padded to a cache line so
+    // that threads taking tasks do not slow each other down
+    struct TaskRange
+    {
+        std::atomic<uint64_t> tasks;    // first task in the low 32 bits,
+                                        // end in the high 32 bits
+        char padding[64 - sizeof(std::atomic<uint64_t>)];
+    };
+
+// member variables
+private:
+    std::vector<std::thread> workers;       // threads for indices 1 and up
+    std::mutex mutex;                       // guards the members below
+    std::condition_variable startCond;      // signaled when a round starts
+    std::condition_variable doneCond;       // signaled when a round ends
+    const std::function<void(int)> *task;   // task of the current round
+    unsigned long round;                    // number of rounds started
+    int pending;                            // workers still running
+    bool stopping;                          // set when pool is destroyed
+    std::vector<TaskRange> ranges;          // tasks of each thread
+    std::atomic<int> steals;                // tasks stolen by runStealing
+
+// member functions
+private:
+    // ThreadPool owns its threads, so copying is not allowed
+    ThreadPool(const ThreadPool &);
+    ThreadPool &operator=(const ThreadPool &);
+
+    // Runs task index of each round until the pool is destroyed.
+    void workerLoop(int);
+
+    // Takes the first task of a range, as the thread that owns it.
+    static int takeFirst(TaskRange &);
+
+    // Takes the last task of a range, as a thread stealing it.
+    static int takeLast(TaskRange &);
+
+public:
+    // Starts the specified total number of threads, including the caller.
+    explicit ThreadPool(int);
+
+    // Stops and joins all worker threads.
+    ~ThreadPool();
+
+    /********************************************************************
+     *  Function:       int getThreadCount()
+     *  Description:    Gets the number of threads including the caller.
+     *  Parameters:     none
+     *  Preconditions:  none
+     *  Postconditions: Returns the number of task indices per round
+     *******************************************************************/
+    int getThreadCount() const
+    {
+        return workers.size() + 1;
+    }
+
+    // Runs task(i) for every thread index i and waits for all to finish.
+    void run(const std::function<void(int)> &);
+
+    // Runs task(i) for tasks 0 to count - 1, stealing when out of tasks.
+    void runStealing(int, const std::function<void(int)> &);
+
+    /********************************************************************
+     *  Function:       int getStealCount()
+     *  Description:    Gets the number of tasks that the last call to
+     *                  runStealing ran on another thread than planned.
+     *  Parameters:     none
+     *  Preconditions:  none
+     *  Postconditions: Returns 0 if the threads were evenly loaded
+     *******************************************************************/
+    int getStealCount() const
+    {
+        return steals;
+    }
+};
+#endif // end of define THREADPOOL_HPP
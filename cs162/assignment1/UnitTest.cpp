@@ -0,0 +1,2274 @@
+/*************************************************************************
+ * Author:          David Rigert
+ * Date Created:    10/17/2026
+ * Last Modified:   10/17/2026
+ * Assignment:      Assignment 1
+ * Filename:        UnitTest.cpp
+ *
+ * Description:     Implementation for UnitTest class.
+ ************************************************************************/
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+#include <algorithm>
+#include <sstream>
+#include <chrono>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include "UnitTest.hpp"
+#include "VectorGrid.hpp"
+#include "PackedGrid.hpp"
+#include "ByteGrid.hpp"
+#include "InfiniteGrid.hpp"
+#include "StateGrid.hpp"
+#include "Simulation.hpp"
+#include "HashLife.hpp"
+#include "Pattern.hpp"
+#include "Rule.hpp"
+#include "PatternReader.hpp"
+#include "Renderer.hpp"
+#include "SoupSearch.hpp"
+#include "ThreadPool.hpp"
+
+// grid sizes that exercise partial words and partial SIMD registers
+static const int SIZES[][2] = { {3, 3}, {17, 9}, {34, 40}, {64, 64},
+                                {65, 33}, {100, 70}, {130, 129} };
+static const int SIZE_COUNT = sizeof(SIZES) / sizeof(SIZES[0]);
+static const int GENERATIONS = 60;
+
+// rules with specialized kernels, then rules that use the generic ones
+static const char *RULES[] = { "B3/S23", "B36/S23", "B3678/S34678",
+                               "B2/S", "B36/S125", "B1357/S1357", "B0/S8" };
+static const int RULE_COUNT = sizeof(RULES) / sizeof(RULES[0]);
+
+// calculates the next generation of the interior of a grid with wrapped
+// coordinates instead of a halo, as an independent check of exchangeHalo
+static std::vector<bool> wrapStep(const std::vector<bool> &cells, int w, int h,
+                                  Grid::Boundary mode)
+{
+    std::vector<bool> next(cells.size());
+    for (int y = 0; y < h; y++)
+    {
+        for (int x = 0; x < w; x++)
+        {
+            int count = 0;
+            for (int dy = -1; dy <= 1; dy++)
+            {
+                for (int dx = -1; dx <= 1; dx++)
+                {
+                    if (dx == 0 && dy == 0)
+                    {
+                        continue;
+                    }
+                    int nx = x + dx;
+                    int ny = y + dy;
+                    if (ny < 0 || ny >= h)
+                    {
+                        ny = (ny + h) % h;
+                        if (mode == Grid::KLEIN_BOTTLE)
+                        {
+                            nx = w - 1 - nx;
+                        }
+                    }
+                    nx = (nx + w) % w;
+                    count += cells[ny * w + nx];
+                }
+            }
+            next[y * w + x] = count == 3 || (count == 2 && cells[y * w + x]);
+        }
+    }
+    return next;
+}
+
+// calculates the next generation of a grid under Conway's rule one cell
+// at a time, keeping the outermost ring dead, as an independent check of
+// VectorGrid, which the other backends are compared with
+static std::vector<bool> deadEdgeStep(const std::vector<bool> &cells, int w, int h)
+{
+    std::vector<bool> next(cells.size());
+    for (int y = 1; y < h - 1; y++)
+    {
+        for (int x = 1; x < w - 1; x++)
+        {
+            int count = 0;
+            for (int dy = -1; dy <= 1; dy++)
+            {
+                for (int dx = -1; dx <= 1; dx++)
+                {
+                    if (dx != 0 || dy != 0)
+                    {
+                        count += cells[(y + dy) * w + x + dx];
+                    }
+                }
+            }
+            next[y * w + x] = count == 3 || (count == 2 && cells[y * w + x]);
+        }
+    }
+    return next;
+}
+
+// calculates the next generation of the interior of a multi-state grid
+// one cell at a time, as an independent check of the StateGrid kernels
+static std::vector<int> stateStep(const std::vector<int> &cells, int w, int h,
+                                  const Rule &rule, bool torus)
+{
+    std::vector<int> next(cells.size());
+    int states = rule.getStateCount();
+    for (int y = 0; y < h; y++)
+    {
+        for (int x = 0; x < w; x++)
+        {
+            int count = 0;
+            for (int dy = -1; dy <= 1; dy++)
+            {
+                for (int dx = -1; dx <= 1; dx++)
+                {
+                    int nx = x + dx;
+                    int ny = y + dy;
+                    if (torus)
+                    {
+                        nx = (nx + w) % w;
+                        ny = (ny + h) % h;
+                    }
+                    else if (nx < 0 || nx >= w || ny < 0 || ny >= h)
+                    {
+                        continue;
+                    }
+                    if ((dx != 0 || dy != 0) && cells[ny * w + nx] == 1)
+                    {
+                        count++;
+                    }
+                }
+            }
+    
+            int state = cells[y * w + x];
+            if (rule.getFamily() == Rule::WIREWORLD)
+            {
+                const int wire[] = { 0, 2, 3, (count == 1 || count == 2) ? 1 : 3 };
+                next[y * w + x] = wire[state];
+            }
+            else if (state == 0)
+            {
+                next[y * w + x] = rule.getNextState(false, count) ? 1 : 0;
+            }
+            else if (state == 1 && rule.getNextState(true, count))
+            {
+                next[y * w + x] = 1;
+            }
+            else
+            {
+                next[y * w + x] = (state + 1) % states;
+            }
+        }
+    }
+    return next;
+}
+
+// writes the cells of a grid as RLE, with runs split across lines
+static std::string encodeRle(Grid &grid)
+{
+    std::ostringstream out;
+    out << "x = " << grid.getWidth() << ", y = " << grid.getHeight() << "\n";
+    for (int y = 0; y < grid.getHeight(); y++)
+    {
+        int x = 0;
+        while (x < grid.getWidth())
+        {
+            bool alive = grid.getCell(x, y);
+            int run = 0;
+            while (x < grid.getWidth() && grid.getCell(x, y) == alive)
+            {
+                run++;
+                x++;
+            }
+            out << run << (alive ? 'o' : 'b');
+            if (run % 5 == 0)
+            {
+                out << "\n";
+            }
+        }
+        out << (y + 1 < grid.getHeight() ? '$' : '!');
+    }
+    out << "\n";
+    return out.str();
+}
+
+// writes the cells of a grid in the .cells format
+static std::string encodeCells(Grid &grid)
+{
+    std::string text = "!Name: Random\n!\n";
+    for (int y = 0; y < grid.getHeight(); y++)
+    {
+        for (int x = 0; x < grid.getWidth(); x++)
+        {
+            text += grid.getCell(x, y) ? 'O' : '.';
+        }
+        text += "\r\n";
+    }
+    return text;
+}
+
+// applies the cursor moves and cells of a rendered frame to a screen of
+// rows, as a terminal would; returns the number of cursor moves
+static int applyFrame(const std::string &frame, std::vector<std::string> &screen)
+{
+    int moves = 0;
+    int row = 0;
+    int col = 0;
+    for (size_t i = 0; i < frame.size(); i++)
+    {
+        if (frame[i] == '\033')
+        {
+            size_t end = frame.find_first_of("HJKhl", i);
+            if (frame[end] == 'H')
+            {
+                std::sscanf(frame.c_str() + i + 2, "%d;%d", &row, &col);
+                row--;
+                col--;
+                moves++;
+            }
+            else if (frame[end] == 'J')
+            {
+                screen.assign(screen.size(), std::string(screen[0].size(), '?'));
+            }
+            i = end;
+        }
+        else if (frame[i] == '\n')
+        {
+            row++;
+            col = 0;
+        }
+        else if (row < static_cast<int>(screen.size()))
+        {
+            screen[row][col++] = frame[i];
+        }
+    }
+    return moves;
+}
+
+void UnitTest::fillRandom(Grid &a, Grid &b, unsigned seed)
+{
+    std::srand(seed);
+    for (int y = 0; y < a.getHeight(); y++)
+    {
+        for (int x = 0; x < a.getWidth(); x++)
+        {
+            bool alive = std::rand() % 3 == 0;
+            a.setCell(x, y, alive);
+            b.setCell(x, y, alive);
+        }
+    }
+}
+
+bool UnitTest::sameCells(Grid &a, Grid &b)
+{
+    for (int y = 0; y < a.getHeight(); y++)
+    {
+        for (int x = 0; x < a.getWidth(); x++)
+        {
+            if (a.getCell(x, y) != b.getCell(x, y))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void UnitTest::test_Grid()
+{
+    /**************************************************************************
+     * VectorGrid
+     *************************************************************************/
+    std::cout << "Comparing VectorGrid with a per-cell reference...";
+    for (int i = 0; i < SIZE_COUNT; i++)
+    {
+        int w = SIZES[i][0];
+        int h = SIZES[i][1];
+        VectorGrid actual(w, h);
+        std::vector<bool> expected(w * h);
+        std::srand(i + 1);
+        for (int y = 1; y < h - 1; y++)
+        {
+            for (int x = 1; x < w - 1; x++)
+            {
+                expected[y * w + x] = std::rand() % 3 == 0;
+                actual.setCell(x, y, expected[y * w + x]);
+            }
+        }
+        for (int gen = 0; gen < GENERATIONS; gen++)
+        {
+            expected = deadEdgeStep(expected, w, h);
+            actual.step();
+            for (int y = 0; y < h; y++)
+            {
+                for (int x = 0; x < w; x++)
+                {
+                    assert(actual.getCell(x, y) == expected[y * w + x]);
+                }
+            }
+        }
+    }
+    std::cout << "Passed!" << std::endl;
+    
+    // rows past the width used to be rejected as off the grid
+    std::cout << "Testing grids taller than they are wide...";
+    {
+        VectorGrid tallVector(5, 40);
+        PackedGrid tallPacked(5, 40);
+        for (int y = 34; y <= 36; y++)
+        {
+            tallVector.setCell(2, y, true);
+            tallPacked.setCell(2, y, true);
+        }
+        tallVector.step();
+        tallPacked.step();
+        for (int x = 1; x <= 3; x++)
+        {
+            assert(tallVector.getCell(x, 35));
+            assert(tallPacked.getCell(x, 35));
+        }
+        assert(!tallVector.getCell(2, 34) && !tallVector.getCell(2, 36));
+        assert(sameCells(tallVector, tallPacked));
+    }
+    std::cout << "Passed!" << std::endl;
+    
+    /**************************************************************************
+     * PackedGrid
+     *************************************************************************/
+    std::cout << "Comparing PackedGrid with VectorGrid...";
+    for (int i = 0; i < SIZE_COUNT; i++)
+    {
+        VectorGrid expected(SIZES[i][0], SIZES[i][1]);
+        PackedGrid actual(SIZES[i][0], SIZES[i][1]);
+        fillRandom(expected, actual, i + 1);
+        for (int gen = 0; gen < GENERATIONS; gen++)
+        {
+            expected.step();
+            actual.step();
+            assert(sameCells(expected, actual));
+        }
+    }
+    std::cout << "Passed!" << std::endl;
+    
+    /**************************************************************************
+     * PackedGrid in sparse mode
+     *************************************************************************/
+    std::cout << "Comparing sparse PackedGrid with VectorGrid...";
+    for (int i = 0; i < SIZE_COUNT; i++)
+    {
+        VectorGrid expected(SIZES[i][0], SIZES[i][1]);
+        PackedGrid actual(SIZES[i][0], SIZES[i][1]);
+        fillRandom(expected, actual, i + 1);
+        actual.setSparse(true);
+        for (int gen = 0; gen < GENERATIONS; gen++)
+        {
+            // edits between generations must wake up their tiles
+            if (gen % 20 == 10)
+            {
+                int x = gen % expected.getWidth();
+                int y = (gen * 7) % expected.getHeight();
+                expected.setCell(x, y, !expected.getCell(x, y));
+                actual.setCell(x, y, !actual.getCell(x, y));
+            }
+            expected.step();
+            actual.step();
+            assert(sameCells(expected, actual));
+        }
+    }
+    std::cout << "Passed!" << std::endl;
+    
+    std::cout << "Testing active tile count of a still life...";
+    PackedGrid still(256, 256);
+    still.setSparse(true);
+    assert(still.getTileCount() == 4 * 16);
+    // every tile is evaluated once after enabling sparse mode
+    still.step();
+    assert(still.getActiveTileCount() == 4 * 16);
+    still.setCell(100, 100, true);
+    still.setCell(101, 100, true);
+    still.setCell(100, 101, true);
+    still.setCell(101, 101, true);
+    still.step();
+    // tiles around the edited cells are evaluated and do not change
+    assert(still.getActiveTileCount() == 9);
+    still.step();
+    assert(still.getActiveTileCount() == 0);
+    assert(still.getCell(100, 100) && still.getCell(101, 101));
+    std::cout << "Passed!" << std::endl;
+    
+    /**************************************************************************
+     * InfiniteGrid against a bounded grid and with a moving pattern
+     *************************************************************************/
+    std::cout << "Comparing InfiniteGrid with PackedGrid...";
+    {
+        // cells placed away from the PackedGrid edge never reach it
+        PackedGrid expected(300, 300);
+        InfiniteGrid actual(300, 300);
+        std::srand(3);
+        for (int y = 130; y < 170; y++)
+        {
+            for (int x = 130; x < 170; x++)
+            {
+                bool alive = std::rand() % 2 == 0;
+                expected.setCell(x, y, alive);
+                actual.setCell(x, y, alive);
+            }
+        }
+        for (int gen = 0; gen < GENERATIONS; gen++)
+        {
+            expected.step();
+            actual.step();
+            assert(sameCells(expected, actual));
+        }
+    }
+    std::cout << "Passed!" << std::endl;
+    
+    std::cout << "Testing InfiniteGrid tiles follow a glider...";
+    {
+        InfiniteGrid plane(10, 10);
+        // glider moving up and to the left
+        plane.setCell(0, 0, true);
+        plane.setCell(1, 0, true);
+        plane.setCell(2, 0, true);
+        plane.setCell(0, 1, true);
+        plane.setCell(1, 2, true);
+        for (int gen = 0; gen < 4 * 1000; gen++)
+        {
+            plane.step();
+            // never more than the 4 tiles under the glider and neighbors
+            assert(plane.getTileCount() <= 16);
+        }
+        assert(plane.getCell(-1000, -1000) && plane.getCell(-999, -1000)
+            && plane.getCell(-998, -1000) && plane.getCell(-1000, -999)
+            && plane.getCell(-999, -998));
+    }
+    std::cout << "Passed!" << std::endl;
+    
+    /**************************************************************************
+     * ByteGrid with each kernel supported by this CPU
+     *************************************************************************/
+    for (int k = ByteGrid::KERNEL_SCALAR; k <= ByteGrid::getBestKernel(); k++)
+    {
+        ByteGrid::Kernel kernel = static_cast<ByteGrid::Kernel>(k);
+        std::cout << "Comparing ByteGrid (" << ByteGrid::getKernelName(kernel)
+                  << ") with VectorGrid...";
+        for (int i = 0; i < SIZE_COUNT; i++)
+        {
+            VectorGrid expected(SIZES[i][0], SIZES[i][1]);
+            ByteGrid actual(SIZES[i][0], SIZES[i][1], kernel);
+            assert(actual.getKernel() == kernel);
+            fillRandom(expected, actual, i + 1);
+            for (int gen = 0; gen < GENERATIONS; gen++)
+            {
+                expected.step();
+                actual.step();
+                assert(sameCells(expected, actual));
+            }
+        }
+        std::cout << "Passed!" << std::endl;
+    }
+    
+    /**************************************************************************
+     * Other Life-like rules
+     *************************************************************************/
+    std::cout << "Comparing backends under other rules...";
+    for (int r = 0; r < RULE_COUNT; r++)
+    {
+        Rule rule(RULES[r]);
+        for (int i = 0; i < SIZE_COUNT; i++)
+        {
+            std::vector<Grid *> grids;
+            grids.push_back(new VectorGrid(SIZES[i][0], SIZES[i][1]));
+            grids.push_back(new PackedGrid(SIZES[i][0], SIZES[i][1]));
+            grids.push_back(new PackedGrid(SIZES[i][0], SIZES[i][1]));
+            grids.push_back(new StateGrid(SIZES[i][0], SIZES[i][1]));
+            for (int k = ByteGrid::KERNEL_SCALAR; k <= ByteGrid::getBestKernel(); k++)
+            {
+                grids.push_back(new ByteGrid(SIZES[i][0], SIZES[i][1],
+                                             static_cast<ByteGrid::Kernel>(k)));
+            }
+            for (size_t g = 0; g < grids.size(); g++)
+            {
+                fillRandom(*grids[0], *grids[g], i + r);
+                grids[g]->setRule(rule);
+                assert(grids[g]->getRule() == rule);
+            }
+            grids[2]->setSparse(true);
+            for (int gen = 0; gen < GENERATIONS; gen++)
+            {
+                for (size_t g = 0; g < grids.size(); g++)
+                {
+                    grids[g]->step();
+                }
+                for (size_t g = 1; g < grids.size(); g++)
+                {
+                    assert(sameCells(*grids[0], *grids[g]));
+                }
+            }
+            for (size_t g = 0; g < grids.size(); g++)
+            {
+                delete grids[g];
+            }
+        }
+    }
+    std::cout << "Passed!" << std::endl;
+    
+    std::cout << "Comparing InfiniteGrid with PackedGrid under HighLife...";
+    {
+        PackedGrid expected(300, 300);
+        InfiniteGrid actual(300, 300);
+        expected.setRule(Rule("B36/S23"));
+        actual.setRule(Rule("B36/S23"));
+        std::srand(5);
+        for (int y = 140; y < 160; y++)
+        {
+            for (int x = 140; x < 160; x++)
+            {
+                bool alive = std::rand() % 2 == 0;
+                expected.setCell(x, y, alive);
+                actual.setCell(x, y, alive);
+            }
+        }
+        for (int gen = 0; gen < GENERATIONS; gen++)
+        {
+            expected.step();
+            actual.step();
+            assert(sameCells(expected, actual));
+        }
+    
+        // B0 would fill the infinite plane
+        bool thrown = false;
+        try
+        {
+            actual.setRule(Rule("B03/S23"));
+        }
+        catch (std::invalid_argument &)
+        {
+            thrown = true;
+        }
+        assert(thrown);
+        assert(actual.getRule() == Rule("B36/S23"));
+    }
+    std::cout << "Passed!" << std::endl;
+    
+    /**************************************************************************
+     * Wrapping boundaries
+     *************************************************************************/
+    const Grid::Boundary modes[] = { Grid::TORUS, Grid::KLEIN_BOTTLE };
+    const char *modeNames[] = { "torus", "Klein bottle" };
+    for (int m = 0; m < 2; m++)
+    {
+        std::cout << "Comparing " << modeNames[m] << " grids with a reference...";
+        for (int i = 0; i < SIZE_COUNT; i++)
+        {
+            int width = SIZES[i][0];
+            int height = SIZES[i][1];
+            std::vector<Grid *> grids;
+            grids.push_back(new VectorGrid(width, height));
+            grids.push_back(new PackedGrid(width, height));
+            grids.push_back(new PackedGrid(width, height));
+            grids.push_back(new StateGrid(width, height));
+            for (int k = ByteGrid::KERNEL_SCALAR; k <= ByteGrid::getBestKernel(); k++)
+            {
+                grids.push_back(new ByteGrid(width, height,
+                                             static_cast<ByteGrid::Kernel>(k)));
+            }
+            for (size_t g = 1; g < grids.size(); g++)
+            {
+                fillRandom(*grids[0], *grids[g], i + 1);
+                grids[g]->setBoundary(modes[m]);
+            }
+            grids[0]->setBoundary(modes[m]);
+            grids[2]->setSparse(true);
+    
+            // the reference only holds the interior
+            int w = width - 2;
+            int h = height - 2;
+            std::vector<bool> expected(w * h);
+            for (int y = 0; y < h; y++)
+            {
+                for (int x = 0; x < w; x++)
+                {
+                    expected[y * w + x] = grids[0]->getCell(x + 1, y + 1);
+                }
+            }
+            for (int gen = 0; gen < GENERATIONS; gen++)
+            {
+                expected = wrapStep(expected, w, h, modes[m]);
+                for (size_t g = 0; g < grids.size(); g++)
+                {
+                    grids[g]->step();
+                    for (int y = 0; y < h; y++)
+                    {
+                        for (int x = 0; x < w; x++)
+                        {
+                            assert(grids[g]->getCell(x + 1, y + 1) == expected[y * w + x]);
+                        }
+                    }
+                }
+            }
+            for (size_t g = 0; g < grids.size(); g++)
+            {
+                delete grids[g];
+            }
+        }
+        std::cout << "Passed!" << std::endl;
+    }
+    
+    std::cout << "Testing a glider returns to its start on a torus...";
+    {
+        // an 8x8 interior takes a glider 4 * 8 generations to cross
+        PackedGrid torus(10, 10);
+        torus.setBoundary(Grid::TORUS);
+        torus.setSparse(true);
+        torus.setCell(2, 1, true);
+        torus.setCell(3, 2, true);
+        torus.setCell(1, 3, true);
+        torus.setCell(2, 3, true);
+        torus.setCell(3, 3, true);
+        PackedGrid start(10, 10);
+        for (int y = 0; y < 10; y++)
+        {
+            for (int x = 0; x < 10; x++)
+            {
+                start.setCell(x, y, torus.getCell(x, y));
+            }
+        }
+        for (int gen = 0; gen < 4 * 8; gen++)
+        {
+            torus.step();
+        }
+        assert(sameCells(start, torus));
+    
+        // returning to a dead edge clears the halo
+        torus.setBoundary(Grid::DEAD_EDGE);
+        for (int x = 0; x < 10; x++)
+        {
+            assert(!torus.getCell(x, 0) && !torus.getCell(x, 9));
+        }
+    }
+    std::cout << "Passed!" << std::endl;
+    
+    std::cout << "Testing InfiniteGrid rejects wrapping boundaries...";
+    {
+        InfiniteGrid plane(10, 10);
+        bool thrown = false;
+        try
+        {
+            plane.setBoundary(Grid::TORUS);
+        }
+        catch (std::invalid_argument &)
+        {
+            thrown = true;
+        }
+        assert(thrown);
+        assert(plane.getBoundary() == Grid::DEAD_EDGE);
+    }
+    std::cout << "Passed!" << std::endl;
+    
+    /**************************************************************************
+     * StateGrid under rules with more than two states
+     *************************************************************************/
+    std::cout << "Comparing multi-state rules with a reference...";
+    const char *stateRules[] = { "B2/S/C3", "B2/S345/C4", "B3/S23/C8",
+                                 "B2/S/C16", "Wireworld" };
+    for (int r = 0; r < 5; r++)
+    {
+        Rule rule(stateRules[r]);
+        for (int i = 0; i < SIZE_COUNT; i++)
+        {
+            int w = SIZES[i][0] - 2;
+            int h = SIZES[i][1] - 2;
+            bool torus = (i + r) % 2 == 1;
+            StateGrid grid(w + 2, h + 2);
+            grid.setRule(rule);
+            grid.setHashEnabled(true);
+            assert(grid.getPlaneCount() == (rule.getStateCount() > 4 ? 4 : 2));
+            if (torus)
+            {
+                grid.setBoundary(Grid::TORUS);
+            }
+    
+            // the reference only holds the interior
+            std::vector<int> expected(w * h);
+            std::srand(i + r);
+            for (int j = 0; j < w * h; j++)
+            {
+                expected[j] = std::rand() % 2 ? 0 : std::rand() % rule.getStateCount();
+                grid.setState(j % w + 1, j / w + 1, expected[j]);
+            }
+            for (int gen = 0; gen < GENERATIONS; gen++)
+            {
+                uint64_t hash = grid.getHash();
+                expected = stateStep(expected, w, h, rule, torus);
+                if ((i + r) % 3 == 0)
+                {
+                    // tiles one word wide split the rows
+                    grid.exchangeHalo();
+                    for (int top = 1; top < h + 1; top += 5)
+                    {
+                        for (int left = 0; left < w + 2; left += 64)
+                        {
+                            grid.computeTile(top, std::min(h + 1, top + 5),
+                                             left, std::min(w + 2, left + 64));
+                        }
+                    }
+                    grid.swapBuffers();
+                }
+                else
+                {
+                    grid.step();
+                }
+                assert((hash ^ grid.getChangeHash()) == grid.getHash());
+                for (int j = 0; j < w * h; j++)
+                {
+                    assert(grid.getState(j % w + 1, j / w + 1) == expected[j]);
+                }
+            }
+        }
+    }
+    std::cout << "Passed!" << std::endl;
+    
+    std::cout << "Testing StateGrid keeps states across rule changes...";
+    {
+        StateGrid grid(70, 5);
+        grid.setRule(Rule("B2/S/C8"));
+        for (int x = 1; x < 69; x++)
+        {
+            grid.setState(x, 2, x % 8);
+        }
+        // 4 planes to 2 planes kills the states the new rule lacks
+        grid.setRule(Rule("B2/S/C3"));
+        assert(grid.getPlaneCount() == 2);
+        for (int x = 1; x < 69; x++)
+        {
+            assert(grid.getState(x, 2) == (x % 8 < 3 ? x % 8 : 0));
+        }
+        grid.setRule(Rule("B2/S/C16"));
+        assert(grid.getPlaneCount() == 4);
+        assert(grid.getState(9, 2) == 1 && grid.getState(10, 2) == 2);
+        assert(grid.getPopulation() == 2 * 9);
+        bool thrown = false;
+        try
+        {
+            grid.setState(1, 1, 16);
+        }
+        catch (std::invalid_argument &)
+        {
+            thrown = true;
+        }
+        assert(thrown);
+    }
+    std::cout << "Passed!" << std::endl;
+    
+    /**************************************************************************
+     * getPopulation and getBounds
+     *************************************************************************/
+    std::cout << "Comparing population and bounds of each backend...";
+    for (int i = 0; i < SIZE_COUNT; i++)
+    {
+        int w = SIZES[i][0];
+        int h = SIZES[i][1];
+        VectorGrid expected(w, h);
+        PackedGrid packed(w, h);
+        ByteGrid bytes(w, h);
+        InfiniteGrid plane(w, h);
+        fillRandom(expected, packed, i + 1);
+        fillRandom(bytes, bytes, i + 1);
+        // the torus leaves live halo cells in the ring, which do not count
+        expected.setBoundary(Grid::TORUS);
+        packed.setBoundary(Grid::TORUS);
+        bytes.setBoundary(Grid::TORUS);
+        for (int gen = 0; gen < 5; gen++)
+        {
+            expected.step();
+            packed.step();
+            bytes.step();
+        }
+    
+        // count the interior by hand and copy it onto the plane off center
+        long long count = 0;
+        int left = w, top = h, right = -1, bottom = -1;
+        for (int y = 1; y < h - 1; y++)
+        {
+            for (int x = 1; x < w - 1; x++)
+            {
+                if (expected.getCell(x, y))
+                {
+                    count++;
+                    left = std::min(left, x);
+                    right = std::max(right, x);
+                    top = std::min(top, y);
+                    bottom = std::max(bottom, y);
+                    plane.setCell(x - 100, y - 70, true);
+                }
+            }
+        }
+    
+        Grid *grids[] = { &expected, &packed, &bytes };
+        for (int g = 0; g < 3; g++)
+        {
+            int l = 0, t = 0, r = 0, b = 0;
+            assert(grids[g]->getPopulation() == count);
+            assert(grids[g]->getBounds(l, t, r, b) == (count > 0));
+            assert(count == 0 || (l == left && t == top && r == right && b == bottom));
+        }
+        int l = 0, t = 0, r = 0, b = 0;
+        assert(plane.getPopulation() == count);
+        assert(plane.getBounds(l, t, r, b) == (count > 0));
+        assert(count == 0 || (l == left - 100 && t == top - 70
+                              && r == right - 100 && b == bottom - 70));
+    }
+    std::cout << "Passed!" << std::endl;
+    
+    std::cout << "Comparing row bits of each backend...";
+    for (int i = 0; i < SIZE_COUNT; i++)
+    {
+        int w = SIZES[i][0];
+        int h = SIZES[i][1];
+        VectorGrid expected(w, h);
+        PackedGrid packed(w, h);
+        fillRandom(expected, packed, i + 1);
+        std::vector<uint64_t> want((w + 63) / 64);
+        std::vector<uint64_t> got((w + 63) / 64);
+        const int starts[] = { 0, 1, 64 };
+        for (int s = 0; s < 3 && starts[s] < w; s++)
+        {
+            int x = starts[s];
+            int count = w - x;
+            for (int y = 0; y < h; y++)
+            {
+                expected.getRowBits(x, y, count, &want[0]);
+                packed.getRowBits(x, y, count, &got[0]);
+                assert(std::equal(want.begin(), want.begin() + (count + 63) / 64,
+                                  got.begin()));
+            }
+    
+            // setting a row leaves the cells before and after it alone
+            for (int y = 0; y < h; y++)
+            {
+                for (unsigned j = 0; j < want.size(); j++)
+                {
+                    want[j] = (static_cast<uint64_t>(std::rand()) << 32) ^ std::rand();
+                }
+                expected.setRowBits(x, y, count - 1, &want[0]);
+                packed.setRowBits(x, y, count - 1, &want[0]);
+            }
+            assert(sameCells(expected, packed));
+        }
+    }
+    std::cout << "Passed!" << std::endl;
+}
+
+void UnitTest::test_Simulation()
+{
+    /**************************************************************************
+     * setThreadCount function
+     *************************************************************************/
+    std::cout << "Testing setThreadCount...";
+    Simulation small(10, 4, 1);
+    assert(small.getThreadCount() == 1);
+    small.setThreadCount(3);
+    assert(small.getThreadCount() == 3);
+    // no more threads than rows
+    small.setThreadCount(50);
+    assert(small.getThreadCount() == 4);
+    small.setThreadCount(1);
+    assert(small.getThreadCount() == 1);
+    std::cout << "Passed!" << std::endl;
+    
+    /**************************************************************************
+     * setSparse function
+     *************************************************************************/
+    std::cout << "Testing setSparse...";
+    bool thrown = false;
+    try
+    {
+        small.setSparse(true);
+    }
+    catch (std::invalid_argument &)
+    {
+        thrown = true;
+    }
+    assert(thrown);
+    assert(small.getActiveTileCount() == -1);
+    Simulation packed(10, 4, 1, Simulation::PACKED_GRID);
+    packed.setSparse(true);
+    packed.advanceGeneration();
+    assert(packed.getActiveTileCount() == 1);
+    Simulation plane(10, 10, 1, Simulation::INFINITE_GRID);
+    plane.setSparse(true);
+    thrown = false;
+    try
+    {
+        plane.setSparse(false);
+    }
+    catch (std::invalid_argument &)
+    {
+        thrown = true;
+    }
+    assert(thrown);
+    // Threads and tiles leave the plane on whole steps
+    plane.setThreadCount(2);
+    plane.setTileSize(4, 4);
+    plane.advanceGeneration();
+    plane.setTileSize(0, 0);
+    plane.advanceGeneration();
+    assert(plane.getGenerationCount() == 2);
+    std::cout << "Passed!" << std::endl;
+    
+    /**************************************************************************
+     * advanceGeneration with multiple threads
+     *************************************************************************/
+    const Simulation::GridType types[] = { Simulation::VECTOR_GRID,
+        Simulation::PACKED_GRID, Simulation::BYTE_GRID, Simulation::INFINITE_GRID,
+        Simulation::STATE_GRID };
+    const int typeCount = sizeof(types) / sizeof(types[0]);
+    std::cout << "Comparing multithreaded and single-threaded runs...";
+    for (int t = 0; t < typeCount; t++)
+    {
+        for (int threads = 2; threads <= 5; threads++)
+        {
+            Simulation single(90, 37, 2, types[t]);
+            Simulation multi(90, 37, 2, types[t]);
+            multi.setThreadCount(threads);
+            fillRandom(*single.grid, *multi.grid, threads);
+            // the bounded grids also exchange the halo before each run
+            if (types[t] != Simulation::INFINITE_GRID && threads % 2 == 1)
+            {
+                Grid::Boundary mode = threads == 3 ? Grid::TORUS : Grid::KLEIN_BOTTLE;
+                single.setBoundary(mode);
+                multi.setBoundary(mode);
+            }
+            if (types[t] == Simulation::PACKED_GRID)
+            {
+                multi.setSparse(true);
+            }
+            for (int gen = 0; gen < GENERATIONS; gen++)
+            {
+                single.advanceGeneration();
+                multi.advanceGeneration();
+                assert(sameCells(*single.grid, *multi.grid));
+            }
+        }
+    }
+    std::cout << "Passed!" << std::endl;
+    
+    /**************************************************************************
+     * Tiles shared out by work stealing
+     *************************************************************************/
+    std::cout << "Testing each stolen task runs once...";
+    {
+        ThreadPool stealing(4);
+        std::vector<int> runs(1000);
+        // the tasks of the first thread are much slower than the others
+        stealing.runStealing(runs.size(), [&runs](int task)
+        {
+            volatile int spin = 0;
+            for (int i = 0; i < (task < 250 ? 20000 : 10); i++)
+            {
+                spin = spin + i;
+            }
+            runs[task]++;
+        });
+        for (unsigned i = 0; i < runs.size(); i++)
+        {
+            assert(runs[i] == 1);
+        }
+        assert(stealing.getStealCount() >= 0 && stealing.getStealCount() < 1000);
+        stealing.runStealing(0, [](int) { assert(false); });
+        assert(stealing.getStealCount() == 0);
+    }
+    std::cout << "Passed!" << std::endl;
+    
+    std::cout << "Comparing tiled runs with single-threaded runs...";
+    const int tileSizes[][2] = { {0, 1}, {1, 1}, {64, 16}, {70, 7}, {200, 100} };
+    for (int t = 0; t < typeCount; t++)
+    {
+        for (int s = 0; s < 5; s++)
+        {
+            Simulation single(150, 37, 2, types[t]);
+            Simulation tiled(150, 37, 2, types[t]);
+            tiled.setThreadCount(s % 2 == 0 ? 3 : 1);
+            tiled.setTileSize(tileSizes[s][0], tileSizes[s][1]);
+            assert(tiled.getTileWidth() == tileSizes[s][0]);
+            assert(tiled.getTileHeight() == tileSizes[s][1]);
+            fillRandom(*single.grid, *tiled.grid, s + 3);
+            if (types[t] != Simulation::INFINITE_GRID && s % 2 == 0)
+            {
+                single.setBoundary(Grid::TORUS);
+                tiled.setBoundary(Grid::TORUS);
+            }
+            if (types[t] == Simulation::PACKED_GRID && s > 1)
+            {
+                tiled.setSparse(true);
+            }
+            for (int gen = 0; gen < GENERATIONS; gen++)
+            {
+                single.advanceGeneration();
+                tiled.advanceGeneration();
+                assert(sameCells(*single.grid, *tiled.grid));
+            }
+        }
+    }
+    thrown = false;
+    try
+    {
+        small.setTileSize(-1, 16);
+    }
+    catch (std::invalid_argument &)
+    {
+        thrown = true;
+    }
+    assert(thrown);
+    
+    // a backend without tile alignment only calculates whole rows
+    VectorGrid rows(100, 10);
+    assert(rows.getTileAlignment() == 0);
+    thrown = false;
+    try
+    {
+        rows.computeTile(1, 9, 0, 64);
+    }
+    catch (std::logic_error &)
+    {
+        thrown = true;
+    }
+    assert(thrown);
+
+    // the dense backends tile whole rows, but still calculate columns
+    ByteGrid whole(100, 10);
+    ByteGrid split(100, 10);
+    assert(split.getTileAlignment() == 0);
+    assert(StateGrid(100, 10).getTileAlignment() == 0);
+    fillRandom(whole, split, 7);
+    whole.step();
+    split.exchangeHalo();
+    for (int left = 0; left < 100; left += 32)
+    {
+        split.computeTile(1, 9, left, std::min(100, left + 32));
+    }
+    split.swapBuffers();
+    assert(sameCells(whole, split));
+    std::cout << "Passed!" << std::endl;
+
+    /**************************************************************************
+     * runDecoupled function
+     *************************************************************************/
+    std::cout << "Comparing decoupled runs with advanceGeneration...";
+    for (int t = 0; t < typeCount; t++)
+    {
+        Simulation stepped(40, 20, 2, types[t]);
+        Simulation decoupled(40, 20, 2, types[t]);
+        decoupled.setThreadCount(2);
+        fillRandom(*stepped.grid, *decoupled.grid, t + 7);
+        for (int gen = 0; gen < GENERATIONS; gen++)
+        {
+            stepped.advanceGeneration();
+        }
+        decoupled.runDecoupled(GENERATIONS, 0, -1);
+        assert(decoupled.generationCount == GENERATIONS);
+        assert(sameCells(*stepped.grid, *decoupled.grid));
+    }
+    thrown = false;
+    try
+    {
+        small.runDecoupled(1, -1, -1);
+    }
+    catch (std::invalid_argument &)
+    {
+        thrown = true;
+    }
+    assert(thrown);
+    std::cout << "Passed!" << std::endl;
+    
+    std::cout << "Testing the target rate of runDecoupled...";
+    {
+        Simulation paced(20, 10, 1);
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        paced.runDecoupled(20, 200, -1);
+        double seconds = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count();
+        // generation 20 cannot start before 19 / 200 seconds
+        assert(seconds >= 0.095);
+        assert(paced.generationCount == 20);
+    }
+    std::cout << "Passed!" << std::endl;
+    
+    /**************************************************************************
+     * Cycle detection
+     *************************************************************************/
+    std::cout << "Comparing incremental and full hashes...";
+    for (int t = 0; t < typeCount; t++)
+    {
+        for (int mode = 0; mode < 3; mode++)
+        {
+            if (types[t] == Simulation::INFINITE_GRID && mode > 0)
+            {
+                continue;
+            }
+            Simulation sim(150, 30, 1, types[t]);
+            Simulation unused(150, 30, 1);
+            fillRandom(*sim.grid, *unused.grid, t * 3 + mode + 1);
+            sim.setBoundary(static_cast<Grid::Boundary>(mode));
+            if (types[t] == Simulation::PACKED_GRID && mode > 0)
+            {
+                sim.setSparse(true);
+            }
+            sim.setThreadCount(mode + 1);
+            if (mode == 2)
+            {
+                // the kernels of different tiles add to one change hash
+                sim.setTileSize(64, 8);
+            }
+            sim.setCycleDetection(8);
+            for (int gen = 0; gen < GENERATIONS * 3; gen++)
+            {
+                sim.advanceGeneration();
+                assert(sim.hash == sim.grid->getHash());
+            }
+        }
+    }
+    std::cout << "Passed!" << std::endl;
+    
+    std::cout << "Testing still lifes and oscillators...";
+    for (int t = 0; t < typeCount; t++)
+    {
+        const char *patterns[] = { "2o$2o!", "3o!", "b3o$3o!", "bo$2bo$3o!" };
+        const int periods[] = { 1, 2, 2, 0 };
+        for (int p = 0; p < 4; p++)
+        {
+            Simulation sim(30, 30, 2, types[t]);
+            std::istringstream in(std::string("x = 4, y = 3\n") + patterns[p] + "\n");
+            PatternReader reader(in);
+            sim.addPattern(reader, 10, 10);
+            sim.setCycleDetection(16);
+            int run = sim.advanceUntilCycle(40);
+            if (periods[p] > 0)
+            {
+                assert(sim.getPeriod() == periods[p]);
+                assert(run == periods[p]);
+            }
+            else
+            {
+                // a glider moves, so its cells never repeat
+                assert(sim.getPeriod() == 0 && run == 40);
+            }
+        }
+    }
+    {
+        // a glider on a torus comes back after crossing the board
+        Simulation sim(8, 8, 1, Simulation::PACKED_GRID);
+        std::istringstream in("x = 3, y = 3\nbo$2bo$3o!\n");
+        PatternReader reader(in);
+        sim.addPattern(reader, 0, 0);
+        sim.setBoundary(Grid::TORUS);
+        sim.setCycleDetection(64);
+        assert(sim.advanceUntilCycle(100) == 32 && sim.getPeriod() == 32);
+    
+        // editing the grid starts a new history
+        std::istringstream more("x = 1, y = 1\no!\n");
+        PatternReader dot(more);
+        sim.addPattern(dot, 4, 4);
+        assert(sim.getPeriod() == 0);
+    
+        // a dead grid is a still life
+        Simulation empty(10, 10, 1, Simulation::BYTE_GRID);
+        empty.setCycleDetection(4);
+        assert(empty.advanceUntilCycle(10) == 1 && empty.getPeriod() == 1);
+    }
+    std::cout << "Passed!" << std::endl;
+    
+    std::cout << "Comparing the history table with a linear search...";
+    for (int size = 1; size <= 40; size += 13)
+    {
+        Simulation sim(10, 10, 1, Simulation::PACKED_GRID);
+        sim.setCycleDetection(size);
+        sim.resetHistory();
+        std::vector<uint64_t> seen(1, sim.hash);   // hashes since the reset
+        std::srand(size);
+        for (int gen = 1; gen < 3000; gen++)
+        {
+            sim.generationCount = gen;
+            if (std::rand() % 500 == 0)
+            {
+                sim.resetHistory();
+                assert(sim.getPeriod() == 0);
+                seen.assign(1, sim.hash);
+                continue;
+            }
+    
+            // a few hashes, half of them selecting the same slot, so
+            // searches and removals probe past other entries
+            sim.hash = static_cast<uint64_t>(std::rand() % 9) << (std::rand() % 2 ? 40 : 0);
+            int expected = 0;
+            for (int p = 1; p <= size && p <= static_cast<int>(seen.size()); p++)
+            {
+                if (seen[seen.size() - p] == sim.hash)
+                {
+                    expected = p;
+                    break;
+                }
+            }
+            sim.recordHash();
+            assert(sim.getPeriod() == expected);
+            seen.push_back(sim.hash);
+        }
+    }
+    std::cout << "Passed!" << std::endl;
+    
+    /**************************************************************************
+     * save and restore functions
+     *************************************************************************/
+    std::cout << "Testing save and restore...";
+    const char CHECKPOINT[] = "test_checkpoint.snap";
+    for (int t = 0; t < typeCount; t++)
+    {
+        for (int compress = 0; compress < 2; compress++)
+        {
+            Simulation sim(70, 40, 1, types[t]);
+            Simulation unused(70, 40, 1);
+            fillRandom(*sim.grid, *unused.grid, t * 2 + compress + 1);
+            if (types[t] != Simulation::INFINITE_GRID)
+            {
+                sim.setBoundary(static_cast<Grid::Boundary>(t % 3));
+            }
+            if (types[t] == Simulation::PACKED_GRID)
+            {
+                sim.setSparse(compress == 1);
+            }
+            sim.setRule(Rule("B36/S23"));
+            for (int gen = 0; gen < GENERATIONS; gen++)
+            {
+                sim.advanceGeneration();
+            }
+            sim.save(CHECKPOINT, compress == 1);
+    
+            // restoring replaces the size and backend of the simulation
+            Simulation copy(10, 10, 0);
+            copy.restore(CHECKPOINT);
+            assert(copy.getGridType() == types[t]);
+            assert(copy.getWidth() == sim.getWidth() && copy.getHeight() == sim.getHeight());
+            assert(copy.getGenerationCount() == sim.getGenerationCount());
+            assert(copy.getRule().getBirth() == sim.getRule().getBirth());
+            assert(copy.grid->getBoundary() == sim.grid->getBoundary());
+            assert(copy.getActiveTileCount() == -1 || copy.getActiveTileCount() == 0);
+            for (int gen = 0; gen <= GENERATIONS; gen++)
+            {
+                int x = 0, y = 0, w = 0, h = 0;
+                int cx = 0, cy = 0, cw = 0, ch = 0;
+                assert(copy.getPopulation() == sim.getPopulation());
+                assert(copy.getBoundingBox(cx, cy, cw, ch) == sim.getBoundingBox(x, y, w, h));
+                assert(cx == x && cy == y && cw == w && ch == h);
+                for (int j = y; j < y + h; j++)
+                {
+                    for (int i = x; i < x + w; i++)
+                    {
+                        assert(copy.getCell(i, j) == sim.getCell(i, j));
+                    }
+                }
+                sim.advanceGeneration();
+                copy.advanceGeneration();
+            }
+        }
+    }
+    
+    // a file that is not a checkpoint leaves the simulation alone
+    {
+        Simulation sim(20, 20, 1, Simulation::PACKED_GRID);
+        sim.setCell(3, 4, true);
+        sim.save(CHECKPOINT);
+        std::ifstream in(CHECKPOINT, std::ios::binary);
+        std::string contents((std::istreambuf_iterator<char>(in)),
+                             std::istreambuf_iterator<char>());
+        in.close();
+        std::ofstream out(CHECKPOINT, std::ios::binary | std::ios::trunc);
+        out.write(contents.data(), contents.size() - 8);
+        out.close();
+    
+        const char *files[] = { CHECKPOINT, "patterns.rle", "no such file" };
+        for (int f = 0; f < 3; f++)
+        {
+            bool thrown = false;
+            try
+            {
+                sim.restore(files[f]);
+            }
+            catch (std::invalid_argument &)
+            {
+                thrown = true;
+            }
+            assert(thrown);
+            assert(sim.getCell(3, 4) && sim.getPopulation() == 1);
+        }
+    }
+    std::remove(CHECKPOINT);
+    std::cout << "Passed!" << std::endl;
+    
+    /**************************************************************************
+     * statistics functions
+     *************************************************************************/
+    std::cout << "Comparing statistics with a full recount...";
+    for (int t = 0; t < typeCount; t++)
+    {
+        for (int variant = 0; variant < 2; variant++)
+        {
+            Simulation sim(70, 40, 1, types[t]);
+            Simulation unused(70, 40, 1);
+            fillRandom(*sim.grid, *unused.grid, t * 2 + variant + 11);
+            if (types[t] != Simulation::INFINITE_GRID)
+            {
+                sim.setBoundary(static_cast<Grid::Boundary>((t + variant) % 3));
+            }
+            if (types[t] == Simulation::PACKED_GRID)
+            {
+                sim.setSparse(variant == 1);
+            }
+            sim.setThreadCount(variant + 1);
+            sim.setStatsHistory(GENERATIONS);
+    
+            // previous cells, kept inside the previous bounding box
+            int px = 0, py = 0, pw = 0, ph = 0;
+            std::vector<bool> previous;
+            for (int gen = 0; gen < GENERATIONS; gen++)
+            {
+                // edits between generations restart the population count
+                if (gen % 20 == 10)
+                {
+                    sim.setCell(gen % 70, (gen * 7) % 40, !sim.getCell(gen % 70, (gen * 7) % 40));
+                }
+                if (!sim.getBoundingBox(px, py, pw, ph))
+                {
+                    pw = ph = 0;
+                }
+                previous.assign(pw * ph, false);
+                for (int j = 0; j < ph; j++)
+                {
+                    for (int i = 0; i < pw; i++)
+                    {
+                        previous[j * pw + i] = sim.getCell(px + i, py + j);
+                    }
+                }
+                sim.advanceGeneration();
+    
+                int x = 0, y = 0, w = 0, h = 0;
+                const Simulation::GenerationStats &stats = sim.getStats(sim.getStatsCount() - 1);
+                assert(sim.getStatsCount() == gen + 1);
+                assert(stats.generation == sim.getGenerationCount());
+                assert(stats.population == sim.getPopulation());
+                assert(sim.getBoundingBox(x, y, w, h) == (stats.width > 0));
+                assert(stats.width == 0 || (stats.x == x && stats.y == y
+                                            && stats.width == w && stats.height == h));
+                assert(stats.stepSeconds >= 0);
+    
+                // every change lies in the union of both boxes
+                int left = std::min(x, px), top = std::min(y, py);
+                int right = std::max(x + w, px + pw), bottom = std::max(y + h, py + ph);
+                long long births = 0, deaths = 0;
+                for (int j = top; j < bottom; j++)
+                {
+                    for (int i = left; i < right; i++)
+                    {
+                        bool before = i >= px && i < px + pw && j >= py && j < py + ph
+                                      && previous[(j - py) * pw + (i - px)];
+                        bool after = sim.getCell(i, j);
+                        births += after && !before;
+                        deaths += before && !after;
+                    }
+                }
+                assert(stats.births == births && stats.deaths == deaths);
+            }
+        }
+    }
+    std::cout << "Passed!" << std::endl;
+    
+    std::cout << "Testing multi-state rules on a Simulation...";
+    {
+        // an electron going around a loop of 14 wire cells
+        std::istringstream in("x = 6, y = 3, rule = WireWorld\nCBA3C$C4.C$6C!\n");
+        PatternReader reader(in);
+        Simulation sim(9, 7, 1, Simulation::STATE_GRID);
+        sim.setThreadCount(2);
+        sim.setCycleDetection(20);
+        sim.addPattern(reader, 2, 2);
+        assert(sim.getRule() == Rule::wireworld());
+        assert(sim.getState(3, 2) == 2 && sim.getState(4, 2) == 1 && sim.getState(5, 2) == 3);
+        assert(sim.getPopulation() == 14);
+        for (int gen = 0; gen < 30 && sim.getPeriod() == 0; gen++)
+        {
+            sim.advanceGeneration();
+        }
+        // the head cuts each corner, so it takes 10 generations
+        assert(sim.getPeriod() == 10);
+        std::vector<int> states;
+        for (int i = 0; i < 9 * 7; i++)
+        {
+            states.push_back(sim.getState(i % 9, i / 9));
+        }
+        for (int gen = 0; gen < 10; gen++)
+        {
+            sim.advanceGeneration();
+        }
+        for (int i = 0; i < 9 * 7; i++)
+        {
+            assert(sim.getState(i % 9, i / 9) == states[i]);
+        }
+        sim.setState(4, 3, 3);
+        assert(sim.getPopulation() == 15 && sim.getPeriod() == 0);
+    
+        // only the state grid has room for more than two states
+        Simulation packed(10, 10, 1, Simulation::PACKED_GRID);
+        bool thrown = false;
+        try
+        {
+            packed.setRule(Rule("B2/S/C3"));
+        }
+        catch (std::invalid_argument &)
+        {
+            thrown = true;
+        }
+        assert(thrown && packed.getRule().isConway());
+        thrown = false;
+        try
+        {
+            packed.setState(1, 1, 2);
+        }
+        catch (std::invalid_argument &)
+        {
+            thrown = true;
+        }
+        assert(thrown);
+    
+        // checkpoints store one bit per cell
+        thrown = false;
+        try
+        {
+            sim.save("test_checkpoint.snap", false);
+        }
+        catch (std::invalid_argument &)
+        {
+            thrown = true;
+        }
+        assert(thrown);
+    }
+    std::cout << "Passed!" << std::endl;
+    
+    std::cout << "Testing statistics history and CSV...";
+    {
+        // a blinker keeps 3 cells and swaps 2 of them every generation
+        Simulation sim(10, 10, 1, Simulation::BYTE_GRID);
+        sim.setCell(4, 5, true);
+        sim.setCell(5, 5, true);
+        sim.setCell(6, 5, true);
+        assert(sim.getStatsCount() == 0);
+        sim.setStatsHistory(3);
+        for (int gen = 0; gen < 5; gen++)
+        {
+            sim.advanceGeneration();
+        }
+    
+        // only the last 3 generations are kept, oldest first
+        assert(sim.getStatsCount() == 3);
+        for (int i = 0; i < 3; i++)
+        {
+            const Simulation::GenerationStats &stats = sim.getStats(i);
+            assert(stats.generation == static_cast<unsigned>(i + 3));
+            assert(stats.population == 3 && stats.births == 2 && stats.deaths == 2);
+            assert(stats.width == (i % 2 == 0 ? 1 : 3));
+        }
+        bool thrown = false;
+        try
+        {
+            sim.getStats(3);
+        }
+        catch (std::invalid_argument &)
+        {
+            thrown = true;
+        }
+        assert(thrown);
+    
+        std::ostringstream out;
+        sim.writeStatsCsv(out);
+        std::istringstream in(out.str());
+        std::string line;
+        std::getline(in, line);
+        assert(line == "generation,population,births,deaths,x,y,width,height,step_seconds");
+        std::getline(in, line);
+        assert(line.compare(0, 16, "3,3,2,2,5,4,1,3,") == 0);
+        int lines = 2;
+        while (std::getline(in, line))
+        {
+            lines++;
+        }
+        assert(lines == 4);
+    
+        // disabling statistics forgets them
+        sim.setStatsHistory(0);
+        sim.advanceGeneration();
+        assert(sim.getStatsCount() == 0);
+    }
+    std::cout << "Passed!" << std::endl;
+    
+    std::cout << "Testing sampled statistics...";
+    for (int t = 0; t < typeCount; t++)
+    {
+        // every third generation matches a run that counts all of them
+        Simulation every(40, 30, 1, types[t]);
+        Simulation sampled(40, 30, 1, types[t]);
+        fillRandom(*every.grid, *sampled.grid, t + 1);
+        assert(every.getStatsInterval() == 1);
+        every.setStatsHistory(20);
+        sampled.setStatsHistory(7);
+        sampled.setStatsInterval(3);
+        for (int gen = 0; gen < 20; gen++)
+        {
+            every.advanceGeneration();
+            sampled.advanceGeneration();
+        }
+        assert(sampled.getStatsCount() == 7);
+        for (int i = 0; i < 7; i++)
+        {
+            const Simulation::GenerationStats &expected = every.getStats(i * 3);
+            const Simulation::GenerationStats &actual = sampled.getStats(i);
+            assert(actual.generation == static_cast<unsigned>(i * 3 + 1));
+            assert(actual.generation == expected.generation);
+            assert(actual.population == expected.population);
+            assert(actual.births == expected.births && actual.deaths == expected.deaths);
+            assert(actual.x == expected.x && actual.y == expected.y);
+            assert(actual.width == expected.width && actual.height == expected.height);
+        }
+        assert(sampled.getPopulation() == every.getPopulation());
+    }
+    {
+        Simulation sim(10, 10, 1, Simulation::PACKED_GRID);
+        bool thrown = false;
+        try
+        {
+            sim.setStatsInterval(0);
+        }
+        catch (std::invalid_argument &)
+        {
+            thrown = true;
+        }
+        assert(thrown);
+    }
+    std::cout << "Passed!" << std::endl;
+}
+
+void UnitTest::test_Rule()
+{
+    /**************************************************************************
+     * Parsing and formatting
+     *************************************************************************/
+    std::cout << "Testing B/S notation...";
+    Rule conway;
+    assert(conway.isConway());
+    assert(conway.toString() == "B3/S23");
+    assert(Rule("B3/S23") == conway);
+    assert(Rule("b3/s23") == conway);
+    assert(Rule("S23/B3") == conway);
+    assert(Rule("23/3") == conway);
+    assert(Rule("B36/S23").getBirth() == Rule::HIGHLIFE_BIRTH);
+    assert(Rule("B3678/S34678") == Rule(Rule::DAY_NIGHT_BIRTH, Rule::DAY_NIGHT_SURVIVAL));
+    assert(Rule("B2/S").getSurvival() == 0);
+    assert(Rule("B2/S").toString() == "B2/S");
+    assert(Rule("B0/S8").hasBirthOnZero());
+    for (int r = 0; r < RULE_COUNT; r++)
+    {
+        assert(Rule(RULES[r]).toString() == RULES[r]);
+    }
+    std::cout << "Passed!" << std::endl;
+    
+    std::cout << "Testing getNextState...";
+    for (int n = 0; n <= 8; n++)
+    {
+        assert(conway.getNextState(false, n) == (n == 3));
+        assert(conway.getNextState(true, n) == (n == 2 || n == 3));
+    }
+    std::cout << "Passed!" << std::endl;
+    
+    std::cout << "Testing invalid rules...";
+    const char *invalid[] = { "", "B3S23", "B3/S23/", "B9/S23", "B3/B23",
+                              "X3/S23", "B3/S2a", "3/23/" };
+    for (int i = 0; i < 8; i++)
+    {
+        bool thrown = false;
+        try
+        {
+            Rule rule(invalid[i]);
+        }
+        catch (std::invalid_argument &)
+        {
+            thrown = true;
+        }
+        assert(thrown);
+    }
+    bool thrown = false;
+    try
+    {
+        Rule rule(1 << 9, 0);
+    }
+    catch (std::invalid_argument &)
+    {
+        thrown = true;
+    }
+    assert(thrown);
+    std::cout << "Passed!" << std::endl;
+    
+    /**************************************************************************
+     * Rules with more than two states
+     *************************************************************************/
+    std::cout << "Testing multi-state rules...";
+    Rule brain("B2/S/C3");
+    assert(brain.getFamily() == Rule::GENERATIONS);
+    assert(brain.getStateCount() == 3);
+    assert(brain.toString() == "B2/S/C3");
+    assert(Rule("/2/3") == brain);
+    assert(Rule("b2/s/c3") == brain);
+    assert(Rule("B2/S/C3") == Rule(1 << 2, 0, 3));
+    assert(!(brain == Rule("B2/S")));
+    assert(Rule("345/2/4").toString() == "B2/S345/C4");
+    // two states is the Life-like rule
+    assert(Rule("B3/S23/C2") == conway);
+    assert(Rule("B3/S23/C2").getFamily() == Rule::LIFE_LIKE);
+    assert(Rule("WireWorld").getFamily() == Rule::WIREWORLD);
+    assert(Rule("wireworld") == Rule::wireworld());
+    assert(Rule::wireworld().getStateCount() == 4);
+    assert(Rule::wireworld().toString() == "Wireworld");
+    const char *invalidStates[] = { "B2/S/C1", "B2/S/C17", "B2/S/C", "B2/S/X3",
+                                    "B2/S/C3/", "Wirewor" };
+    for (int i = 0; i < 6; i++)
+    {
+        thrown = false;
+        try
+        {
+            Rule rule(invalidStates[i]);
+        }
+        catch (std::invalid_argument &)
+        {
+            thrown = true;
+        }
+        assert(thrown);
+    }
+    std::cout << "Passed!" << std::endl;
+}
+
+void UnitTest::test_PatternReader()
+{
+    /**************************************************************************
+     * RLE patterns
+     *************************************************************************/
+    std::cout << "Testing an RLE glider...";
+    {
+        std::istringstream in("#N Glider\n#C A comment\n"
+                              "x = 3, y = 3, rule = B36/S23\nbo$2bo$3o!\n");
+        PatternReader reader(in);
+        assert(reader.getFormat() == PatternReader::FORMAT_RLE);
+        assert(reader.getName() == "Glider");
+        assert(reader.getWidth() == 3 && reader.getHeight() == 3);
+        assert(reader.hasRule() && reader.getRule() == Rule("B36/S23"));
+        VectorGrid grid(10, 10);
+        reader.readInto(grid, 4, 5);
+        int live = 0;
+        for (int y = 0; y < 10; y++)
+        {
+            for (int x = 0; x < 10; x++)
+            {
+                live += grid.getCell(x, y);
+            }
+        }
+        assert(live == 5);
+        assert(grid.getCell(5, 5) && grid.getCell(6, 6) && grid.getCell(4, 7)
+            && grid.getCell(5, 7) && grid.getCell(6, 7));
+    }
+    std::cout << "Passed!" << std::endl;
+    
+    std::cout << "Comparing RLE and .cells loads with the source grid...";
+    for (int i = 0; i < SIZE_COUNT; i++)
+    {
+        VectorGrid source(SIZES[i][0], SIZES[i][1]);
+        VectorGrid unused(SIZES[i][0], SIZES[i][1]);
+        fillRandom(source, unused, i + 1);
+    
+        std::istringstream rle(encodeRle(source));
+        PatternReader rleReader(rle);
+        PackedGrid packed(SIZES[i][0], SIZES[i][1]);
+        packed.setSparse(true);
+        rleReader.readInto(packed, 0, 0);
+        assert(sameCells(source, packed));
+    
+        std::istringstream cells(encodeCells(source));
+        PatternReader cellsReader(cells);
+        assert(cellsReader.getFormat() == PatternReader::FORMAT_CELLS);
+        assert(cellsReader.getName() == "Random");
+        assert(cellsReader.getWidth() == -1 && !cellsReader.hasRule());
+        InfiniteGrid plane(SIZES[i][0], SIZES[i][1]);
+        cellsReader.readInto(plane, -7, -3);
+        for (int y = 0; y < source.getHeight(); y++)
+        {
+            for (int x = 0; x < source.getWidth(); x++)
+            {
+                assert(plane.getCell(x - 7, y - 3) == source.getCell(x, y));
+            }
+        }
+    }
+    std::cout << "Passed!" << std::endl;
+    
+    std::cout << "Testing several patterns in one stream...";
+    {
+        std::istringstream in("#N Block\nx = 2, y = 2\n2o$2o!\n\n"
+                              "#N Blinker\nx = 3, y = 1\n3o!\n");
+        PatternReader block(in);
+        assert(block.getName() == "Block" && !block.hasRule());
+        block.skip();
+        PatternReader blinker(in);
+        assert(blinker.getName() == "Blinker");
+        PackedGrid grid(5, 3);
+        blinker.readInto(grid, 1, 1);
+        assert(grid.getCell(1, 1) && grid.getCell(2, 1) && grid.getCell(3, 1));
+        assert(!grid.getCell(0, 0) && !grid.getCell(1, 0));
+    }
+    std::cout << "Passed!" << std::endl;
+    
+    /**************************************************************************
+     * Invalid patterns
+     *************************************************************************/
+    std::cout << "Testing invalid patterns...";
+    const char *invalid[] = { "", "#N No header\n", "x = 3\nbo$2bo$3o!\n",
+                              "x = 3, y = 3\nbo$2bo$3o\n", "x = 3, y = 3\nbq!\n",
+                              "x = 3, y = 3, rule = B9/S23\no!\n", "..O\n.x.\n",
+                              "x = 3, y = 3\n5o!\n", "O\n\n\n\nO\n" };
+    for (int i = 0; i < 9; i++)
+    {
+        bool thrown = false;
+        try
+        {
+            // patterns that fit must stay inside this 4x4 grid
+            std::istringstream in(invalid[i]);
+            PatternReader reader(in);
+            VectorGrid grid(4, 4);
+            reader.readInto(grid, 0, 0);
+        }
+        catch (std::invalid_argument &)
+        {
+            thrown = true;
+        }
+        assert(thrown);
+    }
+    std::cout << "Passed!" << std::endl;
+
+    std::cout << "Testing oversized dead runs...";
+    {
+        // 22 runs of 1e8 pass INT_MAX without writing a live cell
+        std::string dead = "x = 1, y = 1\n";
+        std::string ends = dead;
+        for (int i = 0; i < 22; i++)
+        {
+            dead += "100000000b";
+            ends += "100000000$";
+        }
+        dead += "o!\n";
+        ends += "o!\n";
+        const std::string *oversized[] = { &dead, &ends };
+        for (int i = 0; i < 2; i++)
+        {
+            for (int target = 0; target < 3; target++)
+            {
+                bool thrown = false;
+                try
+                {
+                    std::istringstream in(*oversized[i]);
+                    PatternReader reader(in);
+                    VectorGrid grid(4, 4);
+                    InfiniteGrid plane(4, 4);
+                    if (target == 0)
+                    {
+                        reader.readInto(grid, 0, 0);
+                    }
+                    else if (target == 1)
+                    {
+                        reader.readInto(plane, -5, -5);
+                    }
+                    else
+                    {
+                        reader.skip();
+                    }
+                }
+                catch (std::invalid_argument &)
+                {
+                    thrown = true;
+                }
+                assert(thrown);
+            }
+        }
+
+        // a run whose end still fits in an int is read
+        std::istringstream in("x = 3, y = 1\n2bo!\n");
+        PatternReader reader(in);
+        InfiniteGrid plane(4, 4);
+        reader.readInto(plane, std::numeric_limits<int>::max() - 3, 0);
+        assert(plane.getPopulation() == 1);
+    }
+    std::cout << "Passed!" << std::endl;
+
+    /**************************************************************************
+     * Simulation::addPattern
+     *************************************************************************/
+    std::cout << "Testing Simulation::addPattern with a reader...";
+    {
+        Simulation sim(10, 10, 1, Simulation::PACKED_GRID);
+        std::istringstream big("x = 12, y = 1\n12o!\n");
+        PatternReader bigReader(big);
+        bool thrown = false;
+        try
+        {
+            sim.addPattern(bigReader, 0, 0);
+        }
+        catch (std::invalid_argument &)
+        {
+            thrown = true;
+        }
+        assert(thrown);
+    
+        std::istringstream in("x = 3, y = 1, rule = 23/36\n3o!\n");
+        PatternReader reader(in);
+        sim.addPattern(reader, 2, 3);
+        assert(sim.getRule() == Rule("B36/S23"));
+        assert(sim.grid->getCell(3, 4) && sim.grid->getCell(5, 4));
+    }
+    std::cout << "Passed!" << std::endl;
+    
+    std::cout << "Testing Simulation::addPattern in each orientation...";
+    {
+        // every orientation of this pattern is different
+        const char *const ORIENTED[Pattern::ORIENTATION_COUNT][3] = {
+            { "oo.", "..o", NULL }, { ".o", ".o", "o." },
+            { "o..", ".oo", NULL }, { ".o", "o.", "o." },
+            { ".oo", "o..", NULL }, { "..o", "oo.", NULL },
+            { "o.", "o.", ".o" }, { "o.", ".o", ".o" } };
+        vgrid cells(2, std::vector<bool>(3, false));
+        cells[0][0] = cells[0][1] = cells[1][2] = true;
+        Pattern p("Hook", cells);
+        const Simulation::GridType types[] = { Simulation::VECTOR_GRID,
+            Simulation::PACKED_GRID, Simulation::BYTE_GRID, Simulation::INFINITE_GRID,
+            Simulation::STATE_GRID };
+        const int typeCount = sizeof(types) / sizeof(types[0]);
+        for (int t = 0; t < typeCount; t++)
+        {
+            for (int o = 0; o < Pattern::ORIENTATION_COUNT; o++)
+            {
+                Pattern::Orientation orientation = static_cast<Pattern::Orientation>(o);
+                Simulation sim(140, 12, 1, types[t]);
+                Simulation before(140, 12, 1, types[t]);
+                fillRandom(*sim.grid, *before.grid, t * 8 + o + 1);
+    
+                // straddles the word boundary at column 64 of the grid
+                sim.addPattern(p, 62, 4, orientation);
+                assert(p.getWidth(orientation) == static_cast<int>(std::strlen(ORIENTED[o][0])));
+                for (int y = 0; y < 12; y++)
+                {
+                    for (int x = 0; x < 140; x++)
+                    {
+                        int u = x - 62;
+                        int v = y - 4;
+                        bool inside = u >= 0 && v >= 0 && u < p.getWidth(orientation)
+                                      && v < p.getHeight(orientation);
+                        bool expected = inside ? ORIENTED[o][v][u] == 'o'
+                                               : before.getCell(x, y);
+                        assert(sim.getCell(x, y) == expected);
+                    }
+                }
+            }
+        }
+    
+        // a wide pattern spans several words at any offset
+        vgrid wide(5, std::vector<bool>(150, false));
+        std::srand(7);
+        for (int y = 0; y < 5; y++)
+        {
+            for (int x = 0; x < 150; x++)
+            {
+                wide[y][x] = std::rand() % 2 == 0;
+            }
+        }
+        Pattern soup("Wide", wide);
+        for (int x = 0; x < 70; x += 23)
+        {
+            Simulation sim(230, 8, 1, Simulation::PACKED_GRID);
+            sim.setSparse(x % 2 == 1);
+            sim.addPattern(soup, x, 1, Pattern::ROTATE_180);
+            for (int v = 0; v < 5; v++)
+            {
+                for (int u = 0; u < 150; u++)
+                {
+                    assert(sim.getCell(x + u, 1 + v) == soup.getCellState(149 - u, 4 - v));
+                }
+            }
+            assert(!sim.getCell(x + 150, 1) && (x == 0 || !sim.getCell(x - 1, 1)));
+        }
+    
+        // changing a cell rebuilds the packed rows
+        p.setCellState(1, 1, true);
+        Simulation sim(10, 10, 1, Simulation::PACKED_GRID);
+        sim.addPattern(p, 0, 0, Pattern::FLIP_VERTICAL);
+        assert(sim.getCell(1, 0) && sim.getPopulation() == 4);
+    }
+    std::cout << "Passed!" << std::endl;
+}
+
+void UnitTest::test_HashLife()
+{
+    /**************************************************************************
+     * setCell and getCell functions
+     *************************************************************************/
+    std::cout << "Testing setCell and getCell...";
+    HashLife life;
+    life.setCell(-1000, 5000, true);
+    life.setCell(3, -4, true);
+    assert(life.getCell(-1000, 5000));
+    assert(life.getCell(3, -4));
+    assert(!life.getCell(4, -4));
+    assert(!life.getCell(1L << 40, 0));
+    assert(life.getPopulation() == 2);
+    life.setCell(3, -4, false);
+    assert(!life.getCell(3, -4));
+    assert(life.getPopulation() == 1);
+    std::cout << "Passed!" << std::endl;
+    
+    /**************************************************************************
+     * advanceGeneration and advanceBy functions
+     *************************************************************************/
+    std::cout << "Comparing HashLife with PackedGrid...";
+    const int SOUP = 24;            // size of random soup
+    const int MARGIN = 100;         // distance from soup to grid edge
+    PackedGrid expected(SOUP + 2 * MARGIN, SOUP + 2 * MARGIN);
+    HashLife stepped;
+    HashLife jumped;
+    std::srand(42);
+    for (int y = 0; y < SOUP; y++)
+    {
+        for (int x = 0; x < SOUP; x++)
+        {
+            bool alive = std::rand() % 2 == 0;
+            expected.setCell(x + MARGIN, y + MARGIN, alive);
+            stepped.setCell(x, y, alive);
+            jumped.setCell(x, y, alive);
+        }
+    }
+    for (int gen = 1; gen <= GENERATIONS; gen++)
+    {
+        expected.step();
+        stepped.advanceGeneration();
+        assert(stepped.getGenerationCount() == static_cast<uint64_t>(gen));
+    }
+    jumped.advanceBy(GENERATIONS);
+    for (int y = 0; y < expected.getHeight(); y++)
+    {
+        for (int x = 0; x < expected.getWidth(); x++)
+        {
+            bool alive = expected.getCell(x, y);
+            assert(stepped.getCell(x - MARGIN, y - MARGIN) == alive);
+            assert(jumped.getCell(x - MARGIN, y - MARGIN) == alive);
+        }
+    }
+    std::cout << "Passed!" << std::endl;
+    
+    /**************************************************************************
+     * InfiniteGrid
+     *************************************************************************/
+    std::cout << "Comparing InfiniteGrid with HashLife...";
+    InfiniteGrid plane(SOUP, SOUP);
+    HashLife reference;
+    std::srand(7);
+    for (int y = -SOUP; y < 0; y++)
+    {
+        for (int x = -SOUP / 2; x < SOUP / 2; x++)
+        {
+            bool alive = std::rand() % 2 == 0;
+            plane.setCell(x, y, alive);
+            reference.setCell(x, y, alive);
+        }
+    }
+    for (int gen = 0; gen < 4 * GENERATIONS; gen++)
+    {
+        plane.step();
+        reference.advanceGeneration();
+    }
+    for (int y = -MARGIN; y < MARGIN; y++)
+    {
+        for (int x = -MARGIN; x < MARGIN; x++)
+        {
+            assert(plane.getCell(x, y) == reference.getCell(x, y));
+        }
+    }
+    std::cout << "Passed!" << std::endl;
+    
+    std::cout << "Comparing InfiniteGrid with HashLife under Day & Night...";
+    {
+        // changing the rule must discard the results memoized for Conway
+        InfiniteGrid dayNight(SOUP, SOUP);
+        reference.setRule(Rule("B3678/S34678"));
+        dayNight.setRule(Rule("B3678/S34678"));
+        for (int y = -MARGIN; y < MARGIN; y++)
+        {
+            for (int x = -MARGIN; x < MARGIN; x++)
+            {
+                dayNight.setCell(x, y, reference.getCell(x, y));
+            }
+        }
+        for (int gen = 0; gen < GENERATIONS; gen++)
+        {
+            dayNight.step();
+        }
+        reference.advanceBy(GENERATIONS);
+        for (int y = -2 * MARGIN; y < 2 * MARGIN; y++)
+        {
+            for (int x = -2 * MARGIN; x < 2 * MARGIN; x++)
+            {
+                assert(dayNight.getCell(x, y) == reference.getCell(x, y));
+            }
+        }
+    
+        bool thrown = false;
+        try
+        {
+            reference.setRule(Rule("B0/S8"));
+        }
+        catch (std::invalid_argument &)
+        {
+            thrown = true;
+        }
+        assert(thrown);
+    }
+    std::cout << "Passed!" << std::endl;
+    
+    /**************************************************************************
+     * addPattern function and long jumps
+     *************************************************************************/
+    std::cout << "Testing a glider one million generations ahead...";
+    const bool GLIDER[3][3] = { {0, 1, 0}, {0, 0, 1}, {1, 1, 1} };
+    vgrid cells(3, std::vector<bool>(3));
+    for (int y = 0; y < 3; y++)
+    {
+        for (int x = 0; x < 3; x++)
+        {
+            cells[y][x] = GLIDER[y][x];
+        }
+    }
+    Pattern glider("Glider", cells);
+    HashLife far;
+    far.addPattern(glider, 10, -7);
+    far.advanceBy(1000000);
+    assert(far.getGenerationCount() == 1000000);
+    assert(far.getPopulation() == 5);
+    // a glider moves one cell diagonally every 4 generations
+    for (int y = 0; y < 3; y++)
+    {
+        for (int x = 0; x < 3; x++)
+        {
+            assert(far.getCell(10 + 250000 + x, -7 + 250000 + y) == GLIDER[y][x]);
+        }
+    }
+    
+    // a jump this large grows the root past the levels whose offsets
+    // fit in 64 bits
+    HashLife huge;
+    huge.addPattern(glider, 10, -7);
+    huge.advanceBy(static_cast<uint64_t>(1) << 62);
+    assert(huge.getPopulation() == 5);
+    const int64_t moved = static_cast<int64_t>(1) << 60;
+    for (int y = 0; y < 3; y++)
+    {
+        for (int x = 0; x < 3; x++)
+        {
+            assert(huge.getCell(10 + moved + x, -7 + moved + y) == GLIDER[y][x]);
+            assert(!huge.getCell(10 + x, -7 + y));
+        }
+    }
+    // cells in every quadrant of the plane, out to the ends of int64_t
+    const int64_t MAX = std::numeric_limits<int64_t>::max();
+    const int64_t corners[][2] = { {-MAX - 1, -MAX - 1}, {MAX, -MAX - 1},
+                                   {-MAX - 1, MAX}, {MAX, MAX}, {-1, 0}, {0, -1} };
+    for (int c = 0; c < 6; c++)
+    {
+        assert(!huge.getCell(corners[c][0], corners[c][1]));
+        huge.setCell(corners[c][0], corners[c][1], true);
+        assert(huge.getCell(corners[c][0], corners[c][1]));
+    }
+    assert(huge.getPopulation() == 11);
+    assert(huge.getCell(10 + moved + 2, -7 + moved + 2));
+    std::cout << "Passed!" << std::endl;
+    
+    /**************************************************************************
+     * garbage collection
+     *************************************************************************/
+    std::cout << "Testing unreachable nodes are collected...";
+    {
+        const size_t THRESHOLD = 4096;
+        HashLife collected;
+        collected.gcThreshold = THRESHOLD;
+        collected.addPattern(glider, 0, 0);
+        // edits leave dead paths behind
+        for (int i = 0; i < 2000; i++)
+        {
+            collected.setCell(i * 37, -i * 11, true);
+            collected.setCell(i * 37, -i * 11, false);
+        }
+        assert(collected.getNodeCount() <= 2 * THRESHOLD);
+        // so do the old roots of jumps of different sizes
+        for (int i = 0; i < 200; i++)
+        {
+            collected.advanceBy(1000 + i);
+            assert(collected.getNodeCount() <= 2 * THRESHOLD);
+        }
+        assert(collected.gcThreshold == THRESHOLD);
+        uint64_t moved = collected.getGenerationCount() / 4;
+        assert(collected.getGenerationCount() % 4 == 0);
+        assert(collected.getPopulation() == 5);
+        for (int y = 0; y < 3; y++)
+        {
+            for (int x = 0; x < 3; x++)
+            {
+                assert(collected.getCell(moved + x, moved + y) == GLIDER[y][x]);
+            }
+        }
+    }
+    std::cout << "Passed!" << std::endl;
+}
+
+void UnitTest::test_Renderer()
+{
+    /**************************************************************************
+     * Frame contents
+     *************************************************************************/
+    std::cout << "Testing full and empty frames...";
+    {
+        VectorGrid grid(8, 6);
+        grid.setCell(2, 1, true);
+        grid.setCell(3, 1, true);
+        Renderer renderer(5, 3);
+        std::string frame = renderer.renderFrame(grid, 1, 1, "Status\n");
+        assert(frame.compare(0, 4, "\033[2J") == 0);
+        assert(renderer.getChangedCount() == 15);
+        assert(frame.find(" ##  ") != std::string::npos);
+        assert(frame.find("\033[4;1HStatus\033[K\n") != std::string::npos);
+    
+        // nothing changed, so only the status is written
+        frame = renderer.renderFrame(grid, 1, 1, "Status\n");
+        assert(renderer.getChangedCount() == 0);
+        assert(frame == "\033[4;1HStatus\033[K\n");
+    
+        // one changed cell is one cursor move and one character
+        grid.setCell(5, 3, true);
+        frame = renderer.renderFrame(grid, 1, 1, "");
+        assert(renderer.getChangedCount() == 1);
+        assert(frame == "\033[3;5H#\033[4;1H");
+    
+        // a short gap is overwritten instead of moving the cursor
+        grid.setCell(1, 1, true);
+        grid.setCell(4, 1, true);
+        frame = renderer.renderFrame(grid, 1, 1, "");
+        assert(renderer.getChangedCount() == 2);
+        assert(frame == "\033[1;1H####\033[4;1H");
+    
+        renderer.invalidate();
+        frame = renderer.renderFrame(grid, 1, 1, "");
+        assert(frame.compare(0, 4, "\033[2J") == 0);
+        assert(renderer.getChangedCount() == 15);
+    }
+    std::cout << "Passed!" << std::endl;
+    
+    std::cout << "Replaying rendered generations against the grid...";
+    for (int i = 0; i < SIZE_COUNT; i++)
+    {
+        int w = SIZES[i][0];
+        int h = SIZES[i][1];
+        VectorGrid grid(w, h);
+        VectorGrid unused(w, h);
+        fillRandom(grid, unused, i + 1);
+        Renderer renderer(w - 2, h - 2);
+        std::vector<std::string> screen(h - 2, std::string(w - 2, '?'));
+        for (int gen = 0; gen < GENERATIONS; gen++)
+        {
+            std::string frame = renderer.renderFrame(grid, 1, 1, "");
+            int moves = applyFrame(frame, screen);
+            assert(moves <= renderer.getChangedCount() + 1);
+            for (int y = 1; y < h - 1; y++)
+            {
+                for (int x = 1; x < w - 1; x++)
+                {
+                    assert(screen[y - 1][x - 1] == (grid.getCell(x, y) ? '#' : ' '));
+                }
+            }
+            grid.step();
+        }
+    }
+    std::cout << "Passed!" << std::endl;
+}
+
+void UnitTest::test_SoupSearch()
+{
+    /**************************************************************************
+     * Census of known objects
+     *************************************************************************/
+    std::cout << "Testing census of soups...";
+    const int SOUPS = 40;
+    SoupSearch single(1);
+    single.run(7, 0, SOUPS);
+    assert(single.getSoupCount() == SOUPS);
+    assert(single.getGenerationCount() > 0);
+    assert(single.getCount("block") > 0);
+    assert(single.getCount("blinker") > 0);
+    assert(single.getCount("glider") > 0);
+    assert(single.getCount("no such object") == 0);
+    std::cout << "Passed!" << std::endl;
+    
+    /**************************************************************************
+     * Census does not depend on threads or ranges
+     *************************************************************************/
+    std::cout << "Comparing census with 1 and 3 threads...";
+    SoupSearch threaded(3);
+    assert(threaded.getThreadCount() == 3);
+    threaded.run(7, 0, SOUPS / 2);
+    threaded.run(7, SOUPS / 2, SOUPS - SOUPS / 2);
+    assert(threaded.getSoupCount() == single.getSoupCount());
+    assert(threaded.getUnstableCount() == single.getUnstableCount());
+    assert(threaded.getGenerationCount() == single.getGenerationCount());
+    assert(threaded.getNames() == single.getNames());
+    for (unsigned i = 0; i < single.getNames().size(); i++)
+    {
+        const std::string &name = single.getNames()[i];
+        assert(threaded.getCount(name) == single.getCount(name));
+    }
+    std::cout << "Passed!" << std::endl;
+    
+    /**************************************************************************
+     * Invalid arguments
+     *************************************************************************/
+    std::cout << "Testing invalid arguments...";
+    bool thrown = false;
+    try
+    {
+        SoupSearch invalid(-1);
+    }
+    catch (std::invalid_argument &)
+    {
+        thrown = true;
+    }
+    assert(thrown);
+    thrown = false;
+    try
+    {
+        single.run(7, 0, -1);
+    }
+    catch (std::invalid_argument &)
+    {
+        thrown = true;
+    }
+    assert(thrown);
+    std::cout << "Passed!" << std::endl;
+}
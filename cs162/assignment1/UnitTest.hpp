@@ -0,0 +1,50 @@
+/*************************************************************************
+ * Author:          David Rigert
+ * Date Created:    10/17/2026
+ * Last Modified:   10/17/2026
+ * Assignment:      Assignment 1
+ * Filename:        UnitTest.hpp
+ *
+ * Description:     Represents unit tests for the life simulator.
+ ************************************************************************/
+#ifndef UNITTEST_HPP
+#define UNITTEST_HPP
+
+#include <iostream>
+#include <cassert>
+
+class Grid;
+
+class UnitTest
+{
+private:
+    // fills both grids with the same random cells
+    static void fillRandom(Grid &, Grid &, unsigned);
+
+    // returns true if both grids have the same cells
+    static bool sameCells(Grid &, Grid &);
+
+public:
+    // differential tests of each Grid backend against VectorGrid
+    static void test_Grid();
+
+    // unit tests for the Rule class
+    static void test_Rule();
+
+    // unit tests for the PatternReader class
+    static void test_PatternReader();
+
+    // unit tests for the Renderer class
+    static void test_Renderer();
+
+    // unit tests for the HashLife class
+    static void test_HashLife();
+
+    // unit tests for the Simulation class
+    static void test_Simulation();
+
+    // unit tests for the SoupSearch class
+    static void test_SoupSearch();
+};
+
+#endif
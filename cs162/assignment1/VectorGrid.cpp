@@ -0,0 +1,162 @@
+/*************************************************************************
+ * Author:          David Rigert
+ * Date Created:    10/17/2026
+ * Last Modified:   10/17/2026
+ * Assignment:      Assignment 1
+ * Filename:        VectorGrid.cpp
+ *
+ * Description:     Implementation of the VectorGrid class.
+ ************************************************************************/
+#include <stdexcept>
+#include <algorithm>
+#include "VectorGrid.hpp"
+
+/********************************************************************
+ *  Function:       VectorGrid(int width, int height)
+ *  Description:    Creates the current and next grids with all cells
+ *                  set to dead.
+ *  Parameters:     width   Width of the grid including buffer cells
+ *                  height  Height of the grid including buffer cells
+ *******************************************************************/
+VectorGrid::VectorGrid(int width, int height) : Grid(width, height)
+{
+    stride = (width + 63) / 64 * 64;
+    currentIndex = 0;
+    
+    // Initialize grids
+    grids[0].assign(stride * height, false);
+    grids[1].assign(stride * height, false);
+}
+
+/********************************************************************
+ *  Function:       bool getCellNextState(int x, int y)
+ *  Description:    Gets whether the specified cell will be alive in
+ *                  the next generation. The rule looks up the next
+ *                  state from the current state and the number of
+ *                  live neighbors, e.g. for Conway's Game of Life live
+ *                  cells stay alive with 2-3 live neighbors and dead
+ *                  cells come to life with 3 live neighbors.
+ *  Parameters:     x   X coordinate of cell to check
+ *                  y   Y coordinate of cell to check
+ *  Preconditions:  Grids are initialized
+ *                  Specified coords are at least 1 cell away from real edge
+ *  Postconditions: Returns true if cell is alive in next generation.
+ *******************************************************************/
+bool VectorGrid::getCellNextState(int x, int y)
+{
+    // Validate argument values
+    if ((x < 1 || x > width - 2) || (y < 1 || y > height - 2))
+    {
+        throw std::invalid_argument("ERROR: Invalid cell coordinates specified.");
+    }
+    
+    const std::vector<bool> &currentGrid = grids[currentIndex];
+    int liveNeighborCount = 0;  // number of live neighbor cells
+    bool currentState = false;  // stores state of cell in current generation
+    bool nextState = false;        // stores state of cell in next generation
+    
+    // Check number of live neighbors
+    for (int i = y - 1; i <= y + 1; i++)
+    {
+        for (int j = x - 1; j <= x + 1; j++)
+        {
+            if (y == i && x == j)         // specified cell
+            {
+                currentState = currentGrid[i * stride + j];
+            }
+            else if (currentGrid[i * stride + j]) // neighbor is alive
+            {
+                liveNeighborCount++;
+            }
+        }
+    }
+    
+    // Determine next state
+    nextState = rule.getNextState(currentState, liveNeighborCount);
+    return nextState;
+}
+
+/********************************************************************
+ *  Function:       void computeRows(int first, int last)
+ *  Description:    Updates the cells of the specified rows in the next
+ *                  grid according to the rule, comparing each cell
+ *                  with its current state when gathering statistics
+ *                  or hashing changes.
+ *  Parameters:     first   First row to calculate, at least 1
+ *                  last    Row after the last row, at most height - 1
+ *  Preconditions:  Current grid is initialized
+ *  Postconditions: Rows first to last - 1 of next grid are calculated
+ *******************************************************************/
+void VectorGrid::computeRows(int first, int last)
+{
+    std::vector<bool> &nextGrid = grids[1 - currentIndex];
+    bool nextState = false; // stores the next state
+    uint64_t hash = 0;      // keys of the changed cells
+    
+    // Get state in next generation and set nextState grid
+    for (int i = first; i < last; i++)
+    {
+        RowStats row = { 0, 0, width, -1 };
+        for (int j = 1; j < width - 1; j++)
+        {
+            nextState = getCellNextState(j, i);
+            nextGrid[i * stride + j] = nextState;
+            if (hashEnabled && nextState != grids[currentIndex][i * stride + j])
+            {
+                hash ^= getCellKey(j, i);
+            }
+            if (statsEnabled)
+            {
+                bool alive = grids[currentIndex][i * stride + j];
+                row.births += nextState && !alive;
+                row.deaths += alive && !nextState;
+                if (nextState)
+                {
+                    row.left = std::min(row.left, j);
+                    row.right = j;
+                }
+            }
+        }
+        if (statsEnabled)
+        {
+            rowStats[i] = row;
+        }
+    }
+    addChangeHash(hash);
+}
+
+/********************************************************************
+ *  Function:       void swapBuffers()
+ *  Description:    Makes the next grid the current grid by switching
+ *                  the buffer index. Every interior cell of the next
+ *                  grid was just written, so only the outermost ring
+ *                  of cells, which may hold cells set on the old
+ *                  generation, has to be cleared.
+ *  Parameters:     none
+ *  Preconditions:  All rows of the next grid are calculated
+ *  Postconditions: Current grid contains next generation
+ *******************************************************************/
+void VectorGrid::swapBuffers()
+{
+    std::vector<bool> &nextGrid = grids[1 - currentIndex];
+    
+    // Clear top and bottom rows
+    for (int j = 0; j < width; j++)
+    {
+        nextGrid[j] = false;
+        nextGrid[(height - 1) * stride + j] = false;
+    }
+    // Clear first and last columns
+    for (int i = 0; i < height; i++)
+    {
+        nextGrid[i * stride] = false;
+        nextGrid[i * stride + width - 1] = false;
+    }
+    
+    if (statsEnabled)
+    {
+        sumRowStats();
+    }
+    finishChangeHash();
+    currentIndex = 1 - currentIndex;
+}
@@ -0,0 +1,69 @@
+/*************************************************************************
+ * Author:          David Rigert
+ * Date Created:    10/17/2026
+ * Last Modified:   10/17/2026
+ * Assignment:      Assignment 1
+ * Filename:        VectorGrid.hpp
+ *
+ * Description:     Grid backend that stores one bool per cell in a flat
+ *                  vector and evaluates each cell individually. This is
+ *                  the reference implementation of the Life rules.
+ ************************************************************************/
+#ifndef VECTORGRID_HPP
+#define VECTORGRID_HPP
+
+#include <vector>
+#include "Grid.hpp"
+
+class VectorGrid : public Grid
+{
+// member variables
+private:
+    std::vector<bool> grids[2]; // current and next generation
+    int currentIndex;           // index of current generation in grids
+    int stride;                 // cells per row, rounded up to 64 so rows
+                                // never share a word between threads
+
+// member functions
+private:
+    // Gets whether a cell will be alive or dead next generation.
+    bool getCellNextState(int, int);
+
+public:
+    // Instantiates a grid of the specified size with all cells dead.
+    VectorGrid(int, int);
+
+    /********************************************************************
+     *  Function:       bool getCell(int x, int y)
+     *  Description:    Gets whether the specified cell is alive.
+     *  Parameters:     x   X coordinate of cell
+     *                  y   Y coordinate of cell
+     *  Preconditions:  x,y is on the grid
+     *  Postconditions: Returns true if the cell is alive
+     *******************************************************************/
+    bool getCell(int x, int y) const
+    {
+        return grids[currentIndex][y * stride + x];
+    }
+
+    /********************************************************************
+     *  Function:       void setCell(int x, int y, bool alive)
+     *  Description:    Sets the state of the specified cell.
+     *  Parameters:     x       X coordinate of cell
+     *                  y       Y coordinate of cell
+     *                  alive   New state of the cell
+     *  Preconditions:  x,y is on the grid
+     *  Postconditions: Cell at x,y is set to alive
+     *******************************************************************/
+    void setCell(int x, int y, bool alive)
+    {
+        grids[currentIndex][y * stride + x] = alive;
+    }
+
+    // Calculates rows first to last - 1 of the next generation.
+    void computeRows(int, int);
+
+    // Makes the next generation the current generation.
+    void swapBuffers();
+};
+#endif // end of define VECTORGRID_HPP
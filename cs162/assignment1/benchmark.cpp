@@ -0,0 +1,648 @@
+/*************************************************************************
+ * Author:          David Rigert
+ * Date Created:    10/17/2026
+ * Last Modified:   10/17/2026
+ * Assignment:      Assignment 1
+ * Filename:        benchmark.cpp
+ *
+ * Description:     This program measures the speed of the Grid backends
+ *                  used by the life simulator.
+ *
+ * Input:           - Command line: lifebench kernel [maxSize]
+ *                    Compares the VectorGrid reference path with each
+ *                    ByteGrid kernel on square random soups from 1024
+ *                    cells up to maxSize (default 16384) cells per side.
+ *                  - Command line: lifebench swap [maxSize]
+ *                    Compares the old copy-and-reset generation turnover
+ *                    of VectorGrid with the current buffer swap on
+ *                    grids up to maxSize (default 4096) cells per side.
+ *                  - Command line: lifebench boundary [size] [generations]
+ *                    Runs the same random soup with each boundary mode
+ *                    on a size x size ByteGrid (default 1024) for the
+ *                    given number of generations (default 4000).
+ *                  - Command line: lifebench rule [size]
+ *                    Times PackedGrid and the best ByteGrid kernel under
+ *                    several Life-like rules on a size x size random
+ *                    soup (default 2048).
+ *                  - Command line: lifebench load [size]
+ *                    Loads a size x size random soup (default 4096)
+ *                    from RLE text into PackedGrid and InfiniteGrid.
+ *                  - Command line: lifebench stamp [count]
+ *                    Stamps count patterns (default 20000) in random
+ *                    orientations onto a 4096 x 4096 PackedGrid, cell
+ *                    by cell from a copy of the pattern and from its
+ *                    packed rows.
+ *
+ * Output:          - Displays the time per generation and the time per
+ *                    cell update of each backend and kernel.
+ *                  - Displays the bytes moved and time spent per
+ *                    generation by each turnover method.
+ *                  - Displays the time per generation and the final
+ *                    density of live cells of each boundary mode.
+ *                  - Displays the time per generation of each rule and
+ *                    its speed relative to Conway's rule.
+ *                  - Displays the size of the RLE text and the time and
+ *                    throughput of each load.
+ *                  - Displays the time per stamp of each method.
+ ************************************************************************/
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <sstream>
+#include "VectorGrid.hpp"
+#include "ByteGrid.hpp"
+#include "PackedGrid.hpp"
+#include "InfiniteGrid.hpp"
+#include "PatternReader.hpp"
+#include "Pattern.hpp"
+
+// Define 2D bool vector as vgrid
+typedef std::vector<std::vector<bool> > vgrid;
+
+// Function prototypes
+// Fills a grid with random live cells
+void fillRandom(Grid &, unsigned);
+// Compares VectorGrid with the ByteGrid kernels
+void runKernelBenchmark(int);
+// Compares the copy-and-reset turnover with the buffer swap
+void runSwapBenchmark(int);
+// Compares the speed and soup density of each boundary mode
+void runBoundaryBenchmark(int, int);
+// Compares the speed of each backend under several rules
+void runRuleBenchmark(int);
+// Times streaming an RLE soup into the grids
+void runLoadBenchmark(int);
+// Compares stamping patterns cell by cell and by packed rows
+void runStampBenchmark(int);
+// Prints the result of one timed run
+void printResult(const char *, int, double, double);
+// Prints the result of one timed turnover method
+void printTurnover(const char *, int, double, double);
+// Times the generations of a grid and returns seconds per generation
+double timeGrid(Grid &);
+// Prints the command line usage
+void printUsage();
+
+// Constants
+static const int MIN_SIZE = 1024;
+static const int DEFAULT_MAX_SIZE = 16384;
+static const int DEFAULT_MAX_SWAP_SIZE = 4096;
+static const int DEFAULT_BOUNDARY_SIZE = 1024;
+static const int DEFAULT_BOUNDARY_GENERATIONS = 4000;
+static const int DEFAULT_RULE_SIZE = 2048;
+static const int DEFAULT_LOAD_SIZE = 4096;
+static const int DEFAULT_STAMP_COUNT = 20000;
+static const int STAMP_GRID_SIZE = 4096;
+static const double MIN_SECONDS = 0.5;  // minimum time spent per run
+
+int main(int argc, char *argv[])
+{
+    if (argc >= 2 && std::strcmp(argv[1], "kernel") == 0)
+    {
+        int maxSize = argc >= 3 ? std::atoi(argv[2]) : DEFAULT_MAX_SIZE;
+        runKernelBenchmark(maxSize);
+    }
+    else if (argc >= 2 && std::strcmp(argv[1], "swap") == 0)
+    {
+        int maxSize = argc >= 3 ? std::atoi(argv[2]) : DEFAULT_MAX_SWAP_SIZE;
+        runSwapBenchmark(maxSize);
+    }
+    else if (argc >= 2 && std::strcmp(argv[1], "boundary") == 0)
+    {
+        int size = argc >= 3 ? std::atoi(argv[2]) : DEFAULT_BOUNDARY_SIZE;
+        int generations = argc >= 4 ? std::atoi(argv[3]) : DEFAULT_BOUNDARY_GENERATIONS;
+        runBoundaryBenchmark(size, generations);
+    }
+    else if (argc >= 2 && std::strcmp(argv[1], "rule") == 0)
+    {
+        int size = argc >= 3 ? std::atoi(argv[2]) : DEFAULT_RULE_SIZE;
+        runRuleBenchmark(size);
+    }
+    else if (argc >= 2 && std::strcmp(argv[1], "load") == 0)
+    {
+        int size = argc >= 3 ? std::atoi(argv[2]) : DEFAULT_LOAD_SIZE;
+        runLoadBenchmark(size);
+    }
+    else if (argc >= 2 && std::strcmp(argv[1], "stamp") == 0)
+    {
+        int count = argc >= 3 ? std::atoi(argv[2]) : DEFAULT_STAMP_COUNT;
+        runStampBenchmark(count);
+    }
+    else
+    {
+        printUsage();
+        return 1;
+    }
+    
+    return 0;
+}
+
+/********************************************************************
+ *  Function:       void fillRandom(Grid &grid, unsigned seed)
+ *  Description:    Sets roughly one third of the cells to alive.
+ *  Parameters:     grid    Grid to fill
+ *                  seed    Seed for the random number generator
+ *  Preconditions:  none
+ *  Postconditions: Every cell of grid is set to a random state
+ *******************************************************************/
+void fillRandom(Grid &grid, unsigned seed)
+{
+    std::srand(seed);
+    for (int y = 0; y < grid.getHeight(); y++)
+    {
+        for (int x = 0; x < grid.getWidth(); x++)
+        {
+            grid.setCell(x, y, std::rand() % 3 == 0);
+        }
+    }
+}
+
+/********************************************************************
+ *  Function:       void runKernelBenchmark(int maxSize)
+ *  Description:    Times VectorGrid and each supported ByteGrid kernel
+ *                  on square grids, doubling the size each time.
+ *  Parameters:     maxSize     Largest grid size to time
+ *  Preconditions:  none
+ *  Postconditions: Results are displayed in the console
+ *******************************************************************/
+void runKernelBenchmark(int maxSize)
+{
+    std::cout << "Best kernel on this CPU: "
+              << ByteGrid::getKernelName(ByteGrid::getBestKernel()) << "\n\n";
+    std::cout << std::left << std::setw(12) << "backend"
+              << std::right << std::setw(8) << "size"
+              << std::setw(14) << "ms/gen"
+              << std::setw(14) << "ns/cell"
+              << std::setw(10) << "speedup" << std::endl;
+    
+    for (int size = MIN_SIZE; size <= maxSize; size *= 2)
+    {
+        double baseline;
+        {
+            VectorGrid grid(size, size);
+            fillRandom(grid, size);
+            baseline = timeGrid(grid);
+            printResult("vector", size, baseline, 1.0);
+        }
+        
+        for (int k = ByteGrid::KERNEL_SCALAR; k <= ByteGrid::getBestKernel(); k++)
+        {
+            ByteGrid::Kernel kernel = static_cast<ByteGrid::Kernel>(k);
+            ByteGrid grid(size, size, kernel);
+            fillRandom(grid, size);
+            double seconds = timeGrid(grid);
+            printResult(ByteGrid::getKernelName(kernel), size, seconds,
+                        baseline / seconds);
+        }
+    }
+}
+
+/********************************************************************
+ *  Function:       void runSwapBenchmark(int maxSize)
+ *  Description:    Times the work done between generations: the old
+ *                  VectorGrid copied the next grid into the current
+ *                  grid cell by cell and then reset the next grid,
+ *                  while the current one switches buffers and clears
+ *                  the outermost ring. Bytes moved count every byte of
+ *                  storage read or written by the turnover.
+ *  Parameters:     maxSize     Largest grid size to time
+ *  Preconditions:  none
+ *  Postconditions: Results are displayed in the console
+ *******************************************************************/
+void runSwapBenchmark(int maxSize)
+{
+    typedef std::chrono::steady_clock clock;
+    
+    std::cout << std::left << std::setw(12) << "turnover"
+              << std::right << std::setw(8) << "size"
+              << std::setw(16) << "bytes/gen"
+              << std::setw(14) << "ms/gen" << std::endl;
+    
+    for (int size = MIN_SIZE; size <= maxSize; size *= 2)
+    {
+        // vector<bool> stores each row in 64-bit words
+        double rowBytes = (size + 63) / 64 * 8;
+        double gridBytes = rowBytes * size;
+        
+        // Old turnover: read next and write current, then write next
+        vgrid current(size, std::vector<bool>(size, false));
+        vgrid next(size, std::vector<bool>(size, true));
+        int generations = 0;
+        double elapsed = 0;
+        clock::time_point start = clock::now();
+        while (elapsed < MIN_SECONDS)
+        {
+            for (int i = 0; i < size; i++)
+            {
+                for (int j = 0; j < size; j++)
+                {
+                    current[i][j] = next[i][j];
+                }
+            }
+            for (int i = 0; i < size; i++)
+            {
+                for (int j = 0; j < size; j++)
+                {
+                    next[i][j] = false;
+                }
+            }
+            generations++;
+            elapsed = std::chrono::duration<double>(clock::now() - start).count();
+        }
+        printTurnover("copy+reset", size, 3 * gridBytes, elapsed / generations);
+        
+        // New turnover: clear two rows and two columns, then swap
+        VectorGrid grid(size, size);
+        generations = 0;
+        elapsed = 0;
+        start = clock::now();
+        while (elapsed < MIN_SECONDS)
+        {
+            grid.swapBuffers();
+            generations++;
+            elapsed = std::chrono::duration<double>(clock::now() - start).count();
+        }
+        // each column cell read-modify-writes one word
+        printTurnover("swap", size, 2 * rowBytes + 2 * 2 * 8.0 * size,
+                      elapsed / generations);
+    }
+}
+
+/********************************************************************
+ *  Function:       void runBoundaryBenchmark(int size, int generations)
+ *  Description:    Runs the same random soup once with each boundary
+ *                  mode using the best ByteGrid kernel. The density is
+ *                  measured over the interior only, because the ring
+ *                  is a halo or always dead.
+ *  Parameters:     size            Width and height of the grid
+ *                  generations     Number of generations to run
+ *  Preconditions:  size >= 3, generations > 0
+ *  Postconditions: Results are displayed in the console
+ *******************************************************************/
+void runBoundaryBenchmark(int size, int generations)
+{
+    typedef std::chrono::steady_clock clock;
+    const Grid::Boundary modes[] = { Grid::DEAD_EDGE, Grid::TORUS, Grid::KLEIN_BOTTLE };
+    const char *names[] = { "dead edge", "torus", "klein" };
+    
+    std::cout << std::left << std::setw(12) << "boundary"
+              << std::right << std::setw(8) << "size"
+              << std::setw(14) << "ms/gen"
+              << std::setw(14) << "density" << std::endl;
+    
+    for (int m = 0; m < 3; m++)
+    {
+        ByteGrid grid(size, size);
+        fillRandom(grid, size);
+        grid.setBoundary(modes[m]);
+        
+        clock::time_point start = clock::now();
+        for (int gen = 0; gen < generations; gen++)
+        {
+            grid.step();
+        }
+        double seconds = std::chrono::duration<double>(clock::now() - start).count();
+        
+        long live = 0;
+        for (int y = 1; y < size - 1; y++)
+        {
+            for (int x = 1; x < size - 1; x++)
+            {
+                live += grid.getCell(x, y);
+            }
+        }
+        double interior = static_cast<double>(size - 2) * (size - 2);
+        std::cout << std::left << std::setw(12) << names[m]
+                  << std::right << std::setw(8) << size
+                  << std::fixed << std::setprecision(3)
+                  << std::setw(14) << seconds * 1e3 / generations
+                  << std::setprecision(4)
+                  << std::setw(14) << live / interior << std::endl;
+    }
+}
+
+/********************************************************************
+ *  Function:       void runRuleBenchmark(int size)
+ *  Description:    Times PackedGrid and the best ByteGrid kernel under
+ *                  Conway's rule, the rules with specialized PackedGrid
+ *                  kernels, and a rule that uses the generic kernel.
+ *                  The speedup column is relative to Conway's rule on
+ *                  the same backend.
+ *  Parameters:     size    Width and height of the grid
+ *  Preconditions:  size >= 3
+ *  Postconditions: Results are displayed in the console
+ *******************************************************************/
+void runRuleBenchmark(int size)
+{
+    const char *rules[] = { "B3/S23", "B36/S23", "B3678/S34678", "B36/S125" };
+    const int ruleCount = sizeof(rules) / sizeof(rules[0]);
+    
+    std::cout << std::left << std::setw(14) << "rule"
+              << std::setw(12) << "backend"
+              << std::right << std::setw(8) << "size"
+              << std::setw(14) << "ms/gen"
+              << std::setw(14) << "ns/cell"
+              << std::setw(10) << "speedup" << std::endl;
+    
+    double packedBaseline = 0;
+    double byteBaseline = 0;
+    for (int r = 0; r < ruleCount; r++)
+    {
+        Rule rule(rules[r]);
+        {
+            PackedGrid grid(size, size);
+            fillRandom(grid, size);
+            grid.setRule(rule);
+            double seconds = timeGrid(grid);
+            packedBaseline = r == 0 ? seconds : packedBaseline;
+            std::cout << std::left << std::setw(14) << rules[r];
+            printResult("packed", size, seconds, packedBaseline / seconds);
+        }
+        {
+            ByteGrid grid(size, size);
+            fillRandom(grid, size);
+            grid.setRule(rule);
+            double seconds = timeGrid(grid);
+            byteBaseline = r == 0 ? seconds : byteBaseline;
+            std::cout << std::left << std::setw(14) << rules[r];
+            printResult(ByteGrid::getKernelName(grid.getKernel()), size, seconds,
+                        byteBaseline / seconds);
+        }
+    }
+}
+
+/********************************************************************
+ *  Function:       void runLoadBenchmark(int size)
+ *  Description:    Encodes a random soup as RLE in memory and times
+ *                  streaming it into each grid with PatternReader.
+ *  Parameters:     size    Width and height of the soup
+ *  Preconditions:  size > 0
+ *  Postconditions: Results are displayed in the console
+ *******************************************************************/
+void runLoadBenchmark(int size)
+{
+    typedef std::chrono::steady_clock clock;
+    
+    // Encode the soup with at most 70 characters per line
+    std::string text;
+    {
+        std::ostringstream out;
+        out << "#N Random soup\nx = " << size << ", y = " << size << "\n";
+        std::srand(size);
+        int lineLength = 0;
+        for (int y = 0; y < size; y++)
+        {
+            int x = 0;
+            while (x < size)
+            {
+                bool alive = std::rand() % 3 == 0;
+                int run = 1;
+                while (x + run < size && (std::rand() % 3 == 0) == alive)
+                {
+                    run++;
+                }
+                x += run;
+                if (!alive && x == size)
+                {
+                    break;      // trailing dead cells are left out
+                }
+                std::ostringstream token;
+                if (run > 1)
+                {
+                    token << run;
+                }
+                token << (alive ? 'o' : 'b');
+                if (lineLength + token.str().size() > 70)
+                {
+                    out << "\n";
+                    lineLength = 0;
+                }
+                out << token.str();
+                lineLength += token.str().size();
+            }
+            out << (y + 1 < size ? '$' : '!');
+            lineLength++;
+        }
+        out << "\n";
+        text = out.str();
+    }
+    
+    std::cout << "RLE text: " << std::fixed << std::setprecision(1)
+              << text.size() / 1e6 << " MB\n\n";
+    std::cout << std::left << std::setw(12) << "grid"
+              << std::right << std::setw(8) << "size"
+              << std::setw(14) << "ms"
+              << std::setw(14) << "MB/s" << std::endl;
+    
+    for (int g = 0; g < 2; g++)
+    {
+        Grid *grid = g == 0 ? static_cast<Grid *>(new PackedGrid(size, size))
+                            : static_cast<Grid *>(new InfiniteGrid(size, size));
+        std::istringstream in(text);
+        clock::time_point start = clock::now();
+        PatternReader reader(in);
+        reader.readInto(*grid, 0, 0);
+        double seconds = std::chrono::duration<double>(clock::now() - start).count();
+        std::cout << std::left << std::setw(12) << (g == 0 ? "packed" : "infinite")
+                  << std::right << std::setw(8) << size
+                  << std::setprecision(1)
+                  << std::setw(14) << seconds * 1e3
+                  << std::setw(14) << text.size() / 1e6 / seconds << std::endl;
+        delete grid;
+    }
+}
+
+/********************************************************************
+ *  Function:       void runStampBenchmark(int count)
+ *  Description:    Stamps the same patterns at the same random places
+ *                  and orientations twice: the old way, copying the
+ *                  pattern and setting one cell at a time, and through
+ *                  the packed rows the pattern caches for each
+ *                  orientation. Both grids are compared afterwards.
+ *  Parameters:     count   Number of patterns to stamp
+ *  Preconditions:  count > 0
+ *  Postconditions: Results are displayed in the console
+ *******************************************************************/
+void runStampBenchmark(int count)
+{
+    typedef std::chrono::steady_clock clock;
+    
+    // Lightweight spaceship and a wide random strip
+    const char *const SHIP[] = { ".o..o", "o....", "o...o", "oooo." };
+    vgrid shipCells(4, std::vector<bool>(5));
+    for (int y = 0; y < 4; y++)
+    {
+        for (int x = 0; x < 5; x++)
+        {
+            shipCells[y][x] = SHIP[y][x] == 'o';
+        }
+    }
+    vgrid stripCells(8, std::vector<bool>(100));
+    std::srand(count);
+    for (int y = 0; y < 8; y++)
+    {
+        for (int x = 0; x < 100; x++)
+        {
+            stripCells[y][x] = std::rand() % 2 == 0;
+        }
+    }
+    const Pattern patterns[] = { Pattern("Ship", shipCells), Pattern("Strip", stripCells) };
+    
+    // Same places for both methods, clear of the edges for any orientation
+    std::vector<int> places(count * 4);
+    for (int i = 0; i < count; i++)
+    {
+        places[i * 4] = std::rand() % 2;
+        places[i * 4 + 1] = std::rand() % Pattern::ORIENTATION_COUNT;
+        places[i * 4 + 2] = std::rand() % (STAMP_GRID_SIZE - 100);
+        places[i * 4 + 3] = std::rand() % (STAMP_GRID_SIZE - 100);
+    }
+    
+    std::cout << std::left << std::setw(12) << "method"
+              << std::right << std::setw(8) << "count"
+              << std::setw(14) << "ms"
+              << std::setw(14) << "us/stamp" << std::endl;
+    
+    PackedGrid byCell(STAMP_GRID_SIZE, STAMP_GRID_SIZE);
+    PackedGrid byRow(STAMP_GRID_SIZE, STAMP_GRID_SIZE);
+    PackedGrid *grids[] = { &byCell, &byRow };
+    for (int m = 0; m < 2; m++)
+    {
+        clock::time_point start = clock::now();
+        for (int i = 0; i < count; i++)
+        {
+            const Pattern &p = patterns[places[i * 4]];
+            Pattern::Orientation o = static_cast<Pattern::Orientation>(places[i * 4 + 1]);
+            int x = places[i * 4 + 2];
+            int y = places[i * 4 + 3];
+            int width = p.getWidth(o);
+            int height = p.getHeight(o);
+            if (m == 0)
+            {
+                // The pattern used to be passed by value
+                Pattern copy = p;
+                for (int v = 0; v < height; v++)
+                {
+                    const uint64_t *row = copy.getRowBits(v, o);
+                    for (int u = 0; u < width; u++)
+                    {
+                        grids[m]->setCell(x + u, y + v, (row[u >> 6] >> (u & 63)) & 1);
+                    }
+                }
+            }
+            else
+            {
+                for (int v = 0; v < height; v++)
+                {
+                    grids[m]->setRowBits(x, y + v, width, p.getRowBits(v, o));
+                }
+            }
+        }
+        double seconds = std::chrono::duration<double>(clock::now() - start).count();
+        std::cout << std::left << std::setw(12) << (m == 0 ? "cells" : "rows")
+                  << std::right << std::setw(8) << count
+                  << std::fixed << std::setprecision(1)
+                  << std::setw(14) << seconds * 1e3
+                  << std::setprecision(3)
+                  << std::setw(14) << seconds * 1e6 / count << std::endl;
+    }
+    
+    for (int y = 0; y < STAMP_GRID_SIZE; y++)
+    {
+        for (int x = 0; x < STAMP_GRID_SIZE; x++)
+        {
+            if (byCell.getCell(x, y) != byRow.getCell(x, y))
+            {
+                std::cout << "ERROR: Stamped grids differ." << std::endl;
+                return;
+            }
+        }
+    }
+}
+
+/********************************************************************
+ *  Function:       void printTurnover(const char *name, int size,
+ *                                     double bytes, double seconds)
+ *  Description:    Prints one row of the turnover results table.
+ *  Parameters:     name        Name of turnover method
+ *                  size        Width and height of the grid
+ *                  bytes       Bytes moved per generation
+ *                  seconds     Seconds per generation
+ *  Preconditions:  none
+ *  Postconditions: Row is displayed in the console
+ *******************************************************************/
+void printTurnover(const char *name, int size, double bytes, double seconds)
+{
+    std::cout << std::left << std::setw(12) << name
+              << std::right << std::setw(8) << size
+              << std::fixed << std::setprecision(0)
+              << std::setw(16) << bytes
+              << std::setprecision(3)
+              << std::setw(14) << seconds * 1e3 << std::endl;
+}
+
+/********************************************************************
+ *  Function:       void printResult(const char *name, int size,
+ *                                   double seconds, double speedup)
+ *  Description:    Prints one row of the results table.
+ *  Parameters:     name        Name of backend or kernel
+ *                  size        Width and height of the grid
+ *                  seconds     Seconds per generation
+ *                  speedup     Speed relative to VectorGrid
+ *  Preconditions:  none
+ *  Postconditions: Row is displayed in the console
+ *******************************************************************/
+void printResult(const char *name, int size, double seconds, double speedup)
+{
+    double cells = static_cast<double>(size) * size;
+    std::cout << std::left << std::setw(12) << name
+              << std::right << std::setw(8) << size
+              << std::fixed << std::setprecision(3)
+              << std::setw(14) << seconds * 1e3
+              << std::setw(14) << seconds * 1e9 / cells
+              << std::setprecision(1)
+              << std::setw(9) << speedup << "x" << std::endl;
+}
+
+/********************************************************************
+ *  Function:       double timeGrid(Grid &grid)
+ *  Description:    Advances the grid until at least MIN_SECONDS have
+ *                  passed and calculates the average generation time.
+ *  Parameters:     grid    Grid to advance
+ *  Preconditions:  none
+ *  Postconditions: Returns the average seconds per generation
+ *******************************************************************/
+double timeGrid(Grid &grid)
+{
+    typedef std::chrono::steady_clock clock;
+    clock::time_point start = clock::now();
+    double elapsed = 0;
+    int generations = 0;
+    
+    while (elapsed < MIN_SECONDS)
+    {
+        grid.step();
+        generations++;
+        elapsed = std::chrono::duration<double>(clock::now() - start).count();
+    }
+    return elapsed / generations;
+}
+
+/********************************************************************
+ *  Function:       void printUsage()
+ *  Description:    Prints the command line options.
+ *  Parameters:     none
+ *  Preconditions:  none
+ *  Postconditions: Usage is displayed in the console
+ *******************************************************************/
+void printUsage()
+{
+    std::cout << "Usage: lifebench kernel [maxSize]\n"
+              << "       lifebench swap [maxSize]\n"
+              << "       lifebench boundary [size] [generations]\n"
+              << "       lifebench rule [size]\n"
+              << "       lifebench load [size]\n"
+              << "       lifebench stamp [count]\n";
+}
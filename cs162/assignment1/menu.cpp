@@ -8,20 +8,75 @@
  * Description:     This program is a simulation of Conway's Game of Life.
  *                  The user can select from a list of known patterns and
  *                  add them to an 80x22 grid of cells. 
+ *                  The user can also change the rule to any Life-like
+ *                  rule in B/S notation, such as B36/S23 for HighLife.
  *                  The user can only modify the initial state of the 
  *                  simulation. Once the simulation starts running, the
  *                  user can only specify the number of generations to
  *                  advance.
  *
- * Input:           - User chooses patterns to add to the initial state from
- *                    a list of known patterns loaded from patterns.txt.
+ *                  Given command line arguments, the program instead
+ *                  runs a pattern headless and reports statistics, for
+ *                  tracking the speed of the simulation across builds.
+ *
+ * Input:           - Command line: lifesim --headless file [-n name]
+ *                    [-g generations] [-s size] [-t type] [-j threads]
+ *                    [-c history] [-o checkpoint] [-x stats]
+ *                    [-i interval] [-T tile]
+ *                    Runs the named pattern of an RLE or .cells file
+ *                    (default the first) for the given generations
+ *                    (default 1000), centered on a size x size board
+ *                    (default 256) of type vector, packed, byte,
+ *                    infinite or state (default packed) with the given number
+ *                    of threads (default 1). With -c the run stops
+ *                    early once a generation repeats one of the last
+ *                    history generations. The file can also be a
+ *                    checkpoint, which is restored and continued
+ *                    instead, and -o writes a compressed checkpoint
+ *                    after the run. With -x the population, births,
+ *                    deaths, bounding box and step time of generation
+ *                    1 and every interval generations after it
+ *                    (default 128, or 1 for every generation) are
+ *                    written to a CSV file. With -T
+ *                    the generations are split into tiles of the given
+ *                    size, such as 1024x256, shared out by work
+ *                    stealing instead of one band of rows per thread.
+ *                  - Command line: lifesim --scale size [-g generations]
+ *                    [-j threads] [-T tile] [-t type]
+ *                    Fills the top quarter of a size x size board
+ *                    (default 16384) with random cells and times the
+ *                    given generations (default 10) with 1 thread up
+ *                    to the given number (default 0, one per core),
+ *                    both in bands and in tiles (default 1024x256).
+ *                  - Command line: lifesim --soup count [-j threads]
+ *                    [-r seed]
+ *                    Runs count random 16x16 soups (from seed 1 by
+ *                    default) to stabilization with the given number of
+ *                    threads (default 0, one per core).
+ *                  - User chooses patterns to add to the initial state from
+ *                    a list of known patterns loaded from patterns.rle.
+ *                  - User can load any RLE or .cells pattern file.
+ *                  - User can enter a rule such as B3/S23.
  *                  - Once the simulation begins, the user specifies the
- *                    number of generations to advance at the prompt.
+ *                    generations per second and then the number of
+ *                    generations to advance at the prompt.
  *
- * Output:          - Displays a menu for setting the initial state.
+ * Output:          - In headless mode, displays the population, bounding
+ *                    box, period if a cycle was found, generations per
+ *                    second and nanoseconds per cell update after the
+ *                    last generation.
+ *                  - In soup mode, displays the number of each object
+ *                    found, most common first, and the soups per second
+ *                    in total and per thread.
+ *                  - In scale mode, displays the seconds per generation
+ *                    and speedup over 1 thread of bands and tiles for
+ *                    each thread count, and the tiles stolen.
+ *                  - Displays a menu for setting the initial state.
  *                  - Displays a list of known patterns.
  *                  - Displays the changes of the cells as an animation for
- *                    the specified number of generations.
+ *                    the specified number of generations, with the
+ *                    generations and frames per second when running on
+ *                    a separate thread.
  ************************************************************************/
 #include <iostream>
 #include <iomanip>
@@ -29,36 +84,83 @@
 #include <sstream>
 #include <stdexcept>
 #include <vector>
+#include <chrono>
+#include <cstring>
+#include <cstdlib>
+#include <algorithm>
+#include <thread>
 #include "Simulation.hpp"
-#include "Pattern.hpp"
+#include "InfiniteGrid.hpp"
+#include "PatternReader.hpp"
+#include "SoupSearch.hpp"
 #include "utility.hpp"
 
+// A pattern in the pattern file and where its header starts
+struct PatternEntry
+{
+    std::string name;
+    int width;
+    int height;
+    std::streampos offset;
+};
+
 // Function prototypes
 // Gets a set of coordinates from the user
 void getCoordinates(int &, int &);
-// Populates a vector with a set of hard-coded patterns
-void loadPatterns(std::vector<Pattern> &);
+// Adds the pattern starting at an offset of a file to the simulation
+void addPatternFile(Simulation &, const std::string &, std::streampos, int, int);
+// Populates a vector with the patterns in the pattern file
+void loadPatterns(std::vector<PatternEntry> &);
 // Prints the initial setup menu to the console
-void printMenu();
+void printMenu(const Simulation &);
 // Prints a list of available patterns to the user
-void printPatternMenu(std::vector<Pattern> &);
+void printPatternMenu(std::vector<PatternEntry> &);
+// Runs a pattern without rendering and prints statistics
+int runHeadless(int, char *[]);
+// Runs random soups and prints the census of the objects they leave
+int runSoupSearch(int, char *[]);
+// Times a large board with each thread count in bands and in tiles
+int runScaling(int, char *[]);
+// Gets the grid type with the specified command line name
+bool parseGridType(const std::string &, Simulation::GridType &);
+// Gets the width and height of a tile such as 1024x256
+bool parseTileSize(const std::string &, int &, int &);
 // Runs the simulation
 void runSimulation(Simulation &);
 // Gets the pattern index of the user selection
-int selectPattern(std::vector<Pattern> &);
+int selectPattern(std::vector<PatternEntry> &);
+// Gets a rule from the user and sets it on the simulation
+void selectRule(Simulation &);
 
 // Constants
 static const int GRID_WIDTH = 80;
 static const int GRID_HEIGHT = 22;
-static const int BUFFER_CELLS = 40;
+static const int CYCLE_HISTORY = 64;    // longest period shown while running
+static const char PATTERN_FILE[] = "patterns.rle";
 
-int main()
+int main(int argc, char *argv[])
 {
-    Simulation sim = Simulation(GRID_WIDTH, GRID_HEIGHT, BUFFER_CELLS);
+    if (argc > 1 && std::strcmp(argv[1], "--soup") == 0)
+    {
+        return runSoupSearch(argc, argv);
+    }
+    if (argc > 1 && std::strcmp(argv[1], "--scale") == 0)
+    {
+        return runScaling(argc, argv);
+    }
+    if (argc > 1)
+    {
+        return runHeadless(argc, argv);
+    }
+    
+    // The grid grows with the pattern, so no hidden buffer cells are needed
+    Simulation sim(GRID_WIDTH, GRID_HEIGHT, 0, Simulation::INFINITE_GRID);
+    sim.setCycleDetection(CYCLE_HISTORY);
     int selection = 0;              // for menu selection
     int index;                      // for pattern index
     int x, y;                       // for pattern coordinates
-    std::vector<Pattern> patterns;  // for predefined patterns
+    std::vector<PatternEntry> patterns; // for predefined patterns
+    std::string filename;           // for pattern file to load
     
     // Load patterns from file
     loadPatterns(patterns);
@@ -66,20 +168,20 @@ int main()
     // Display welcome message
     std::cout << "\nWelcome to David Rigert's Life Simulator.\n";
     std::cout << "This program is for CS162_400 in Winter 2015.\n";
-
+    
     // Menu loop
     do
     {
         std::cout << std::endl;
-        printMenu();
+        printMenu(sim);
         std::cout << "Enter your selection: ";
         std::cin >> selection;
-
+    
         clearInputBuffer();
-        
+    
         // Initialize coordinate variables to invalid selection
         x = y = -1;
-        
+    
         switch(selection)
         {
             case 1: 
@@ -92,20 +194,29 @@ int main()
                 index = selectPattern(patterns);
                 std::cout << std::endl;
                 getCoordinates(x, y);
-                
+    
                 // Add pattern to simulation
-                sim.addPattern(patterns[index], x, y);
+                addPatternFile(sim, PATTERN_FILE, patterns[index].offset, x, y);
                 break;
             case 3:
+                std::cout << "\nEnter the name of an RLE or .cells file: ";
+                std::getline(std::cin, filename);
+                getCoordinates(x, y);
+                addPatternFile(sim, filename, 0, x, y);
+                break;
+            case 4:
+                selectRule(sim);
+                break;
+            case 5:
                 runSimulation(sim);
                 // Intentional fall-through
-            case 4:
+            case 6:
                 std::cout << "\nThank you for playing.\n";
                 break;
             default:
                 std::cout << "\nInvalid selection.\n\n"; 
         }
-    } while (selection < 3 || selection > 4);
+    } while (selection < 5 || selection > 6);
     
     return 0;
 }
@@ -125,7 +236,7 @@ void getCoordinates(int &x, int &y)
     std::cin >> x;
     std::cout << "Y: ";
     std::cin >> y;
-
+    
     // Validate coordinates
     while (std::cin.peek() != '\n'
         || x < 0 || x > GRID_WIDTH 
@@ -138,109 +249,628 @@ void getCoordinates(int &x, int &y)
         std::cout << "Y: ";
         std::cin >> y;
     }
-
+    
     clearInputBuffer();
 }
 
 
 /********************************************************************
- *  Function:       void loadPatterns(std::vector<Pattern> &patterns)
- *  Description:    Loads the patterns from patterns.txt.
- *  Parameters:     patterns    Stores the patterns from patterns.txt.
- *  Preconditions:  patterns.txt is in same directory as executable.
- *  Postconditions: patterns vector contains list of Pattern objects
- *                  defined in patterns.txt file.
+ *  Function:       void addPatternFile(Simulation &sim,
+ *                      const std::string &filename, std::streampos offset,
+ *                      int x, int y)
+ *  Description:    Streams the pattern that starts at the specified
+ *                  offset of a file onto the simulation grid.
+ *  Parameters:     sim         Simulation to add the pattern to
+ *                  filename    RLE or .cells file to read
+ *                  offset      Offset of the pattern in the file
+ *                  x           X coordinate of the top-left corner
+ *                  y           Y coordinate of the top-left corner
+ *  Preconditions:  none
+ *  Postconditions: Pattern is on the grid, or an error is displayed
  *******************************************************************/
-void loadPatterns(std::vector<Pattern> &patterns)
+void addPatternFile(Simulation &sim, const std::string &filename,
+                    std::streampos offset, int x, int y)
 {
-    // Patterns taken from http://en.wikipedia.org/wiki/Conway's_Game_of_Life
-    std::ifstream dataIn;
-    dataIn.open("patterns.txt");
+    std::ifstream dataIn(filename.c_str(), std::ios::binary);
     if (dataIn.fail())
     {
-        std::cout << "Warning: pattern.txt file not found.\n";
+        std::cout << "Warning: " << filename << " file not found.\n";
         return;
     }
+    dataIn.seekg(offset);
     
-    std::string name;
-    std::string vals;
-    std::istringstream iss;
-    std::vector<std::vector<bool> > grid;
-    int width = 0;
-    int height = 0;
-    int val = 0;
-    
-    // Load patterns from file
-    while (!dataIn.eof())
+    try
     {
-        // Load name and first line of values
-        std::getline(dataIn, name);
-        std::getline(dataIn, vals);
-
-        // Create vector rows and store pattern
-        while (vals != "#" && !dataIn.eof())
-        {
-            iss.clear();
-            iss.str(vals);
-            std::vector<bool> row;
-            while (iss >> val)
-            {
-                row.push_back(static_cast<bool>(val));
-            }
-            grid.push_back(row);
-            std::getline(dataIn, vals);
-        }
+        PatternReader reader(dataIn);
+        sim.addPattern(reader, x, y);
+    }
+    catch (std::invalid_argument &e)
+    {
+        std::cout << e.what() << std::endl;
+    }
+}
 
-        // Store pattern in vector unless name is blank
-        if (!name.empty())
-        {
-            patterns.push_back(Pattern(name, grid));
-        }
-        grid.clear();
+/********************************************************************
+ *  Function:       void loadPatterns(std::vector<PatternEntry> &patterns)
+ *  Description:    Reads the name and size of each pattern in
+ *                  patterns.rle. The cells are skipped and only read
+ *                  when the pattern is added.
+ *  Parameters:     patterns    Stores the patterns from patterns.rle.
+ *  Preconditions:  patterns.rle is in same directory as executable.
+ *  Postconditions: patterns vector contains the name, size and offset
+ *                  of each pattern defined in patterns.rle.
+ *******************************************************************/
+void loadPatterns(std::vector<PatternEntry> &patterns)
+{
+    // Patterns taken from http://en.wikipedia.org/wiki/Conway's_Game_of_Life
+    std::ifstream dataIn(PATTERN_FILE, std::ios::binary);
+    if (dataIn.fail())
+    {
+        std::cout << "Warning: " << PATTERN_FILE << " file not found.\n";
+        return;
     }
     
-    dataIn.close();
+    // Load headers from file
+    while ((dataIn >> std::ws).peek() != EOF)
+    {
+        PatternEntry entry;
+        entry.offset = dataIn.tellg();
+        PatternReader reader(dataIn);
+        entry.name = reader.getName();
+        entry.width = reader.getWidth();
+        entry.height = reader.getHeight();
+        reader.skip();
+        patterns.push_back(entry);
+    }
 }
 
 /********************************************************************
- *  Function:       void printMenu()
+ *  Function:       void printMenu(const Simulation &sim)
  *  Description:    Prints the initial setup menu
- *  Parameters:     none
+ *  Parameters:     sim     Simulation to show the rule of
  *  Preconditions:  none
  *  Postconditions: Initial setup menu items are displayed on console.
  *******************************************************************/
-void printMenu()
+void printMenu(const Simulation &sim)
 {
     std::cout << " 1: Show current configuration\n"
               << " 2: Add a pattern\n"
-              << " 3: Run the simulation\n"
-              << " 4: Quit the program\n\n";
+              << " 3: Load a pattern file\n"
+              << " 4: Change the rule (current: " << sim.getRule().toString() << ")\n"
+              << " 5: Run the simulation\n"
+              << " 6: Quit the program\n\n";
 }
 
 /********************************************************************
- *  Function:       void printPatternMenu(std::vector<Pattern> &patterns)
- *  Description:    Prints the names of the Pattern objects in patterns
- *                  as a list of menu items.
- *  Parameters:     patterns    List of Pattern objects
+ *  Function:       void printPatternMenu(std::vector<PatternEntry> &patterns)
+ *  Description:    Prints the names of the patterns in patterns as a
+ *                  list of menu items.
+ *  Parameters:     patterns    List of patterns
  *  Preconditions:  none
  *  Postconditions: Initial setup menu items are displayed on console.
  *******************************************************************/
-void printPatternMenu(std::vector<Pattern> &patterns)
+void printPatternMenu(std::vector<PatternEntry> &patterns)
 {
     for (int i = 0; i < patterns.size(); i++)
     {
         std::cout << std::setw(2) << std::right << (i + 1) << ": "
-                  << patterns[i].getName() << " (Size: " 
-                  << patterns[i].getWidth() << " x " 
-                  << patterns[i].getHeight() << " cells)" << std::endl;
+                  << patterns[i].name << " (Size: " 
+                  << patterns[i].width << " x " 
+                  << patterns[i].height << " cells)" << std::endl;
     }
     std::cout << std::endl;
 }
 
+/********************************************************************
+ *  Function:       int runHeadless(int argc, char *argv[])
+ *  Description:    Parses the headless command line, loads the pattern
+ *                  centered on a new board and advances it with nothing
+ *                  drawn. Only the generations are timed. A cell update
+ *                  is one cell evaluated in one generation: the whole
+ *                  board for bounded types, and the active tiles for
+ *                  the infinite plane.
+ *  Parameters:     argc    Number of command line arguments
+ *                  argv    Command line arguments
+ *  Preconditions:  none
+ *  Postconditions: Returns 0 after printing the statistics, or 1 after
+ *                  printing an error
+ *******************************************************************/
+int runHeadless(int argc, char *argv[])
+{
+    std::string filename;           // pattern file to run
+    std::string name;               // pattern to find, or the first
+    int generations = 1000;         // generations to run
+    int size = 256;                 // width and height of the board
+    std::string typeName = "packed";
+    int threads = 1;
+    int history = 0;                // generations searched for cycles
+    std::string checkpointName;     // checkpoint written after the run
+    std::string statsName;          // CSV of statistics written after the run
+    int statsInterval = 128;        // generations per statistics entry
+    int tileWidth = 0;              // columns of a tile, 0 for whole rows
+    int tileHeight = 0;             // rows of a tile, 0 for bands
+    
+    // Parse command line
+    bool valid = argc >= 3 && std::strcmp(argv[1], "--headless") == 0;
+    if (valid)
+    {
+        filename = argv[2];
+    }
+    for (int i = 3; valid && i < argc; i += 2)
+    {
+        if (i + 1 >= argc || argv[i][0] != '-' || std::strlen(argv[i]) != 2)
+        {
+            valid = false;
+            break;
+        }
+        const char *value = argv[i + 1];
+        switch (argv[i][1])
+        {
+            case 'n':
+                name = value;
+                break;
+            case 'g':
+                generations = std::atoi(value);
+                break;
+            case 's':
+                size = std::atoi(value);
+                break;
+            case 't':
+                typeName = value;
+                break;
+            case 'j':
+                threads = std::atoi(value);
+                break;
+            case 'c':
+                history = std::atoi(value);
+                break;
+            case 'o':
+                checkpointName = value;
+                break;
+            case 'x':
+                statsName = value;
+                break;
+            case 'i':
+                statsInterval = std::atoi(value);
+                break;
+            case 'T':
+                valid = parseTileSize(value, tileWidth, tileHeight);
+                break;
+            default:
+                valid = false;
+        }
+    }
+    
+    Simulation::GridType type = Simulation::PACKED_GRID;
+    valid = valid && parseGridType(typeName, type);
+    
+    if (!valid || generations < 0 || size < 1 || threads < 0 || history < 0 ||
+        statsInterval < 1)
+    {
+        std::cerr << "Usage: " << argv[0] << " --headless file [-n name] "
+                  << "[-g generations] [-s size]\n"
+                  << "       [-t vector|packed|byte|infinite|state] [-j threads] "
+                  << "[-c history] [-o checkpoint] [-x stats]\n"
+                  << "       [-i interval] [-T tile]\n";
+        return 1;
+    }
+    
+    std::ifstream dataIn(filename.c_str(), std::ios::binary);
+    if (dataIn.fail())
+    {
+        std::cerr << "ERROR: " << filename << " file not found.\n";
+        return 1;
+    }
+    
+    // One buffer cell is the ring that is never evaluated
+    Simulation sim(size, size, 1, type);
+    std::string patternName;
+    typedef std::chrono::steady_clock clock;
+    double restoreSeconds = -1;     // time to restore a checkpoint
+    try
+    {
+        sim.setThreadCount(threads);
+        sim.setTileSize(tileWidth, tileHeight);
+        sim.setCycleDetection(history);
+        if (!statsName.empty())
+        {
+            sim.setStatsInterval(statsInterval);
+            sim.setStatsHistory(generations / statsInterval + 1);
+        }
+    
+        // A checkpoint replaces the board instead of adding a pattern
+        char magic[8] = { 0 };
+        dataIn.read(magic, sizeof(magic));
+        dataIn.clear();
+        dataIn.seekg(0);
+        if (std::memcmp(magic, "LIFESNAP", sizeof(magic)) == 0)
+        {
+            clock::time_point start = clock::now();
+            sim.restore(filename);
+            restoreSeconds = std::chrono::duration<double>(clock::now() - start).count();
+            patternName = filename;
+        }
+    
+        // Skip to the named pattern
+        while (patternName.empty())
+        {
+            PatternReader reader(dataIn);
+            if (name.empty() || reader.getName() == name)
+            {
+                patternName = reader.getName().empty() ? filename : reader.getName();
+                sim.addPattern(reader, (size - std::max(reader.getWidth(), 0)) / 2,
+                               (size - std::max(reader.getHeight(), 0)) / 2);
+                break;
+            }
+            reader.skip();
+        }
+    }
+    catch (std::invalid_argument &e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    
+    // Run without rendering
+    unsigned firstGeneration = sim.getGenerationCount();
+    double cellUpdates = 0;
+    clock::time_point start = clock::now();
+    for (int i = 0; i < generations && sim.getPeriod() == 0; i++)
+    {
+        sim.advanceGeneration();
+        if (type == Simulation::INFINITE_GRID)
+        {
+            cellUpdates += static_cast<double>(sim.getActiveTileCount())
+                         * InfiniteGrid::TILE_SIZE * InfiniteGrid::TILE_SIZE;
+        }
+    }
+    double seconds = std::chrono::duration<double>(clock::now() - start).count();
+    generations = sim.getGenerationCount() - firstGeneration;
+    if (sim.getGridType() != Simulation::INFINITE_GRID)
+    {
+        cellUpdates = static_cast<double>(sim.getWidth()) * sim.getHeight() * generations;
+    }
+    
+    std::cout << std::fixed << std::setprecision(2);
+    static const char *TYPE_NAMES[] = { "vector", "packed", "byte", "infinite", "state" };
+    std::cout << "Pattern: " << patternName << " on " << TYPE_NAMES[sim.getGridType()]
+              << " " << sim.getWidth() << " x " << sim.getHeight() << ", "
+              << sim.getThreadCount()
+              << (sim.getThreadCount() == 1 ? " thread\n" : " threads\n");
+    std::cout << "Generations: " << sim.getGenerationCount() << "\n";
+    std::cout << "Population: " << sim.getPopulation() << "\n";
+    int x, y, w, h;
+    if (sim.getBoundingBox(x, y, w, h))
+    {
+        std::cout << "Bounding box: " << w << " x " << h
+                  << " at " << x << "," << y << "\n";
+    }
+    else
+    {
+        std::cout << "Bounding box: empty\n";
+    }
+    if (sim.getPeriod() > 0)
+    {
+        std::cout << "Period: " << sim.getPeriod() << "\n";
+    }
+    std::cout << "Generations per second: "
+              << (seconds > 0 ? generations / seconds : 0) << "\n";
+    std::cout << "Nanoseconds per cell update: "
+              << (cellUpdates > 0 ? seconds * 1e9 / cellUpdates : 0) << std::endl;
+    if (restoreSeconds >= 0)
+    {
+        std::cout << "Restore seconds: " << restoreSeconds << std::endl;
+    }
+    
+    if (!statsName.empty())
+    {
+        std::ofstream statsOut(statsName.c_str());
+        sim.writeStatsCsv(statsOut);
+        if (statsOut.fail())
+        {
+            std::cerr << "ERROR: Could not write " << statsName << ".\n";
+            return 1;
+        }
+    }
+    
+    if (!checkpointName.empty())
+    {
+        try
+        {
+            clock::time_point start = clock::now();
+            sim.save(checkpointName, true);
+            std::cout << "Save seconds: "
+                      << std::chrono::duration<double>(clock::now() - start).count()
+                      << std::endl;
+        }
+        catch (std::invalid_argument &e)
+        {
+            std::cerr << e.what() << std::endl;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/********************************************************************
+ *  Function:       int runSoupSearch(int argc, char *argv[])
+ *  Description:    Parses the soup command line, runs the soups and
+ *                  prints the census. Soups that did not stabilize are
+ *                  reported separately and not counted in the census.
+ *  Parameters:     argc    Number of command line arguments
+ *                  argv    Command line arguments
+ *  Preconditions:  argv[1] is --soup
+ *  Postconditions: Returns 0 after printing the census, or 1 after
+ *                  printing an error
+ *******************************************************************/
+int runSoupSearch(int argc, char *argv[])
+{
+    int count = 0;                  // soups to run
+    int threads = 0;                // 0 for one per core
+    unsigned long long seed = 1;    // seed shared by all soups
+    
+    // Parse command line
+    bool valid = argc >= 3;
+    if (valid)
+    {
+        count = std::atoi(argv[2]);
+    }
+    for (int i = 3; valid && i < argc; i += 2)
+    {
+        if (i + 1 >= argc || argv[i][0] != '-' || std::strlen(argv[i]) != 2)
+        {
+            valid = false;
+            break;
+        }
+        const char *value = argv[i + 1];
+        switch (argv[i][1])
+        {
+            case 'j':
+                threads = std::atoi(value);
+                break;
+            case 'r':
+                seed = std::strtoull(value, NULL, 10);
+                break;
+            default:
+                valid = false;
+        }
+    }
+    
+    if (!valid || count < 1 || threads < 0)
+    {
+        std::cerr << "Usage: " << argv[0] << " --soup count [-j threads] "
+                  << "[-r seed]\n";
+        return 1;
+    }
+    
+    SoupSearch search(threads);
+    typedef std::chrono::steady_clock clock;
+    clock::time_point start = clock::now();
+    search.run(seed, 0, count);
+    double seconds = std::chrono::duration<double>(clock::now() - start).count();
+    
+    // Sort the census with the most common object first
+    std::vector<std::pair<long long, std::string> > census;
+    for (unsigned i = 0; i < search.getNames().size(); i++)
+    {
+        const std::string &name = search.getNames()[i];
+        census.push_back(std::make_pair(-search.getCount(name), name));
+    }
+    std::sort(census.begin(), census.end());
+    
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Soups: " << search.getSoupCount() << " from seed " << seed
+              << ", " << search.getThreadCount()
+              << (search.getThreadCount() == 1 ? " thread\n" : " threads\n");
+    for (unsigned i = 0; i < census.size() && census[i].first < 0; i++)
+    {
+        std::cout << std::setw(10) << -census[i].first << "  "
+                  << census[i].second << "\n";
+    }
+    std::cout << "Unstable soups: " << search.getUnstableCount() << "\n";
+    std::cout << "Generations: " << search.getGenerationCount() << "\n";
+    double rate = seconds > 0 ? search.getSoupCount() / seconds : 0;
+    std::cout << "Soups per second: " << rate << "\n";
+    std::cout << "Soups per second per thread: "
+              << rate / search.getThreadCount() << std::endl;
+    return 0;
+}
+
+/********************************************************************
+ *  Function:       int runScaling(int argc, char *argv[])
+ *  Description:    Parses the scale command line and times the same
+ *                  board with 1, 2, 4 and so on up to the given number
+ *                  of threads. Only the top quarter of the board is
+ *                  filled and PACKED_GRID runs in sparse mode, so with
+ *                  one band per thread the first thread has nearly all
+ *                  the work, while tiles are stolen by the idle threads.
+ *  Parameters:     argc    Number of command line arguments
+ *                  argv    Command line arguments
+ *  Preconditions:  argv[1] is --scale
+ *  Postconditions: Returns 0 after printing the timings, or 1 after
+ *                  printing an error
+ *******************************************************************/
+int runScaling(int argc, char *argv[])
+{
+    int size = 16384;               // width and height of the board
+    int generations = 10;           // generations timed per run
+    int maxThreads = 0;             // 0 for one per core
+    int tileWidth = 1024;           // columns of a tile
+    int tileHeight = 256;           // rows of a tile
+    std::string typeName = "packed";
+    
+    // Parse command line
+    bool valid = true;
+    int first = 2;
+    if (argc > 2 && argv[2][0] != '-')
+    {
+        size = std::atoi(argv[2]);
+        first = 3;
+    }
+    for (int i = first; valid && i < argc; i += 2)
+    {
+        if (i + 1 >= argc || argv[i][0] != '-' || std::strlen(argv[i]) != 2)
+        {
+            valid = false;
+            break;
+        }
+        const char *value = argv[i + 1];
+        switch (argv[i][1])
+        {
+            case 'g':
+                generations = std::atoi(value);
+                break;
+            case 'j':
+                maxThreads = std::atoi(value);
+                break;
+            case 'T':
+                valid = parseTileSize(value, tileWidth, tileHeight);
+                break;
+            case 't':
+                typeName = value;
+                break;
+            default:
+                valid = false;
+        }
+    }
+    Simulation::GridType type = Simulation::PACKED_GRID;
+    valid = valid && parseGridType(typeName, type) && type != Simulation::INFINITE_GRID;
+    
+    if (!valid || size < 4 || generations < 1 || maxThreads < 0 || tileHeight < 1)
+    {
+        std::cerr << "Usage: " << argv[0] << " --scale size [-g generations] "
+                  << "[-j threads] [-T tile]\n"
+                  << "       [-t vector|packed|byte|state]\n";
+        return 1;
+    }
+    if (maxThreads == 0)
+    {
+        maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    
+    // Random cells in the top quarter, the same for every run
+    vgrid cells(size / 4, std::vector<bool>(size));
+    std::srand(1);
+    for (int y = 0; y < size / 4; y++)
+    {
+        for (int x = 0; x < size; x++)
+        {
+            cells[y][x] = std::rand() % 3 == 0;
+        }
+    }
+    Pattern soup("soup", cells);
+    
+    std::cout << std::fixed << std::setprecision(4);
+    std::cout << "Board: " << size << " x " << size << ", tiles " << tileWidth
+              << " x " << tileHeight << ", " << generations << " generations\n";
+    std::cout << "Threads  Band s/gen  Speedup  Tile s/gen  Speedup  Steals/gen\n";
+    typedef std::chrono::steady_clock clock;
+    double baseline = 0;            // seconds per generation of 1 band
+    for (int threads = 1; ; threads = std::min(threads * 2, maxThreads))
+    {
+        double seconds[2];
+        long long steals = 0;
+        for (int tiled = 0; tiled < 2; tiled++)
+        {
+            Simulation sim(size, size, 1, type);
+            if (type == Simulation::PACKED_GRID)
+            {
+                sim.setSparse(true);
+            }
+            sim.setThreadCount(threads);
+            if (tiled)
+            {
+                sim.setTileSize(tileWidth, tileHeight);
+            }
+            sim.addPattern(soup, 0, 0);
+            // the first generation evaluates every sparse tile
+            sim.advanceGeneration();
+    
+            clock::time_point start = clock::now();
+            for (int gen = 0; gen < generations; gen++)
+            {
+                sim.advanceGeneration();
+                steals += sim.getStealCount();
+            }
+            seconds[tiled] = std::chrono::duration<double>(clock::now() - start).count()
+                           / generations;
+            if (threads == 1 && !tiled)
+            {
+                baseline = seconds[0];
+            }
+        }
+        std::cout << std::setw(7) << threads
+                  << std::setw(12) << seconds[0]
+                  << std::setw(9) << baseline / seconds[0]
+                  << std::setw(12) << seconds[1]
+                  << std::setw(9) << baseline / seconds[1]
+                  << std::setw(12) << steals / generations << std::endl;
+        if (threads == maxThreads)
+        {
+            break;
+        }
+    }
+    return 0;
+}
+
+/********************************************************************
+ *  Function:       bool parseGridType(const std::string &name,
+ *                                     Simulation::GridType &type)
+ *  Description:    Converts a grid type name from the command line.
+ *  Parameters:     name    vector, packed, byte, infinite or state
+ *                  type    Receives the grid type
+ *  Preconditions:  none
+ *  Postconditions: Returns false and leaves type unchanged if the
+ *                  name is unknown
+ *******************************************************************/
+bool parseGridType(const std::string &name, Simulation::GridType &type)
+{
+    static const char *NAMES[] = { "vector", "packed", "byte", "infinite", "state" };
+    for (int i = 0; i < 5; i++)
+    {
+        if (name == NAMES[i])
+        {
+            type = static_cast<Simulation::GridType>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+/********************************************************************
+ *  Function:       bool parseTileSize(const std::string &text,
+ *                                     int &width, int &height)
+ *  Description:    Converts a tile size such as 1024x256, or a single
+ *                  number for a square tile.
+ *  Parameters:     text    Tile size from the command line
+ *                  width   Receives the columns of a tile
+ *                  height  Receives the rows of a tile
+ *  Preconditions:  none
+ *  Postconditions: Returns false if the size is not positive numbers
+ *******************************************************************/
+bool parseTileSize(const std::string &text, int &width, int &height)
+{
+    size_t x = text.find('x');
+    std::string columns = text.substr(0, x);
+    std::string rows = x == std::string::npos ? columns : text.substr(x + 1);
+    if (columns.empty() || rows.empty()
+        || columns.find_first_not_of("0123456789") != std::string::npos
+        || rows.find_first_not_of("0123456789") != std::string::npos)
+    {
+        return false;
+    }
+    width = std::atoi(columns.c_str());
+    height = std::atoi(rows.c_str());
+    return width > 0 && height > 0;
+}
+
 /********************************************************************
  *  Function:       void runSimulation(Simulation &sim)
- *  Description:    Prompts the user for the number of generations and
- *                  runs the simulation based on the current configuration.
+ *  Description:    Prompts the user for the speed and the number of
+ *                  generations and runs the simulation based on the
+ *                  current configuration. A speed of -1 draws every
+ *                  generation; otherwise the generations are calculated
+ *                  on a separate thread at the chosen rate.
  *  Parameters:     sim     Simulation object to run
  *  Preconditions:  none
  *  Postconditions: User chose to exit the simulation
@@ -248,6 +878,16 @@ void printPatternMenu(std::vector<Pattern> &patterns)
 void runSimulation(Simulation &sim)
 {
     unsigned runForGens = 0; // for input of number of generations to run
+    int rate = -1;           // generations per second, 0 unlimited, -1 every one
+    
+    std::cout << "Enter generations per second, 0 to run as fast as possible, "
+              << "or -1 to draw every generation: ";
+    while (!(std::cin >> rate) || rate < -1)
+    {
+        clearInputBuffer();
+        std::cout << "Invalid speed. Try again: ";
+    }
+    clearInputBuffer();
     
     // Clear console
     clearWindow();
@@ -255,24 +895,31 @@ void runSimulation(Simulation &sim)
     sim.printCurrent();
     
     std::cout << "Enter the number of generations to run or any letter to quit: ";
-
+    
     while (std::cin >> runForGens)
     {
-        sim.runInConsole(runForGens);
+        if (rate < 0)
+        {
+            sim.runInConsole(runForGens);
+        }
+        else
+        {
+            sim.runDecoupled(runForGens, rate);
+        }
         std::cout << "Enter another number to advance or any letter to quit: ";
     }
 }
 
 
 /********************************************************************
- *  Function:       int selectPattern(std::vector<Pattern> &patterns)
+ *  Function:       int selectPattern(std::vector<PatternEntry> &patterns)
  *  Description:    Prompts the user to select a pattern and returns 
  *                  the index.
- *  Parameters:     patterns    Vector of Pattern objects to list
- *  Preconditions:  patterns has at least one Pattern object.
- *  Postconditions: Returns the index of the selected Pattern object.
+ *  Parameters:     patterns    Vector of patterns to list
+ *  Preconditions:  patterns has at least one pattern.
+ *  Postconditions: Returns the index of the selected pattern.
  *******************************************************************/
-int selectPattern(std::vector<Pattern> &patterns)
+int selectPattern(std::vector<PatternEntry> &patterns)
 {
     // Test for empty patterns vector
     if (patterns.size() < 1)
@@ -294,7 +941,36 @@ int selectPattern(std::vector<Pattern> &patterns)
     }
     
     clearInputBuffer();
-
+    
     // Return index value
     return selection - 1;
 }
+
+/********************************************************************
+ *  Function:       void selectRule(Simulation &sim)
+ *  Description:    Prompts the user for a rule in B/S notation until
+ *                  a valid rule is entered.
+ *  Parameters:     sim     Simulation to set the rule on
+ *  Preconditions:  none
+ *  Postconditions: Simulation uses the entered rule
+ *******************************************************************/
+void selectRule(Simulation &sim)
+{
+    std::string text;
+    std::cout << "\nExamples: B3/S23 (Life), B36/S23 (HighLife), "
+              << "B3678/S34678 (Day & Night)\n";
+    std::cout << "Enter a rule: ";
+    
+    while (std::getline(std::cin, text))
+    {
+        try
+        {
+            sim.setRule(Rule(text));
+            return;
+        }
+        catch (std::invalid_argument &)
+        {
+            std::cout << "Invalid rule. Try again: ";
+        }
+    }
+}
@@ -0,0 +1,43 @@
+/*************************************************************************
+ * Author:          David Rigert
+ * Date Created:    10/17/2026
+ * Last Modified:   10/17/2026
+ * Assignment:      Assignment 1
+ * Filename:        test.cpp
+ *
+ * Description:     Driver for running unit tests on all classes. Fails on
+ *                  assert if any of the tests fail.
+ ************************************************************************/
+#include "UnitTest.hpp"
+
+
+int main()
+{
+    std::cout << "Running Rule class unit tests..." << std::endl;
+    UnitTest::test_Rule();
+    std::cout << std::endl;
+    
+    std::cout << "Running Grid backend differential tests..." << std::endl;
+    UnitTest::test_Grid();
+    std::cout << std::endl;
+    
+    std::cout << "Running PatternReader class unit tests..." << std::endl;
+    UnitTest::test_PatternReader();
+    std::cout << std::endl;
+    
+    std::cout << "Running Renderer class unit tests..." << std::endl;
+    UnitTest::test_Renderer();
+    std::cout << std::endl;
+    
+    std::cout << "Running HashLife class unit tests..." << std::endl;
+    UnitTest::test_HashLife();
+    std::cout << std::endl;
+    
+    std::cout << "Running Simulation class unit tests..." << std::endl;
+    UnitTest::test_Simulation();
+    std::cout << std::endl;
+    
+    std::cout << "Running SoupSearch class unit tests..." << std::endl;
+    UnitTest::test_SoupSearch();
+    std::cout << std::endl;
+}
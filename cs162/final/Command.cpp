@@ -149,6 +149,7 @@ Command::CommandMap Command::populateCommands()
     result["listitems"] = Command(WORLD_ITEM_LIST, "List all items in world.", true);
     result["listrooms"] = Command(WORLD_ROOM_LIST, "List all rooms in world.", true);
     result["save"] = Command(WORLD_SAVE, "Save the current world.", true);
+    result["export"] = Command(WORLD_EXPORT, "Save the current world as text.", true);
     result["setend"] = Command(WORLD_SET_END, "Set current room to end point.", true);
     result["setintro"] = Command(WORLD_SET_INTRO, "Set introduction displayed at start.", true);
     result["setstart"] = Command(WORLD_SET_START, "Set current room to start point.", true);
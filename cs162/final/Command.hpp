@@ -62,6 +62,7 @@ public:
 		WORLD_ITEM_LIST,    // list all items in world
 		WORLD_ROOM_LIST,    // list all rooms in world
 		WORLD_SAVE,         // save the world to file
+		WORLD_EXPORT,       // save the world to text file
 		WORLD_SET_END,      // set end point
         WORLD_SET_INTRO,    // set the introduction text
 		WORLD_SET_START,    // set start point
@@ -194,10 +194,54 @@ void ConditionRoom::deserialize(std::istream &in)
     {
         Item *itm = global->findItem(itemId);
         if (itm)
-            items[itemId] = itm;
+            addItem(itm);
     }
 }
 
+/*************************************************************************
+ *  Function:       void ConditionRoom::readRecord(const WorldFile &file,
+ *                      const WorldFile::RoomRecord &rec)
+ *  Description:    Configures the Room object from a binary save record.
+ *  Parameters:     file    Mapped save file holding the record.
+ *                  rec     Record of this room.
+ *  Preconditions:  All items have been loaded.
+ *  Postconditions: Room is configured to data from the record.
+ ************************************************************************/
+void ConditionRoom::readRecord(const WorldFile &file,
+                               const WorldFile::RoomRecord &rec)
+{
+    Room::readRecord(file, rec);
+    required = global->findItem(rec.required);
+    enabled = (rec.flags & WorldFile::ENABLED) != 0;
+    northEnabled = (rec.flags & WorldFile::NORTH_ENABLED) != 0;
+    eastEnabled = (rec.flags & WorldFile::EAST_ENABLED) != 0;
+    southEnabled = (rec.flags & WorldFile::SOUTH_ENABLED) != 0;
+    westEnabled = (rec.flags & WorldFile::WEST_ENABLED) != 0;
+    altDescription = file.getString(rec.altDesc);
+}
+
+/*************************************************************************
+ *  Function:       WorldFile::RoomRecord &ConditionRoom::writeRecord(
+ *                      WorldFile &file)
+ *  Description:    Converts the room data into a binary save record.
+ *  Parameters:     file    Save file to add the record to.
+ *  Preconditions:  None.
+ *  Postconditions: Returns the new record.
+ ************************************************************************/
+WorldFile::RoomRecord &ConditionRoom::writeRecord(WorldFile &file)
+{
+    WorldFile::RoomRecord &rec = Room::writeRecord(file);
+    rec.type = WorldFile::CONDITION_ROOM;
+    rec.flags = (enabled ? WorldFile::ENABLED : 0)
+                | (northEnabled ? WorldFile::NORTH_ENABLED : 0)
+                | (eastEnabled ? WorldFile::EAST_ENABLED : 0)
+                | (southEnabled ? WorldFile::SOUTH_ENABLED : 0)
+                | (westEnabled ? WorldFile::WEST_ENABLED : 0);
+    rec.altDesc = file.addString(altDescription);
+    rec.required = required ? required->getId() : 0;
+    return rec;
+}
+
 /*************************************************************************
  *  Function:       Result ConditionRoom::setDescription(std::string desc)
  *  Description:    Prompts the user to set the room description.
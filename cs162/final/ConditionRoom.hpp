@@ -53,6 +53,12 @@ public:
     // deserializes the room data and configures the Room object
     virtual void deserialize(std::istream &);
     
+    // configures the Room object from a binary save record
+    virtual void readRecord(const WorldFile &, const WorldFile::RoomRecord &);
+    
+    // converts the room data into a binary save record
+    virtual WorldFile::RoomRecord &writeRecord(WorldFile &);
+    
     // prompts the user to set the room description
     virtual Result setDescription(std::string = "");
     
@@ -11,6 +11,8 @@
  ************************************************************************/
 #include "Item.hpp"
 
+#include <algorithm>    // transform
+#include <cctype>       // tolower
 #include <cstdlib>
 
 // starting value for Item ID
@@ -24,13 +26,22 @@ Item::Item(std::string name, int size, int weight)
     this->names.insert(name);
     this->size = size;
     this->weight = weight;
+    this->index = NULL;
 }
 Item::Item(unsigned id)
 {
     this->id = id;
+    this->index = NULL;
     nextId = id < nextId ? nextId : (id + 1);
 }
 
+// destructor
+Item::~Item()
+{
+    // remove names from the alias index
+    setIndex(NULL);
+}
+
 // adds a name to the list of acceptable names
 void Item::addName(std::string name)
 {
@@ -39,6 +50,9 @@ void Item::addName(std::string name)
         realName = name;
     // add to list of acceptable names
     names.insert(name);
+    // add to alias index if any
+    if (index)
+        (*index)[normalize(name)].insert(id);
 }
 
 // for configuring object with save data
@@ -75,6 +89,83 @@ bool Item::hasName(std::string name)
     return it != names.end();
 }
 
+// moves all names of the item to the specified alias index
+void Item::setIndex(NameIndex *index)
+{
+    // remove names from the old index
+    if (this->index)
+        removeFromIndex(*this->index);
+    
+    // add names to the new index
+    this->index = index;
+    if (index)
+        addToIndex(*index);
+}
+
+// adds all names of the item to an alias index
+void Item::addToIndex(NameIndex &index) const
+{
+    std::set<std::string>::const_iterator it = names.begin();
+    while (it != names.end())
+    {
+        index[normalize(*it)].insert(id);
+        ++it;
+    }
+}
+
+// removes all names of the item from an alias index, dropping keys no
+// item has left
+void Item::removeFromIndex(NameIndex &index) const
+{
+    // nothing to remove once the world has cleared the index
+    if (index.empty())
+        return;
+    
+    std::set<std::string>::const_iterator it = names.begin();
+    while (it != names.end())
+    {
+        NameIndex::iterator entry = index.find(normalize(*it));
+        if (entry != index.end())
+        {
+            entry->second.erase(id);
+            if (entry->second.empty())
+                index.erase(entry);
+        }
+        ++it;
+    }
+}
+
+// converts a name to lowercase, because commands are read in lowercase
+std::string Item::normalize(std::string name)
+{
+    std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+    return name;
+}
+
+// for configuring object with a binary save record
+void Item::readRecord(const WorldFile &file, const WorldFile::ItemRecord &rec)
+{
+    realName = file.getString(rec.realName);
+    for (uint32_t i = 0; i < rec.nameCount; i++)
+        addName(file.getString(file.getName(rec.firstName + i)));
+    desc = file.getString(rec.desc);
+    size = rec.size;
+    weight = rec.weight;
+}
+
+// for converting object to a binary save record
+void Item::writeRecord(WorldFile &file) const
+{
+    WorldFile::ItemRecord &rec = file.addItemRecord();
+    rec.id = id;
+    rec.realName = file.addString(realName);
+    rec.desc = file.addString(desc);
+    rec.firstName = file.addNames(names);
+    rec.nameCount = names.size();
+    rec.size = size;
+    rec.weight = weight;
+}
+
 // overloaded stream insertion for serialization
 std::ostream &operator<<(std::ostream &out, Item &itm)
 {
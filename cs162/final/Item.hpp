@@ -15,11 +15,18 @@
 #include <map>
 #include <string>
 #include <set>
+#include <unordered_map>
 #include <iostream>
 
+#include "WorldFile.hpp"
+
 class Item
 {
     friend class UnitTest;      // for unit testing
+public:
+    // maps each normalized name to the IDs of the items that have it
+    typedef std::unordered_map<std::string, std::set<unsigned> > NameIndex;
+    
 private:
     unsigned id;                // unique ID of item
     std::string realName;       // actual name of item
@@ -27,18 +34,25 @@ private:
     std::string desc;           // description of item
     int size;                   // size of item
     int weight;                 // weight of item
+    NameIndex *index;           // alias index to keep names in or NULL
     
     static unsigned nextId;     // ID of next Item object to be created
     
+    // not copyable, because a copy would share the entries in the index
+    Item(const Item &);
+    Item &operator=(const Item &);
+    
 public:
     Item()
     {
         id = nextId++;
         size = 0;
         weight = 0;
+        index = NULL;
     }
     Item(unsigned);
     Item(std::string, int size = 0, int weight = 0);
+    ~Item();
 
     void addName(std::string);
     std::string getDesc() const { return desc; }
@@ -49,9 +63,25 @@ public:
     bool hasName(std::string);
     void setDesc(std::string desc)   { this->desc = desc; }
     
+    // moves all names of the item to the specified alias index
+    void setIndex(NameIndex *);
+    
+    // adds or removes all names of the item in a local alias index
+    void addToIndex(NameIndex &) const;
+    void removeFromIndex(NameIndex &) const;
+    
+    // converts a name to the form used as a key in the alias index
+    static std::string normalize(std::string);
+    
     // for configuring object with save data
     void deserialize(std::istream &);
     
+    // for configuring object with a binary save record
+    void readRecord(const WorldFile &, const WorldFile::ItemRecord &);
+    
+    // for converting object to a binary save record
+    void writeRecord(WorldFile &) const;
+    
     // for converting object to save data
     friend std::ostream &operator<<(std::ostream &, Item &);
 };
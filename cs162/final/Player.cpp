@@ -50,6 +50,7 @@ Result Player::dropItem(unsigned id)
         if (res.type == Result::SUCCESS)
         {
             res.message = "You dropped your " + it->second->getName() + ".";
+            it->second->removeFromIndex(itemNames);
             inventory.erase(it);
         }
     }
@@ -61,6 +62,15 @@ Result Player::dropItem(unsigned id)
     return res;
 }
 
+// find the ID of the first item carried with the specified name or 0
+unsigned Player::findItemId(std::string name)
+{
+    Item::NameIndex::iterator it = itemNames.find(Item::normalize(name));
+    if (it != itemNames.end())
+        return *it->second.begin();
+    return 0;
+}
+
 // get the combined weight of all items in inventory
 int Player::getInventoryWeight()
 {
@@ -125,6 +135,7 @@ Result Player::take(unsigned id)
             if (res.type == Result::SUCCESS)
             {
                 inventory[id] = itm;
+                itm->addToIndex(itemNames);
                 res.message = "You picked up the " + itm->getName() + ".";
             }
         }
@@ -207,11 +218,44 @@ void Player::deserialize(std::istream &in)
     while (iss >> id)
     {
         Item *itm = global->findItem(id);
-        if (itm)
+        if (itm && inventory.count(id) == 0)
+        {
             inventory[id] = itm;
+            itm->addToIndex(itemNames);
+        }
     }
 }
 
+// for configuring object with a binary save record
+void Player::readRecord(const WorldFile &file, const WorldFile::PlayerRecord &rec)
+{
+    weightLimit = rec.weightLimit;
+    maxSize = rec.maxSize;
+    maxQuantity = rec.maxQuantity;
+    
+    // get player inventory
+    for (uint32_t i = 0; i < rec.itemCount; i++)
+    {
+        unsigned id = file.getItemId(rec.firstItem + i);
+        Item *itm = global->findItem(id);
+        if (itm && inventory.count(id) == 0)
+        {
+            inventory[id] = itm;
+            itm->addToIndex(itemNames);
+        }
+    }
+}
+
+// for converting object to a binary save record
+void Player::writeRecord(WorldFile &file, WorldFile::PlayerRecord &rec)
+{
+    rec.weightLimit = weightLimit;
+    rec.maxSize = maxSize;
+    rec.maxQuantity = maxQuantity;
+    rec.firstItem = file.addItems(inventory);
+    rec.itemCount = inventory.size();
+}
+
 std::ostream &operator<<(std::ostream &out, Player &plr)
 {
     // output weight limit
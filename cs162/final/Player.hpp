@@ -18,10 +18,11 @@
 
 #include "Result.hpp"
 #include "Direction.hpp"
+#include "Item.hpp"
+#include "WorldFile.hpp"
 
 class World;
 class Room;
-class Item;
 
 class Player
 {
@@ -29,6 +30,7 @@ class Player
 private:
     Room *location;             // current location of player
     std::map<unsigned, Item *> inventory;   // items carried by player
+    Item::NameIndex itemNames;  // IDs of the items carried with each name
     unsigned weightLimit;       // maximum weight the player can carry
     unsigned maxSize;           // maximum size of item the player can pick up
     unsigned maxQuantity;       // maximum number of items the player can carry
@@ -45,6 +47,9 @@ public:
     // drops the item with the specified ID in inventory
     Result dropItem(unsigned);
     
+    // finds the ID of the first item carried with the specified name or 0
+    unsigned findItemId(std::string);
+    
     // gets a pointer to the current location of the player
     Room *getCurrentRoom() const    { return location; }
     
@@ -81,6 +86,12 @@ public:
     // view all items in inventory
     void viewItems();
 
+    // for configuring object with a binary save record
+    void readRecord(const WorldFile &, const WorldFile::PlayerRecord &);
+    
+    // for converting object to a binary save record
+    void writeRecord(WorldFile &, WorldFile::PlayerRecord &);
+    
     // for converting object to save data
     friend std::ostream &operator<<(std::ostream &, Player &);
 };
@@ -0,0 +1,81 @@
+/*************************************************************************
+ * Author:                 David Rigert
+ * Date Created:           10/17/2026
+ * Last Modification Date: 10/17/2026
+ * Course:                 CS162_400
+ * Assignment:             Final Project
+ * Filename:               Pool.cpp
+ *
+ * Overview:
+ *     Implementation for the Pool class.
+ ************************************************************************/
+#include "Pool.hpp"
+
+#include <new>      // operator new
+
+// alignment of every slot, enough for any member type
+static const size_t SLOT_ALIGN = 16;
+
+// constructor - slot size is rounded up for alignment
+Pool::Pool(size_t size)
+{
+    slotSize = (size + SLOT_ALIGN - 1) / SLOT_ALIGN * SLOT_ALIGN;
+    nextChunkSlots = FIRST_CHUNK_SLOTS;
+    next = NULL;
+    end = NULL;
+}
+
+// destructor - frees all chunks
+Pool::~Pool()
+{
+    for (size_t i = 0; i < chunks.size(); i++)
+        ::operator delete(chunks[i]);
+}
+
+/*************************************************************************
+ *  Function:       void *Pool::allocate()
+ *  Description:    Gets memory for one object. Reuses a released slot if
+ *                  any, otherwise cuts the next slot from the last chunk,
+ *                  allocating a chunk twice the size of the last one when
+ *                  it is full.
+ *  Preconditions:  None.
+ *  Postconditions: Returns memory of getSlotSize() bytes.
+ ************************************************************************/
+void *Pool::allocate()
+{
+    // reuse a released slot
+    if (!freeSlots.empty())
+    {
+        void *slot = freeSlots.back();
+        freeSlots.pop_back();
+        return slot;
+    }
+    
+    // allocate a new chunk if the last one is full
+    if (next == end)
+    {
+        char *chunk = static_cast<char *>(::operator new(nextChunkSlots * slotSize));
+        chunks.push_back(chunk);
+        next = chunk;
+        end = chunk + nextChunkSlots * slotSize;
+        if (nextChunkSlots < MAX_CHUNK_SLOTS)
+            nextChunkSlots *= 2;
+    }
+    
+    void *slot = next;
+    next += slotSize;
+    return slot;
+}
+
+/*************************************************************************
+ *  Function:       void Pool::release(void *slot)
+ *  Description:    Returns the memory of a destroyed object for reuse.
+ *  Parameters:     slot    Memory returned by allocate.
+ *  Preconditions:  The object in the slot has been destroyed.
+ *  Postconditions: The slot will be returned by a later allocate.
+ ************************************************************************/
+void Pool::release(void *slot)
+{
+    if (slot)
+        freeSlots.push_back(slot);
+}
@@ -0,0 +1,65 @@
+/*************************************************************************
+ * Author:                 David Rigert
+ * Date Created:           10/17/2026
+ * Last Modification Date: 10/17/2026
+ * Course:                 CS162_400
+ * Assignment:             Final Project
+ * Filename:               Pool.hpp
+ *
+ * Overview:
+ *     Represents a pool of fixed-size memory slots for objects of one
+ *     size class. Slots are cut from large chunks that double in size as
+ *     the pool grows, so a million objects take 15 heap allocations, and
+ *     objects created one after another sit next to each other in memory.
+ *     Chunks are never moved, so a pointer to an object stays valid until
+ *     the object is released. Released slots are reused before new ones
+ *     are cut.
+ *
+ *     Objects are created with placement new in a slot from allocate,
+ *     and must be destroyed by calling their destructor before the slot
+ *     is released or the pool is destroyed.
+ ************************************************************************/
+#ifndef POOL_HPP
+#define POOL_HPP
+
+#include <cstddef>
+#include <vector>
+
+class Pool
+{
+    friend class UnitTest;      // for unit testing
+private:
+    size_t slotSize;            // bytes in each slot
+    size_t nextChunkSlots;      // number of slots in the next chunk
+    std::vector<char *> chunks; // chunks of slots in order of allocation
+    char *next;                 // next unused slot in the last chunk
+    char *end;                  // end of the last chunk
+    std::vector<void *> freeSlots;  // released slots to reuse
+
+    static const size_t FIRST_CHUNK_SLOTS = 64; // slots in the first chunk
+    static const size_t MAX_CHUNK_SLOTS = 1048576;  // most slots in a chunk
+
+    // not copyable, because a copy would free the chunks twice
+    Pool(const Pool &);
+    Pool &operator=(const Pool &);
+
+public:
+    // constructor - slot size is rounded up for alignment
+    Pool(size_t);
+
+    // destructor - frees all chunks
+    ~Pool();
+
+    // gets memory for one object
+    void *allocate();
+
+    // returns the memory of a destroyed object for reuse
+    void release(void *);
+
+    // gets the number of chunks allocated from the heap
+    size_t getChunkCount() const    { return chunks.size(); }
+
+    // gets the number of bytes in each slot
+    size_t getSlotSize() const      { return slotSize; }
+};
+#endif  // end of POOL_HPP definition
@@ -61,8 +61,9 @@ Result Room::addItem(Item *itm)
         return res;
     }
     
-    // add item to Room if execution reaches here
+    // add item and its names to Room if execution reaches here
     items[itm->getId()] = itm;
+    itm->addToIndex(itemNames);
     return res;
 }
 
@@ -190,6 +191,24 @@ Item *Room::findItem(unsigned id)
     return pItem;
 }
 
+/*************************************************************************
+ *  Function:       unsigned Room::findItemId(std::string name)
+ *  Description:    Finds the ID of the first item in the room that matches
+ *                  the specified name or 0 if none found. Only items in
+ *                  the room are considered, so the lookup takes constant
+ *                  time on average however large the world is.
+ *  Parameters:     name    Name of item to find.
+ *  Preconditions:  None.
+ *  Postconditions: Returns the ID of the item if found.
+ ************************************************************************/
+unsigned Room::findItemId(std::string name)
+{
+    Item::NameIndex::iterator it = itemNames.find(Item::normalize(name));
+    if (it != itemNames.end())
+        return *it->second.begin();
+    return 0;
+}
+
 /*************************************************************************
  *  Function:       Room *Room::getExit(Direction d) const
  *  Description:    Gets a pointer to the exit in the specified direction.
@@ -227,6 +246,7 @@ Result Room::removeItem(unsigned id)
     it = items.find(id);
     if (it != items.end())
     {
+        it->second->removeFromIndex(itemNames);
         items.erase(it);
     }
     else
@@ -556,7 +576,7 @@ void Room::deserialize(std::istream &in)
     {
         Item *itm = global->findItem(itemId);
         if (itm)
-            items[itemId] = itm;
+            addItem(itm);
     }
 }
 
@@ -586,6 +606,60 @@ void Room::deserializeExits(std::istream &in)
     setExit(WEST, target);
 }
 
+/*************************************************************************
+ *  Function:       void Room::readRecord(const WorldFile &file,
+ *                      const WorldFile::RoomRecord &rec)
+ *  Description:    Configures the Room object from a binary save record.
+ *  Parameters:     file    Mapped save file holding the record.
+ *                  rec     Record of this room.
+ *  Preconditions:  All items have been loaded.
+ *  Postconditions: Room is configured to data from the record.
+ ************************************************************************/
+void Room::readRecord(const WorldFile &file, const WorldFile::RoomRecord &rec)
+{
+    // get room ID
+    id = rec.id;
+    nextId = (nextId > id ? nextId : id + 1);
+    
+    // get room description
+    description = file.getString(rec.desc);
+    
+    // get room items
+    for (uint32_t i = 0; i < rec.itemCount; i++)
+    {
+        Item *itm = global->findItem(file.getItemId(rec.firstItem + i));
+        if (itm)
+            addItem(itm);
+    }
+}
+
+/*************************************************************************
+ *  Function:       WorldFile::RoomRecord &Room::writeRecord(WorldFile &file)
+ *  Description:    Converts the room data, exits and items into a binary
+ *                  save record.
+ *  Parameters:     file    Save file to add the record to.
+ *  Preconditions:  None.
+ *  Postconditions: Returns the new record so derived classes can add to it.
+ ************************************************************************/
+WorldFile::RoomRecord &Room::writeRecord(WorldFile &file)
+{
+    WorldFile::RoomRecord &rec = file.addRoomRecord();
+    rec.id = id;
+    rec.type = WorldFile::BASIC_ROOM;
+    rec.desc = file.addString(description);
+    
+    // output exit room IDs or 0 for NULL
+    rec.exits[NORTH] = north ? north->id : 0;
+    rec.exits[EAST] = east ? east->id : 0;
+    rec.exits[SOUTH] = south ? south->id : 0;
+    rec.exits[WEST] = west ? west->id : 0;
+    
+    // output item IDs
+    rec.firstItem = file.addItems(items);
+    rec.itemCount = items.size();
+    return rec;
+}
+
 /*************************************************************************
  *  Function:       void Room::serializeExits(std::ostream &out)
  *  Description:    Serializes the exits into the save file format.
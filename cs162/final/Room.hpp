@@ -17,8 +17,9 @@
 
 #include "Result.hpp"
 #include "Direction.hpp"
+#include "Item.hpp"
+#include "WorldFile.hpp"
 
-class Item;
 class World;
 
 class Room
@@ -28,6 +29,7 @@ protected:
     int id;                     // holds a unique room ID
     std::string description;    // description of the room
     std::map<unsigned, Item *> items;   // list of items in room
+    Item::NameIndex itemNames;  // IDs of the items in room with each name
     Room *north;                // pointer to north
     Room *south;                // pointer to south
     Room *east;                 // pointer to east
@@ -58,6 +60,9 @@ public:
     // finds an item with the specified id in the room or returns NULL
     Item *findItem(unsigned);
     
+    // finds the ID of the first item in the room with the specified name or 0
+    unsigned findItemId(std::string);
+    
     // gets a pointer to the specified direction
     virtual Room *getExit(Direction d) const;
     
@@ -85,6 +90,12 @@ public:
     // deserializes the room data and configures the Room object
     virtual void deserialize(std::istream &);
     
+    // configures the Room object from a binary save record
+    virtual void readRecord(const WorldFile &, const WorldFile::RoomRecord &);
+    
+    // converts the room data into a binary save record
+    virtual WorldFile::RoomRecord &writeRecord(WorldFile &);
+    
     // prompts the user to set the room description
     virtual Result setDescription(std::string = "");
     
@@ -158,10 +158,47 @@ void SwitchRoom::deserialize(std::istream &in)
     {
         Item *itm = global->findItem(itemId);
         if (itm)
-            items[itemId] = itm;
+            addItem(itm);
     }
 }
 
+/*************************************************************************
+ *  Function:       void SwitchRoom::readRecord(const WorldFile &file,
+ *                      const WorldFile::RoomRecord &rec)
+ *  Description:    Configures the Room object from a binary save record.
+ *  Parameters:     file    Mapped save file holding the record.
+ *                  rec     Record of this room.
+ *  Preconditions:  All items have been loaded.
+ *  Postconditions: Room is configured to data from the record.
+ ************************************************************************/
+void SwitchRoom::readRecord(const WorldFile &file,
+                            const WorldFile::RoomRecord &rec)
+{
+    Room::readRecord(file, rec);
+    required = global->findItem(rec.required);
+    enabled = (rec.flags & WorldFile::ENABLED) != 0;
+    altDescription = file.getString(rec.altDesc);
+}
+
+/*************************************************************************
+ *  Function:       WorldFile::RoomRecord &SwitchRoom::writeRecord(
+ *                      WorldFile &file)
+ *  Description:    Converts the room data into a binary save record.
+ *  Parameters:     file    Save file to add the record to.
+ *  Preconditions:  None.
+ *  Postconditions: Returns the new record.
+ ************************************************************************/
+WorldFile::RoomRecord &SwitchRoom::writeRecord(WorldFile &file)
+{
+    WorldFile::RoomRecord &rec = Room::writeRecord(file);
+    rec.type = WorldFile::SWITCH_ROOM;
+    rec.flags = enabled ? WorldFile::ENABLED : 0;
+    rec.altDesc = file.addString(altDescription);
+    rec.required = required ? required->getId() : 0;
+    rec.target = target ? target->getRoomId() : 0;
+    return rec;
+}
+
 /*************************************************************************
  *  Function:       Result SwitchRoom::setDescription(std::string desc)
  *  Description:    Prompts the user to set the room description.
@@ -14,6 +14,13 @@
 #include "Item.hpp"
 #include "BasicRoom.hpp"
 #include "Player.hpp"
+#include "World.hpp"
+#include "WorldFile.hpp"
+#include "Pool.hpp"
+
+#include <fstream>
+#include <sstream>
+#include <cstdio>   // remove
 
 void UnitTest::test_Room()
 {
@@ -59,6 +66,7 @@ void UnitTest::test_Room()
     std::cout << "Testing addItem...";
     // happy path
     Item *pItem = new Item();
+    pItem->addName("Widget");
     pItem->setDesc("You see an item here.");
     r = pRoom1->addItem(pItem);
     assert(r.type == Result::SUCCESS);
@@ -82,6 +90,17 @@ void UnitTest::test_Room()
     assert(!pItem2);
     std::cout << "Passed!" << std::endl;
     
+    /**************************************************************************
+     * findItemId function
+     *************************************************************************/
+    std::cout << "Testing findItemId...";
+    // happy path, names are matched in lowercase
+    assert(pRoom1->findItemId("widget") == pItem->getId());
+    // not found or in another room
+    assert(pRoom1->findItemId("gadget") == 0);
+    assert(pRoom2->findItemId("widget") == 0);
+    std::cout << "Passed!" << std::endl;
+    
     /**************************************************************************
      * useItem(Item *) function
      *************************************************************************/
@@ -162,6 +181,7 @@ void UnitTest::test_Room()
     r = pRoom1->removeItem(pItem->getId());
     assert(r.type == Result::SUCCESS);
     assert(pRoom1->items.size() == 0);
+    assert(pRoom1->itemNames.size() == 0);
     std::cout << "Passed!" << std::endl;
     
     /**************************************************************************
@@ -295,6 +315,32 @@ void UnitTest::test_Item()
     itm.setDesc("foo");
     assert(itm.desc == "foo");
     std::cout << "Passed!" << std::endl;
+    
+    /**************************************************************************
+     * setIndex function
+     *************************************************************************/
+    std::cout << "Testing setIndex function...";
+    Item::NameIndex index;
+    itm.setIndex(&index);
+    assert(index.size() == 2);
+    assert(index["main"].count(itm.id) == 1);
+    // names added later are indexed, normalized to lowercase
+    itm.addName("Shiny Key");
+    assert(index.count("shiny key") == 1);
+    assert(index.count("Shiny Key") == 0);
+    {
+        Item *pItm = new Item("MAIN");
+        pItm->setIndex(&index);
+        assert(index["main"].size() == 2);
+        // destructor removes only the names of its own item
+        delete pItm;
+        assert(index["main"].size() == 1);
+        assert(*index["main"].begin() == itm.id);
+    }
+    // removing from the index drops keys no item has left
+    itm.setIndex(NULL);
+    assert(index.empty());
+    std::cout << "Passed!" << std::endl;
 }
 
 void UnitTest::test_Command()
@@ -561,6 +607,8 @@ void UnitTest::test_Player()
     assert(r.type == Result::SUCCESS);
     assert(p2.inventory.size() == 1);
     assert(rm->items.size() == 5);
+    assert(p2.findItemId("key1") == itm1->getId());
+    assert(rm->findItemId("key1") == 0);
     // boundary (weight and size limit)
     r = p2.take(itm2->getId());
     assert(r.type == Result::SUCCESS);
@@ -610,6 +658,8 @@ void UnitTest::test_Player()
     assert(r.type == Result::SUCCESS);
     assert(p2.inventory.size() == 2);
     assert(rm->items.size() == 4);
+    assert(p2.findItemId("key1") == 0);
+    assert(rm->findItemId("key1") == itm1->getId());
     std::cout << "Passed!" << std::endl;
     
     /**************************************************************************
@@ -663,4 +713,277 @@ void UnitTest::test_Player()
     delete rm2;
     itm1 = itm2 = itm3 = itm4 = itm5 = itm6 = NULL;
     rm = rm2 = NULL;
-}
\ No newline at end of file
+}
+
+// reads a whole file into a string
+static std::string readFile(const char *filename)
+{
+    std::ifstream in(filename, std::ios::binary);
+    std::ostringstream oss;
+    oss << in.rdbuf();
+    return oss.str();
+}
+
+void UnitTest::test_WorldFile()
+{
+    Result r;
+    std::ifstream ifs;
+    std::ofstream ofs;
+    
+    /**************************************************************************
+     * addString function
+     *************************************************************************/
+    std::cout << "Testing addString...";
+    WorldFile file;
+    assert(file.addString("") == 0);
+    assert(file.addString("key") == 1);
+    assert(file.addString("chest") == 2);
+    assert(file.addString("key") == 1);
+    assert(file.charList == "keychest");
+    std::cout << "Passed!" << std::endl;
+    
+    /**************************************************************************
+     * saveBinary and loadBinary functions
+     *************************************************************************/
+    std::cout << "Testing saveBinary and loadBinary...";
+    // load the text world and save it in both formats
+    World *text = new World();
+    ifs.open("game.dat");
+    r = text->load(ifs);
+    ifs.close();
+    assert(r.type == Result::SUCCESS);
+    ofs.open("test_text.dat");
+    text->save(ofs);
+    ofs.close();
+    ofs.open("test_world.bin", std::ios::out | std::ios::binary);
+    r = text->saveBinary(ofs);
+    ofs.close();
+    assert(r.type == Result::SUCCESS);
+    assert(WorldFile::isWorldFile("test_world.bin"));
+    assert(!WorldFile::isWorldFile("test_text.dat"));
+    delete text;
+    
+    // the binary world exports to the same text
+    World *binary = new World();
+    r = binary->loadBinary("test_world.bin");
+    assert(r.type == Result::SUCCESS);
+    ofs.open("test_binary.dat");
+    binary->save(ofs);
+    ofs.close();
+    delete binary;
+    assert(readFile("test_text.dat") == readFile("test_binary.dat"));
+    std::cout << "Passed!" << std::endl;
+    
+    /**************************************************************************
+     * load function
+     *************************************************************************/
+    std::cout << "Testing load with links before rooms...";
+    // move the exits and targets ahead of the rooms they link
+    std::string data = readFile("test_text.dat");
+    size_t roomPos = data.find("##ROOMS##");
+    size_t linkPos = data.find("##ROOMEXITS##");
+    size_t introPos = data.find("##INTRO##");
+    std::string links = data.substr(linkPos, introPos - linkPos);
+    data.erase(linkPos, introPos - linkPos);
+    data.insert(roomPos, links);
+    ofs.open("test_binary.dat");
+    ofs << data;
+    ofs.close();
+    
+    // the links wait for their rooms, so the world is unchanged
+    World *reordered = new World();
+    ifs.open("test_binary.dat");
+    r = reordered->load(ifs);
+    ifs.close();
+    assert(r.type == Result::SUCCESS);
+    assert(r.message.find("rooms/s") != std::string::npos);
+    assert(r.message.find("items/s") != std::string::npos);
+    ofs.open("test_binary.dat");
+    reordered->save(ofs);
+    ofs.close();
+    delete reordered;
+    assert(readFile("test_text.dat") == readFile("test_binary.dat"));
+    
+    // missing end marker
+    data = readFile("test_text.dat");
+    data.erase(data.find("##ENDROOMS##"));
+    ofs.open("test_binary.dat");
+    ofs << data;
+    ofs.close();
+    reordered = new World();
+    ifs.open("test_binary.dat");
+    r = reordered->load(ifs);
+    ifs.close();
+    assert(r.type == Result::FAILURE);
+    delete reordered;
+    std::cout << "Passed!" << std::endl;
+
+    /**************************************************************************
+     * clear function
+     *************************************************************************/
+    std::cout << "Testing clear after a failed load...";
+    // item 1 is already taken, so the binary load stops partway
+    World *partial = new World();
+    assert(partial->storeItem(partial->createItem(1)));
+    r = partial->loadBinary("test_world.bin");
+    assert(r.type == Result::FAILURE);
+    partial->clear();
+    assert(partial->roomCount == 0 && partial->itemCount == 0);
+    assert(partial->findItem(1) == NULL && partial->start == NULL);
+
+    // the text file then loads into the empty world
+    ifs.open("game.dat");
+    r = partial->load(ifs);
+    ifs.close();
+    assert(r.type == Result::SUCCESS);
+    ofs.open("test_binary.dat");
+    partial->save(ofs);
+    ofs.close();
+    delete partial;
+    assert(readFile("test_text.dat") == readFile("test_binary.dat"));
+    std::cout << "Passed!" << std::endl;
+
+    /**************************************************************************
+     * open function
+     *************************************************************************/
+    std::cout << "Testing open...";
+    // happy path
+    r = file.open("test_world.bin");
+    assert(r.type == Result::SUCCESS);
+    assert(file.getHeader().version == WorldFile::VERSION);
+    file.close();
+    // not found
+    r = file.open("missing.bin");
+    assert(r.type == Result::FAILURE);
+    // text file
+    r = file.open("test_text.dat");
+    assert(r.type == Result::FAILURE);
+    // truncated file
+    data = readFile("test_world.bin");
+    ofs.open("test_world.bin", std::ios::out | std::ios::binary);
+    ofs.write(data.data(), data.size() - 1);
+    ofs.close();
+    r = file.open("test_world.bin");
+    assert(r.type == Result::FAILURE);
+    // list outside of its section
+    WorldFile::Header *hdr = reinterpret_cast<WorldFile::Header *>(&data[0]);
+    hdr->player.firstItem = hdr->refCount;
+    hdr->player.itemCount = 1;
+    ofs.open("test_world.bin", std::ios::out | std::ios::binary);
+    ofs.write(data.data(), data.size());
+    ofs.close();
+    r = file.open("test_world.bin");
+    assert(r.type == Result::FAILURE);
+    std::cout << "Passed!" << std::endl;
+    
+    std::remove("test_text.dat");
+    std::remove("test_binary.dat");
+    std::remove("test_world.bin");
+}
+
+void UnitTest::test_Pool()
+{
+    /**************************************************************************
+     * constructor
+     *************************************************************************/
+    std::cout << "Testing constructor...";
+    Pool pool(20);
+    assert(pool.getSlotSize() == 32);
+    assert(pool.getChunkCount() == 0);
+    std::cout << "Passed!" << std::endl;
+    
+    /**************************************************************************
+     * allocate function
+     *************************************************************************/
+    std::cout << "Testing allocate...";
+    // slots of the first chunk are next to each other
+    char *first = static_cast<char *>(pool.allocate());
+    char *second = static_cast<char *>(pool.allocate());
+    assert(second == first + pool.getSlotSize());
+    assert(pool.getChunkCount() == 1);
+    // each new chunk holds twice as many slots as the last one
+    for (size_t i = 2; i < Pool::FIRST_CHUNK_SLOTS; i++)
+        pool.allocate();
+    assert(pool.getChunkCount() == 1);
+    pool.allocate();
+    assert(pool.getChunkCount() == 2);
+    for (size_t i = 1; i < 2 * Pool::FIRST_CHUNK_SLOTS; i++)
+        pool.allocate();
+    assert(pool.getChunkCount() == 2);
+    pool.allocate();
+    assert(pool.getChunkCount() == 3);
+    std::cout << "Passed!" << std::endl;
+    
+    /**************************************************************************
+     * release function
+     *************************************************************************/
+    std::cout << "Testing release...";
+    pool.release(second);
+    pool.release(NULL);
+    assert(pool.allocate() == second);
+    assert(pool.getChunkCount() == 3);
+    std::cout << "Passed!" << std::endl;
+    
+    /**************************************************************************
+     * World storage
+     *************************************************************************/
+    std::cout << "Testing World storage...";
+    World *w = new World();
+    assert(w->roomCount == 0 && w->itemCount == 0);
+    assert(w->findRoom(0) == NULL);
+    
+    // rooms are found by ID and can only be stored once
+    Room *rm = w->createRoom(WorldFile::SWITCH_ROOM);
+    assert(w->storeRoom(rm));
+    assert(!w->storeRoom(rm));
+    assert(w->findRoom(rm->getRoomId()) == rm);
+    assert(w->roomCount == 1);
+    
+    // items are found by ID and name, and IDs must be unique
+    Item *itm = w->createItem(5);
+    itm->addName("Lamp");
+    assert(w->storeItem(itm));
+    assert(w->findItem(5) == itm);
+    assert(w->findItemId("lamp") == 5);
+    assert(w->itemCount == 1);
+    Item *dup = w->createItem(5);
+    assert(!w->storeItem(dup));
+    w->destroyItem(dup);
+    assert(w->findItem(5) == itm);
+    assert(w->itemCount == 1);
+    
+    // destroyed objects are removed and their memory is reused
+    unsigned id = rm->getRoomId();
+    w->destroyRoom(rm);
+    assert(w->findRoom(id) == NULL);
+    assert(w->roomCount == 0);
+    assert(w->createRoom(WorldFile::BASIC_ROOM) == rm);
+    w->destroyRoom(rm);
+    w->destroyItem(itm);
+    assert(w->findItem(5) == NULL);
+    assert(w->findItemId("lamp") == 0);
+    delete w;
+    std::cout << "Passed!" << std::endl;
+
+    /**************************************************************************
+     * addItem function
+     *************************************************************************/
+    std::cout << "Testing addItem with an ID that cannot be stored..." << std::endl;
+    w = new World();
+    rm = w->createRoom(WorldFile::BASIC_ROOM);
+    assert(w->storeRoom(rm));
+    w->user = Player(w, rm);
+    unsigned savedId = Item::nextId;
+    Item::nextId = World::MAX_ID;
+    std::istringstream input("Lamp\n\nA lamp.\n1\n1\n");
+    std::streambuf *cinBuf = std::cin.rdbuf(input.rdbuf());
+    Result res = w->addItem();
+    std::cin.rdbuf(cinBuf);
+    Item::nextId = savedId;
+    assert(res.type == Result::FAILURE);
+    assert(w->itemCount == 0);
+    assert(rm->getItems().empty());
+    assert(w->findItemId("lamp") == 0);
+    delete w;
+    std::cout << "Passed!" << std::endl;
+}
@@ -29,6 +29,12 @@ public:
     
     // unit tests for the Player class
     static void test_Player();
+    
+    // unit tests for the WorldFile class and saving and loading World
+    static void test_WorldFile();
+    
+    // unit tests for the Pool class and World object storage
+    static void test_Pool();
 };
 
 #endif
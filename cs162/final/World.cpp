@@ -11,7 +11,11 @@
  ************************************************************************/
 #include "World.hpp"
 
-#include <cstdlib>  // atoi
+#include <algorithm>    // max
+#include <chrono>   // steady_clock
+#include <cstdlib>  // atoi, strtoul
+#include <cstring>  // memset
+#include <new>      // placement new
 #include <queue>
 #include <set>
 #include <typeinfo> // typeid
@@ -23,8 +27,28 @@
 #include "BasicRoom.hpp"
 #include "ConditionRoom.hpp"
 #include "SwitchRoom.hpp"
+#include "WorldFile.hpp"
 
 const char* DEFAULT_FILENAME = "game.dat";
+const char* DEFAULT_BINARY_FILENAME = "game.bin";
+
+// reads the unsigned number at the start of a string
+static unsigned readId(const char *str)
+{
+    return static_cast<unsigned>(std::strtoul(str, NULL, 10));
+}
+
+// reads up to 'count' unsigned numbers separated by spaces, setting
+// any missing ones to 0
+static void readIds(const char *str, unsigned *ids, int count)
+{
+    char *end = NULL;   // first character after the number
+    for (int i = 0; i < count; i++)
+    {
+        ids[i] = static_cast<unsigned>(std::strtoul(str, &end, 10));
+        str = end;
+    }
+}
 
 /******************************************************
 *             Private Member Functions                *
@@ -58,7 +82,8 @@ Result World::addExit(Direction d, std::string arg)
     // create BasicRoom if arg is blank
     if (arg.empty())
     {
-        rm = new BasicRoom(this);
+        rm = createRoom(WorldFile::BASIC_ROOM);
+        storeRoom(rm);
         res = user.getCurrentRoom()->setExit(d, rm);
         res.message = "Created new basic room.";
     }
@@ -73,14 +98,16 @@ Result World::addExit(Direction d, std::string arg)
             // check for ConditionRoom argument
             if (arg == "cond")
             {
-                rm = new ConditionRoom(this);
+                rm = createRoom(WorldFile::CONDITION_ROOM);
+                storeRoom(rm);
                 res = user.getCurrentRoom()->setExit(d, rm);
                 res.message = "Created new condition room.";
             }
             // check for SwitchRoom argument
             else if (arg == "switch")
             {
-                rm = new SwitchRoom(this);
+                rm = createRoom(WorldFile::SWITCH_ROOM);
+                storeRoom(rm);
                 res = user.getCurrentRoom()->setExit(d, rm);
                 res.message = "Created new switch room.";
             }
@@ -96,8 +123,8 @@ Result World::addExit(Direction d, std::string arg)
         else
         {
             // see if id is a valid room ID
-            std::map<unsigned, Room *>::iterator it = rooms.find(id);
-            if (it == rooms.end())
+            rm = findRoom(id);
+            if (!rm)
             {
                 res.type = Result::FAILURE;
                 oss << "Cannot find a room with an ID of " << id << ".";
@@ -105,7 +132,6 @@ Result World::addExit(Direction d, std::string arg)
             }
             else
             {
-                rm = it->second;
                 res = user.getCurrentRoom()->setExit(d, rm);
                 // only update message if operation was successful
                 if (res.type == Result::SUCCESS)
@@ -117,9 +143,6 @@ Result World::addExit(Direction d, std::string arg)
         }
         
     }
-    // add to master room list if successful
-    if (res.type == Result::SUCCESS)
-        rooms[rm->getRoomId()] = rm;
     
     return res;
 }
@@ -129,7 +152,8 @@ Result World::addExit(Direction d, std::string arg)
  *  Description:    Prompts the user for Item info and adds an item to 
  *                  the current room.
  *  Preconditions:  None.
- *  Postconditions: Item is created and is on floor of current room.
+ *  Postconditions: Item is created and is on floor of current room, or
+ *                  FAILURE is returned if the item cannot be stored.
  ************************************************************************/
 Result World::addItem()
 {
@@ -193,8 +217,8 @@ Result World::addItem()
     std::cout << std::endl;
     
     // create new Item object
-    pItem = new Item(names.front(), static_cast<unsigned>(size), 
-                     static_cast<unsigned>(weight));
+    pItem = new (itemPool.allocate()) Item(names.front(), 
+                     static_cast<unsigned>(size), static_cast<unsigned>(weight));
     names.pop();
     // add any aliases
     while (names.size() > 0)
@@ -206,8 +230,15 @@ Result World::addItem()
     // add description
     pItem->setDesc(input);
     
-    // add to master items list
-    items[pItem->getId()] = pItem;
+    // add to master items list and alias index; the ID can run past
+    // MAX_ID or collide with a loaded item
+    if (!storeItem(pItem))
+    {
+        destroyItem(pItem);
+        res.type = Result::FAILURE;
+        res.message = "Cannot create any more items.";
+        return res;
+    }
     
     // add to current room
     res = user.getCurrentRoom()->addItem(pItem);
@@ -216,6 +247,159 @@ Result World::addItem()
     return res;
 }
 
+/*************************************************************************
+ *  Function:       Item *World::createItem(unsigned id)
+ *  Description:    Creates an item with the specified ID in the item pool.
+ *  Parameters:     id      ID of the new item.
+ *  Preconditions:  None.
+ *  Postconditions: Returns the new item, which must be stored with
+ *                  storeItem or destroyed with destroyItem.
+ ************************************************************************/
+Item *World::createItem(unsigned id)
+{
+    return new (itemPool.allocate()) Item(id);
+}
+
+/*************************************************************************
+ *  Function:       Room *World::createRoom(WorldFile::RoomType type)
+ *  Description:    Creates a room of the specified type in the room pool.
+ *  Parameters:     type    Type of the new room.
+ *  Preconditions:  None.
+ *  Postconditions: Returns the new room, which must be stored with
+ *                  storeRoom or destroyed with destroyRoom.
+ ************************************************************************/
+Room *World::createRoom(WorldFile::RoomType type)
+{
+    void *slot = roomPool.allocate();   // memory for any room type
+    if (type == WorldFile::SWITCH_ROOM)
+        return new (slot) SwitchRoom(this);
+    else if (type == WorldFile::CONDITION_ROOM)
+        return new (slot) ConditionRoom(this);
+    else
+        return new (slot) BasicRoom(this);
+}
+
+/*************************************************************************
+ *  Function:       bool World::storeItem(Item *itm)
+ *  Description:    Adds an item to the master list at the index of its ID
+ *                  and to the alias index.
+ *  Parameters:     itm     Item created by createItem.
+ *  Preconditions:  None.
+ *  Postconditions: Returns false if the ID is 0, too large, or already
+ *                  used by another item.
+ ************************************************************************/
+bool World::storeItem(Item *itm)
+{
+    unsigned id = itm->getId();
+    if (id == 0 || id >= MAX_ID || (id < items.size() && items[id]))
+        return false;
+    
+    if (id >= items.size())
+        items.resize(id + 1, NULL);
+    items[id] = itm;
+    itemCount++;
+    itm->setIndex(&itemNames);
+    return true;
+}
+
+/*************************************************************************
+ *  Function:       bool World::storeRoom(Room *rm)
+ *  Description:    Adds a room to the master list at the index of its ID.
+ *  Parameters:     rm      Room created by createRoom.
+ *  Preconditions:  None.
+ *  Postconditions: Returns false if the ID is 0, too large, or already
+ *                  used by another room.
+ ************************************************************************/
+bool World::storeRoom(Room *rm)
+{
+    unsigned id = rm->getRoomId();
+    if (id == 0 || id >= MAX_ID || (id < rooms.size() && rooms[id]))
+        return false;
+    
+    if (id >= rooms.size())
+        rooms.resize(id + 1, NULL);
+    rooms[id] = rm;
+    roomCount++;
+    return true;
+}
+
+/*************************************************************************
+ *  Function:       void World::destroyItem(Item *itm)
+ *  Description:    Removes an item from the master list if it is stored
+ *                  there, destroys it and returns its memory to the pool.
+ *  Parameters:     itm     Item created by createItem.
+ *  Preconditions:  No room or player holds the item.
+ *  Postconditions: itm is no longer valid.
+ ************************************************************************/
+void World::destroyItem(Item *itm)
+{
+    unsigned id = itm->getId();
+    if (id < items.size() && items[id] == itm)
+    {
+        items[id] = NULL;
+        itemCount--;
+    }
+    itm->~Item();
+    itemPool.release(itm);
+}
+
+/*************************************************************************
+ *  Function:       void World::destroyRoom(Room *rm)
+ *  Description:    Removes a room from the master list if it is stored
+ *                  there, destroys it and returns its memory to the pool.
+ *  Parameters:     rm      Room created by createRoom.
+ *  Preconditions:  No other room links to the room.
+ *  Postconditions: rm is no longer valid.
+ ************************************************************************/
+void World::destroyRoom(Room *rm)
+{
+    unsigned id = rm->getRoomId();
+    if (id < rooms.size() && rooms[id] == rm)
+    {
+        rooms[id] = NULL;
+        roomCount--;
+    }
+    rm->~Room();
+    roomPool.release(rm);
+}
+
+/*************************************************************************
+ *  Function:       void World::clear()
+ *  Description:    Destroys all rooms and items and resets the world
+ *                  settings and player, so that a load that failed
+ *                  partway leaves nothing behind.
+ *  Preconditions:  None.
+ *  Postconditions: World is empty, as if newly constructed.
+ ************************************************************************/
+void World::clear()
+{
+    // the player drops its items before they are destroyed
+    user = Player(this);
+    
+    // drop the alias index at once instead of one name at a time
+    itemNames.clear();
+    
+    // destroy all rooms, then all items; the pools reuse the memory
+    for (unsigned id = 0; id < rooms.size(); id++)
+    {
+        if (rooms[id])
+            destroyRoom(rooms[id]);
+    }
+    for (unsigned id = 0; id < items.size(); id++)
+    {
+        if (items[id])
+            destroyItem(items[id]);
+    }
+    rooms.assign(1, static_cast<Room *>(NULL));
+    items.assign(1, static_cast<Item *>(NULL));
+    std::vector<Fixup>().swap(pending);
+    
+    timeLimit = 600;
+    start = NULL;
+    endpoint = NULL;
+    intro.clear();
+}
+
 /*************************************************************************
  *  Function:       Result World::cleanUpOrphans()
  *  Description:    Cleans up any items not in inventory or a room, and
@@ -231,15 +415,16 @@ Result World::cleanUpOrphans()
     std::set<Room *> roomLinks;     // stores all pointers to all rooms
     
     // go through all rooms and save all pointers to rooms
-    std::map<unsigned, Room *>::iterator roomIt = rooms.begin();
-    while (roomIt != rooms.end())
+    for (unsigned id = 0; id < rooms.size(); id++)
     {
         // save all room links
-        roomLinks.insert(roomIt->second->getExit(NORTH));
-        roomLinks.insert(roomIt->second->getExit(EAST));
-        roomLinks.insert(roomIt->second->getExit(SOUTH));
-        roomLinks.insert(roomIt->second->getExit(WEST));
-        ++roomIt;
+        if (rooms[id])
+        {
+            roomLinks.insert(rooms[id]->getExit(NORTH));
+            roomLinks.insert(rooms[id]->getExit(EAST));
+            roomLinks.insert(rooms[id]->getExit(SOUTH));
+            roomLinks.insert(rooms[id]->getExit(WEST));
+        }
     }
     
     // add player location and start/end points
@@ -277,37 +462,25 @@ Result World::cleanUpOrphans()
     }
     
     // remove any unlinked items from master list
-    itemIt = items.begin();
     std::cout << "Removing item IDs: ";
-    while (itemIt != items.end())
+    for (unsigned id = 0; id < items.size(); id++)
     {
-        if (itemLinks.count(itemIt->second) == 0)
+        if (items[id] && itemLinks.count(items[id]) == 0)
         {
-            std::cout << itemIt->second->getId() << " ";
-            delete itemIt->second;
-            items.erase(itemIt++);
-        }
-        else
-        {
-            ++itemIt;
+            std::cout << id << " ";
+            destroyItem(items[id]);
         }
     }
     std::cout << std::endl;
 
     // remove any unlinked rooms from master list
-    roomIt = rooms.begin();
     std::cout << "Removing room IDs: ";
-    while (roomIt != rooms.end())
+    for (unsigned id = 0; id < rooms.size(); id++)
     {
-        if (roomLinks.count(roomIt->second) == 0)
+        if (rooms[id] && roomLinks.count(rooms[id]) == 0)
         {
-            std::cout << roomIt->second->getRoomId() << " ";
-            delete roomIt->second;
-            rooms.erase(roomIt++);
-        }
-        else
-        {
-            ++roomIt;
+            std::cout << id << " ";
+            destroyRoom(rooms[id]);
         }
     }
     std::cout << std::endl;
@@ -331,8 +504,8 @@ Result World::deleteItem(unsigned id)
     std::ostringstream oss;         // message builder
     
     // check if item exists
-    std::map<unsigned, Item *>::iterator itemIt = items.find(id);
-    if (itemIt == items.end())
+    Item *itm = findItem(id);
+    if (!itm)
     {
         res.type = Result::FAILURE;
         res.message = "Item not found.";
@@ -340,20 +513,19 @@ Result World::deleteItem(unsigned id)
     }
     
     // remove any link to item in player inventory
-    user.dropItem(itemIt->second->getId());
+    user.dropItem(id);
     
     // remove any links to item in rooms
-    std::map<unsigned, Room *>::iterator roomIt = rooms.begin();
-    while (roomIt != rooms.end())
+    for (unsigned rmId = 0; rmId < rooms.size(); rmId++)
     {
-        roomIt->second->removeItem(itemIt->second->getId());
-        roomIt++;
+        if (rooms[rmId])
+            rooms[rmId]->removeItem(id);
     }
     
-    // delete Item object and remove from items
-    name = itemIt->second->getName();
-    delete itemIt->second;
-    items.erase(itemIt);
+    // delete Item object, which removes its names from the alias index,
+    // and remove from items
+    name = itm->getName();
+    destroyItem(itm);
     
     oss << "Permanently deleted item ID " << id << " (" << name << ").";
     res.message = oss.str();
@@ -374,14 +546,14 @@ Result World::deleteRoom(unsigned id)
     std::ostringstream oss;         // message builder
     
     // check if room ID exists
-    std::map<unsigned, Room *>::iterator it = rooms.find(id);
-    if (it == rooms.end())
+    Room *rm = findRoom(id);
+    if (!rm)
     {
         res.type = Result::FAILURE;
         res.message = "Room not found.";
         return res;
     }
-    else if (it->second == user.getCurrentRoom())
+    else if (rm == user.getCurrentRoom())
     {
         res.type = Result::FAILURE;
         res.message = "You cannot delete the room you are in.";
@@ -389,25 +561,25 @@ Result World::deleteRoom(unsigned id)
     }
     
     // remove any exits to room from other rooms
-    std::map<unsigned, Room *>::iterator it2 = rooms.begin();
-    while (it2 != rooms.end())
+    for (unsigned id2 = 0; id2 < rooms.size(); id2++)
     {
+        Room *rm2 = rooms[id2];
+        if (!rm2)
+            continue;
         // we could just remove exits from the room being deleted,
         // but I'll do it this way just in case I add one-way links
-        if (it2->second->getExit(NORTH) == it->second)
-            it2->second->clearExit(NORTH);
-        if (it2->second->getExit(EAST) == it->second)
-            it2->second->clearExit(EAST);
-        if (it2->second->getExit(SOUTH) == it->second)
-            it2->second->clearExit(SOUTH);
-        if (it2->second->getExit(WEST) == it->second)
-            it2->second->clearExit(WEST);
-        it2++;
+        if (rm2->getExit(NORTH) == rm)
+            rm2->clearExit(NORTH);
+        if (rm2->getExit(EAST) == rm)
+            rm2->clearExit(EAST);
+        if (rm2->getExit(SOUTH) == rm)
+            rm2->clearExit(SOUTH);
+        if (rm2->getExit(WEST) == rm)
+            rm2->clearExit(WEST);
     }
     
     // delete Room object and remove from rooms
-    delete it->second;
-    rooms.erase(it);
+    destroyRoom(rm);
     oss << "Permanently deleted room ID " << id << ".";
     res.message = oss.str();
     
@@ -417,24 +589,62 @@ Result World::deleteRoom(unsigned id)
 /*************************************************************************
  *  Function:       unsigned World::findItemId(std::string name)
  *  Description:    Finds the ID of the first item that matches 
- *                  the specified name or 0 if none found.
+ *                  the specified name or 0 if none found. Looks the
+ *                  name up in the alias index, so it takes constant
+ *                  time on average however many items there are.
  *  Parameters:     name    Name of item to find.
  *  Preconditions:  None.
  *  Postconditions: Returns the ID of the item if found.
  ************************************************************************/
 unsigned World::findItemId(std::string name)
 {
-    std::map<unsigned, Item *>::iterator it = items.begin();
+    // IDs are kept in order, so the first one has the lowest ID
+    Item::NameIndex::iterator it = itemNames.find(Item::normalize(name));
+    if (it != itemNames.end())
+        return *it->second.begin();
+    
+    return 0;
+}
 
-    // check every Item in items
-    while (it != items.end())
+/*************************************************************************
+ *  Function:       Result World::finishLoad(Result res, double seconds)
+ *  Description:    Resolves the links that were read before their rooms,
+ *                  frees the tables used while loading and adds the load
+ *                  throughput to the message of a successful load.
+ *  Parameters:     res     Result of reading the save file.
+ *                  seconds Time taken to read the save file.
+ *  Preconditions:  A save file was just read.
+ *  Postconditions: Returns the Result of the load.
+ ************************************************************************/
+Result World::finishLoad(Result res, double seconds)
+{
+    std::ostringstream oss;         // message builder
+    
+    // resolve links to rooms that were loaded after the link was read
+    for (size_t i = 0; i < pending.size(); i++)
     {
-        if (it->second->hasName(name))
-            return it->second->getId();
-        it++;
+        Room *from = findRoom(pending[i].from);
+        Room *to = findRoom(pending[i].to);
+        if (from && to && pending[i].slot == TARGET_SLOT)
+            from->setTarget(to);
+        else if (from && to)
+            from->setExit(static_cast<Direction>(pending[i].slot), to);
     }
     
-    return 0;
+    // free the pending links, which are only needed while loading
+    std::vector<Fixup>().swap(pending);
+    
+    if (res.type == Result::SUCCESS)
+    {
+        if (seconds <= 0)
+            seconds = 1e-6;
+        oss << "Loaded " << roomCount << " rooms and " << itemCount
+            << " items in " << seconds << " s ("
+            << static_cast<long long>(roomCount / seconds) << " rooms/s, "
+            << static_cast<long long>(itemCount / seconds) << " items/s).";
+        res.message = oss.str();
+    }
+    return res;
 }
 
 /*************************************************************************
@@ -446,9 +656,8 @@ unsigned World::findItemId(std::string name)
  ************************************************************************/
 Item *World::findItem(unsigned id)
 {
-    std::map<unsigned, Item *>::iterator it = items.find(id);
-    if (it != items.end())
-        return it->second;
+    if (id < items.size())
+        return items[id];
     else
         return NULL;
 }
@@ -464,13 +673,42 @@ Item *World::findItem(unsigned id)
  ************************************************************************/
 Room *World::findRoom(unsigned id)
 {
-    std::map<unsigned, Room *>::iterator it = rooms.find(id);
-    if (it != rooms.end())
-        return it->second;
+    if (id < rooms.size())
+        return rooms[id];
     else
         return NULL;
 }
 
+/*************************************************************************
+ *  Function:       void World::linkLoaded(unsigned from, int slot,
+ *                                         unsigned to)
+ *  Description:    Sets an exit or switch target of a loaded room, or
+ *                  saves it in the fixup table if either room has not
+ *                  been loaded yet.
+ *  Parameters:     from    ID of room holding the link.
+ *                  slot    Direction of exit or TARGET_SLOT.
+ *                  to      ID of room the link leads to or 0 for none.
+ *  Preconditions:  A save file is being read.
+ *  Postconditions: Link is set or will be set by finishLoad.
+ ************************************************************************/
+void World::linkLoaded(unsigned from, int slot, unsigned to)
+{
+    if (to == 0)
+        return;
+    
+    Room *rmFrom = findRoom(from);
+    Room *rmTo = findRoom(to);
+    if (!rmFrom || !rmTo)
+    {
+        Fixup f = {from, slot, to};
+        pending.push_back(f);
+    }
+    else if (slot == TARGET_SLOT)
+        rmFrom->setTarget(rmTo);
+    else
+        rmFrom->setExit(static_cast<Direction>(slot), rmTo);
+}
+
 /*************************************************************************
  *  Function:       void World::listItems()
  *  Description:    Lists all of the items in the game world with IDs.
@@ -479,20 +717,19 @@ Room *World::findRoom(unsigned id)
  ************************************************************************/
 void World::listItems()
 {
-    std::map<unsigned, Item *>::iterator it = items.begin();
-
-    if (items.size() > 0)
+    if (itemCount > 0)
         std::cout << "The world currently contains the following items:" << std::endl;
     else
         std::cout << "The world does not have any items yet." << std::endl;
     
     // list all items and the ID number
-    while (it != items.end())
+    for (unsigned id = 0; id < items.size(); id++)
     {
-        std::cout << "  " << it->second->getName() 
-                  << " (ID: " << it->second->getId() << ", " 
-                  << "weight: " << it->second->getWeight() << ")" << std::endl;
-        it++;
+        if (!items[id])
+            continue;
+        std::cout << "  " << items[id]->getName() 
+                  << " (ID: " << id << ", " 
+                  << "weight: " << items[id]->getWeight() << ")" << std::endl;
     }
 }
 
@@ -504,27 +741,237 @@ void World::listItems()
  ************************************************************************/
 void World::listRooms()
 {
-    std::map<unsigned, Room *>::iterator it = rooms.begin();
-
-    if (rooms.size() > 0)
+    if (roomCount > 0)
         std::cout << "The world currently contains the following rooms:" << std::endl;
     else
         std::cout << "The world does not have any rooms yet." << std::endl;
     
     // list the ID and type of all rooms
-    while (it != rooms.end())
+    for (unsigned id = 0; id < rooms.size(); id++)
     {
-        std::cout << "  " << it->second->getRoomId() << " (";
-        if (typeid(*it->second) == typeid(BasicRoom))
+        if (!rooms[id])
+            continue;
+        std::cout << "  " << id << " (";
+        if (typeid(*rooms[id]) == typeid(BasicRoom))
             std::cout << "basic)" << std::endl;
-        else if (typeid(*it->second) == typeid(ConditionRoom))
+        else if (typeid(*rooms[id]) == typeid(ConditionRoom))
             std::cout << "condition)" << std::endl;
-        else if (typeid(*it->second) == typeid(SwitchRoom))
+        else if (typeid(*rooms[id]) == typeid(SwitchRoom))
             std::cout << "switch)" << std::endl;
-        it++;
     }
 }
 
+/*************************************************************************
+ *  Function:       Result World::readBinary(const WorldFile &file)
+ *  Description:    Reads the items, rooms, world settings and player of
+ *                  a mapped binary save file. Records are read in place,
+ *                  and rooms are linked as soon as both ends exist.
+ *  Parameters:     file    Mapped binary save file.
+ *  Preconditions:  World is empty.
+ *  Postconditions: World is initialized to data from the file.
+ ************************************************************************/
+Result World::readBinary(const WorldFile &file)
+{
+    Result res(Result::FAILURE);
+    const WorldFile::Header &hdr = file.getHeader();
+    
+    // load items first
+    const WorldFile::ItemRecord *itemRecs = file.getItems();
+    for (uint32_t i = 0; i < hdr.itemCount; i++)
+    {
+        Item *itm = createItem(itemRecs[i].id); // new Item object
+        itm->readRecord(file, itemRecs[i]);     // configure object
+        if (!storeItem(itm))
+        {
+            destroyItem(itm);
+            res.message = "Invalid save data.";
+            return res;
+        }
+    }
+    
+    // load rooms next
+    const WorldFile::RoomRecord *roomRecs = file.getRooms();
+    for (uint32_t i = 0; i < hdr.roomCount; i++)
+    {
+        Room *rm = NULL;
+        if (roomRecs[i].type == WorldFile::BASIC_ROOM
+            || roomRecs[i].type == WorldFile::SWITCH_ROOM
+            || roomRecs[i].type == WorldFile::CONDITION_ROOM)
+            rm = createRoom(static_cast<WorldFile::RoomType>(roomRecs[i].type));
+        else
+        {
+            res.message = "Unknown room type encountered.";
+            return res;
+        }
+        
+        // configure room and add to master list
+        rm->readRecord(file, roomRecs[i]);
+        if (!storeRoom(rm))
+        {
+            destroyRoom(rm);
+            res.message = "Invalid save data.";
+            return res;
+        }
+        
+        // link exits and target, or wait for rooms later in the file
+        for (int d = NORTH; d <= WEST; d++)
+            linkLoaded(roomRecs[i].id, d, roomRecs[i].exits[d]);
+        linkLoaded(roomRecs[i].id, TARGET_SLOT, roomRecs[i].target);
+    }
+    
+    // load world info
+    intro = file.getString(hdr.intro);
+    timeLimit = hdr.timeLimit;
+    start = findRoom(hdr.start);
+    endpoint = findRoom(hdr.endpoint);
+    
+    // load player info
+    user = Player(this, start);
+    user.readRecord(file, hdr.player);
+    
+    res.type = Result::SUCCESS;
+    return res;
+}
+
+/*************************************************************************
+ *  Function:       Result World::readText(std::ifstream &in)
+ *  Description:    Reads the text save format in one pass. Each line is
+ *                  read once, and numbers are converted in place rather
+ *                  than through a stringstream. Items must come first,
+ *                  but the rooms, exits and targets sections may come
+ *                  in any order: a link read before one of its rooms
+ *                  waits in the fixup table until the end of the file.
+ *  Parameters:     in  fstream to load the data from.
+ *  Preconditions:  World is empty.
+ *  Postconditions: World is initialized to data from 'in'.
+ ************************************************************************/
+Result World::readText(std::ifstream &in)
+{
+    Result res(Result::FAILURE);
+    res.message = "Invalid save data.";
+    std::string input;      // line buffer
+    unsigned ids[5];        // room IDs on an exit or target line
+    std::ostringstream oss; // intro builder
+    
+    // load items first, because rooms and the player hold them
+    std::getline(in, input);
+    if (input != "##ITEMS##")
+        return res;
+    
+    // keep reading until end marker is found
+    std::getline(in, input);
+    while (in && input != "##ENDITEMS##")
+    {
+        Item *itm = createItem(readId(input.c_str()));  // new Item object
+        itm->deserialize(in);                           // configure object
+        if (!storeItem(itm))
+        {
+            destroyItem(itm);
+            return res;
+        }
+        std::getline(in, input);
+    }
+    
+    // load rooms, room exits and switch room targets
+    std::getline(in, input);
+    while (in && input != "##INTRO##")
+    {
+        if (input == "##ROOMS##")
+        {
+            // keep reading room types until end marker is found
+            std::getline(in, input);
+            while (in && input != "##ENDROOMS##")
+            {
+                Room *rm = NULL;
+                if (input == "basic")
+                    rm = createRoom(WorldFile::BASIC_ROOM);
+                else if (input == "switch")
+                    rm = createRoom(WorldFile::SWITCH_ROOM);
+                else if (input == "condition")
+                    rm = createRoom(WorldFile::CONDITION_ROOM);
+                else
+                {
+                    res.message = "Unknown room type encountered.";
+                    return res;
+                }
+                
+                // configure room and add to master list
+                rm->deserialize(in);
+                if (!storeRoom(rm))
+                {
+                    destroyRoom(rm);
+                    return res;
+                }
+                std::getline(in, input);
+            }
+        }
+        else if (input == "##ROOMEXITS##")
+        {
+            // room ID followed by north, east, south and west room IDs
+            std::getline(in, input);
+            while (in && input != "##ENDROOMEXITS##")
+            {
+                readIds(input.c_str(), ids, 5);
+                for (int d = NORTH; d <= WEST; d++)
+                    linkLoaded(ids[0], d, ids[d + 1]);
+                std::getline(in, input);
+            }
+        }
+        else if (input == "##ROOMTARGETS##")
+        {
+            // room ID followed by target room ID
+            std::getline(in, input);
+            while (in && input != "##ENDROOMTARGETS##")
+            {
+                readIds(input.c_str(), ids, 2);
+                linkLoaded(ids[0], TARGET_SLOT, ids[1]);
+                std::getline(in, input);
+            }
+        }
+        else
+        {
+            return res;
+        }
+        std::getline(in, input);
+    }
+    if (!in)
+        return res;
+    
+    // load world info
+    
+    // get first line of intro
+    std::getline(in, input);
+    while (in && input != "##ENDINTRO##")
+    {
+        oss << input << std::endl;
+        std::getline(in, input);
+    }
+    intro = oss.str();
+    
+    // read time limit
+    std::getline(in, input);
+    timeLimit = readId(input.c_str());
+    
+    // read start room ID
+    std::getline(in, input);
+    start = findRoom(readId(input.c_str()));
+    
+    // read end room ID
+    std::getline(in, input);
+    endpoint = findRoom(readId(input.c_str()));
+    
+    // load player info
+    user = Player(this, start);
+    std::getline(in, input);
+    if (input != "##PLAYER##")
+        return res;
+    user.deserialize(in);
+    
+    res.type = Result::SUCCESS;
+    res.message.clear();
+    return res;
+}
+
 /*************************************************************************
  *  Function:       Result World::setIntro()
  *  Description:    Prompts user for the introductory text to display when
@@ -587,7 +1034,14 @@ void World::setTimeLimit(time_t seconds)
 *            Constructors and Destructor              *
 ******************************************************/
 World::World()
+    : roomPool(std::max(sizeof(BasicRoom),
+                        std::max(sizeof(SwitchRoom), sizeof(ConditionRoom)))),
+      itemPool(sizeof(Item)),
+      rooms(1, static_cast<Room *>(NULL)),
+      items(1, static_cast<Item *>(NULL))
 {
+    roomCount = 0;              // ID 0 is never used, so the lists
+    itemCount = 0;              // start with one NULL entry
     startTime = std::time(0);   // set start time to now
     timeLimit = 600;            // default time limit of 10 minutes
     editMode = false;           // edit mode off by default
@@ -599,25 +1053,8 @@ World::World()
 
 World::~World()
 {
-    // delete all rooms
-    std::map<unsigned, Room *>::iterator roomIt = rooms.begin();
-    while (roomIt != rooms.end())
-    {
-        delete roomIt->second;
-        roomIt->second = NULL;
-        roomIt++;
-    }
-    rooms.clear();
-
-    // delete all items
-    std::map<unsigned, Item *>::iterator itemIt = items.begin();
-    while (itemIt != items.end())
-    {
-        delete itemIt->second;
-        itemIt->second = NULL;
-        itemIt++;
-    }
-    items.clear();
+    // the pools free the memory
+    clear();
 }
 
 /******************************************************
@@ -625,7 +1062,8 @@ World::~World()
 ******************************************************/
 /*************************************************************************
  *  Function:       Result World::load(std::ifstream &in)
- *  Description:    Loads the game data from the specified fstream.
+ *  Description:    Loads the game data from the specified fstream and
+ *                  reports how many rooms and items were loaded per second.
  *  Parameters:     in  fstream to load the data from.
  *  Preconditions:  'in' contains valid game data.
  *  Postconditions: World is initialized to data from 'in'.
@@ -633,166 +1071,39 @@ World::~World()
 Result World::load(std::ifstream &in)
 {
     Result res(Result::FAILURE);
-    std::string input;      // user input buffer
-    unsigned val = 0;       // numeric input buffer
-    std::ostringstream oss; // intro builder
-    
-    if (in)
-    {
-        // load items first
-        std::getline(in, input);
-        if (input != "##ITEMS##")
-        {
-            res.message = "Invalid save data.";
-            return res;
-        }
-        
-        // get ID of first Item entry
-        std::getline(in, input);
-        
-        // keep reading until end marker is found
-        while (input != "##ENDITEMS##")
-        {
-            val = std::atoi(input.c_str());     // item ID
-            Item *itm = new Item(val);  // new Item object
-            itm->deserialize(in);       // configure object
-            items[val] = itm;           // add to master list
-            std::getline(in, input);    // read next line
-        }
-        
-        // load rooms next
-        std::getline(in, input);
-        if (input != "##ROOMS##")
-        {
-            res.message = "Invalid save data.";
-            return res;
-        }
-        
-        // load first room type
-        std::getline(in, input);
-        Room *rm = NULL;
-        
-        // keep reading until end marker is found
-        while (input != "##ENDROOMS##")
-        {
-            if (input == "basic")
-                rm = new BasicRoom(this);
-            else if (input == "switch")
-                rm = new SwitchRoom(this);
-            else if (input == "condition")
-                rm = new ConditionRoom(this);
-            else
-            {
-                res.message = "Unknown room type encountered.";
-                return res;
-            }
-            
-            // configure room
-            rm->deserialize(in);
-            
-            // add to master list
-            val = rm->getRoomId();
-            rooms[val] = rm;
-            
-            // read next room type
-            std::getline(in, input);
-        }
-        
-        // load room exits
-        std::getline(in, input);
-        if (input != "##ROOMEXITS##")
-        {
-            res.message = "Invalid save data.";
-            return res;
-        }
-        
-        // load exits of first room
-        std::getline(in, input);
-        while (input != "##ENDROOMEXITS##")
-        {
-            std::istringstream iss(input);
-            iss >> val;             // room ID
-            rm = findRoom(val);     // pointer to room
-            rm->deserializeExits(iss);
-            // get next line
-            std::getline(in, input);
-        }
-        
-        // load switch room targets
-        std::getline(in, input);
-        if (input != "##ROOMTARGETS##")
-        {
-            res.message = "Invalid save data.";
-            return res;
-        }
-        
-        // load target of first room
-        std::getline(in, input);
-        while (input != "##ENDROOMTARGETS##")
-        {
-            Room *t = NULL;
-            std::istringstream iss(input);
-            iss >> val;             // room ID
-            rm = findRoom(val);     // pointer to room
-            iss >> val;             // target room ID
-            t = findRoom(val);      // pointer to target
-            rm->setTarget(t);
-            // get next line
-            std::getline(in, input);
-        }
-        
-        // load world info
-        
-        // introduction
-        std::getline(in, input);
-        if (input != "##INTRO##")
-        {
-            res.message = "Invalid save data.";
-            return res;
-        }
-        
-        // get first line of intro
-        std::getline(in, input);
-        while (input != "##ENDINTRO##")
-        {
-            oss << input << std::endl;
-            std::getline(in, input);
-        }
-        intro = oss.str();
-        
-        // read time limit
-        std::getline(in, input);
-        timeLimit = std::atoi(input.c_str());
-        
-        // read start room ID
-        std::getline(in, input);
-        val = std::atoi(input.c_str());
-        start = findRoom(val);
-        
-        // read end room ID
-        std::getline(in, input);
-        val = std::atoi(input.c_str());
-        endpoint = findRoom(val);
-        
-        // load player info
-        user = Player(this, start);
-        std::getline(in, input);
-        if (input != "##PLAYER##")
-        {
-            res.message = "Invalid save data.";
-            return res;
-        }
-        
-        user.deserialize(in);
-        
-        res.type = Result::SUCCESS;
-        res.message = "World data successfully loaded.";
-    }
-    else
+    if (!in)
     {
         res.message = "Cannot read save data file.";
+        return res;
     }
-    return res;
+    
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    res = readText(in);
+    return finishLoad(res, std::chrono::duration<double>(
+                               std::chrono::steady_clock::now() - begin).count());
+}
+
+/*************************************************************************
+ *  Function:       Result World::loadBinary(const char *filename)
+ *  Description:    Loads the game data from the binary save file with the
+ *                  specified name. The file is mapped into memory and the
+ *                  fixed-width records are read in place, so no fields
+ *                  are parsed.
+ *  Parameters:     filename    Name of binary save file.
+ *  Preconditions:  World is empty.
+ *  Postconditions: World is initialized to data from the file.
+ ************************************************************************/
+Result World::loadBinary(const char *filename)
+{
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    WorldFile file;         // mapped save file
+    Result res = file.open(filename);
+    if (res.type != Result::SUCCESS)
+        return res;
+    
+    res = readBinary(file);
+    return finishLoad(res, std::chrono::duration<double>(
+                               std::chrono::steady_clock::now() - begin).count());
 }
 
 /*************************************************************************
@@ -832,9 +1143,9 @@ Result World::parse(Command cmd)
         {
             // check if item ID was entered
             value = std::atoi(cmd.getArgument().c_str());
-            // otherwise check if item name was entered
+            // otherwise look the name up in inventory
             if (value <= 0)
-                value = findItemId(cmd.getArgument());
+                value = user.findItemId(cmd.getArgument());
             res = user.dropItem(value);
         }
         break;
@@ -848,9 +1159,9 @@ Result World::parse(Command cmd)
         {
             // check if item ID was entered
             value = std::atoi(cmd.getArgument().c_str());
-            // otherwise check if item name was entered
+            // otherwise look the name up in the current room
             if (value <= 0)
-                value = findItemId(cmd.getArgument());
+                value = user.getCurrentRoom()->findItemId(cmd.getArgument());
             res = user.take(value);
         }
         break;
@@ -864,9 +1175,11 @@ Result World::parse(Command cmd)
         {
             // check if item ID was entered
             value = std::atoi(cmd.getArgument().c_str());
-            // otherwise check if item name was entered
+            // otherwise look the name up in inventory, then the room
             if (value <= 0)
-                value = findItemId(cmd.getArgument());
+                value = user.findItemId(cmd.getArgument());
+            if (value <= 0)
+                value = user.getCurrentRoom()->findItemId(cmd.getArgument());
             res = user.useItem(value);
         }
         break;
@@ -1004,10 +1317,10 @@ Result World::parse(Command cmd)
             if (value <= 0)
                 value = findItemId(cmd.getArgument());
             // make sure ID is valid
-            std::map<unsigned, Item *>::iterator it = items.find(value);
-            if (it != items.end())
+            Item *itm = findItem(value);
+            if (itm)
             {
-                res = user.getCurrentRoom()->setRequired(it->second);
+                res = user.getCurrentRoom()->setRequired(itm);
             }
             else
             {
@@ -1026,10 +1339,10 @@ Result World::parse(Command cmd)
         else
         {
             // make sure ID is valid
-            std::map<unsigned, Room *>::iterator it = rooms.find(value);
-            if (it != rooms.end())
+            Room *rm = findRoom(value);
+            if (rm)
             {
-                res = user.getCurrentRoom()->setTarget(it->second);
+                res = user.getCurrentRoom()->setTarget(rm);
             }
             else
             {
@@ -1089,7 +1402,17 @@ Result World::parse(Command cmd)
         std::cout << "Press Enter to continue...";
         std::getline(std::cin, input);
         break;
-    case Command::WORLD_SAVE:          // save the world to file
+    case Command::WORLD_SAVE:          // save the world to binary file
+        // use default filename if none specified
+        if (cmd.getArgument().empty())
+            input = DEFAULT_BINARY_FILENAME;
+        else
+            input = cmd.getArgument();
+        ofs.open(input.c_str(), std::ios::out | std::ios::binary);
+        res = saveBinary(ofs);
+        ofs.close();
+        break;
+    case Command::WORLD_EXPORT:        // save the world to text file
         // use default filename if none specified
         if (cmd.getArgument().empty())
             input = DEFAULT_FILENAME;
@@ -1146,25 +1469,37 @@ void World::run()
     Command cmd;
     std::string input;
     
-    // try to load game data
-    std::ifstream ifs(DEFAULT_FILENAME);
-    if (ifs)
+    // try to load binary game data, then text game data; a load that
+    // fails partway is cleared before the next one
+    if (WorldFile::isWorldFile(DEFAULT_BINARY_FILENAME))
     {
-        res = load(ifs);
+        res = loadBinary(DEFAULT_BINARY_FILENAME);
+        if (res.type != Result::SUCCESS)
+            clear();
+    }
+    if (res.type != Result::SUCCESS)
+    {
+        std::ifstream ifs(DEFAULT_FILENAME);
+        if (ifs)
+        {
+            res = load(ifs);
+            if (res.type != Result::SUCCESS)
+                clear();
+        }
+        ifs.close();
     }
-    ifs.close();
     
     // create initial room if none exist
-    if (rooms.size() == 0)
+    if (roomCount == 0)
     {
-        start = new BasicRoom(this);
-        rooms[start->getRoomId()] = start;
+        start = createRoom(WorldFile::BASIC_ROOM);
+        storeRoom(start);
     }
     
-    // set start point if NULL
-    if (!start)
+    // set start point to the room with the lowest ID if NULL
+    for (unsigned id = 0; !start && id < rooms.size(); id++)
     {
-        start = rooms.begin()->second;
+        start = rooms[id];
     }
     
     // only initialize player data if load was unsuccessful
@@ -1174,6 +1509,10 @@ void World::run()
         user = Player(this, start);
     }
     
+    // display load result
+    if (!res.message.empty())
+        std::cout << res.message << std::endl << std::endl;
+    
     // display intro
     std::cout << intro << std::endl;
     
@@ -1257,50 +1596,47 @@ Result World::save(std::ofstream &out)
         // item section heading
         out << "##ITEMS##" << std::endl;
         // write all items
-        std::map<unsigned, Item *>::iterator it = items.begin();
-        while (it != items.end())
+        for (unsigned id = 0; id < items.size(); id++)
         {
-            out << *it->second;
-            ++it;
+            if (items[id])
+                out << *items[id];
         }
         out << "##ENDITEMS##" << std::endl;
         
         // room section heading
         out << "##ROOMS##" << std::endl;
         // write room info
-        std::map<unsigned, Room *>::iterator rmIt = rooms.begin();
-        while (rmIt != rooms.end())
+        for (unsigned id = 0; id < rooms.size(); id++)
         {
-            rmIt->second->serialize(out);
-            ++rmIt;
+            if (rooms[id])
+                rooms[id]->serialize(out);
         }
         out << "##ENDROOMS##" << std::endl;
         
         // room exits section heading
         out << "##ROOMEXITS##" << std::endl;
         // write room info
-        rmIt = rooms.begin();
-        while (rmIt != rooms.end())
+        for (unsigned id = 0; id < rooms.size(); id++)
         {
-            rmIt->second->serializeExits(out);
-            ++rmIt;
+            if (rooms[id])
+                rooms[id]->serializeExits(out);
         }
         out << "##ENDROOMEXITS##" << std::endl;
         
         // room targets section heading
         out << "##ROOMTARGETS##" << std::endl;
-        rmIt = rooms.begin();
-        while (rmIt != rooms.end())
+        for (unsigned id = 0; id < rooms.size(); id++)
         {
+            if (!rooms[id])
+                continue;
             // output source room ID
-            out << rmIt->first << " ";
+            out << id << " ";
             // output target room ID or 0 for NULL
-            if (rmIt->second->getTarget())
-                out << rmIt->second->getTarget()->getRoomId();
+            if (rooms[id]->getTarget())
+                out << rooms[id]->getTarget()->getRoomId();
             else
                 out << 0;
             out << std::endl;
-            ++rmIt;
         }
         out << "##ENDROOMTARGETS##" << std::endl;
         
@@ -1329,3 +1665,54 @@ Result World::save(std::ofstream &out)
     }
     return res;
 }
+
+/*************************************************************************
+ *  Function:       Result World::saveBinary(std::ofstream &out)
+ *  Description:    Saves the current game data in the binary save format
+ *                  to the specified fstream.
+ *  Parameters:     out     fstream opened in binary mode to save data to.
+ *  Preconditions:  fstream is available for writing.
+ *  Postconditions: World data is output to fstream.
+ ************************************************************************/
+Result World::saveBinary(std::ofstream &out)
+{
+    Result res(Result::SUCCESS);
+    if (!out)
+    {
+        res.type = Result::FAILURE;
+        res.message = "Cannot open file for writing.";
+        return res;
+    }
+    
+    WorldFile file;             // records and strings to write
+    WorldFile::Header hdr;      // world settings
+    std::memset(&hdr, 0, sizeof(hdr));
+    
+    // add all items
+    for (unsigned id = 0; id < items.size(); id++)
+    {
+        if (items[id])
+            items[id]->writeRecord(file);
+    }
+    
+    // add all rooms with their exits and targets
+    for (unsigned id = 0; id < rooms.size(); id++)
+    {
+        if (rooms[id])
+            rooms[id]->writeRecord(file);
+    }
+    
+    // world settings
+    hdr.intro = file.addString(intro);
+    hdr.timeLimit = timeLimit;
+    hdr.start = start->getRoomId();
+    hdr.endpoint = endpoint ? endpoint->getRoomId() : 0;
+    
+    // player settings and inventory
+    user.writeRecord(file, hdr.player);
+    
+    res = file.write(out, hdr);
+    if (res.type == Result::SUCCESS)
+        res.message = "Game data saved.";
+    return res;
+}
@@ -16,20 +16,23 @@
 #include <ctime>
 #include <string>
 #include <map>
+#include <vector>
 #include <iostream>
 #include <fstream>
 
 #include "Direction.hpp"
 #include "Result.hpp"
 #include "Player.hpp"
+#include "Item.hpp"
+#include "Pool.hpp"
 
 // forward class declarations
 class Room;
-class Item;
 class Command;
 
 class World
 {
+    friend class UnitTest;      // for unit testing
 private:
     /******************************************************
     *             Private Member Variables                *
@@ -41,8 +44,23 @@ private:
         unsigned rm;        // room ID that exit leads to
     };
     
-    std::map<unsigned, Room *> rooms;    // all rooms in the game world
-    std::map<unsigned, Item *> items;    // all items in the game world
+    // a link read before one of its rooms was loaded, resolved at the end
+    struct Fixup
+    {
+        unsigned from;      // room ID holding the link
+        int slot;           // Direction of exit or TARGET_SLOT
+        unsigned to;        // room ID that the link leads to
+    };
+    static const int TARGET_SLOT = 4;   // Fixup slot of a switch target
+    static const unsigned MAX_ID = 1 << 24; // largest room or item ID + 1
+    
+    Pool roomPool;          // memory of all rooms in the game world
+    Pool itemPool;          // memory of all items in the game world
+    std::vector<Room *> rooms;  // all rooms in the game world by ID or NULL
+    std::vector<Item *> items;  // all items in the game world by ID or NULL
+    unsigned roomCount;     // number of rooms in the game world
+    unsigned itemCount;     // number of items in the game world
+    Item::NameIndex itemNames;  // IDs of the items with each name
     time_t startTime;       // time that gameplay started
     time_t timeLimit;       // gameplay time limit in seconds
     Player user;            // player info
@@ -51,6 +69,7 @@ private:
     Room *start;            // starting point
     Room *endpoint;         // exit
     std::string intro;      // game introduction text
+    std::vector<Fixup> pending;     // links waiting for a room while loading
     
     /******************************************************
     *             Private Member Functions                *
@@ -73,6 +92,33 @@ private:
     // finds the ID of the first item that matches the specified name or 0
     unsigned findItemId(std::string);
     
+    // creates an item or room of the specified type in the pools
+    Item *createItem(unsigned);
+    Room *createRoom(WorldFile::RoomType);
+    
+    // adds an item or room to the master list at the index of its ID
+    bool storeItem(Item *);
+    bool storeRoom(Room *);
+    
+    // removes an item or room from the master list and frees it
+    void destroyItem(Item *);
+    void destroyRoom(Room *);
+    
+    // destroys all rooms and items and resets the world settings
+    void clear();
+    
+    // sets an exit or target of a loaded room now or once both rooms exist
+    void linkLoaded(unsigned, int, unsigned);
+    
+    // reads the text save format in one pass
+    Result readText(std::ifstream &);
+    
+    // reads the records of a mapped binary save file
+    Result readBinary(const WorldFile &);
+    
+    // resolves pending links and reports throughput
+    Result finishLoad(Result, double);
+    
     // lists all of the items in the game world with IDs
     void listItems();
     
@@ -104,6 +150,9 @@ public:
     // loads the game data from the specified fstream
     Result load(std::ifstream &);
     
+    // loads the game data from the binary save file with the specified name
+    Result loadBinary(const char *);
+    
     // Parses and runs the specified Command object
     Result parse(Command);
     
@@ -112,6 +161,9 @@ public:
     
     // saves the current game data to the specified fstream
     Result save(std::ofstream &);
+    
+    // saves the current game data in binary format to the specified fstream
+    Result saveBinary(std::ofstream &);
 };
 
 #endif  // end of WORLD_HPP definition
@@ -0,0 +1,324 @@
+/*************************************************************************
+ * Author:                 David Rigert
+ * Date Created:           10/17/2026
+ * Last Modification Date: 10/17/2026
+ * Course:                 CS162_400
+ * Assignment:             Final Project
+ * Filename:               WorldFile.cpp
+ *
+ * Overview:
+ *     Implementation for the WorldFile class.
+ ************************************************************************/
+#include "WorldFile.hpp"
+
+#include <cstring>      // memcmp, memcpy
+#include <fstream>
+#include <fcntl.h>      // open
+#include <sys/mman.h>   // mmap
+#include <sys/stat.h>   // fstat
+#include <unistd.h>     // close
+
+#include "Item.hpp"
+
+// identifies a binary save file
+const char WorldFile::MAGIC[8] = {'C', 'S', '1', '6', '2', 'W', 'L', 'D'};
+
+// constructor
+WorldFile::WorldFile()
+{
+    map = NULL;
+    mapSize = 0;
+    header = NULL;
+    items = NULL;
+    rooms = NULL;
+    names = NULL;
+    refs = NULL;
+    strings = NULL;
+    chars = NULL;
+    
+    // string index 0 is always the empty string
+    addString("");
+}
+
+// destructor
+WorldFile::~WorldFile()
+{
+    close();
+}
+
+/******************************************************
+*                     Saving                          *
+******************************************************/
+/*************************************************************************
+ *  Function:       uint32_t WorldFile::addString(const std::string &str)
+ *  Description:    Adds a string to the string table unless an equal
+ *                  string was already added.
+ *  Parameters:     str     String to add.
+ *  Preconditions:  None.
+ *  Postconditions: Returns the index of the string in the string table.
+ ************************************************************************/
+uint32_t WorldFile::addString(const std::string &str)
+{
+    std::unordered_map<std::string, uint32_t>::iterator it;
+    it = stringIds.find(str);
+    if (it != stringIds.end())
+        return it->second;
+    
+    // append characters and add an entry to the string table
+    StringRecord rec;
+    rec.offset = charList.size();
+    rec.length = str.size();
+    charList += str;
+    stringList.push_back(rec);
+    
+    uint32_t index = stringList.size() - 1;
+    stringIds[str] = index;
+    return index;
+}
+
+/*************************************************************************
+ *  Function:       uint32_t WorldFile::addNames(
+ *                      const std::set<std::string> &aliases)
+ *  Description:    Adds the aliases of an item to the names array.
+ *  Parameters:     aliases Names of the item.
+ *  Preconditions:  None.
+ *  Postconditions: Returns the index of the first alias in names.
+ ************************************************************************/
+uint32_t WorldFile::addNames(const std::set<std::string> &aliases)
+{
+    uint32_t first = nameList.size();
+    std::set<std::string>::const_iterator it = aliases.begin();
+    while (it != aliases.end())
+    {
+        nameList.push_back(addString(*it));
+        ++it;
+    }
+    return first;
+}
+
+/*************************************************************************
+ *  Function:       uint32_t WorldFile::addItems(
+ *                      const std::map<unsigned, Item *> &list)
+ *  Description:    Adds the IDs of a list of items to the refs array.
+ *  Parameters:     list    Items held by a room or the player.
+ *  Preconditions:  None.
+ *  Postconditions: Returns the index of the first item ID in refs.
+ ************************************************************************/
+uint32_t WorldFile::addItems(const std::map<unsigned, Item *> &list)
+{
+    uint32_t first = refList.size();
+    std::map<unsigned, Item *>::const_iterator it = list.begin();
+    while (it != list.end())
+    {
+        refList.push_back(it->first);
+        ++it;
+    }
+    return first;
+}
+
+// adds a new zeroed item record and returns a reference to it
+WorldFile::ItemRecord &WorldFile::addItemRecord()
+{
+    ItemRecord rec;
+    std::memset(&rec, 0, sizeof(rec));
+    itemRecords.push_back(rec);
+    return itemRecords.back();
+}
+
+// adds a new zeroed room record and returns a reference to it
+WorldFile::RoomRecord &WorldFile::addRoomRecord()
+{
+    RoomRecord rec;
+    std::memset(&rec, 0, sizeof(rec));
+    roomRecords.push_back(rec);
+    return roomRecords.back();
+}
+
+/*************************************************************************
+ *  Function:       Result WorldFile::write(std::ostream &out, Header &hdr)
+ *  Description:    Writes the header followed by all added records, names,
+ *                  item IDs and strings to the stream.
+ *  Parameters:     out     Binary stream to write to.
+ *                  hdr     Header with the world settings filled in. The
+ *                          magic number, version and counts are set here.
+ *  Preconditions:  All records of the world have been added.
+ *  Postconditions: The file is written to the stream.
+ ************************************************************************/
+Result WorldFile::write(std::ostream &out, Header &hdr)
+{
+    Result res(Result::SUCCESS);
+    
+    // fill in the fields describing the layout
+    std::memcpy(hdr.magic, MAGIC, sizeof(hdr.magic));
+    hdr.version = VERSION;
+    hdr.itemCount = itemRecords.size();
+    hdr.roomCount = roomRecords.size();
+    hdr.nameCount = nameList.size();
+    hdr.refCount = refList.size();
+    hdr.stringCount = stringList.size();
+    hdr.charCount = charList.size();
+    
+    // write each section as one block
+    out.write(reinterpret_cast<const char *>(&hdr), sizeof(hdr));
+    if (!itemRecords.empty())
+        out.write(reinterpret_cast<const char *>(&itemRecords[0]),
+                  itemRecords.size() * sizeof(ItemRecord));
+    if (!roomRecords.empty())
+        out.write(reinterpret_cast<const char *>(&roomRecords[0]),
+                  roomRecords.size() * sizeof(RoomRecord));
+    if (!nameList.empty())
+        out.write(reinterpret_cast<const char *>(&nameList[0]),
+                  nameList.size() * sizeof(uint32_t));
+    if (!refList.empty())
+        out.write(reinterpret_cast<const char *>(&refList[0]),
+                  refList.size() * sizeof(uint32_t));
+    out.write(reinterpret_cast<const char *>(&stringList[0]),
+              stringList.size() * sizeof(StringRecord));
+    out.write(charList.data(), charList.size());
+    
+    if (!out)
+    {
+        res.type = Result::FAILURE;
+        res.message = "Cannot write save data.";
+    }
+    return res;
+}
+
+/******************************************************
+*                     Loading                         *
+******************************************************/
+/*************************************************************************
+ *  Function:       Result WorldFile::open(const char *filename)
+ *  Description:    Maps the binary save file with the specified name into
+ *                  memory and checks that every section, list and string
+ *                  lies inside the file.
+ *  Parameters:     filename    Name of file to open.
+ *  Preconditions:  None.
+ *  Postconditions: Records can be read if successful.
+ ************************************************************************/
+Result WorldFile::open(const char *filename)
+{
+    Result res(Result::FAILURE);
+    close();
+    
+    // map the whole file read-only
+    int fd = ::open(filename, O_RDONLY);
+    if (fd < 0)
+    {
+        res.message = "Cannot read save data file.";
+        return res;
+    }
+    struct stat info;
+    if (fstat(fd, &info) == 0 && info.st_size >= (off_t)sizeof(Header))
+    {
+        mapSize = info.st_size;
+        map = mmap(NULL, mapSize, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map == MAP_FAILED)
+            map = NULL;
+    }
+    ::close(fd);
+    if (!map)
+    {
+        res.message = "Invalid save data.";
+        return res;
+    }
+    
+    // check the header
+    header = static_cast<const Header *>(map);
+    if (std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0
+        || header->version != VERSION)
+    {
+        close();
+        res.message = "Unsupported save data version.";
+        return res;
+    }
+    
+    // find each section and check the total size
+    uint64_t size = sizeof(Header);
+    uint64_t itemPos = size;
+    size += (uint64_t)header->itemCount * sizeof(ItemRecord);
+    uint64_t roomPos = size;
+    size += (uint64_t)header->roomCount * sizeof(RoomRecord);
+    uint64_t namePos = size;
+    size += (uint64_t)header->nameCount * sizeof(uint32_t);
+    uint64_t refPos = size;
+    size += (uint64_t)header->refCount * sizeof(uint32_t);
+    uint64_t stringPos = size;
+    size += (uint64_t)header->stringCount * sizeof(StringRecord);
+    uint64_t charPos = size;
+    size += header->charCount;
+    if (size != mapSize)
+    {
+        close();
+        res.message = "Invalid save data.";
+        return res;
+    }
+    const char *base = static_cast<const char *>(map);
+    items = reinterpret_cast<const ItemRecord *>(base + itemPos);
+    rooms = reinterpret_cast<const RoomRecord *>(base + roomPos);
+    names = reinterpret_cast<const uint32_t *>(base + namePos);
+    refs = reinterpret_cast<const uint32_t *>(base + refPos);
+    strings = reinterpret_cast<const StringRecord *>(base + stringPos);
+    chars = base + charPos;
+    
+    // check that lists and strings stay inside their sections
+    bool valid = (uint64_t)header->player.firstItem
+                 + header->player.itemCount <= header->refCount;
+    for (uint32_t i = 0; valid && i < header->itemCount; i++)
+    {
+        valid = (uint64_t)items[i].firstName + items[i].nameCount
+                <= header->nameCount;
+    }
+    for (uint32_t i = 0; valid && i < header->roomCount; i++)
+    {
+        valid = (uint64_t)rooms[i].firstItem + rooms[i].itemCount
+                <= header->refCount;
+    }
+    for (uint32_t i = 0; valid && i < header->stringCount; i++)
+    {
+        valid = (uint64_t)strings[i].offset + strings[i].length
+                <= header->charCount;
+    }
+    if (!valid)
+    {
+        close();
+        res.message = "Invalid save data.";
+        return res;
+    }
+    
+    res.type = Result::SUCCESS;
+    return res;
+}
+
+// unmaps the file opened by open
+void WorldFile::close()
+{
+    if (map)
+        munmap(map, mapSize);
+    map = NULL;
+    mapSize = 0;
+    header = NULL;
+    items = NULL;
+    rooms = NULL;
+    names = NULL;
+    refs = NULL;
+    strings = NULL;
+    chars = NULL;
+}
+
+// determines whether the file with the specified name is a binary save
+bool WorldFile::isWorldFile(const char *filename)
+{
+    char magic[sizeof(MAGIC)];  // first bytes of file
+    std::ifstream in(filename, std::ios::binary);
+    in.read(magic, sizeof(magic));
+    return in && std::memcmp(magic, MAGIC, sizeof(MAGIC)) == 0;
+}
+
+// gets the string with the specified index or an empty string
+std::string WorldFile::getString(uint32_t index) const
+{
+    if (index >= header->stringCount)
+        return std::string();
+    return std::string(chars + strings[index].offset, strings[index].length);
+}
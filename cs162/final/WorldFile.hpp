@@ -0,0 +1,209 @@
+/*************************************************************************
+ * Author:                 David Rigert
+ * Date Created:           10/17/2026
+ * Last Modification Date: 10/17/2026
+ * Course:                 CS162_400
+ * Assignment:             Final Project
+ * Filename:               WorldFile.hpp
+ *
+ * Overview:
+ *     Represents the binary save file format. The file is a header
+ *     followed by arrays of fixed-width records and a string table:
+ *
+ *         Header
+ *         ItemRecord[itemCount]
+ *         RoomRecord[roomCount]
+ *         uint32_t names[nameCount]     string indexes of item aliases
+ *         uint32_t refs[refCount]       item IDs held by rooms and player
+ *         StringRecord[stringCount]     offset and length of each string
+ *         char chars[charCount]         string bytes
+ *
+ *     Records refer to strings by index into the string table, so
+ *     repeated text is stored once, and to lists of names or item IDs by
+ *     the first index and count into the names or refs arrays. Numbers
+ *     are stored in the byte order of the machine that saved the file.
+ *
+ *     A WorldFile collects records and strings while a world is being
+ *     saved, or maps a saved file into memory so records can be read in
+ *     place without parsing.
+ ************************************************************************/
+#ifndef WORLDFILE_HPP
+#define WORLDFILE_HPP
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <set>
+#include <map>
+#include <unordered_map>
+#include <iostream>
+
+#include "Result.hpp"
+
+class Item;
+
+class WorldFile
+{
+    friend class UnitTest;      // for unit testing
+public:
+    static const char MAGIC[8];         // identifies a binary save file
+    static const uint32_t VERSION = 1;  // current format version
+    
+    // room types stored in RoomRecord::type
+    enum RoomType { BASIC_ROOM, SWITCH_ROOM, CONDITION_ROOM };
+    
+    // flags stored in RoomRecord::flags
+    enum RoomFlag
+    {
+        ENABLED       = 1,      // room is in toggled state
+        NORTH_ENABLED = 2,      // state affects the north exit
+        EAST_ENABLED  = 4,      // state affects the east exit
+        SOUTH_ENABLED = 8,      // state affects the south exit
+        WEST_ENABLED  = 16      // state affects the west exit
+    };
+    
+    // player settings and inventory
+    struct PlayerRecord
+    {
+        uint32_t weightLimit;   // maximum weight the player can carry
+        uint32_t maxSize;       // maximum size of item to pick up
+        uint32_t maxQuantity;   // maximum number of items to carry
+        uint32_t firstItem;     // index of first inventory ID in refs
+        uint32_t itemCount;     // number of items in inventory
+    };
+    
+    // start of the file
+    struct Header
+    {
+        char magic[8];          // always MAGIC
+        int64_t timeLimit;      // gameplay time limit in seconds
+        uint32_t version;       // always VERSION
+        uint32_t itemCount;     // number of item records
+        uint32_t roomCount;     // number of room records
+        uint32_t nameCount;     // number of item alias names
+        uint32_t refCount;      // number of item IDs held by rooms and player
+        uint32_t stringCount;   // number of strings in the string table
+        uint32_t charCount;     // total length of the strings
+        uint32_t intro;         // string index of introduction text
+        uint32_t start;         // starting room ID
+        uint32_t endpoint;      // exit room ID or 0
+        PlayerRecord player;    // player settings and inventory
+    };
+    
+    // one Item
+    struct ItemRecord
+    {
+        uint32_t id;            // unique ID of item
+        uint32_t realName;      // string index of actual name
+        uint32_t desc;          // string index of description
+        uint32_t firstName;     // index of first alias in names
+        uint32_t nameCount;     // number of aliases including realName
+        int32_t size;           // size of item
+        int32_t weight;         // weight of item
+    };
+    
+    // one Room of any type
+    struct RoomRecord
+    {
+        uint32_t id;            // unique room ID
+        uint8_t type;           // RoomType of room
+        uint8_t flags;          // RoomFlag values of room
+        uint16_t reserved;      // always 0
+        uint32_t desc;          // string index of description
+        uint32_t altDesc;       // string index of alternate description
+        uint32_t required;      // ID of item required to use room or 0
+        uint32_t target;        // ID of room affected by switch or 0
+        uint32_t exits[4];      // IDs of rooms in each Direction or 0
+        uint32_t firstItem;     // index of first item ID in refs
+        uint32_t itemCount;     // number of items in room
+    };
+    
+    // location of one string in chars
+    struct StringRecord
+    {
+        uint32_t offset;        // offset of first character
+        uint32_t length;        // number of characters
+    };
+    
+private:
+    // used while saving
+    std::vector<ItemRecord> itemRecords;    // records of all items
+    std::vector<RoomRecord> roomRecords;    // records of all rooms
+    std::vector<uint32_t> nameList;         // string indexes of aliases
+    std::vector<uint32_t> refList;          // item IDs in rooms and player
+    std::vector<StringRecord> stringList;   // string table
+    std::string charList;                   // string bytes
+    std::unordered_map<std::string, uint32_t> stringIds; // string indexes
+    
+    // used while loading
+    void *map;                  // start of mapped file or NULL
+    size_t mapSize;             // size of mapped file
+    const Header *header;       // header of mapped file
+    const ItemRecord *items;    // item records of mapped file
+    const RoomRecord *rooms;    // room records of mapped file
+    const uint32_t *names;      // alias names of mapped file
+    const uint32_t *refs;       // item IDs of mapped file
+    const StringRecord *strings;// string table of mapped file
+    const char *chars;          // string bytes of mapped file
+    
+    // not copyable, because a copy would unmap the file twice
+    WorldFile(const WorldFile &);
+    WorldFile &operator=(const WorldFile &);
+    
+public:
+    WorldFile();
+    ~WorldFile();
+    
+    /******************************************************
+    *                     Saving                          *
+    ******************************************************/
+    // adds a string to the string table once and returns its index
+    uint32_t addString(const std::string &);
+    
+    // adds the aliases of an item and returns the index of the first one
+    uint32_t addNames(const std::set<std::string> &);
+    
+    // adds the IDs of a list of items and returns the index of the first one
+    uint32_t addItems(const std::map<unsigned, Item *> &);
+    
+    // adds a new zeroed item record and returns a reference to it
+    ItemRecord &addItemRecord();
+    
+    // adds a new zeroed room record and returns a reference to it
+    RoomRecord &addRoomRecord();
+    
+    // writes the header followed by all added records to the stream
+    Result write(std::ostream &, Header &);
+    
+    /******************************************************
+    *                     Loading                         *
+    ******************************************************/
+    // maps the binary save file with the specified name into memory
+    Result open(const char *);
+    
+    // unmaps the file opened by open
+    void close();
+    
+    // determines whether the file with the specified name is a binary save
+    static bool isWorldFile(const char *);
+    
+    // gets the header of the mapped file
+    const Header &getHeader() const         { return *header; }
+    
+    // gets the item records of the mapped file
+    const ItemRecord *getItems() const      { return items; }
+    
+    // gets the room records of the mapped file
+    const RoomRecord *getRooms() const      { return rooms; }
+    
+    // gets the string with the specified index or an empty string
+    std::string getString(uint32_t) const;
+    
+    // gets the string index of the alias with the specified index
+    uint32_t getName(uint32_t i) const      { return names[i]; }
+    
+    // gets the item ID with the specified index in refs
+    uint32_t getItemId(uint32_t i) const    { return refs[i]; }
+};
+
+#endif  // end of WORLDFILE_HPP definition
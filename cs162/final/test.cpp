@@ -30,5 +30,13 @@ int main()
     std::cout << "Running Player class unit tests..." << std::endl;
     UnitTest::test_Player();
     std::cout << std::endl;
+    
+    std::cout << "Running WorldFile class unit tests..." << std::endl;
+    UnitTest::test_WorldFile();
+    std::cout << std::endl;
+    
+    std::cout << "Running Pool class unit tests..." << std::endl;
+    UnitTest::test_Pool();
+    std::cout << std::endl;
 }
 